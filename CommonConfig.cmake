@@ -184,6 +184,22 @@ if (NOT DEFINED ENABLE_SECURE_STORAGE)
 	if (NOT DEFINED SST_ENABLE_PARTIAL_ASSET_RW)
 		set (SST_ENABLE_PARTIAL_ASSET_RW ON)
 	endif()
+
+	if (NOT DEFINED SST_FLASH_TRACE)
+		set (SST_FLASH_TRACE OFF)
+	endif()
+
+	if (NOT DEFINED SST_FLASH_CACHE)
+		set (SST_FLASH_CACHE OFF)
+	endif()
+
+	if (NOT DEFINED SST_FLASH_ASYNC)
+		set (SST_FLASH_ASYNC OFF)
+	endif()
+
+	if (NOT DEFINED SST_KV)
+		set (SST_KV OFF)
+	endif()
 endif()
 
 if (NOT DEFINED MBEDTLS_DEBUG)
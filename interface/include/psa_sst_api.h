@@ -190,6 +190,44 @@ enum psa_sst_err_t psa_sst_write(uint32_t asset_uuid,
                                  uint32_t offset,
                                  const uint8_t *data);
 
+/**
+ * \brief Reads a batch of assets, in a single call to the secure storage.
+ *
+ * \param[in]     ios      Pointer to the descriptors
+ *                         \ref psa_sst_asset_io_t of the reads
+ * \param[in/out] nbr_ios  Pointer to the number of descriptors. It is set to
+ *                         the number of assets read.
+ *
+ * \note The reads are done in order, without interleaving any other request
+ *       to the storage areas of the assets, and stop at the first one which
+ *       fails.
+ *
+ * \return Returns error code of the first read which fails, as specified in
+ *         \ref psa_sst_err_t
+ */
+enum psa_sst_err_t psa_sst_read_multi(const struct psa_sst_asset_io_t *ios,
+                                      uint32_t *nbr_ios);
+
+/**
+ * \brief Writes a batch of assets, in a single call to the secure storage.
+ *
+ * \param[in]     ios      Pointer to the descriptors
+ *                         \ref psa_sst_asset_io_t of the writes
+ * \param[in/out] nbr_ios  Pointer to the number of descriptors. It is set to
+ *                         the number of assets written.
+ *
+ * \note The writes are done in order, without interleaving any other request
+ *       to the storage areas of the assets, and stop at the first one which
+ *       fails. They are not applied as a transaction: the assets written
+ *       before the failure keep their new content. psa_sst_apply_ops applies
+ *       a list of writes as a transaction.
+ *
+ * \return Returns error code of the first write which fails, as specified in
+ *         \ref psa_sst_err_t
+ */
+enum psa_sst_err_t psa_sst_write_multi(const struct psa_sst_asset_io_t *ios,
+                                       uint32_t *nbr_ios);
+
 /**
  * \brief Deletes the asset referenced by the asset UUID.
  *
@@ -209,6 +247,171 @@ enum psa_sst_err_t psa_sst_delete(uint32_t asset_uuid,
                                   const uint8_t* token,
                                   uint32_t token_size);
 
+/**
+ * \brief Performs a list of create, write and delete operations on assets as
+ *        a single atomic update, in a single call to the secure storage.
+ *        Either all the operations are performed or none of them.
+ *
+ * \param[in] token       Must be set to NULL, reserved for future use.
+ *                        Pointer to the token of the assets. This is an
+ *                        optional parameter that has to be NULL in case the
+ *                        token is not provied.
+ * \param[in] token_size  Must be set to 0, reserved for future use.
+ *                        Token size. In case the token is not provided
+ *                        the token size has to be 0.
+ * \param[in] ops         Pointer to the list of operations
+ *                        \ref psa_sst_asset_op_t
+ * \param[in] nbr_ops     Number of operations in the list
+ *
+ * \note All the assets must be stored in the same storage area. Otherwise,
+ *       PSA_SST_ERR_PARAM_ERROR is returned and none of the operations is
+ *       performed. No other request to this storage area is interleaved with
+ *       the operations.
+ *
+ * \return Returns error code of the first operation which fails, as
+ *         specified in \ref psa_sst_err_t
+ */
+enum psa_sst_err_t psa_sst_apply_ops(const uint8_t* token,
+                                     uint32_t token_size,
+                                     const struct psa_sst_asset_op_t *ops,
+                                     uint32_t nbr_ops);
+
+/**
+ * \brief Gets the wear information of the flash blocks used by the secure
+ *        storage, based on the number of erases of each block.
+ *
+ * \param[out] info  Pointer to store the wear information
+ *                   \ref psa_sst_wear_info_t
+ *
+ * \return Returns error code as specified in \ref psa_sst_err_t
+ */
+enum psa_sst_err_t psa_sst_get_wear_info(struct psa_sst_wear_info_t *info);
+
+/**
+ * \brief Performs the maintenance of the secure storage. It erases the flash
+ *        blocks which have been retired by the previous updates, so that the
+ *        next updates do not have to erase them. Then, it performs a bounded
+ *        step of the compaction of the storage's data blocks.
+ *
+ * \note It is meant to be called periodically from an idle thread, as
+ *       erasing a flash block is a slow operation.
+ *
+ * \return Returns error code as specified in \ref psa_sst_err_t
+ */
+enum psa_sst_err_t psa_sst_maintenance(void);
+
+/**
+ * \brief Lists the first assets which the calling application can access,
+ *        with their sizes.
+ *
+ * \param[out]    cursor       Pointer to the listing cursor, which is set to
+ *                             get the next assets with \ref psa_sst_list_next
+ * \param[out]    entries      Pointer to store the entries
+ *                             \ref psa_sst_asset_list_entry_t
+ * \param[in/out] nbr_entries  Pointer to the number of entries which can be
+ *                             stored. It is set to the number of entries
+ *                             stored.
+ *
+ * \note The entries are taken from the metadata of the secure storage, so the
+ *       assets are not read. A single call lists all the assets if the
+ *       entries can hold them.
+ *
+ * \return Returns PSA_SST_ERR_ASSET_NOT_FOUND if there is no asset, or
+ *         another error code as specified in \ref psa_sst_err_t
+ */
+enum psa_sst_err_t psa_sst_list_first(uint32_t *cursor,
+                                     struct psa_sst_asset_list_entry_t *entries,
+                                     uint32_t *nbr_entries);
+
+/**
+ * \brief Lists the next assets which the calling application can access,
+ *        with their sizes.
+ *
+ * \param[in/out] cursor       Pointer to the listing cursor, set by
+ *                             \ref psa_sst_list_first. It is updated to get
+ *                             the next assets.
+ * \param[out]    entries      Pointer to store the entries
+ *                             \ref psa_sst_asset_list_entry_t
+ * \param[in/out] nbr_entries  Pointer to the number of entries which can be
+ *                             stored. It is set to the number of entries
+ *                             stored.
+ *
+ * \note An asset which is created or deleted during the listing may be
+ *       skipped.
+ *
+ * \return Returns PSA_SST_ERR_ASSET_NOT_FOUND when there is no more asset,
+ *         or another error code as specified in \ref psa_sst_err_t
+ */
+enum psa_sst_err_t psa_sst_list_next(uint32_t *cursor,
+                                     struct psa_sst_asset_list_entry_t *entries,
+                                     uint32_t *nbr_entries);
+
+/**
+ * \brief Sets the value of a key of the key/value store, creating the key if
+ *        it does not exist. The keys are owned by the calling application,
+ *        and are not visible to the other applications.
+ *
+ * \param[in] key   Key, as a null-terminated string. The length of the keys
+ *                  is limited, to 24 characters by default.
+ * \param[in] data  Pointer to the value
+ * \param[in] size  Value size. The size of the values is limited, to 60
+ *                  bytes by default.
+ *
+ * \note The key/value store is only available if the secure storage is built
+ *       with the SST_KV flag. Otherwise, PSA_SST_ERR_PARAM_ERROR is returned.
+ *
+ * \return Returns PSA_SST_ERR_STORAGE_SYSTEM_FULL if the store can not hold
+ *         another key, or another error code as specified in
+ *         \ref psa_sst_err_t
+ */
+enum psa_sst_err_t psa_sst_kv_set(const char *key, const uint8_t *data,
+                                  uint32_t size);
+
+/**
+ * \brief Gets the value of a key of the key/value store.
+ *
+ * \param[in]     key   Key, as a null-terminated string
+ * \param[out]    data  Pointer to the buffer to store the value
+ * \param[in/out] size  Pointer to the buffer size. It is set to the value
+ *                      size when the value is read.
+ *
+ * \return Returns PSA_SST_ERR_ASSET_NOT_FOUND if the key does not exist,
+ *         PSA_SST_ERR_PARAM_ERROR if the value does not fit in the buffer, or
+ *         another error code as specified in \ref psa_sst_err_t
+ */
+enum psa_sst_err_t psa_sst_kv_get(const char *key, uint8_t *data,
+                                  uint32_t *size);
+
+/**
+ * \brief Deletes a key of the key/value store, and its value.
+ *
+ * \param[in] key  Key, as a null-terminated string
+ *
+ * \return Returns PSA_SST_ERR_ASSET_NOT_FOUND if the key does not exist, or
+ *         another error code as specified in \ref psa_sst_err_t
+ */
+enum psa_sst_err_t psa_sst_kv_delete(const char *key);
+
+/**
+ * \brief Gets the next key of the calling application in the key/value store.
+ *
+ * \param[in/out] cursor   Pointer to the iteration cursor, which must be set
+ *                         to 0 to get the first key. It is updated to get the
+ *                         next key.
+ * \param[out]    key      Pointer to the buffer to store the key. The key is
+ *                         not null-terminated.
+ * \param[in/out] key_len  Pointer to the buffer size. It is set to the key
+ *                         length when the key is copied.
+ *
+ * \note A key which is set or deleted during the iteration may be skipped.
+ *
+ * \return Returns PSA_SST_ERR_ASSET_NOT_FOUND when there is no more key,
+ *         PSA_SST_ERR_PARAM_ERROR if the key does not fit in the buffer, or
+ *         another error code as specified in \ref psa_sst_err_t
+ */
+enum psa_sst_err_t psa_sst_kv_iterate(uint32_t *cursor, char *key,
+                                      uint32_t *key_len);
+
 #ifdef __cplusplus
 }
 #endif
@@ -344,6 +344,28 @@ extern "C" {
  */
 #define PSA_SST_ASSET_ATTR_VENDOR_DEFINED       ((uint32_t)0x80000000)
 
+/* List of PSA SST asset operation types */
+/*!
+ * \def PSA_SST_ASSET_OP_CREATE
+ *
+ * \brief Creates the asset, if it does not exist yet.
+ */
+#define PSA_SST_ASSET_OP_CREATE                 ((uint32_t)0x00000001)
+
+/*!
+ * \def PSA_SST_ASSET_OP_WRITE
+ *
+ * \brief Writes data into the asset.
+ */
+#define PSA_SST_ASSET_OP_WRITE                  ((uint32_t)0x00000002)
+
+/*!
+ * \def PSA_SST_ASSET_OP_DELETE
+ *
+ * \brief Deletes the asset.
+ */
+#define PSA_SST_ASSET_OP_DELETE                 ((uint32_t)0x00000003)
+
 
 /* PSA SST asset structure definitions */
 /*!
@@ -390,6 +412,75 @@ struct psa_sst_asset_attrs_t {
                                                */
 };
 
+/*!
+ * \struct psa_sst_wear_info_t
+ *
+ * \brief Wear information of the flash blocks used by the secure storage.
+ *
+ */
+struct psa_sst_wear_info_t {
+    uint32_t nbr_blocks;       /*!< Number of flash blocks */
+    uint32_t min_erase_count;  /*!< Lowest number of erases of a block */
+    uint32_t max_erase_count;  /*!< Highest number of erases of a block */
+};
+
+/*!
+ * \struct psa_sst_asset_list_entry_t
+ *
+ * \brief Entry of an asset list.
+ *
+ */
+struct psa_sst_asset_list_entry_t {
+    uint32_t uuid;          /*!< Asset's unique identifier */
+    uint32_t size_current;  /*!< The current size of the asset content */
+    uint32_t size_max;      /*!< The maximum size of the asset content in
+                             *   bytes
+                             */
+};
+
+/*!
+ * \struct psa_sst_asset_io_t
+ *
+ * \brief Descriptor of an asset read or write, in a batch of reads or writes.
+ *
+ */
+struct psa_sst_asset_io_t {
+    uint32_t uuid;          /*!< Asset's unique identifier */
+    const uint8_t *token;   /*!< Must be set to NULL, reserved for future use.
+                             *   Pointer to the asset token.
+                             */
+    uint32_t token_size;    /*!< Must be set to 0, reserved for future use.
+                             *   Token size.
+                             */
+    uint32_t size;          /*!< Size of the data to read or write */
+    uint32_t offset;        /*!< Offset within the asset */
+    uint8_t *data;          /*!< Pointer to the data vector to store the data
+                             *   read, or which contains the data to write
+                             */
+};
+
+/*!
+ * \struct psa_sst_asset_op_t
+ *
+ * \brief Descriptor of an asset operation, in a set of operations applied
+ *        atomically.
+ *
+ */
+struct psa_sst_asset_op_t {
+    uint32_t type;          /*!< Operation type, one of PSA_SST_ASSET_OP_* */
+    uint32_t uuid;          /*!< Asset's unique identifier */
+    uint32_t size;          /*!< Size of the data to write. Ignored by the
+                             *   create and delete operations.
+                             */
+    uint32_t offset;        /*!< Offset within the asset. Ignored by the
+                             *   create and delete operations.
+                             */
+    const uint8_t *data;    /*!< Pointer to the data vector which contains the
+                             *   data to write. Ignored by the create and
+                             *   delete operations.
+                             */
+};
+
 /*!
  * \def PSA_SST_ASSET_INFO_SIZE
  *
@@ -404,6 +495,34 @@ struct psa_sst_asset_attrs_t {
  */
 #define PSA_SST_ASSET_ATTR_SIZE sizeof(struct psa_sst_asset_attrs_t)
 
+/*!
+ * \def PSA_SST_WEAR_INFO_SIZE
+ *
+ * \brief Indicates the wear information structure size.
+ */
+#define PSA_SST_WEAR_INFO_SIZE sizeof(struct psa_sst_wear_info_t)
+
+/*!
+ * \def PSA_SST_ASSET_LIST_ENTRY_SIZE
+ *
+ * \brief Indicates the asset list entry structure size.
+ */
+#define PSA_SST_ASSET_LIST_ENTRY_SIZE sizeof(struct psa_sst_asset_list_entry_t)
+
+/*!
+ * \def PSA_SST_ASSET_IO_SIZE
+ *
+ * \brief Indicates the asset read or write descriptor structure size.
+ */
+#define PSA_SST_ASSET_IO_SIZE sizeof(struct psa_sst_asset_io_t)
+
+/*!
+ * \def PSA_SST_ASSET_OP_SIZE
+ *
+ * \brief Indicates the asset operation descriptor structure size.
+ */
+#define PSA_SST_ASSET_OP_SIZE sizeof(struct psa_sst_asset_op_t)
+
 #ifdef __cplusplus
 }
 #endif
@@ -47,7 +47,17 @@ extern "C" {
     X(SVC_TFM_SST_SET_ATTRIBUTES, tfm_sst_svc_set_attributes) \
     X(SVC_TFM_SST_READ, tfm_sst_svc_read) \
     X(SVC_TFM_SST_WRITE, tfm_sst_svc_write) \
+    X(SVC_TFM_SST_READ_MULTI, tfm_sst_svc_read_multi) \
+    X(SVC_TFM_SST_WRITE_MULTI, tfm_sst_svc_write_multi) \
     X(SVC_TFM_SST_DELETE, tfm_sst_svc_delete) \
+    X(SVC_TFM_SST_APPLY_OPS, tfm_sst_svc_apply_ops) \
+    X(SVC_TFM_SST_GET_WEAR_INFO, tfm_sst_svc_get_wear_info) \
+    X(SVC_TFM_SST_MAINTENANCE, tfm_sst_svc_maintenance) \
+    X(SVC_TFM_SST_LIST_ASSETS, tfm_sst_svc_list_assets) \
+    X(SVC_TFM_SST_KV_SET, tfm_sst_svc_kv_set) \
+    X(SVC_TFM_SST_KV_GET, tfm_sst_svc_kv_get) \
+    X(SVC_TFM_SST_KV_DELETE, tfm_sst_svc_kv_delete) \
+    X(SVC_TFM_SST_KV_ITERATE, tfm_sst_svc_kv_iterate) \
     X(SVC_TFM_LOG_RETRIEVE, tfm_log_svc_retrieve) \
     X(SVC_TFM_LOG_GET_INFO, tfm_log_svc_get_info) \
     X(SVC_TFM_LOG_DELETE_ITEMS, tfm_log_svc_delete_items)
@@ -46,6 +46,77 @@ struct tfm_sst_buf_t {
     uint32_t offset; /*!< Offset within asset */
 };
 
+/*!
+ * \enum tfm_sst_flash_op_t
+ *
+ * \brief Flash operations accounted by the secure storage.
+ *
+ */
+enum tfm_sst_flash_op_t {
+    TFM_SST_FLASH_OP_READ = 0, /*!< Data read from a block */
+    TFM_SST_FLASH_OP_WRITE,    /*!< Data programmed in a block */
+    TFM_SST_FLASH_OP_MOVE,     /*!< Data moved from a block to another one */
+    TFM_SST_FLASH_OP_ERASE,    /*!< Block erased */
+    TFM_SST_FLASH_NBR_OPS,     /*!< Number of flash operations */
+};
+
+/*!
+ * \struct tfm_sst_flash_op_stats_t
+ *
+ * \brief Counters of a flash operation.
+ *
+ */
+struct tfm_sst_flash_op_stats_t {
+    uint32_t calls;   /*!< Number of calls */
+    uint32_t errors;  /*!< Number of calls which failed */
+    uint64_t bytes;   /*!< Number of bytes read, programmed, moved or erased */
+    uint64_t cycles;  /*!< Number of cycles spent in the calls, or 0 if the
+                       *   target does not provide a cycle counter
+                       */
+};
+
+/*!
+ * \struct tfm_sst_flash_stats_t
+ *
+ * \brief Counters of the flash operations performed by the secure storage
+ *        since boot.
+ *
+ */
+struct tfm_sst_flash_stats_t {
+    struct tfm_sst_flash_op_stats_t ops[TFM_SST_FLASH_NBR_OPS]; /*!< Counters
+                                                    *   of each operation, as
+                                                    *   indexed by
+                                                    *   \ref tfm_sst_flash_op_t
+                                                    */
+    uint32_t cache_size;   /*!< Number of pages of the read cache, or 0 if
+                            *   the read cache is disabled
+                            */
+    uint32_t cache_hits;   /*!< Number of pages read from the read cache */
+    uint32_t cache_misses; /*!< Number of pages read from flash into the
+                            *   read cache
+                            */
+    uint32_t trace_size;   /*!< Number of entries of the trace, or 0 if the
+                            *   trace is disabled
+                            */
+    uint32_t trace_count;  /*!< Number of entries recorded in the trace since
+                            *   boot
+                            */
+};
+
+/*!
+ * \struct tfm_sst_flash_trace_t
+ *
+ * \brief Entry of the flash operation trace.
+ *
+ */
+struct tfm_sst_flash_trace_t {
+    uint32_t op;      /*!< Operation, as defined by \ref tfm_sst_flash_op_t */
+    uint32_t area;    /*!< Storage area ID */
+    uint32_t block;   /*!< Block ID, or destination block ID of a move */
+    uint32_t offset;  /*!< Offset in the block */
+    uint32_t size;    /*!< Number of bytes */
+};
+
 struct tfm_sst_jwt_t {
     char *buffer;        /* Buffer to write result, in NS memory. */
     uint32_t out_size;  /* Function will write bytes used here. */
@@ -96,6 +96,30 @@ enum psa_sst_err_t tfm_sst_svc_write(uint32_t asset_uuid,
                                      const struct tfm_sst_token_t *s_token,
                                      struct tfm_sst_buf_t* data);
 
+/**
+ * \brief SVC funtion to read a batch of assets.
+ *
+ * \param[in]     ios      Pointer to the descriptors \ref psa_sst_asset_io_t
+ * \param[in/out] nbr_ios  Pointer to the number of descriptors
+ *
+ * \return Returns error code as specified in \ref psa_sst_err_t
+ */
+enum psa_sst_err_t tfm_sst_svc_read_multi(
+                                        const struct psa_sst_asset_io_t *ios,
+                                        uint32_t *nbr_ios);
+
+/**
+ * \brief SVC funtion to write a batch of assets.
+ *
+ * \param[in]     ios      Pointer to the descriptors \ref psa_sst_asset_io_t
+ * \param[in/out] nbr_ios  Pointer to the number of descriptors
+ *
+ * \return Returns error code as specified in \ref psa_sst_err_t
+ */
+enum psa_sst_err_t tfm_sst_svc_write_multi(
+                                        const struct psa_sst_asset_io_t *ios,
+                                        uint32_t *nbr_ios);
+
 /**
  * \brief SVC funtion to delete the asset referenced by the asset UUID.
  *
@@ -107,6 +131,96 @@ enum psa_sst_err_t tfm_sst_svc_write(uint32_t asset_uuid,
 enum psa_sst_err_t tfm_sst_svc_delete(uint32_t asset_uuid,
                                       const struct tfm_sst_token_t *s_token);
 
+/**
+ * \brief SVC funtion to perform a list of operations on assets as a single
+ *        atomic update.
+ *
+ * \param[in] s_token  Pointer to the asset's token \ref tfm_sst_token_t
+ * \param[in] ops      Pointer to the list of operations
+ *                     \ref psa_sst_asset_op_t
+ * \param[in] nbr_ops  Number of operations in the list
+ *
+ * \return Returns error code as specified in \ref psa_sst_err_t
+ */
+enum psa_sst_err_t tfm_sst_svc_apply_ops(
+                                        const struct tfm_sst_token_t *s_token,
+                                        const struct psa_sst_asset_op_t *ops,
+                                        uint32_t nbr_ops);
+
+/**
+ * \brief SVC funtion to get the wear information of the flash blocks used by
+ *        the secure storage.
+ *
+ * \param[out] info  Pointer to store the wear information
+ *                   \ref psa_sst_wear_info_t
+ *
+ * \return Returns error code as specified in \ref psa_sst_err_t
+ */
+enum psa_sst_err_t tfm_sst_svc_get_wear_info(struct psa_sst_wear_info_t *info);
+
+/**
+ * \brief SVC funtion to perform the maintenance of the secure storage.
+ *
+ * \return Returns error code as specified in \ref psa_sst_err_t
+ */
+enum psa_sst_err_t tfm_sst_svc_maintenance(void);
+
+/**
+ * \brief SVC funtion to list the assets which the application can access.
+ *
+ * \param[in/out] cursor       Pointer to the listing cursor
+ * \param[out]    entries      Pointer to store the entries
+ *                             \ref psa_sst_asset_list_entry_t
+ * \param[in/out] nbr_entries  Pointer to the number of entries
+ *
+ * \return Returns error code as specified in \ref psa_sst_err_t
+ */
+enum psa_sst_err_t tfm_sst_svc_list_assets(uint32_t *cursor,
+                                     struct psa_sst_asset_list_entry_t *entries,
+                                     uint32_t *nbr_entries);
+
+/**
+ * \brief SVC funtion to set the value of a key of the key/value store.
+ *
+ * \param[in] key   Pointer to the key vector \ref tfm_sst_buf_t
+ * \param[in] data  Pointer to the value vector \ref tfm_sst_buf_t
+ *
+ * \return Returns error code as specified in \ref psa_sst_err_t
+ */
+enum psa_sst_err_t tfm_sst_svc_kv_set(const struct tfm_sst_buf_t *key,
+                                      const struct tfm_sst_buf_t *data);
+
+/**
+ * \brief SVC funtion to get the value of a key of the key/value store.
+ *
+ * \param[in]     key   Pointer to the key vector \ref tfm_sst_buf_t
+ * \param[in/out] data  Pointer to the value vector \ref tfm_sst_buf_t
+ *
+ * \return Returns error code as specified in \ref psa_sst_err_t
+ */
+enum psa_sst_err_t tfm_sst_svc_kv_get(const struct tfm_sst_buf_t *key,
+                                      struct tfm_sst_buf_t *data);
+
+/**
+ * \brief SVC funtion to delete a key of the key/value store.
+ *
+ * \param[in] key  Pointer to the key vector \ref tfm_sst_buf_t
+ *
+ * \return Returns error code as specified in \ref psa_sst_err_t
+ */
+enum psa_sst_err_t tfm_sst_svc_kv_delete(const struct tfm_sst_buf_t *key);
+
+/**
+ * \brief SVC funtion to get the next key of the key/value store.
+ *
+ * \param[in/out] cursor  Pointer to the iteration cursor
+ * \param[in/out] key     Pointer to the key vector \ref tfm_sst_buf_t
+ *
+ * \return Returns error code as specified in \ref psa_sst_err_t
+ */
+enum psa_sst_err_t tfm_sst_svc_kv_iterate(uint32_t *cursor,
+                                          struct tfm_sst_buf_t *key);
+
 #ifdef __cplusplus
 }
 #endif
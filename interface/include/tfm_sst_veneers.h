@@ -122,6 +122,55 @@ enum psa_sst_err_t tfm_sst_veneer_write(uint32_t app_id, uint32_t asset_uuid,
                                         const struct tfm_sst_token_t *s_token,
                                         struct tfm_sst_buf_t *data);
 
+/**
+ * \brief Reads a batch of assets.
+ *
+ * \param[in]     app_id   Application ID
+ * \param[in]     ios      Pointer to the descriptors \ref psa_sst_asset_io_t
+ *                         of the reads
+ * \param[in/out] nbr_ios  Pointer to the number of descriptors. It is set to
+ *                         the number of assets read.
+ *
+ * \return Returns error code of the first read which fails, as specified in
+ *         \ref psa_sst_err_t
+ */
+enum psa_sst_err_t tfm_sst_veneer_read_multi(uint32_t app_id,
+                                          const struct psa_sst_asset_io_t *ios,
+                                          uint32_t *nbr_ios);
+
+/**
+ * \brief Writes a batch of assets.
+ *
+ * \param[in]     app_id   Application ID
+ * \param[in]     ios      Pointer to the descriptors \ref psa_sst_asset_io_t
+ *                         of the writes
+ * \param[in/out] nbr_ios  Pointer to the number of descriptors. It is set to
+ *                         the number of assets written.
+ *
+ * \return Returns error code of the first write which fails, as specified in
+ *         \ref psa_sst_err_t
+ */
+enum psa_sst_err_t tfm_sst_veneer_write_multi(uint32_t app_id,
+                                          const struct psa_sst_asset_io_t *ios,
+                                          uint32_t *nbr_ios);
+
+/**
+ * \brief Performs a list of create, write and delete operations on assets as
+ *        a single atomic update.
+ *
+ * \param[in] app_id   Application ID
+ * \param[in] s_token  Pointer to the asset's token \ref tfm_sst_token_t
+ * \param[in] ops      Pointer to the list of operations
+ *                     \ref psa_sst_asset_op_t
+ * \param[in] nbr_ops  Number of operations in the list
+ *
+ * \return Returns error code as specified in \ref psa_sst_err_t
+ */
+enum psa_sst_err_t tfm_sst_veneer_apply_ops(uint32_t app_id,
+                                        const struct tfm_sst_token_t *s_token,
+                                        const struct psa_sst_asset_op_t *ops,
+                                        uint32_t nbr_ops);
+
 /**
  * \brief Deletes the asset referenced by the asset UUID.
  *
@@ -135,6 +184,135 @@ enum psa_sst_err_t tfm_sst_veneer_write(uint32_t app_id, uint32_t asset_uuid,
  */
 enum psa_sst_err_t tfm_sst_veneer_delete(uint32_t app_id, uint32_t asset_uuid,
                                          const struct tfm_sst_token_t *s_token);
+
+/**
+ * \brief Gets the wear information of the flash blocks used by the secure
+ *        storage.
+ *
+ * \param[in]  app_id  Application ID
+ * \param[out] info    Pointer to store the wear information
+ *                     \ref psa_sst_wear_info_t
+ *
+ * \return Returns error code as specified in \ref psa_sst_err_t
+ */
+enum psa_sst_err_t tfm_sst_veneer_get_wear_info(uint32_t app_id,
+                                             struct psa_sst_wear_info_t *info);
+
+/**
+ * \brief Gets the counters of the flash operations performed by the secure
+ *        storage since boot. Only secure callers using the secure application
+ *        ID are allowed.
+ *
+ * \param[in]  app_id  Application ID
+ * \param[out] stats   Pointer to store the flash counters
+ *                     \ref tfm_sst_flash_stats_t
+ *
+ * \return Returns error code as specified in \ref psa_sst_err_t
+ */
+enum psa_sst_err_t tfm_sst_veneer_get_flash_stats(uint32_t app_id,
+                                          struct tfm_sst_flash_stats_t *stats);
+
+/**
+ * \brief Gets the most recent entries of the flash operation trace. Only
+ *        secure callers using the secure application ID are allowed.
+ *
+ * \param[in]  app_id       Application ID
+ * \param[out] entries      Pointer to store the entries, from the oldest to
+ *                          the most recent one
+ *                          \ref tfm_sst_flash_trace_t
+ * \param[in]  nbr_entries  Number of entries to get
+ *
+ * \return Returns error code as specified in \ref psa_sst_err_t
+ */
+enum psa_sst_err_t tfm_sst_veneer_get_flash_trace(uint32_t app_id,
+                                         struct tfm_sst_flash_trace_t *entries,
+                                         uint32_t nbr_entries);
+
+/**
+ * \brief Performs the maintenance of the secure storage, which erases the
+ *        flash blocks retired by the previous updates.
+ *
+ * \param[in] app_id  Application ID
+ *
+ * \return Returns error code as specified in \ref psa_sst_err_t
+ */
+enum psa_sst_err_t tfm_sst_veneer_maintenance(uint32_t app_id);
+
+/**
+ * \brief Lists the assets which the application can access, with their
+ *        sizes.
+ *
+ * \param[in]     app_id       Application ID
+ * \param[in/out] cursor       Pointer to the listing cursor, set to 0 to get
+ *                             the first assets
+ * \param[out]    entries      Pointer to store the entries
+ *                             \ref psa_sst_asset_list_entry_t
+ * \param[in/out] nbr_entries  Pointer to the number of entries which can be
+ *                             stored. It is set to the number of entries
+ *                             stored.
+ *
+ * \return Returns PSA_SST_ERR_ASSET_NOT_FOUND when there is no more asset, or
+ *         another error code as specified in \ref psa_sst_err_t
+ */
+enum psa_sst_err_t tfm_sst_veneer_list_assets(uint32_t app_id,
+                                     uint32_t *cursor,
+                                     struct psa_sst_asset_list_entry_t *entries,
+                                     uint32_t *nbr_entries);
+
+/**
+ * \brief Sets the value of a key of the key/value store, creating the key if
+ *        it does not exist.
+ *
+ * \param[in] app_id  Application ID, which owns the key
+ * \param[in] key     Pointer to the key vector \ref tfm_sst_buf_t
+ * \param[in] data    Pointer to the value vector \ref tfm_sst_buf_t
+ *
+ * \return Returns error code as specified in \ref psa_sst_err_t
+ */
+enum psa_sst_err_t tfm_sst_veneer_kv_set(uint32_t app_id,
+                                         const struct tfm_sst_buf_t *key,
+                                         const struct tfm_sst_buf_t *data);
+
+/**
+ * \brief Gets the value of a key of the key/value store.
+ *
+ * \param[in]     app_id  Application ID, which owns the key
+ * \param[in]     key     Pointer to the key vector \ref tfm_sst_buf_t
+ * \param[in/out] data    Pointer to the value vector \ref tfm_sst_buf_t. Its
+ *                        size is set to the value size.
+ *
+ * \return Returns error code as specified in \ref psa_sst_err_t
+ */
+enum psa_sst_err_t tfm_sst_veneer_kv_get(uint32_t app_id,
+                                         const struct tfm_sst_buf_t *key,
+                                         struct tfm_sst_buf_t *data);
+
+/**
+ * \brief Deletes a key of the key/value store.
+ *
+ * \param[in] app_id  Application ID, which owns the key
+ * \param[in] key     Pointer to the key vector \ref tfm_sst_buf_t
+ *
+ * \return Returns error code as specified in \ref psa_sst_err_t
+ */
+enum psa_sst_err_t tfm_sst_veneer_kv_delete(uint32_t app_id,
+                                            const struct tfm_sst_buf_t *key);
+
+/**
+ * \brief Gets the next key of an application in the key/value store.
+ *
+ * \param[in]     app_id  Application ID, which owns the keys
+ * \param[in/out] cursor  Pointer to the iteration cursor, set to 0 to get
+ *                        the first key
+ * \param[in/out] key     Pointer to the key vector \ref tfm_sst_buf_t. Its
+ *                        size is set to the key length.
+ *
+ * \return Returns PSA_SST_ERR_ASSET_NOT_FOUND when there is no more key, or
+ *         another error code as specified in \ref psa_sst_err_t
+ */
+enum psa_sst_err_t tfm_sst_veneer_kv_iterate(uint32_t app_id,
+                                             uint32_t *cursor,
+                                             struct tfm_sst_buf_t *key);
 #ifdef __cplusplus
 }
 #endif
@@ -5,6 +5,7 @@
  *
  */
 
+#include <string.h>
 #include "tfm_sst_defs.h"
 #include "tfm_ns_lock.h"
 
@@ -130,6 +131,26 @@ enum psa_sst_err_t psa_sst_write(uint32_t asset_uuid,
                                     0);
 }
 
+enum psa_sst_err_t psa_sst_read_multi(const struct psa_sst_asset_io_t *ios,
+                                      uint32_t *nbr_ios)
+{
+    return tfm_ns_lock_svc_dispatch(SVC_TFM_SST_READ_MULTI,
+                                    (uint32_t)ios,
+                                    (uint32_t)nbr_ios,
+                                    0,
+                                    0);
+}
+
+enum psa_sst_err_t psa_sst_write_multi(const struct psa_sst_asset_io_t *ios,
+                                       uint32_t *nbr_ios)
+{
+    return tfm_ns_lock_svc_dispatch(SVC_TFM_SST_WRITE_MULTI,
+                                    (uint32_t)ios,
+                                    (uint32_t)nbr_ios,
+                                    0,
+                                    0);
+}
+
 enum psa_sst_err_t psa_sst_delete(uint32_t asset_uuid,
                                   const uint8_t* token,
                                   uint32_t token_size)
@@ -146,3 +167,148 @@ enum psa_sst_err_t psa_sst_delete(uint32_t asset_uuid,
                                     0,
                                     0);
 }
+
+enum psa_sst_err_t psa_sst_apply_ops(const uint8_t* token,
+                                     uint32_t token_size,
+                                     const struct psa_sst_asset_op_t *ops,
+                                     uint32_t nbr_ops)
+{
+    struct tfm_sst_token_t s_token;
+
+    /* Pack the token information in the token structure */
+    s_token.token = token;
+    s_token.token_size = token_size;
+
+    return tfm_ns_lock_svc_dispatch(SVC_TFM_SST_APPLY_OPS,
+                                    (uint32_t)&s_token,
+                                    (uint32_t)ops,
+                                    nbr_ops,
+                                    0);
+}
+
+enum psa_sst_err_t psa_sst_get_wear_info(struct psa_sst_wear_info_t *info)
+{
+    return tfm_ns_lock_svc_dispatch(SVC_TFM_SST_GET_WEAR_INFO,
+                                    (uint32_t)info,
+                                    0,
+                                    0,
+                                    0);
+}
+
+enum psa_sst_err_t psa_sst_maintenance(void)
+{
+    return tfm_ns_lock_svc_dispatch(SVC_TFM_SST_MAINTENANCE,
+                                    0,
+                                    0,
+                                    0,
+                                    0);
+}
+
+enum psa_sst_err_t psa_sst_list_first(uint32_t *cursor,
+                                     struct psa_sst_asset_list_entry_t *entries,
+                                     uint32_t *nbr_entries)
+{
+    *cursor = 0;
+
+    return psa_sst_list_next(cursor, entries, nbr_entries);
+}
+
+enum psa_sst_err_t psa_sst_list_next(uint32_t *cursor,
+                                     struct psa_sst_asset_list_entry_t *entries,
+                                     uint32_t *nbr_entries)
+{
+    return tfm_ns_lock_svc_dispatch(SVC_TFM_SST_LIST_ASSETS,
+                                    (uint32_t)cursor,
+                                    (uint32_t)entries,
+                                    (uint32_t)nbr_entries,
+                                    0);
+}
+
+enum psa_sst_err_t psa_sst_kv_set(const char *key, const uint8_t *data,
+                                  uint32_t size)
+{
+    struct tfm_sst_buf_t s_key;
+    struct tfm_sst_buf_t s_data;
+
+    /* Pack the key and value information in the buffer structures */
+    s_key.data = (uint8_t *)key;
+    s_key.size = strlen(key);
+    s_key.offset = 0;
+
+    s_data.data = (uint8_t *)data;
+    s_data.size = size;
+    s_data.offset = 0;
+
+    return tfm_ns_lock_svc_dispatch(SVC_TFM_SST_KV_SET,
+                                    (uint32_t)&s_key,
+                                    (uint32_t)&s_data,
+                                    0,
+                                    0);
+}
+
+enum psa_sst_err_t psa_sst_kv_get(const char *key, uint8_t *data,
+                                  uint32_t *size)
+{
+    struct tfm_sst_buf_t s_key;
+    struct tfm_sst_buf_t s_data;
+    enum psa_sst_err_t err;
+
+    /* Pack the key and buffer information in the buffer structures */
+    s_key.data = (uint8_t *)key;
+    s_key.size = strlen(key);
+    s_key.offset = 0;
+
+    s_data.data = data;
+    s_data.size = *size;
+    s_data.offset = 0;
+
+    err = tfm_ns_lock_svc_dispatch(SVC_TFM_SST_KV_GET,
+                                   (uint32_t)&s_key,
+                                   (uint32_t)&s_data,
+                                   0,
+                                   0);
+    if (err == PSA_SST_ERR_SUCCESS) {
+        *size = s_data.size;
+    }
+
+    return err;
+}
+
+enum psa_sst_err_t psa_sst_kv_delete(const char *key)
+{
+    struct tfm_sst_buf_t s_key;
+
+    /* Pack the key information in the buffer structure */
+    s_key.data = (uint8_t *)key;
+    s_key.size = strlen(key);
+    s_key.offset = 0;
+
+    return tfm_ns_lock_svc_dispatch(SVC_TFM_SST_KV_DELETE,
+                                    (uint32_t)&s_key,
+                                    0,
+                                    0,
+                                    0);
+}
+
+enum psa_sst_err_t psa_sst_kv_iterate(uint32_t *cursor, char *key,
+                                      uint32_t *key_len)
+{
+    struct tfm_sst_buf_t s_key;
+    enum psa_sst_err_t err;
+
+    /* Pack the buffer information in the buffer structure */
+    s_key.data = (uint8_t *)key;
+    s_key.size = *key_len;
+    s_key.offset = 0;
+
+    err = tfm_ns_lock_svc_dispatch(SVC_TFM_SST_KV_ITERATE,
+                                   (uint32_t)cursor,
+                                   (uint32_t)&s_key,
+                                   0,
+                                   0);
+    if (err == PSA_SST_ERR_SUCCESS) {
+        *key_len = s_key.size;
+    }
+
+    return err;
+}
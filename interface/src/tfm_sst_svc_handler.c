@@ -76,6 +76,28 @@ enum psa_sst_err_t tfm_sst_svc_write(uint32_t asset_uuid,
     return tfm_sst_veneer_write(app_id, asset_uuid, s_token, data);
 }
 
+enum psa_sst_err_t tfm_sst_svc_read_multi(
+                                        const struct psa_sst_asset_io_t *ios,
+                                        uint32_t *nbr_ios)
+{
+    uint32_t app_id;
+
+    app_id = tfm_sst_get_cur_id();
+
+    return tfm_sst_veneer_read_multi(app_id, ios, nbr_ios);
+}
+
+enum psa_sst_err_t tfm_sst_svc_write_multi(
+                                        const struct psa_sst_asset_io_t *ios,
+                                        uint32_t *nbr_ios)
+{
+    uint32_t app_id;
+
+    app_id = tfm_sst_get_cur_id();
+
+    return tfm_sst_veneer_write_multi(app_id, ios, nbr_ios);
+}
+
 enum psa_sst_err_t tfm_sst_svc_delete(uint32_t asset_uuid,
                                       const struct tfm_sst_token_t *s_token)
 {
@@ -85,3 +107,83 @@ enum psa_sst_err_t tfm_sst_svc_delete(uint32_t asset_uuid,
 
     return tfm_sst_veneer_delete(app_id, asset_uuid, s_token);
 }
+
+enum psa_sst_err_t tfm_sst_svc_apply_ops(
+                                        const struct tfm_sst_token_t *s_token,
+                                        const struct psa_sst_asset_op_t *ops,
+                                        uint32_t nbr_ops)
+{
+    uint32_t app_id;
+
+    app_id = tfm_sst_get_cur_id();
+
+    return tfm_sst_veneer_apply_ops(app_id, s_token, ops, nbr_ops);
+}
+
+enum psa_sst_err_t tfm_sst_svc_get_wear_info(struct psa_sst_wear_info_t *info)
+{
+    uint32_t app_id;
+
+    app_id = tfm_sst_get_cur_id();
+
+    return tfm_sst_veneer_get_wear_info(app_id, info);
+}
+
+enum psa_sst_err_t tfm_sst_svc_maintenance(void)
+{
+    uint32_t app_id;
+
+    app_id = tfm_sst_get_cur_id();
+
+    return tfm_sst_veneer_maintenance(app_id);
+}
+
+enum psa_sst_err_t tfm_sst_svc_list_assets(uint32_t *cursor,
+                                     struct psa_sst_asset_list_entry_t *entries,
+                                     uint32_t *nbr_entries)
+{
+    uint32_t app_id;
+
+    app_id = tfm_sst_get_cur_id();
+
+    return tfm_sst_veneer_list_assets(app_id, cursor, entries, nbr_entries);
+}
+
+enum psa_sst_err_t tfm_sst_svc_kv_set(const struct tfm_sst_buf_t *key,
+                                      const struct tfm_sst_buf_t *data)
+{
+    uint32_t app_id;
+
+    app_id = tfm_sst_get_cur_id();
+
+    return tfm_sst_veneer_kv_set(app_id, key, data);
+}
+
+enum psa_sst_err_t tfm_sst_svc_kv_get(const struct tfm_sst_buf_t *key,
+                                      struct tfm_sst_buf_t *data)
+{
+    uint32_t app_id;
+
+    app_id = tfm_sst_get_cur_id();
+
+    return tfm_sst_veneer_kv_get(app_id, key, data);
+}
+
+enum psa_sst_err_t tfm_sst_svc_kv_delete(const struct tfm_sst_buf_t *key)
+{
+    uint32_t app_id;
+
+    app_id = tfm_sst_get_cur_id();
+
+    return tfm_sst_veneer_kv_delete(app_id, key);
+}
+
+enum psa_sst_err_t tfm_sst_svc_kv_iterate(uint32_t *cursor,
+                                          struct tfm_sst_buf_t *key)
+{
+    uint32_t app_id;
+
+    app_id = tfm_sst_get_cur_id();
+
+    return tfm_sst_veneer_kv_iterate(app_id, cursor, key);
+}
@@ -97,5 +97,9 @@
 #define SST_NBR_OF_SECTORS  (FLASH_SST_AREA_SIZE / SST_SECTOR_SIZE)
 /* Specifies the smallest flash programmable unit in bytes */
 #define SST_FLASH_PROGRAM_UNIT  0x1
+/* The flash is emulated in SRAM, so the SST data can be moved straight from
+ * its secure memory-mapped address.
+ */
+#define SST_FLASH_MAPPED_BASE   FLASH_BASE_ADDRESS
 
 #endif /* __FLASH_LAYOUT_H__ */
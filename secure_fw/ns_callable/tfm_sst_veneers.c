@@ -68,6 +68,24 @@ enum psa_sst_err_t tfm_sst_veneer_write(uint32_t app_id,
                          asset_uuid, s_token, data);
 }
 
+__tfm_secure_gateway_attributes__
+enum psa_sst_err_t tfm_sst_veneer_read_multi(uint32_t app_id,
+                                          const struct psa_sst_asset_io_t *ios,
+                                          uint32_t *nbr_ios)
+{
+    TFM_CORE_SFN_REQUEST(TFM_SP_STORAGE_ID, sst_am_read_multi, app_id,
+                         ios, nbr_ios, 0);
+}
+
+__tfm_secure_gateway_attributes__
+enum psa_sst_err_t tfm_sst_veneer_write_multi(uint32_t app_id,
+                                          const struct psa_sst_asset_io_t *ios,
+                                          uint32_t *nbr_ios)
+{
+    TFM_CORE_SFN_REQUEST(TFM_SP_STORAGE_ID, sst_am_write_multi, app_id,
+                         ios, nbr_ios, 0);
+}
+
 __tfm_secure_gateway_attributes__
 enum psa_sst_err_t tfm_sst_veneer_delete(uint32_t app_id, uint32_t asset_uuid,
                                          const struct tfm_sst_token_t *s_token)
@@ -76,6 +94,93 @@ enum psa_sst_err_t tfm_sst_veneer_delete(uint32_t app_id, uint32_t asset_uuid,
                          asset_uuid, s_token, 0);
 }
 
+__tfm_secure_gateway_attributes__
+enum psa_sst_err_t tfm_sst_veneer_apply_ops(uint32_t app_id,
+                                        const struct tfm_sst_token_t *s_token,
+                                        const struct psa_sst_asset_op_t *ops,
+                                        uint32_t nbr_ops)
+{
+    TFM_CORE_SFN_REQUEST(TFM_SP_STORAGE_ID, sst_am_apply_ops, app_id,
+                         s_token, ops, nbr_ops);
+}
+
+__tfm_secure_gateway_attributes__
+enum psa_sst_err_t tfm_sst_veneer_get_wear_info(uint32_t app_id,
+                                              struct psa_sst_wear_info_t *info)
+{
+    TFM_CORE_SFN_REQUEST(TFM_SP_STORAGE_ID, sst_am_get_wear_info, app_id,
+                         info, 0, 0);
+}
+
+__tfm_secure_gateway_attributes__
+enum psa_sst_err_t tfm_sst_veneer_get_flash_stats(uint32_t app_id,
+                                           struct tfm_sst_flash_stats_t *stats)
+{
+    TFM_CORE_SFN_REQUEST(TFM_SP_STORAGE_ID, sst_am_get_flash_stats, app_id,
+                         stats, 0, 0);
+}
+
+__tfm_secure_gateway_attributes__
+enum psa_sst_err_t tfm_sst_veneer_get_flash_trace(uint32_t app_id,
+                                         struct tfm_sst_flash_trace_t *entries,
+                                         uint32_t nbr_entries)
+{
+    TFM_CORE_SFN_REQUEST(TFM_SP_STORAGE_ID, sst_am_get_flash_trace, app_id,
+                         entries, nbr_entries, 0);
+}
+
+__tfm_secure_gateway_attributes__
+enum psa_sst_err_t tfm_sst_veneer_maintenance(uint32_t app_id)
+{
+    TFM_CORE_SFN_REQUEST(TFM_SP_STORAGE_ID, sst_am_maintenance, app_id,
+                         0, 0, 0);
+}
+
+__tfm_secure_gateway_attributes__
+enum psa_sst_err_t tfm_sst_veneer_list_assets(uint32_t app_id,
+                                     uint32_t *cursor,
+                                     struct psa_sst_asset_list_entry_t *entries,
+                                     uint32_t *nbr_entries)
+{
+    TFM_CORE_SFN_REQUEST(TFM_SP_STORAGE_ID, sst_am_list_assets, app_id,
+                         cursor, entries, nbr_entries);
+}
+
+__tfm_secure_gateway_attributes__
+enum psa_sst_err_t tfm_sst_veneer_kv_set(uint32_t app_id,
+                                         const struct tfm_sst_buf_t *key,
+                                         const struct tfm_sst_buf_t *data)
+{
+    TFM_CORE_SFN_REQUEST(TFM_SP_STORAGE_ID, sst_am_kv_set, app_id,
+                         key, data, 0);
+}
+
+__tfm_secure_gateway_attributes__
+enum psa_sst_err_t tfm_sst_veneer_kv_get(uint32_t app_id,
+                                         const struct tfm_sst_buf_t *key,
+                                         struct tfm_sst_buf_t *data)
+{
+    TFM_CORE_SFN_REQUEST(TFM_SP_STORAGE_ID, sst_am_kv_get, app_id,
+                         key, data, 0);
+}
+
+__tfm_secure_gateway_attributes__
+enum psa_sst_err_t tfm_sst_veneer_kv_delete(uint32_t app_id,
+                                            const struct tfm_sst_buf_t *key)
+{
+    TFM_CORE_SFN_REQUEST(TFM_SP_STORAGE_ID, sst_am_kv_delete, app_id,
+                         key, 0, 0);
+}
+
+__tfm_secure_gateway_attributes__
+enum psa_sst_err_t tfm_sst_veneer_kv_iterate(uint32_t app_id,
+                                             uint32_t *cursor,
+                                             struct tfm_sst_buf_t *key)
+{
+    TFM_CORE_SFN_REQUEST(TFM_SP_STORAGE_ID, sst_am_kv_iterate, app_id,
+                         cursor, key, 0);
+}
+
 __tfm_secure_gateway_attributes__
 enum psa_sst_err_t tfm_veneer_jwt_sign(uint32_t app_id,
                                         uint32_t asset_uuid,
@@ -15,36 +15,42 @@ struct sst_asset_policy_t asset_perms[] = {
     .max_size = SST_ASSET_MAX_SIZE_AES_KEY_128,
     .perms_count = SST_ASSET_PERMS_COUNT_AES_KEY_128,
     .perms_modes_start_idx = 0,
+    .area_id = SST_ASSET_AREA_AES_KEY_128,
 }, {
     .type = PSA_SST_ASSET_KEY_AES,
     .asset_uuid = SST_ASSET_ID_AES_KEY_256,
     .max_size = SST_ASSET_MAX_SIZE_AES_KEY_256,
     .perms_count = SST_ASSET_PERMS_COUNT_AES_KEY_256,
     .perms_modes_start_idx = 2,
+    .area_id = SST_ASSET_AREA_AES_KEY_256,
 }, {
     .type = PSA_SST_ASSET_KEY_RSA_PUBLIC,
     .asset_uuid = SST_ASSET_ID_RSA_KEY_1024,
     .max_size = SST_ASSET_MAX_SIZE_RSA_KEY_1024,
     .perms_count = SST_ASSET_PERMS_COUNT_RSA_KEY_1024,
     .perms_modes_start_idx = 3,
+    .area_id = SST_ASSET_AREA_RSA_KEY_1024,
 }, {
     .type = PSA_SST_ASSET_KEY_RSA_PUBLIC,
     .asset_uuid = SST_ASSET_ID_RSA_KEY_2048,
     .max_size = SST_ASSET_MAX_SIZE_RSA_KEY_2048,
     .perms_count = SST_ASSET_PERMS_COUNT_RSA_KEY_2048,
     .perms_modes_start_idx = 4,
+    .area_id = SST_ASSET_AREA_RSA_KEY_2048,
 }, {
     .type = PSA_SST_ASSET_KEY_RSA_PRIVATE,
     .asset_uuid = SST_ASSET_ID_RSA_KEY_4096,
     .max_size = SST_ASSET_MAX_SIZE_RSA_KEY_4096,
     .perms_count = SST_ASSET_PERMS_COUNT_RSA_KEY_4096,
     .perms_modes_start_idx = 5,
+    .area_id = SST_ASSET_AREA_RSA_KEY_4096,
 }, {
     .type = PSA_SST_ASSET_CERT_X_509,
     .asset_uuid = SST_ASSET_ID_X509_CERT_SMALL,
     .max_size = SST_ASSET_MAX_SIZE_X509_CERT_SMALL,
     .perms_count = SST_ASSET_PERMS_COUNT_X509_CERT_SMALL,
     .perms_modes_start_idx = 6,
+    .area_id = SST_ASSET_AREA_X509_CERT_SMALL,
 }, {
 /* The following assets are used by the SST testsuite */
     .type = PSA_SST_ASSET_CERT_X_509,
@@ -52,24 +58,28 @@ struct sst_asset_policy_t asset_perms[] = {
     .max_size = SST_ASSET_MAX_SIZE_X509_CERT_LARGE,
     .perms_count = SST_ASSET_PERMS_COUNT_X509_CERT_LARGE,
     .perms_modes_start_idx = 7,
+    .area_id = SST_ASSET_AREA_X509_CERT_LARGE,
 }, {
     .type = PSA_SST_ASSET_KEY_AES,
     .asset_uuid = SST_ASSET_ID_AES_KEY_192,
     .max_size = SST_ASSET_MAX_SIZE_AES_KEY_192,
     .perms_count = SST_ASSET_PERMS_COUNT_AES_KEY_192,
     .perms_modes_start_idx = 7,
+    .area_id = SST_ASSET_AREA_AES_KEY_192,
 }, {
     .type = PSA_SST_ASSET_KEY_HMAC,
     .asset_uuid = SST_ASSET_ID_SHA224_HASH,
     .max_size = SST_ASSET_MAX_SIZE_SHA224_HASH,
     .perms_count = SST_ASSET_PERMS_COUNT_SHA224_HASH,
     .perms_modes_start_idx = 10,
+    .area_id = SST_ASSET_AREA_SHA224_HASH,
 }, {
     .type = PSA_SST_ASSET_KEY_HMAC,
     .asset_uuid = SST_ASSET_ID_SHA384_HASH,
     .max_size = SST_ASSET_MAX_SIZE_SHA384_HASH,
     .perms_count = SST_ASSET_PERMS_COUNT_SHA384_HASH,
     .perms_modes_start_idx = 11,
+    .area_id = SST_ASSET_AREA_SHA384_HASH,
 }, };
 
 struct sst_asset_perm_t asset_perms_modes[] = {
@@ -48,6 +48,40 @@ extern "C" {
 #define SST_ASSET_PERMS_COUNT_SHA224_HASH 1
 #define SST_ASSET_PERMS_COUNT_SHA384_HASH 1
 
+/* Storage area of each asset, see SST_NBR_OF_AREAS. By default, all the
+ * assets are stored in the first area.
+ */
+#ifndef SST_ASSET_AREA_AES_KEY_128
+#define SST_ASSET_AREA_AES_KEY_128 0
+#endif
+#ifndef SST_ASSET_AREA_AES_KEY_192
+#define SST_ASSET_AREA_AES_KEY_192 0
+#endif
+#ifndef SST_ASSET_AREA_AES_KEY_256
+#define SST_ASSET_AREA_AES_KEY_256 0
+#endif
+#ifndef SST_ASSET_AREA_RSA_KEY_1024
+#define SST_ASSET_AREA_RSA_KEY_1024 0
+#endif
+#ifndef SST_ASSET_AREA_RSA_KEY_2048
+#define SST_ASSET_AREA_RSA_KEY_2048 0
+#endif
+#ifndef SST_ASSET_AREA_RSA_KEY_4096
+#define SST_ASSET_AREA_RSA_KEY_4096 0
+#endif
+#ifndef SST_ASSET_AREA_X509_CERT_SMALL
+#define SST_ASSET_AREA_X509_CERT_SMALL 0
+#endif
+#ifndef SST_ASSET_AREA_X509_CERT_LARGE
+#define SST_ASSET_AREA_X509_CERT_LARGE 0
+#endif
+#ifndef SST_ASSET_AREA_SHA224_HASH
+#define SST_ASSET_AREA_SHA224_HASH 0
+#endif
+#ifndef SST_ASSET_AREA_SHA384_HASH
+#define SST_ASSET_AREA_SHA384_HASH 0
+#endif
+
 #define SST_APP_ID_0 9
 #define SST_APP_ID_1 10
 #define SST_APP_ID_2 11
@@ -70,6 +70,25 @@ enum psa_sst_err_t sst_crypto_setkey(const uint8_t *key, size_t key_len)
 
 void sst_crypto_set_iv(const union sst_crypto_t *crypto)
 {
+    uint64_t iv_l;
+    uint32_t iv_h;
+    uint64_t cur_iv_l;
+    uint32_t cur_iv_h;
+
+    /* The storage areas share the key, so the IV must not go back to the
+     * value of an area which has been prepared before another one. The
+     * values are compared the same way as they are incremented.
+     */
+    sst_utils_memcpy(&iv_l, crypto->ref.iv, sizeof(iv_l));
+    sst_utils_memcpy(&iv_h, (crypto->ref.iv + sizeof(iv_l)), sizeof(iv_h));
+    sst_utils_memcpy(&cur_iv_l, sst_crypto_iv_buf, sizeof(cur_iv_l));
+    sst_utils_memcpy(&cur_iv_h, (sst_crypto_iv_buf + sizeof(cur_iv_l)),
+                     sizeof(cur_iv_h));
+
+    if ((iv_h < cur_iv_h) || ((iv_h == cur_iv_h) && (iv_l < cur_iv_l))) {
+        return;
+    }
+
     sst_utils_memcpy(sst_crypto_iv_buf, crypto->ref.iv, SST_IV_LEN_BYTES);
 }
 
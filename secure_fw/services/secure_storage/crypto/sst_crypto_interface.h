@@ -128,6 +128,9 @@ enum psa_sst_err_t sst_crypto_authenticate(const union sst_crypto_t *crypto,
  * \brief Provides current IV value to crypto layer
  *
  * \param[in] crypto  Pointer to the crypto union
+ *
+ * \note The IV value is only taken if it is not older than the current one,
+ *       so that the storage areas, which share the key, never reuse an IV.
  */
 void sst_crypto_set_iv(const union sst_crypto_t *crypto);
 
@@ -26,37 +26,388 @@ extern ARM_DRIVER_FLASH FLASH_DEV_NAME;
 
 #define BLOCK_START_OFFSET  0
 
+/* The cycles spent in the flash operations are only accounted if the target
+ * provides a cycle counter.
+ */
+#ifndef SST_FLASH_GET_CYCLES
+#define SST_FLASH_GET_CYCLES() 0
+#endif
+
+/* Size of the buffer used to move data from a block to another one, when
+ * the flash is not memory-mapped. It must be a multiple of the program unit.
+ */
+#ifndef SST_FLASH_MOVE_BUF_SIZE
+#define SST_FLASH_MOVE_BUF_SIZE 128
+#endif
+
+#if ((SST_FLASH_MOVE_BUF_SIZE == 0) || \
+     ((SST_FLASH_MOVE_BUF_SIZE % SST_FLASH_PROGRAM_UNIT) != 0))
+#error "SST_FLASH_MOVE_BUF_SIZE must be a multiple of SST_FLASH_PROGRAM_UNIT"
+#endif
+
+#ifdef SST_FLASH_ASYNC
+/* Number of program and erase requests which can be queued */
+#ifndef SST_FLASH_ASYNC_QUEUE_LEN
+#define SST_FLASH_ASYNC_QUEUE_LEN 4
+#endif
+
+/* Size of the data of a program request. The larger writes are split in
+ * several requests. It must be a multiple of the program unit.
+ */
+#ifndef SST_FLASH_ASYNC_BUF_SIZE
+#define SST_FLASH_ASYNC_BUF_SIZE 64
+#endif
+
+#if ((SST_FLASH_ASYNC_BUF_SIZE == 0) || \
+     ((SST_FLASH_ASYNC_BUF_SIZE % SST_FLASH_PROGRAM_UNIT) != 0))
+#error "SST_FLASH_ASYNC_BUF_SIZE must be a multiple of SST_FLASH_PROGRAM_UNIT"
+#endif
+
+/* Types of asynchronous request */
+#define SST_FLASH_ASYNC_PROGRAM 0
+#define SST_FLASH_ASYNC_ERASE   1
+
+/* Program or erase request queued for the flash device */
+struct sst_flash_async_req_t {
+    uint32_t type;        /*!< Type of request */
+    uint32_t area_id;     /*!< Storage area of the request */
+    uint32_t flash_addr;  /*!< Flash address */
+    uint32_t size;        /*!< Number of bytes to program */
+    uint8_t data[SST_FLASH_ASYNC_BUF_SIZE]; /*!< Data to program */
+};
+
+/* Queue of the requests, in the order they are performed. They are only
+ * started by the caller's thread, while the event handler only reports their
+ * completion, so the queue does not need to be locked. The request in
+ * progress stays at the head of the queue until its completion, as the
+ * driver reads its data until then.
+ */
+static struct sst_flash_async_req_t
+                               sst_flash_async_queue[SST_FLASH_ASYNC_QUEUE_LEN];
+static uint32_t sst_flash_async_head;
+static uint32_t sst_flash_async_count;
+
+/* Set if the flash driver signals the completion of its operations */
+static uint32_t sst_flash_async_enabled;
+
+/* First error of the requests of each storage area, reported until the
+ * area's flash interface is initialized
+ */
+static enum psa_sst_err_t sst_flash_async_err[SST_NBR_OF_AREAS];
+
+/* Set while the request at the head of the queue is in progress */
+static uint32_t sst_flash_async_started;
+
+/* State of the request in progress, updated by the event handler */
+static volatile uint32_t sst_flash_async_busy;
+static volatile uint32_t sst_flash_async_failed;
+#endif /* SST_FLASH_ASYNC */
+
+#ifdef SST_FLASH_CACHE
+#if ((SST_FLASH_CACHE_PAGE_SIZE == 0) || \
+     ((SST_MAX_BLOCK_SIZE % SST_FLASH_CACHE_PAGE_SIZE) != 0))
+#error "SST_FLASH_CACHE_PAGE_SIZE must be a divisor of SST_MAX_BLOCK_SIZE"
+#endif
+
+#if (SST_FLASH_CACHE_NBR_PAGES == 0)
+#error "SST_FLASH_CACHE_NBR_PAGES must not be 0"
+#endif
+
+/* Reads larger than the cache would only evict all its pages */
+#define SST_FLASH_CACHE_SIZE (SST_FLASH_CACHE_PAGE_SIZE * \
+                              SST_FLASH_CACHE_NBR_PAGES)
+
+/* Page of a block held in the read cache */
+struct sst_flash_cache_page_t {
+    uint32_t valid;     /*!< Set if the page holds data of the flash */
+    uint32_t area_id;   /*!< Storage area ID */
+    uint32_t block_id;  /*!< Block ID */
+    uint32_t page;      /*!< Page index in the block */
+    uint32_t last_use;  /*!< Value of the use counter at the last access */
+    uint8_t data[SST_FLASH_CACHE_PAGE_SIZE]; /*!< Content of the page */
+};
+
+static struct sst_flash_cache_page_t
+                                   sst_flash_cache[SST_FLASH_CACHE_NBR_PAGES];
+
+/* Counter of the page accesses, used to find the least recently used page */
+static uint32_t sst_flash_cache_uses;
+#endif /* SST_FLASH_CACHE */
+
+#ifdef SST_FLASH_PROGRAM_PAGE_SIZE
+#if ((SST_FLASH_PROGRAM_PAGE_SIZE == 0) || \
+     ((SST_FLASH_PROGRAM_PAGE_SIZE % SST_FLASH_PROGRAM_UNIT) != 0) || \
+     ((SST_SECTOR_SIZE % SST_FLASH_PROGRAM_PAGE_SIZE) != 0))
+#error "SST_FLASH_PROGRAM_PAGE_SIZE must be a multiple of the program unit " \
+       "and a divisor of SST_SECTOR_SIZE"
+#endif
+
+/* Data of the consecutive writes combined in a program page, which is not
+ * programmed yet. It starts at sst_flash_batch_addr and does not cross a page
+ * boundary.
+ */
+static uint8_t sst_flash_batch_buf[SST_FLASH_PROGRAM_PAGE_SIZE];
+static uint32_t sst_flash_batch_area;
+static uint32_t sst_flash_batch_addr;
+static uint32_t sst_flash_batch_size;
+
+/* First error of the combined writes of each storage area, reported until
+ * the area's flash interface is initialized
+ */
+static enum psa_sst_err_t sst_flash_batch_err[SST_NBR_OF_AREAS];
+#endif /* SST_FLASH_PROGRAM_PAGE_SIZE */
+
+/* Flash geometry of the storage areas */
+static const struct sst_flash_area_t sst_flash_areas[SST_NBR_OF_AREAS] = {
+    SST_FLASH_AREAS
+};
+
+/* Counters of the flash operations */
+static struct tfm_sst_flash_stats_t sst_flash_stats;
+
+#ifdef SST_FLASH_TRACE
+/* Ring buffer of the most recent flash operations */
+static struct tfm_sst_flash_trace_t sst_flash_trace[SST_FLASH_TRACE_ENTRIES];
+#endif
+
 /*
  * \brief Gets physical address of the given block ID.
  *
+ * \param[in]  area_id   Storage area ID
  * \param[in]  block_id  Block ID
  * \param[in]  offset    Offset position from the init of the block
  *
  * \returns Returns physical address for the given block ID.
  */
 __attribute__((always_inline))
-__STATIC_INLINE uint32_t get_phys_address(uint32_t block_id, uint32_t offset)
+__STATIC_INLINE uint32_t get_phys_address(uint32_t area_id, uint32_t block_id,
+                                          uint32_t offset)
+{
+    const struct sst_flash_area_t *area = &sst_flash_areas[area_id];
+
+    return (area->flash_addr + (block_id * area->block_size) + offset);
+}
+
+#ifdef SST_FLASH_ASYNC
+/**
+ * \brief Handles the events signalled by the flash driver, which may be
+ *        called in interrupt context.
+ *
+ * \param[in] event  Flash event
+ */
+static void sst_flash_async_signal_event(uint32_t event)
 {
-    return (SST_FLASH_AREA_ADDR + (block_id * SST_BLOCK_SIZE) + offset);
+    if ((event & ARM_FLASH_EVENT_ERROR) != 0) {
+        sst_flash_async_failed = 1;
+    }
+
+    sst_flash_async_busy = 0;
 }
 
-static enum psa_sst_err_t flash_read(uint32_t flash_addr, uint8_t *buff,
-                                     uint32_t size)
+/**
+ * \brief Records the failure of a request, and discards the requests queued
+ *        after it, as they may depend on it. The failure is reported to the
+ *        storage areas of the failed and discarded requests.
+ *
+ * \param[in] area_id  Storage area of the failed request
+ */
+static void sst_flash_async_fail(uint32_t area_id)
 {
+    uint32_t i;
+
+    sst_flash_async_err[area_id] = PSA_SST_ERR_SYSTEM_ERROR;
+    for (i = 0; i < sst_flash_async_count; i++) {
+        area_id = sst_flash_async_queue[(sst_flash_async_head + i) %
+                                        SST_FLASH_ASYNC_QUEUE_LEN].area_id;
+        sst_flash_async_err[area_id] = PSA_SST_ERR_SYSTEM_ERROR;
+    }
+
+    sst_flash_async_count = 0;
+}
+
+/**
+ * \brief Releases the request at the head of the queue once it has been
+ *        performed, and records its failure.
+ *
+ * \param[in] failed  Set if the request has failed
+ */
+static void sst_flash_async_release(uint32_t failed)
+{
+    uint32_t area_id;
+
+    area_id = sst_flash_async_queue[sst_flash_async_head].area_id;
+    sst_flash_async_started = 0;
+    sst_flash_async_head = (sst_flash_async_head + 1) %
+                           SST_FLASH_ASYNC_QUEUE_LEN;
+    sst_flash_async_count--;
+
+    if (failed) {
+        sst_flash_async_fail(area_id);
+    }
+}
+
+/**
+ * \brief Releases the completed request and starts the queued requests, one
+ *        at a time, while the flash device is not busy.
+ */
+static void sst_flash_async_pump(void)
+{
+    const struct sst_flash_async_req_t *req;
     int32_t err;
 
-    err = FLASH_DEV_NAME.ReadData(flash_addr, buff, size);
-    if (err != ARM_DRIVER_OK) {
+    for (;;) {
+        if (sst_flash_async_started) {
+            if (sst_flash_async_busy) {
+                return;
+            }
+
+            /* The request has completed, so its slot can be reused */
+            sst_flash_async_release(sst_flash_async_failed);
+            sst_flash_async_failed = 0;
+        }
+
+        if (sst_flash_async_count == 0) {
+            return;
+        }
+
+        req = &sst_flash_async_queue[sst_flash_async_head];
+        sst_flash_async_started = 1;
+        sst_flash_async_busy = 1;
+        if (req->type == SST_FLASH_ASYNC_ERASE) {
+            err = FLASH_DEV_NAME.EraseSector(req->flash_addr);
+        } else {
+            err = FLASH_DEV_NAME.ProgramData(req->flash_addr, req->data,
+                                             req->size);
+        }
+
+        if (err != ARM_DRIVER_OK) {
+            sst_flash_async_busy = 0;
+            sst_flash_async_release(1);
+        }
+    }
+}
+
+/**
+ * \brief Waits until the queued requests of all the storage areas have been
+ *        performed.
+ *
+ * \param[in] area_id  Storage area ID
+ *
+ * \return Returns PSA_SST_ERR_SUCCESS if all the requests of the area have
+ *         succeeded. Otherwise, it returns PSA_SST_ERR_SYSTEM_ERROR.
+ */
+static enum psa_sst_err_t sst_flash_async_wait(uint32_t area_id)
+{
+    sst_flash_async_pump();
+    while (sst_flash_async_count != 0) {
+        (void)FLASH_DEV_NAME.GetStatus();
+        sst_flash_async_pump();
+    }
+
+    return sst_flash_async_err[area_id];
+}
+
+/**
+ * \brief Gets a free request at the end of the queue, waiting for the first
+ *        queued request to complete if the queue is full.
+ *
+ * \param[in] area_id  Storage area ID
+ *
+ * \return Returns a pointer to the request, or NULL if a previous request of
+ *         the area has failed
+ */
+static struct sst_flash_async_req_t *sst_flash_async_alloc(uint32_t area_id)
+{
+    sst_flash_async_pump();
+    while (sst_flash_async_count == SST_FLASH_ASYNC_QUEUE_LEN) {
+        (void)FLASH_DEV_NAME.GetStatus();
+        sst_flash_async_pump();
+    }
+
+    if (sst_flash_async_err[area_id] != PSA_SST_ERR_SUCCESS) {
+        return NULL;
+    }
+
+    return &sst_flash_async_queue[(sst_flash_async_head +
+                                   sst_flash_async_count) %
+                                  SST_FLASH_ASYNC_QUEUE_LEN];
+}
+#endif /* SST_FLASH_ASYNC */
+
+/**
+ * \brief Waits until the flash operations in progress have been performed.
+ *
+ * \param[in] area_id  Storage area ID
+ *
+ * \return Returns error code as specified in \ref psa_sst_err_t
+ */
+static enum psa_sst_err_t flash_sync(uint32_t area_id)
+{
+#ifdef SST_FLASH_PROGRAM_PAGE_SIZE
+    if (sst_flash_batch_err[area_id] != PSA_SST_ERR_SUCCESS) {
         return PSA_SST_ERR_SYSTEM_ERROR;
     }
+#endif
+#ifdef SST_FLASH_ASYNC
+    if (sst_flash_async_enabled) {
+        return sst_flash_async_wait(area_id);
+    }
+#else
+    (void)area_id;
+#endif
 
     return PSA_SST_ERR_SUCCESS;
 }
 
-static enum psa_sst_err_t flash_write(uint32_t flash_addr, const uint8_t *buff,
-                                      uint32_t size)
+/**
+ * \brief Programs data in flash, or queues the program requests when the
+ *        flash operations are asynchronous.
+ *
+ * \param[in] area_id     Storage area ID
+ * \param[in] flash_addr  Flash address
+ * \param[in] buff        Data to program
+ * \param[in] size        Number of bytes to program
+ *
+ * \return Returns error code as specified in \ref psa_sst_err_t
+ */
+static enum psa_sst_err_t flash_program(uint32_t area_id, uint32_t flash_addr,
+                                        const uint8_t *buff, uint32_t size)
 {
     int32_t err;
+#ifdef SST_FLASH_ASYNC
+    struct sst_flash_async_req_t *req;
+    uint32_t chunk_size;
+
+    if (sst_flash_async_enabled) {
+        /* The data is copied in the queued requests, so that the caller can
+         * reuse its buffer straight away.
+         */
+        while (size > 0) {
+            req = sst_flash_async_alloc(area_id);
+            if (req == NULL) {
+                return PSA_SST_ERR_SYSTEM_ERROR;
+            }
+
+            chunk_size = (size < SST_FLASH_ASYNC_BUF_SIZE) ?
+                         size : SST_FLASH_ASYNC_BUF_SIZE;
+            req->type = SST_FLASH_ASYNC_PROGRAM;
+            req->area_id = area_id;
+            req->flash_addr = flash_addr;
+            req->size = chunk_size;
+            sst_utils_memcpy(req->data, buff, chunk_size);
+            sst_flash_async_count++;
+            sst_flash_async_pump();
+
+            flash_addr += chunk_size;
+            buff += chunk_size;
+            size -= chunk_size;
+        }
+
+        return sst_flash_async_err[area_id];
+    }
+#else
+    (void)area_id;
+#endif
 
     err = FLASH_DEV_NAME.ProgramData(flash_addr, buff, size);
     if (err != ARM_DRIVER_OK) {
@@ -66,10 +417,152 @@ static enum psa_sst_err_t flash_write(uint32_t flash_addr, const uint8_t *buff,
     return PSA_SST_ERR_SUCCESS;
 }
 
-static enum psa_sst_err_t flash_erase(uint32_t flash_addr)
+#ifdef SST_FLASH_PROGRAM_PAGE_SIZE
+/**
+ * \brief Programs the combined writes which are not programmed yet. A
+ *        failure is recorded for their storage area.
+ */
+static void flash_batch_program(void)
+{
+    uint32_t size = sst_flash_batch_size;
+
+    if (size == 0) {
+        return;
+    }
+
+    sst_flash_batch_size = 0;
+    if (flash_program(sst_flash_batch_area, sst_flash_batch_addr,
+                      sst_flash_batch_buf, size) != PSA_SST_ERR_SUCCESS) {
+        sst_flash_batch_err[sst_flash_batch_area] = PSA_SST_ERR_SYSTEM_ERROR;
+    }
+}
+
+/**
+ * \brief Programs the combined writes which are not programmed yet, if they
+ *        overlap a flash range.
+ *
+ * \param[in] flash_addr  Flash address of the range
+ * \param[in] size        Size of the range
+ */
+static void flash_batch_program_range(uint32_t flash_addr, uint32_t size)
+{
+    if ((sst_flash_batch_size != 0) &&
+        (flash_addr < (sst_flash_batch_addr + sst_flash_batch_size)) &&
+        (sst_flash_batch_addr < (flash_addr + size))) {
+        flash_batch_program();
+    }
+}
+#endif /* SST_FLASH_PROGRAM_PAGE_SIZE */
+
+static enum psa_sst_err_t flash_write(uint32_t area_id, uint32_t flash_addr,
+                                      const uint8_t *buff, uint32_t size)
+{
+#ifdef SST_FLASH_PROGRAM_PAGE_SIZE
+    uint32_t chunk_size;
+
+    if (sst_flash_batch_err[area_id] != PSA_SST_ERR_SUCCESS) {
+        return PSA_SST_ERR_SYSTEM_ERROR;
+    }
+
+    while (size > 0) {
+        chunk_size = (SST_FLASH_PROGRAM_PAGE_SIZE -
+                      (flash_addr % SST_FLASH_PROGRAM_PAGE_SIZE));
+        if (chunk_size > size) {
+            chunk_size = size;
+        }
+
+        /* Only the data which continues the combined writes is added to
+         * them
+         */
+        if ((sst_flash_batch_size != 0) &&
+            ((sst_flash_batch_area != area_id) ||
+             (flash_addr != (sst_flash_batch_addr + sst_flash_batch_size)))) {
+            flash_batch_program();
+        }
+
+        if (sst_flash_batch_size == 0) {
+            sst_flash_batch_area = area_id;
+            sst_flash_batch_addr = flash_addr;
+        }
+
+        sst_utils_memcpy(&sst_flash_batch_buf[sst_flash_batch_size], buff,
+                         chunk_size);
+        sst_flash_batch_size += chunk_size;
+
+        /* The page is programmed as soon as it is full */
+        if (((flash_addr + chunk_size) % SST_FLASH_PROGRAM_PAGE_SIZE) == 0) {
+            flash_batch_program();
+        }
+
+        flash_addr += chunk_size;
+        buff += chunk_size;
+        size -= chunk_size;
+    }
+
+    return sst_flash_batch_err[area_id];
+#else
+    return flash_program(area_id, flash_addr, buff, size);
+#endif
+}
+
+static enum psa_sst_err_t flash_read(uint32_t area_id, uint32_t flash_addr,
+                                     uint8_t *buff, uint32_t size)
 {
     int32_t err;
 
+#ifdef SST_FLASH_PROGRAM_PAGE_SIZE
+    /* The combined writes are programmed before they are read back */
+    flash_batch_program_range(flash_addr, size);
+#endif
+
+    /* The flash device can not be read while it is busy */
+    if (flash_sync(area_id) != PSA_SST_ERR_SUCCESS) {
+        return PSA_SST_ERR_SYSTEM_ERROR;
+    }
+
+    err = FLASH_DEV_NAME.ReadData(flash_addr, buff, size);
+    if (err != ARM_DRIVER_OK) {
+        return PSA_SST_ERR_SYSTEM_ERROR;
+    }
+
+    return PSA_SST_ERR_SUCCESS;
+}
+
+static enum psa_sst_err_t flash_erase(uint32_t area_id, uint32_t flash_addr)
+{
+    int32_t err;
+#ifdef SST_FLASH_ASYNC
+    struct sst_flash_async_req_t *req;
+#endif
+
+#ifdef SST_FLASH_PROGRAM_PAGE_SIZE
+    /* The sector is erased after the previous writes are programmed */
+    flash_batch_program();
+    if (sst_flash_batch_err[area_id] != PSA_SST_ERR_SUCCESS) {
+        return PSA_SST_ERR_SYSTEM_ERROR;
+    }
+#endif
+
+#ifdef SST_FLASH_ASYNC
+    if (sst_flash_async_enabled) {
+        req = sst_flash_async_alloc(area_id);
+        if (req == NULL) {
+            return PSA_SST_ERR_SYSTEM_ERROR;
+        }
+
+        req->type = SST_FLASH_ASYNC_ERASE;
+        req->area_id = area_id;
+        req->flash_addr = flash_addr;
+        req->size = 0;
+        sst_flash_async_count++;
+        sst_flash_async_pump();
+
+        return sst_flash_async_err[area_id];
+    }
+#else
+    (void)area_id;
+#endif
+
     err = FLASH_DEV_NAME.EraseSector(flash_addr);
     if (err != ARM_DRIVER_OK) {
         return PSA_SST_ERR_SYSTEM_ERROR;
@@ -78,75 +571,472 @@ static enum psa_sst_err_t flash_erase(uint32_t flash_addr)
     return PSA_SST_ERR_SUCCESS;
 }
 
-enum psa_sst_err_t sst_flash_read(uint32_t block_id, uint8_t *buff,
-                                  uint32_t offset, uint32_t size)
+#ifdef SST_FLASH_CACHE
+/**
+ * \brief Discards the cached pages which overlap a range of a block.
+ *
+ * \param[in] area_id   Storage area ID
+ * \param[in] block_id  Block ID
+ * \param[in] offset    Offset of the range in the block
+ * \param[in] size      Size of the range
+ */
+static void sst_flash_cache_invalidate(uint32_t area_id, uint32_t block_id,
+                                       uint32_t offset, uint32_t size)
 {
+    struct sst_flash_cache_page_t *entry;
+    uint32_t first_page;
+    uint32_t last_page;
+    uint32_t i;
+
+    if (size == 0) {
+        return;
+    }
+
+    first_page = offset / SST_FLASH_CACHE_PAGE_SIZE;
+    last_page = (offset + size - 1) / SST_FLASH_CACHE_PAGE_SIZE;
+
+    for (i = 0; i < SST_FLASH_CACHE_NBR_PAGES; i++) {
+        entry = &sst_flash_cache[i];
+        if (entry->valid && (entry->area_id == area_id) &&
+            (entry->block_id == block_id) &&
+            (entry->page >= first_page) && (entry->page <= last_page)) {
+            entry->valid = 0;
+        }
+    }
+}
+
+/**
+ * \brief Gets a page of a block in the read cache. On a miss, the page is
+ *        read from flash in place of an unused or the least recently used
+ *        page.
+ *
+ * \param[in] area_id   Storage area ID
+ * \param[in] block_id  Block ID
+ * \param[in] page      Page index in the block
+ *
+ * \return Returns a pointer to the cached page, or NULL if the page can not
+ *         be read from flash
+ */
+static const struct sst_flash_cache_page_t *sst_flash_cache_get(
+                                                             uint32_t area_id,
+                                                             uint32_t block_id,
+                                                             uint32_t page)
+{
+    struct sst_flash_cache_page_t *entry;
+    struct sst_flash_cache_page_t *victim = NULL;
+    uint32_t victim_age = 0;
+    uint32_t age;
+    uint32_t i;
+
+    sst_flash_cache_uses++;
+
+    for (i = 0; i < SST_FLASH_CACHE_NBR_PAGES; i++) {
+        entry = &sst_flash_cache[i];
+        if (!entry->valid) {
+            if ((victim == NULL) || victim->valid) {
+                victim = entry;
+            }
+            continue;
+        }
+
+        if ((entry->area_id == area_id) && (entry->block_id == block_id) &&
+            (entry->page == page)) {
+            entry->last_use = sst_flash_cache_uses;
+            sst_flash_stats.cache_hits++;
+            return entry;
+        }
+
+        /* The age is correct even if the use counter has wrapped around */
+        age = sst_flash_cache_uses - entry->last_use;
+        if ((victim == NULL) || (victim->valid && (age > victim_age))) {
+            victim = entry;
+            victim_age = age;
+        }
+    }
+
+    sst_flash_stats.cache_misses++;
+
+    victim->valid = 0;
+    if (flash_read(area_id,
+                   get_phys_address(area_id, block_id,
+                                    page * SST_FLASH_CACHE_PAGE_SIZE),
+                   victim->data, SST_FLASH_CACHE_PAGE_SIZE) !=
+                                                      PSA_SST_ERR_SUCCESS) {
+        return NULL;
+    }
+
+    victim->valid = 1;
+    victim->area_id = area_id;
+    victim->block_id = block_id;
+    victim->page = page;
+    victim->last_use = sst_flash_cache_uses;
+
+    return victim;
+}
+
+/**
+ * \brief Reads block data through the read cache.
+ *
+ * \param[in]  area_id   Storage area ID
+ * \param[in]  block_id  Block ID
+ * \param[out] buff      Buffer pointer to store the data read
+ * \param[in]  offset    Offset position from the init of the block
+ * \param[in]  size      Number of bytes to read
+ *
+ * \return Returns error code as specified in \ref psa_sst_err_t
+ */
+static enum psa_sst_err_t sst_flash_cache_read(uint32_t area_id,
+                                               uint32_t block_id,
+                                               uint8_t *buff, uint32_t offset,
+                                               uint32_t size)
+{
+    const struct sst_flash_cache_page_t *entry;
+    uint32_t page_offset;
+    uint32_t chunk_size;
+
+    while (size > 0) {
+        page_offset = offset % SST_FLASH_CACHE_PAGE_SIZE;
+        chunk_size = SST_FLASH_CACHE_PAGE_SIZE - page_offset;
+        if (chunk_size > size) {
+            chunk_size = size;
+        }
+
+        entry = sst_flash_cache_get(area_id, block_id,
+                                    offset / SST_FLASH_CACHE_PAGE_SIZE);
+        if (entry == NULL) {
+            return PSA_SST_ERR_SYSTEM_ERROR;
+        }
+
+        sst_utils_memcpy(buff, &entry->data[page_offset], chunk_size);
+
+        buff += chunk_size;
+        offset += chunk_size;
+        size -= chunk_size;
+    }
+
+    return PSA_SST_ERR_SUCCESS;
+}
+#endif /* SST_FLASH_CACHE */
+
+/**
+ * \brief Accounts a flash operation in the counters and the trace.
+ *
+ * \param[in] op      Flash operation
+ * \param[in] area    Storage area ID
+ * \param[in] block   Block ID, or destination block ID of a move
+ * \param[in] offset  Offset in the block
+ * \param[in] size    Number of bytes
+ * \param[in] start   Value of the cycle counter before the operation
+ * \param[in] err     Result of the operation
+ */
+static void sst_flash_account(enum tfm_sst_flash_op_t op, uint32_t area,
+                              uint32_t block, uint32_t offset, uint32_t size,
+                              uint32_t start, enum psa_sst_err_t err)
+{
+    struct tfm_sst_flash_op_stats_t *op_stats = &sst_flash_stats.ops[op];
+#ifdef SST_FLASH_TRACE
+    struct tfm_sst_flash_trace_t *entry;
+#endif
+
+    op_stats->calls++;
+    op_stats->bytes += size;
+    /* The cycle counter is allowed to wrap around between start and end */
+    op_stats->cycles += (uint32_t)((uint32_t)SST_FLASH_GET_CYCLES() - start);
+    if (err != PSA_SST_ERR_SUCCESS) {
+        op_stats->errors++;
+    }
+
+#ifdef SST_FLASH_TRACE
+    entry = &sst_flash_trace[sst_flash_stats.trace_count %
+                             SST_FLASH_TRACE_ENTRIES];
+    entry->op = op;
+    entry->area = area;
+    entry->block = block;
+    entry->offset = offset;
+    entry->size = size;
+    sst_flash_stats.trace_count++;
+#else
+    (void)area;
+    (void)block;
+    (void)offset;
+#endif
+}
+
+enum psa_sst_err_t sst_flash_read(uint32_t area_id, uint32_t block_id,
+                                  uint8_t *buff, uint32_t offset,
+                                  uint32_t size)
+{
+    uint32_t start = SST_FLASH_GET_CYCLES();
+    enum psa_sst_err_t err;
     uint32_t flash_addr;
 
     /* Gets flash address location defined by block ID and offset
      * parameters.
      */
-    flash_addr = get_phys_address(block_id, offset);
+    flash_addr = get_phys_address(area_id, block_id, offset);
 
-    return flash_read(flash_addr, buff, size);
+#ifdef SST_FLASH_CACHE
+    if (size <= SST_FLASH_CACHE_SIZE) {
+        err = sst_flash_cache_read(area_id, block_id, buff, offset, size);
+    } else {
+        err = flash_read(area_id, flash_addr, buff, size);
+    }
+#else
+    err = flash_read(area_id, flash_addr, buff, size);
+#endif
+
+    sst_flash_account(TFM_SST_FLASH_OP_READ, area_id, block_id, offset, size,
+                      start, err);
+
+    return err;
 }
 
-enum psa_sst_err_t sst_flash_write(uint32_t block_id, const uint8_t *buff,
-                                   uint32_t offset, uint32_t size)
+enum psa_sst_err_t sst_flash_write(uint32_t area_id, uint32_t block_id,
+                                   const uint8_t *buff, uint32_t offset,
+                                   uint32_t size)
 {
+    uint32_t start = SST_FLASH_GET_CYCLES();
+    enum psa_sst_err_t err;
     uint32_t flash_addr;
 
     /* Gets flash address location defined by block ID and offset
      * parameters.
      */
-    flash_addr = get_phys_address(block_id, offset);
+    flash_addr = get_phys_address(area_id, block_id, offset);
+
+#ifdef SST_FLASH_CACHE
+    sst_flash_cache_invalidate(area_id, block_id, offset, size);
+#endif
+
+    err = flash_write(area_id, flash_addr, buff, size);
+
+    sst_flash_account(TFM_SST_FLASH_OP_WRITE, area_id, block_id, offset, size,
+                      start, err);
 
-    return flash_write(flash_addr, buff, size);
+    return err;
 }
 
-enum psa_sst_err_t sst_flash_block_to_block_move(uint32_t dst_block,
+enum psa_sst_err_t sst_flash_block_to_block_move(uint32_t area_id,
+                                                 uint32_t dst_block,
                                                  uint32_t dst_offset,
                                                  uint32_t src_block,
                                                  uint32_t src_offset,
                                                  uint32_t size)
 {
-    static uint8_t dst_block_data_copy[SST_BLOCK_SIZE];
-    enum psa_sst_err_t err;
+#ifndef SST_FLASH_MAPPED_BASE
+    static uint8_t move_buf[SST_FLASH_MOVE_BUF_SIZE];
+    uint32_t remaining = size;
+    uint32_t chunk_size;
+#endif
+    uint32_t start = SST_FLASH_GET_CYCLES();
+    enum psa_sst_err_t err = PSA_SST_ERR_SUCCESS;
     uint32_t dst_flash_addr;
     uint32_t src_flash_addr;
 
     /* Gets flash address location defined by block ID and offset
      * parameters.
      */
-    src_flash_addr = get_phys_address(src_block, src_offset);
+    src_flash_addr = get_phys_address(area_id, src_block, src_offset);
+    dst_flash_addr = get_phys_address(area_id, dst_block, dst_offset);
+
+#ifdef SST_FLASH_CACHE
+    sst_flash_cache_invalidate(area_id, dst_block, dst_offset, size);
+#endif
 
-    /* Reads data from source block and store it in the in-memory copy of
-     * destination content.
+#ifdef SST_FLASH_MAPPED_BASE
+    /* The source data is programmed straight from the memory-mapped flash,
+     * once the flash operations in progress have updated it.
      */
-    err = flash_read(src_flash_addr, dst_block_data_copy, size);
-    if (err != PSA_SST_ERR_SUCCESS) {
-        return err;
+#ifdef SST_FLASH_PROGRAM_PAGE_SIZE
+    flash_batch_program_range(src_flash_addr, size);
+#endif
+    err = flash_sync(area_id);
+    if (err == PSA_SST_ERR_SUCCESS) {
+        err = flash_write(area_id, dst_flash_addr,
+                          (const uint8_t *)(uintptr_t)(SST_FLASH_MAPPED_BASE)
+                          + src_flash_addr, size);
     }
-
-    /* Gets flash address location defined by block ID and offset
-     * parameters.
+#else
+    /* Copies the data through the move buffer. As the buffer size is a
+     * multiple of the program unit, all the chunks but the last one end on a
+     * program unit boundary.
      */
-    dst_flash_addr = get_phys_address(dst_block, dst_offset);
+    while ((remaining > 0) && (err == PSA_SST_ERR_SUCCESS)) {
+        chunk_size = (remaining < SST_FLASH_MOVE_BUF_SIZE) ?
+                     remaining : SST_FLASH_MOVE_BUF_SIZE;
+
+        err = flash_read(area_id, src_flash_addr, move_buf, chunk_size);
+        if (err == PSA_SST_ERR_SUCCESS) {
+            err = flash_write(area_id, dst_flash_addr, move_buf, chunk_size);
+        }
+
+        src_flash_addr += chunk_size;
+        dst_flash_addr += chunk_size;
+        remaining -= chunk_size;
+    }
+#endif
 
-    /* Writes in flash the in-memory block content after modification */
-    err = flash_write(dst_flash_addr, dst_block_data_copy, size);
+    sst_flash_account(TFM_SST_FLASH_OP_MOVE, area_id, dst_block, dst_offset,
+                      size, start, err);
 
     return err;
 }
 
-enum psa_sst_err_t sst_flash_erase_block(uint32_t block_id)
+enum psa_sst_err_t sst_flash_erase_block(uint32_t area_id, uint32_t block_id)
 {
+    uint32_t block_size = sst_flash_areas[area_id].block_size;
+    uint32_t start = SST_FLASH_GET_CYCLES();
+    enum psa_sst_err_t err = PSA_SST_ERR_SUCCESS;
     uint32_t flash_addr;
+    uint32_t sector;
 
     /* Calculate flash address location defined by block ID and
      * BLOCK_START_OFFSET parameters.
      */
-    flash_addr = get_phys_address(block_id, BLOCK_START_OFFSET);
+    flash_addr = get_phys_address(area_id, block_id, BLOCK_START_OFFSET);
+
+#ifdef SST_FLASH_CACHE
+    sst_flash_cache_invalidate(area_id, block_id, BLOCK_START_OFFSET,
+                               block_size);
+#endif
+
+    /* A block spans one or more sectors, which are erased in order */
+    for (sector = 0; (sector < block_size) && (err == PSA_SST_ERR_SUCCESS);
+         sector += SST_SECTOR_SIZE) {
+        err = flash_erase(area_id, (flash_addr + sector));
+    }
+
+    sst_flash_account(TFM_SST_FLASH_OP_ERASE, area_id, block_id,
+                      BLOCK_START_OFFSET, block_size, start, err);
+
+    return err;
+}
+
+const struct sst_flash_area_t *sst_flash_get_area(uint32_t area_id)
+{
+    if (area_id >= SST_NBR_OF_AREAS) {
+        return NULL;
+    }
+
+    return &sst_flash_areas[area_id];
+}
+
+enum psa_sst_err_t sst_flash_init(uint32_t area_id)
+{
+#ifdef SST_FLASH_CACHE
+    uint32_t i;
+#endif
+#ifdef SST_FLASH_ASYNC
+    ARM_FLASH_CAPABILITIES capabilities;
+#endif
+
+    if (area_id >= SST_NBR_OF_AREAS) {
+        return PSA_SST_ERR_SYSTEM_ERROR;
+    }
+
+    /* The blocks are erased one sector at a time */
+    if (((sst_flash_areas[area_id].flash_addr % SST_SECTOR_SIZE) != 0) ||
+        (sst_flash_areas[area_id].block_size == 0) ||
+        ((sst_flash_areas[area_id].block_size % SST_SECTOR_SIZE) != 0)) {
+        return PSA_SST_ERR_SYSTEM_ERROR;
+    }
+
+#ifdef SST_FLASH_CACHE
+    if ((sst_flash_areas[area_id].block_size %
+         SST_FLASH_CACHE_PAGE_SIZE) != 0) {
+        return PSA_SST_ERR_SYSTEM_ERROR;
+    }
+
+    /* The flash content may have changed since the pages were read */
+    for (i = 0; i < SST_FLASH_CACHE_NBR_PAGES; i++) {
+        if (sst_flash_cache[i].area_id == area_id) {
+            sst_flash_cache[i].valid = 0;
+        }
+    }
+#endif
 
-    return flash_erase(flash_addr);
+#ifdef SST_FLASH_PROGRAM_PAGE_SIZE
+    /* The combined writes which are not programmed yet are discarded, as a
+     * reset would lose them. If they belong to another area, their loss is
+     * reported to it. Then, the area's error is cleared.
+     */
+    if (sst_flash_batch_size != 0) {
+        sst_flash_batch_err[sst_flash_batch_area] = PSA_SST_ERR_SYSTEM_ERROR;
+        sst_flash_batch_size = 0;
+    }
+    sst_flash_batch_err[area_id] = PSA_SST_ERR_SUCCESS;
+#endif
+
+#ifdef SST_FLASH_ASYNC
+    /* Lets the queued requests of all the areas complete, as they may belong
+     * to other areas. Then, the area's error is cleared.
+     */
+    if (sst_flash_async_enabled) {
+        (void)sst_flash_async_wait(area_id);
+    }
+    sst_flash_async_err[area_id] = PSA_SST_ERR_SUCCESS;
+
+    if (FLASH_DEV_NAME.Initialize(sst_flash_async_signal_event) !=
+                                                               ARM_DRIVER_OK) {
+        return PSA_SST_ERR_SYSTEM_ERROR;
+    }
+
+    /* The flash operations are performed synchronously if the driver does
+     * not signal their completion.
+     */
+    capabilities = FLASH_DEV_NAME.GetCapabilities();
+    sst_flash_async_enabled = capabilities.event_ready;
+#endif
+
+    return PSA_SST_ERR_SUCCESS;
+}
+
+enum psa_sst_err_t sst_flash_flush(uint32_t area_id)
+{
+    if (area_id >= SST_NBR_OF_AREAS) {
+        return PSA_SST_ERR_SYSTEM_ERROR;
+    }
+
+#ifdef SST_FLASH_PROGRAM_PAGE_SIZE
+    flash_batch_program();
+#endif
+
+    return flash_sync(area_id);
+}
+
+void sst_flash_get_stats(struct tfm_sst_flash_stats_t *stats)
+{
+    *stats = sst_flash_stats;
+#ifdef SST_FLASH_CACHE
+    stats->cache_size = SST_FLASH_CACHE_NBR_PAGES;
+#endif
+#ifdef SST_FLASH_TRACE
+    stats->trace_size = SST_FLASH_TRACE_ENTRIES;
+#endif
+}
+
+enum psa_sst_err_t sst_flash_get_trace(struct tfm_sst_flash_trace_t *entries,
+                                       uint32_t nbr_entries)
+{
+#ifdef SST_FLASH_TRACE
+    uint32_t first;
+    uint32_t i;
+
+    if ((nbr_entries > SST_FLASH_TRACE_ENTRIES) ||
+        (nbr_entries > sst_flash_stats.trace_count)) {
+        return PSA_SST_ERR_PARAM_ERROR;
+    }
+
+    /* The requested entries end with the most recent one */
+    first = sst_flash_stats.trace_count - nbr_entries;
+    for (i = 0; i < nbr_entries; i++) {
+        entries[i] = sst_flash_trace[(first + i) % SST_FLASH_TRACE_ENTRIES];
+    }
+
+    return PSA_SST_ERR_SUCCESS;
+#else
+    (void)entries;
+
+    return (nbr_entries == 0) ? PSA_SST_ERR_SUCCESS : PSA_SST_ERR_PARAM_ERROR;
+#endif
 }
@@ -19,19 +19,74 @@ extern "C" {
 /* Adjust to match your system's block size */
 #ifndef SST_SECTOR_SIZE
 #error "SST_SECTOR_SIZE must be defined by the target in flash_layout.h file"
-#define SST_BLOCK_SIZE 0
-#else
-#define SST_BLOCK_SIZE SST_SECTOR_SIZE
 #endif
 
 /* Adjust to a size that will allow all assets to fit */
 #ifndef SST_NBR_OF_SECTORS
 #error "SST_NBR_OF_SECTORS must be defined by the target in flash_layout.h file"
-#define SST_TOTAL_NUM_OF_BLOCKS 0
+#endif
+
+/* Number of flash sectors in a logical block. On flash devices with large
+ * erase sectors, a block of one sector would leave too few blocks for the
+ * metadata and scratch blocks. The sector size is the erase unit, so a block
+ * is erased one sector at a time.
+ */
+#ifndef SST_SECTORS_PER_BLOCK
+#define SST_SECTORS_PER_BLOCK 1
+#endif
+
+#if ((SST_SECTORS_PER_BLOCK == 0) || \
+     ((SST_NBR_OF_SECTORS % SST_SECTORS_PER_BLOCK) != 0))
+#error "SST_NBR_OF_SECTORS must be a multiple of SST_SECTORS_PER_BLOCK"
+#endif
+
+/* Size and number of the blocks of the default storage area */
+#define SST_FLASH_BLOCK_SIZE    (SST_SECTOR_SIZE * SST_SECTORS_PER_BLOCK)
+#define SST_FLASH_NBR_OF_BLOCKS (SST_NBR_OF_SECTORS / SST_SECTORS_PER_BLOCK)
+
+/* Number of independent storage areas. Each area has its own metadata, and
+ * its own flash address, block size and number of blocks, as defined by
+ * SST_FLASH_AREAS. The block size of an area must be a multiple of
+ * SST_SECTOR_SIZE. By default, there is a single area defined by
+ * SST_FLASH_AREA_ADDR, SST_FLASH_BLOCK_SIZE and SST_FLASH_NBR_OF_BLOCKS.
+ */
+#ifndef SST_NBR_OF_AREAS
+#define SST_NBR_OF_AREAS 1
+#endif
+
+#ifndef SST_FLASH_AREAS
+#define SST_FLASH_AREAS \
+    {SST_FLASH_AREA_ADDR, SST_FLASH_BLOCK_SIZE, SST_FLASH_NBR_OF_BLOCKS}
+#endif
+
+#if (SST_NBR_OF_AREAS < 1)
+#error "SST_NBR_OF_AREAS must be 1 or bigger"
+#endif
+
+/* Largest block size and number of blocks of the storage areas. They size
+ * the RAM tables and the metadata of all the areas, so they must be defined
+ * in flash_layout.h if an area is larger than the one defined by
+ * SST_SECTOR_SIZE and SST_NBR_OF_SECTORS.
+ */
+#ifdef SST_MAX_SECTOR_SIZE
+#define SST_MAX_BLOCK_SIZE SST_MAX_SECTOR_SIZE
+#else
+#define SST_MAX_BLOCK_SIZE SST_FLASH_BLOCK_SIZE
+#endif
+
+#ifdef SST_MAX_NBR_OF_SECTORS
+#define SST_MAX_NUM_OF_BLOCKS SST_MAX_NBR_OF_SECTORS
 #else
-#define SST_TOTAL_NUM_OF_BLOCKS SST_NBR_OF_SECTORS
+#define SST_MAX_NUM_OF_BLOCKS SST_FLASH_NBR_OF_BLOCKS
 #endif
 
+/* Flash geometry of a storage area */
+struct sst_flash_area_t {
+    uint32_t flash_addr;  /*!< Flash address of the area's first block */
+    uint32_t block_size;  /*!< Size of a block */
+    uint32_t nbr_blocks;  /*!< Number of blocks */
+};
+
 /* Default value of flash when erased */
 #define SST_FLASH_DEFAULT_VAL 0xFF
 /* A single host specific sst_flash_xxx.c should be included during compile */
@@ -39,9 +94,56 @@ extern "C" {
 /* Invalid block index */
 #define SST_BLOCK_INVALID_ID 0xFFFFFFFF
 
+/* Number of entries of the flash operation trace, when it is enabled by the
+ * SST_FLASH_TRACE flag
+ */
+#ifndef SST_FLASH_TRACE_ENTRIES
+#define SST_FLASH_TRACE_ENTRIES 32
+#endif
+
+/* Size and number of the pages of the read cache, when it is enabled by the
+ * SST_FLASH_CACHE flag. The page size must be a divisor of the block size.
+ */
+#ifndef SST_FLASH_CACHE_PAGE_SIZE
+#define SST_FLASH_CACHE_PAGE_SIZE 64
+#endif
+
+#ifndef SST_FLASH_CACHE_NBR_PAGES
+#define SST_FLASH_CACHE_NBR_PAGES 8
+#endif
+
+/**
+ * \brief Gets the flash geometry of a storage area.
+ *
+ * \param[in] area_id  Storage area ID
+ *
+ * \return Returns a pointer to the area's geometry, or NULL if the area ID is
+ *         not valid
+ */
+const struct sst_flash_area_t *sst_flash_get_area(uint32_t area_id);
+
+/**
+ * \brief Initializes the flash interface of a storage area. It empties the
+ *        area's pages of the read cache and, when the SST_FLASH_ASYNC flag is
+ *        enabled, it waits for the queued requests, clears the area's error
+ *        and registers the flash event handler.
+ *
+ * \param[in] area_id  Storage area ID
+ *
+ * \return Returns PSA_SST_ERR_SUCCESS if the function is executed correctly.
+ *         Otherwise, it returns PSA_SST_ERR_SYSTEM_ERROR.
+ */
+enum psa_sst_err_t sst_flash_init(uint32_t area_id);
+
 /**
  * \brief Reads block data from the position specifed by block ID and offset.
  *
+ * \note When the SST_FLASH_CACHE flag is enabled, the reads which are not
+ *       larger than the read cache are served by the least recently used
+ *       pages of the cache. The pages are read from flash on a miss, and
+ *       discarded when the block is written or erased.
+ *
+ * \param[in]  area_id   Storage area ID
  * \param[in]  block_id  Block ID
  * \param[out] buff      Buffer pointer to store the data read
  * \param[in]  offset    Offset position from the init of the block
@@ -54,12 +156,14 @@ extern "C" {
  * \return Returns PSA_SST_ERR_SUCCESS if the function is executed correctly.
  *         Otherwise, it returns PSA_SST_ERR_SYSTEM_ERROR.
  */
-enum psa_sst_err_t sst_flash_read(uint32_t block_id, uint8_t *buff,
-                                  uint32_t offset, uint32_t size);
+enum psa_sst_err_t sst_flash_read(uint32_t area_id, uint32_t block_id,
+                                  uint8_t *buff, uint32_t offset,
+                                  uint32_t size);
 
 /**
  * \brief Writes block data to the position specifed by block ID and offset.
  *
+ * \param[in] area_id   Storage area ID
  * \param[in] block_id  Block ID
  * \param[in] buff      Buffer pointer to the write data
  * \param[in] offset    Offset position from the init of the block
@@ -69,15 +173,28 @@ enum psa_sst_err_t sst_flash_read(uint32_t block_id, uint8_t *buff,
  *       the range of address, based on blockid + offset + size, are always
  *       valid in the memory.
  *
+ * \note If the target defines SST_FLASH_PROGRAM_PAGE_SIZE, the size of the
+ *       program pages of the flash device, the data is programmed one page
+ *       at a time, and the writes which continue the previous one in the same
+ *       page are combined in a single program operation. The combined data
+ *       is programmed when the page is full, and before any other flash
+ *       operation which could depend on it, so the flash operations are
+ *       still performed in order. A failure to program it is returned by the
+ *       next flash function called for the storage area, until sst_flash_init
+ *       is called again for it.
+ *
  * \return Returns PSA_SST_ERR_SUCCESS if the function is executed correctly.
  *         Otherwise, it returns PSA_SST_ERR_SYSTEM_ERROR.
  */
-enum psa_sst_err_t sst_flash_write(uint32_t block_id, const uint8_t *buff,
-                                   uint32_t offset, uint32_t size);
+enum psa_sst_err_t sst_flash_write(uint32_t area_id, uint32_t block_id,
+                                   const uint8_t *buff, uint32_t offset,
+                                   uint32_t size);
 
 /**
- * \brief Moves data from src block ID to destination block ID.
+ * \brief Moves data from src block ID to destination block ID, within a
+ *        storage area.
  *
+ * \param[in] area_id    Storage area ID
  * \param[in] dst_block  Destination block ID
  * \param[in] dst_offset Destination offset position from the init of the
  *                       destination block
@@ -91,11 +208,18 @@ enum psa_sst_err_t sst_flash_write(uint32_t block_id, const uint8_t *buff,
  *       valid in the memory.
  *       It also considers that the destination block is already erased and
  *       ready to be written.
+ *       The data is copied by chunks of SST_FLASH_MOVE_BUF_SIZE bytes, or
+ *       programmed straight from the flash if the target defines
+ *       SST_FLASH_MAPPED_BASE, the address at which the flash device is
+ *       memory-mapped. If dst_offset is aligned with the program unit, all
+ *       the chunks but the last one start and end on a program unit
+ *       boundary.
  *
  * \return Returns PSA_SST_ERR_SUCCESS if the function is executed correctly.
  *         Otherwise, it returns PSA_SST_ERR_SYSTEM_ERROR.
  */
-enum psa_sst_err_t sst_flash_block_to_block_move(uint32_t dst_block,
+enum psa_sst_err_t sst_flash_block_to_block_move(uint32_t area_id,
+                                                 uint32_t dst_block,
                                                  uint32_t dst_offset,
                                                  uint32_t src_block,
                                                  uint32_t src_offset,
@@ -104,14 +228,64 @@ enum psa_sst_err_t sst_flash_block_to_block_move(uint32_t dst_block,
 /**
  * \brief Erases block ID data.
  *
+ * \param[in] area_id   Storage area ID
  * \param[in] block_id  Block ID
  *
  * \note This function considers all input values valids.
+ *       The sectors of the block are erased one at a time, in order.
  *
  * \return Returns PSA_SST_ERR_SUCCESS if the function is executed correctly.
  *         Otherwise, it returns PSA_SST_ERR_SYSTEM_ERROR.
  */
-enum psa_sst_err_t sst_flash_erase_block(uint32_t block_id);
+enum psa_sst_err_t sst_flash_erase_block(uint32_t area_id, uint32_t block_id);
+
+/**
+ * \brief Waits until the flash operations in progress have been performed.
+ *
+ * \note When the SST_FLASH_ASYNC flag is enabled and the flash driver signals
+ *       the completion of its operations, sst_flash_write,
+ *       sst_flash_block_to_block_move and sst_flash_erase_block queue their
+ *       program and erase operations and return before they are performed.
+ *       The operations of all the storage areas are performed in order, and
+ *       the first one which fails discards the next ones. The failure is
+ *       returned by the next flash function called for the areas of the
+ *       failed and discarded operations, until sst_flash_init is called
+ *       again for them.
+ *
+ * \param[in] area_id  Storage area ID
+ *
+ * \return Returns PSA_SST_ERR_SUCCESS if all the flash operations of the area
+ *         have been performed. Otherwise, it returns PSA_SST_ERR_SYSTEM_ERROR.
+ */
+enum psa_sst_err_t sst_flash_flush(uint32_t area_id);
+
+/**
+ * \brief Gets the counters of the flash operations performed since boot, for
+ *        all the storage areas.
+ *
+ * \param[out] stats  Pointer to store the counters
+ *                    \ref tfm_sst_flash_stats_t
+ *
+ * \note The number of cycles is only accounted if the target defines the
+ *       SST_FLASH_GET_CYCLES() macro in flash_layout.h, which returns the
+ *       current value of a cycle counter.
+ */
+void sst_flash_get_stats(struct tfm_sst_flash_stats_t *stats);
+
+/**
+ * \brief Gets the most recent entries of the flash operation trace.
+ *
+ * \param[out] entries      Pointer to store the entries, from the oldest to
+ *                          the most recent one
+ *                          \ref tfm_sst_flash_trace_t
+ * \param[in]  nbr_entries  Number of entries to get
+ *
+ * \return Returns PSA_SST_ERR_SUCCESS if the entries are copied. It returns
+ *         PSA_SST_ERR_PARAM_ERROR if the trace does not hold that many
+ *         entries, which is always the case when it is disabled.
+ */
+enum psa_sst_err_t sst_flash_get_trace(struct tfm_sst_flash_trace_t *entries,
+                                       uint32_t nbr_entries);
 
 #ifdef __cplusplus
 }
@@ -15,6 +15,10 @@
 #include "jwt.h"
 
 #include "assets/sst_asset_defs.h"
+#include "flash/sst_flash.h"
+#ifdef SST_KV
+#include "sst_kv.h"
+#endif
 #include "sst_object_system.h"
 #include "sst_utils.h"
 #include "tfm_secure_api.h"
@@ -24,33 +28,64 @@
 /* Asset management functions */
 /******************************/
 
+/* The asset list cursor holds the storage area ID in its upper half, and the
+ * object metadata index to resume the listing from in its lower half.
+ */
+#define SST_AM_LIST_CURSOR(area_id, index) (((area_id) << 16) | (index))
+#define SST_AM_LIST_CURSOR_AREA(cursor)    ((cursor) >> 16)
+#define SST_AM_LIST_CURSOR_INDEX(cursor)   ((cursor) & 0xFFFF)
+
 /* Policy database */
 extern struct sst_asset_policy_t asset_perms[];
 extern struct sst_asset_perm_t asset_perms_modes[];
 
+/* Lookup tables of the policy database */
+#include "assets/sst_asset_policy_tables.inc"
+
+#define SST_AM_UUID_HASH(uuid) \
+    (((uint32_t)(uuid) * SST_AM_UUID_HASH_MULT) >> SST_AM_UUID_HASH_SHIFT)
+
+#define SST_AM_APP_HASH(app_id) \
+    (((uint32_t)(app_id) * SST_AM_APP_HASH_MULT) >> SST_AM_APP_HASH_SHIFT)
+
+#define SST_AM_PERMS(asset_idx, app_idx) \
+    sst_am_perms_table[((asset_idx) * (SST_AM_NBR_APPS + 1)) + (app_idx)]
+
 /**
- * \brief Looks up for policy entry for give app and uuid
+ * \brief Gets the index of an asset in the policy database
  *
- * \param[in] db_entry  Asset specific entry
- * \param[in] app_id    Identify of the application calling the service
+ * \param[in] uuid  Unique identifier of the object being accessed
  *
- * \return Returns the perms entry on successful lookup
+ * \return Returns the asset index, or SST_NUM_ASSETS if the asset is not in
+ *         the policy database
  */
-static struct sst_asset_perm_t *sst_am_lookup_app_perms(
-                                      const struct sst_asset_policy_t *db_entry,
-                                      uint32_t app_id)
+static uint32_t sst_am_lookup_asset_idx(uint32_t uuid)
 {
-    struct sst_asset_perm_t *perm_entry;
-    uint32_t i;
+    uint32_t idx;
 
-    for (i = 0; i < db_entry->perms_count; i++) {
-        perm_entry = &asset_perms_modes[db_entry->perms_modes_start_idx+i];
-        if (perm_entry->app == app_id) {
-            return perm_entry;
-        }
-    }
+    /* The hash is perfect for the UUIDs of the database, so an unknown UUID
+     * is the only one which can select an entry with a different UUID.
+     */
+    idx = sst_am_uuid_hash_table[SST_AM_UUID_HASH(uuid)];
 
-    return NULL;
+    return (sst_am_asset_uuids[idx] == uuid) ? idx : SST_NUM_ASSETS;
+}
+
+/**
+ * \brief Gets the index of an application in the policy database
+ *
+ * \param[in] app_id  Identify of the application calling the service
+ *
+ * \return Returns the application index, or SST_AM_NBR_APPS if the
+ *         application does not appear in the policy database
+ */
+static uint32_t sst_am_lookup_app_idx(uint32_t app_id)
+{
+    uint32_t idx;
+
+    idx = sst_am_app_hash_table[SST_AM_APP_HASH(app_id)];
+
+    return (sst_am_app_ids[idx] == app_id) ? idx : SST_AM_NBR_APPS;
 }
 
 /**
@@ -62,16 +97,14 @@ static struct sst_asset_perm_t *sst_am_lookup_app_perms(
  */
 static struct sst_asset_policy_t *sst_am_lookup_db_entry(uint32_t uuid)
 {
-    uint32_t i;
+    uint32_t idx;
 
-    /* Lookup in db for matching entry */
-    for (i = 0; i < SST_NUM_ASSETS; i++) {
-        if (asset_perms[i].asset_uuid == uuid) {
-            return &asset_perms[i];
-        }
+    idx = sst_am_lookup_asset_idx(uuid);
+    if (idx == SST_NUM_ASSETS) {
+        return NULL;
     }
 
-    return NULL;
+    return &asset_perms[idx];
 }
 
 /**
@@ -147,72 +180,97 @@ static struct sst_asset_policy_t *sst_am_get_db_entry(uint32_t app_id,
                                                       uint32_t uuid,
                                                       uint8_t request_type)
 {
-    struct sst_asset_perm_t   *perm_entry;
-    struct sst_asset_policy_t *db_entry;
-
-    request_type = sst_am_check_s_ns_policy(app_id, request_type);
+    uint32_t asset_idx;
+    uint32_t app_idx;
+    uint16_t access;
+    uint16_t granted;
 
-    /* security access violation */
-    if (request_type == SST_PERM_FORBIDDEN) {
-        /* FIXME: this is prone to timing attacks. Ideally the time
-         * spent in this function should always be constant irrespective
-         * of success or failure of checks. Timing attacks will be
-         * addressed in later version.
-         */
-        return NULL;
-    }
+    access = sst_am_check_s_ns_policy(app_id, request_type);
 
-    /* Find policy db entry for the the asset */
-    db_entry = sst_am_lookup_db_entry(uuid);
-    if (db_entry == NULL) {
-        return NULL;
-    }
+    /* The lookups are done whatever the outcome of the other checks, and the
+     * unknown asset and application select a forbidden entry of the
+     * permissions table, so that the time spent in this function does not
+     * depend on which check fails.
+     */
+    asset_idx = sst_am_lookup_asset_idx(uuid);
+    app_idx = sst_am_lookup_app_idx(app_id);
 
-    if (request_type == SST_PERM_BYPASS) {
-         return db_entry;
-     }
+    /* The bypass access is granted on any asset in the database. Otherwise,
+     * the db permission has to match with at least one of the requested
+     * permissions types.
+     */
+    granted = (access & SST_PERM_BYPASS) | (SST_AM_PERMS(asset_idx, app_idx) &
+                                            access);
 
-    /* Find the app ID entry in the database */
-    perm_entry = sst_am_lookup_app_perms(db_entry, app_id);
-    if (perm_entry == NULL) {
+    if ((granted == 0) || (asset_idx == SST_NUM_ASSETS)) {
         return NULL;
     }
 
-     /* Check if the db permission matches with at least one of the
-      * requested permissions types.
-      */
-    if ((perm_entry->perm & request_type) != 0) {
-        return db_entry;
-    }
-    return NULL;
+    return &asset_perms[asset_idx];
 }
 
 /**
  * \brief Validates the policy database's integrity
- *        Stub function.
+ *
+ * \details The lookup tables are generated from sst_asset_policy.yaml. This
+ *          function checks that they describe the same policy as the asset
+ *          definitions.
  *
  * \return Returns value specified in \ref psa_sst_err_t
  */
 static enum psa_sst_err_t validate_policy_db(void)
 {
-    /* Currently the policy database is inbuilt
-     * in the code. It's sanity is assumed to be correct.
-     * In the later revisions if access policy is
-     * stored differently, it may require sanity check
-     * as well.
-     */
+    struct sst_asset_perm_t *perm_entry;
+    uint32_t app_idx;
+    uint32_t asset_idx;
+    uint32_t i;
+    uint32_t perms_count;
+
+    for (asset_idx = 0; asset_idx < SST_NUM_ASSETS; asset_idx++) {
+        if (sst_am_lookup_asset_idx(asset_perms[asset_idx].asset_uuid)
+            != asset_idx) {
+            return PSA_SST_ERR_SYSTEM_ERROR;
+        }
+
+        perm_entry = &asset_perms_modes[
+                                  asset_perms[asset_idx].perms_modes_start_idx];
+        for (i = 0; i < asset_perms[asset_idx].perms_count; i++) {
+            app_idx = sst_am_lookup_app_idx(perm_entry[i].app);
+            if ((app_idx == SST_AM_NBR_APPS) ||
+                (SST_AM_PERMS(asset_idx, app_idx) != perm_entry[i].perm)) {
+                return PSA_SST_ERR_SYSTEM_ERROR;
+            }
+        }
+
+        /* The table must not grant permissions which are not in the asset
+         * definitions
+         */
+        perms_count = 0;
+        for (app_idx = 0; app_idx < SST_AM_NBR_APPS; app_idx++) {
+            if (SST_AM_PERMS(asset_idx, app_idx) != SST_PERM_FORBIDDEN) {
+                perms_count++;
+            }
+        }
+
+        if (perms_count != asset_perms[asset_idx].perms_count) {
+            return PSA_SST_ERR_SYSTEM_ERROR;
+        }
+    }
+
     return PSA_SST_ERR_SUCCESS;
 }
 
 enum psa_sst_err_t sst_am_prepare(void)
 {
+    uint32_t area_id;
     enum psa_sst_err_t err;
     /* FIXME: outcome of this function should determine
      * state machine of asset manager. If this
      * step fails other APIs shouldn't entertain
      * any user calls. Not a major issue for now
-     * as policy db check is a dummy function, and
-     * sst core maintains it's own state machine.
+     * as a policy db check failure leaves the sst
+     * core unprepared, and sst core maintains it's
+     * own state machine.
      */
 
     /* Validate policy database */
@@ -223,20 +281,33 @@ enum psa_sst_err_t sst_am_prepare(void)
         return PSA_SST_ERR_SYSTEM_ERROR;
     }
 
-    err = sst_system_prepare();
+    for (area_id = 0; area_id < SST_NBR_OF_AREAS; area_id++) {
+        err = sst_system_prepare(area_id);
 #ifdef SST_RAM_FS
-    /* in case of RAM based system there wouldn't be
-     * any content in the boot time. Call the wipe API
-     * to create a storage structure.
-     */
+        /* in case of RAM based system there wouldn't be
+         * any content in the boot time. Call the wipe API
+         * to create a storage structure.
+         */
+        if (err != PSA_SST_ERR_SUCCESS) {
+            sst_system_wipe_all(area_id);
+            /* attempt to initialise again */
+            err = sst_system_prepare(area_id);
+        }
+#endif /* SST_RAM_FS */
+        if (err != PSA_SST_ERR_SUCCESS) {
+            return err;
+        }
+    }
+
+#ifdef SST_KV
+    /* Load the key/value directory, once its storage area is prepared */
+    err = sst_kv_prepare();
     if (err != PSA_SST_ERR_SUCCESS) {
-        sst_system_wipe_all();
-        /* attempt to initialise again */
-        err = sst_system_prepare();
+        return err;
     }
-#endif /* SST_RAM_FS */
+#endif
 
-    return err;
+    return PSA_SST_ERR_SUCCESS;
 }
 
 /**
@@ -295,7 +366,8 @@ enum psa_sst_err_t sst_am_get_info(uint32_t app_id, uint32_t asset_uuid,
         return PSA_SST_ERR_ASSET_NOT_FOUND;
     }
 
-    err = sst_object_get_info(asset_uuid, s_token, &tmp_info);
+    err = sst_object_get_info(db_entry->area_id, asset_uuid, s_token,
+                              &tmp_info);
     if (err == PSA_SST_ERR_SUCCESS) {
         /* Use tmp_info to not leak information in case the previous function
          * returns and error. It avoids to leak information in case of error.
@@ -330,7 +402,8 @@ enum psa_sst_err_t sst_am_get_attributes(uint32_t app_id, uint32_t asset_uuid,
         return PSA_SST_ERR_ASSET_NOT_FOUND;
     }
 
-    err = sst_object_get_attributes(asset_uuid, s_token, &tmp_attrs);
+    err = sst_object_get_attributes(db_entry->area_id, asset_uuid, s_token,
+                                    &tmp_attrs);
     if (err == PSA_SST_ERR_SUCCESS) {
         /* Use tmp_attrs to not leak information incase the previous function
          * returns and error. It avoids to leak information in case of error.
@@ -375,15 +448,28 @@ enum psa_sst_err_t sst_am_set_attributes(uint32_t app_id, uint32_t asset_uuid,
     /* FIXME: Check which bit attributes have been changed and check if those
      *        can be modified or not.
      */
-    err = sst_object_set_attributes(asset_uuid, s_token, attrs);
+    err = sst_object_set_attributes(db_entry->area_id, asset_uuid, s_token,
+                                    attrs);
 
     return err;
 }
 
-enum psa_sst_err_t sst_am_create(uint32_t app_id, uint32_t asset_uuid,
-                                 const struct tfm_sst_token_t *s_token)
+/**
+ * \brief Creates an asset
+ *
+ * \param[in] app_id      Application ID of the caller
+ * \param[in] asset_uuid  Asset's unique identifier
+ * \param[in] s_token     Pointer to the asset's token \ref tfm_sst_token_t
+ * \param[in] batch       1 if the area of the asset is locked by
+ *                        sst_system_batch_lock, 0 otherwise
+ *
+ * \return Returns value specified in \ref psa_sst_err_t
+ */
+static enum psa_sst_err_t sst_am_create_obj(uint32_t app_id,
+                                         uint32_t asset_uuid,
+                                         const struct tfm_sst_token_t *s_token,
+                                         uint32_t batch)
 {
-    enum psa_sst_err_t err;
     struct sst_asset_policy_t *db_entry;
 
     db_entry = sst_am_get_db_entry(app_id, asset_uuid, SST_PERM_WRITE);
@@ -391,10 +477,19 @@ enum psa_sst_err_t sst_am_create(uint32_t app_id, uint32_t asset_uuid,
         return PSA_SST_ERR_ASSET_NOT_FOUND;
     }
 
-    err = sst_object_create(asset_uuid, s_token, db_entry->type,
-                            db_entry->max_size);
+    if (batch) {
+        return sst_object_batch_create(db_entry->area_id, asset_uuid, s_token,
+                                       db_entry->type, db_entry->max_size);
+    }
+
+    return sst_object_create(db_entry->area_id, asset_uuid, s_token,
+                             db_entry->type, db_entry->max_size);
+}
 
-    return err;
+enum psa_sst_err_t sst_am_create(uint32_t app_id, uint32_t asset_uuid,
+                                 const struct tfm_sst_token_t *s_token)
+{
+    return sst_am_create_obj(app_id, asset_uuid, s_token, 0);
 }
 
 static const unsigned char simple_private_der[] = {
@@ -449,12 +544,24 @@ enum psa_sst_err_t sst_jwt_sign(uint32_t app_id, uint32_t asset_uuid,
 
 	return err;
 }
-enum psa_sst_err_t sst_am_read(uint32_t app_id, uint32_t asset_uuid,
-                               const struct tfm_sst_token_t *s_token,
-                               struct tfm_sst_buf_t *data)
+/**
+ * \brief Reads an asset into a validated buffer
+ *
+ * \param[in] app_id      Application ID of the caller
+ * \param[in] asset_uuid  Asset's unique identifier
+ * \param[in] s_token     Pointer to the asset's token \ref tfm_sst_token_t
+ * \param[in] local_data  Pointer to the local copy of the iovec, whose data
+ *                        buffer has been validated
+ * \param[in] batch       1 if the area of the asset is locked by
+ *                        sst_system_batch_lock, 0 otherwise
+ *
+ * \return Returns value specified in \ref psa_sst_err_t
+ */
+static enum psa_sst_err_t sst_am_read_buf(uint32_t app_id, uint32_t asset_uuid,
+                                       const struct tfm_sst_token_t *s_token,
+                                       const struct tfm_sst_buf_t *local_data,
+                                       uint32_t batch)
 {
-    struct tfm_sst_buf_t local_data;
-    enum psa_sst_err_t err;
     struct sst_asset_policy_t *db_entry;
 
     /* Check application ID permissions */
@@ -463,23 +570,91 @@ enum psa_sst_err_t sst_am_read(uint32_t app_id, uint32_t asset_uuid,
         return PSA_SST_ERR_ASSET_NOT_FOUND;
     }
 
-    /* Make a local copy of the iovec data structure */
-    err = validate_copy_validate_iovec(data, &local_data,
-                                       app_id, TFM_MEMORY_ACCESS_RW);
-    if (err != PSA_SST_ERR_SUCCESS) {
+#ifndef SST_ENABLE_PARTIAL_ASSET_RW
+    if (local_data->offset != 0) {
+        return PSA_SST_ERR_PARAM_ERROR;
+    }
+#endif
+
+    if (batch) {
+        return sst_object_batch_read(db_entry->area_id, asset_uuid, s_token,
+                                     local_data->data, local_data->offset,
+                                     local_data->size);
+    }
+
+    return sst_object_read(db_entry->area_id, asset_uuid, s_token,
+                           local_data->data, local_data->offset,
+                           local_data->size);
+}
+
+/**
+ * \brief Writes an asset from a validated buffer
+ *
+ * \param[in] app_id      Application ID of the caller
+ * \param[in] asset_uuid  Asset's unique identifier
+ * \param[in] s_token     Pointer to the asset's token \ref tfm_sst_token_t
+ * \param[in] local_data  Pointer to the local copy of the iovec, whose data
+ *                        buffer has been validated
+ * \param[in] batch       1 if the area of the asset is locked by
+ *                        sst_system_batch_lock, 0 otherwise
+ *
+ * \return Returns value specified in \ref psa_sst_err_t
+ */
+static enum psa_sst_err_t sst_am_write_buf(uint32_t app_id,
+                                        uint32_t asset_uuid,
+                                        const struct tfm_sst_token_t *s_token,
+                                        const struct tfm_sst_buf_t *local_data,
+                                        uint32_t batch)
+{
+    enum psa_sst_err_t err;
+    struct sst_asset_policy_t *db_entry;
+
+    /* Check application ID permissions */
+    db_entry = sst_am_get_db_entry(app_id, asset_uuid, SST_PERM_WRITE);
+    if (db_entry == NULL) {
         return PSA_SST_ERR_ASSET_NOT_FOUND;
     }
 
+    /* Boundary check the incoming request */
+    err = sst_utils_check_contained_in(0, db_entry->max_size,
+                                       local_data->offset, local_data->size);
+
+    if (err != PSA_SST_ERR_SUCCESS) {
+        return err;
+    }
+
 #ifndef SST_ENABLE_PARTIAL_ASSET_RW
-    if (data->offset != 0) {
+    if (local_data->offset != 0) {
         return PSA_SST_ERR_PARAM_ERROR;
     }
 #endif
 
-    err = sst_object_read(asset_uuid, s_token, local_data.data,
-                          local_data.offset, local_data.size);
+    if (batch) {
+        return sst_object_batch_write(db_entry->area_id, asset_uuid, s_token,
+                                      local_data->data, local_data->offset,
+                                      local_data->size);
+    }
+
+    return sst_object_write(db_entry->area_id, asset_uuid, s_token,
+                            local_data->data, local_data->offset,
+                            local_data->size);
+}
 
-    return err;
+enum psa_sst_err_t sst_am_read(uint32_t app_id, uint32_t asset_uuid,
+                               const struct tfm_sst_token_t *s_token,
+                               struct tfm_sst_buf_t *data)
+{
+    struct tfm_sst_buf_t local_data;
+    enum psa_sst_err_t err;
+
+    /* Make a local copy of the iovec data structure */
+    err = validate_copy_validate_iovec(data, &local_data,
+                                       app_id, TFM_MEMORY_ACCESS_RW);
+    if (err != PSA_SST_ERR_SUCCESS) {
+        return PSA_SST_ERR_ASSET_NOT_FOUND;
+    }
+
+    return sst_am_read_buf(app_id, asset_uuid, s_token, &local_data, 0);
 }
 
 enum psa_sst_err_t sst_am_write(uint32_t app_id, uint32_t asset_uuid,
@@ -488,53 +663,718 @@ enum psa_sst_err_t sst_am_write(uint32_t app_id, uint32_t asset_uuid,
 {
     struct tfm_sst_buf_t local_data;
     enum psa_sst_err_t err;
+
+    /* Make a local copy of the iovec data structure */
+    err = validate_copy_validate_iovec(data, &local_data,
+                                       app_id, TFM_MEMORY_ACCESS_RO);
+    if (err != PSA_SST_ERR_SUCCESS) {
+        return PSA_SST_ERR_ASSET_NOT_FOUND;
+    }
+
+    return sst_am_write_buf(app_id, asset_uuid, s_token, &local_data, 0);
+}
+
+/**
+ * \brief Reads or writes a batch of assets
+ *
+ * \param[in]     app_id   Application ID of the caller
+ * \param[in]     ios      Pointer to the descriptors
+ *                         \ref psa_sst_asset_io_t
+ * \param[in/out] nbr_ios  Pointer to the number of descriptors. It is set to
+ *                         the number of descriptors processed successfully.
+ * \param[in]     access   TFM_MEMORY_ACCESS_RW to read the assets, or
+ *                         TFM_MEMORY_ACCESS_RO to write them
+ *
+ * \return Returns value specified in \ref psa_sst_err_t
+ */
+static enum psa_sst_err_t sst_am_io_multi(uint32_t app_id,
+                                          const struct psa_sst_asset_io_t *ios,
+                                          uint32_t *nbr_ios,
+                                          uint32_t access)
+{
+    struct psa_sst_asset_io_t local_io;
+    struct tfm_sst_token_t s_token;
+    struct tfm_sst_buf_t local_data;
+    struct sst_asset_policy_t *db_entry;
+    uint32_t area_mask = 0;
+    uint8_t perm;
+    uint32_t count;
+    uint32_t i;
+    enum psa_sst_err_t err;
+
+    err = sst_utils_memory_bound_check(nbr_ios, sizeof(uint32_t), app_id,
+                                       TFM_MEMORY_ACCESS_RW);
+    if (err != PSA_SST_ERR_SUCCESS) {
+        return PSA_SST_ERR_PARAM_ERROR;
+    }
+
+    sst_utils_memcpy(&count, nbr_ios, sizeof(uint32_t));
+
+    if ((count == 0) || (count > (UINT32_MAX / PSA_SST_ASSET_IO_SIZE))) {
+        return PSA_SST_ERR_PARAM_ERROR;
+    }
+
+    /* The descriptors are validated once, for the whole batch */
+    err = sst_utils_memory_bound_check((void *)ios,
+                                       count * PSA_SST_ASSET_IO_SIZE,
+                                       app_id, TFM_MEMORY_ACCESS_RO);
+    if (err != PSA_SST_ERR_SUCCESS) {
+        return PSA_SST_ERR_PARAM_ERROR;
+    }
+
+    /* Collects the storage areas of the assets of the batch. A descriptor
+     * without permission is skipped here, and fails when it is processed.
+     */
+    perm = (access == TFM_MEMORY_ACCESS_RW) ? SST_PERM_READ : SST_PERM_WRITE;
+    for (i = 0; i < count; i++) {
+        sst_utils_memcpy(&local_io, &ios[i], PSA_SST_ASSET_IO_SIZE);
+        db_entry = sst_am_get_db_entry(app_id, local_io.uuid, perm);
+        if (db_entry != NULL) {
+            area_mask |= SST_SYSTEM_AREA_MASK(db_entry->area_id);
+        }
+    }
+
+    /* The locks of these areas are held for the whole batch, so the batch
+     * is not interleaved with the other requests to its assets. A
+     * descriptor which has changed since and refers to another area fails.
+     * The batch stops at the first descriptor which fails, and the assets
+     * processed before it are not restored.
+     */
+    sst_system_batch_lock(area_mask);
+
+    for (i = 0; i < count; i++) {
+        /* Make a local copy of the descriptor */
+        sst_utils_memcpy(&local_io, &ios[i], PSA_SST_ASSET_IO_SIZE);
+
+        s_token.token = local_io.token;
+        s_token.token_size = local_io.token_size;
+
+        local_data.data = local_io.data;
+        local_data.size = local_io.size;
+        local_data.offset = local_io.offset;
+
+        err = sst_utils_memory_bound_check(local_data.data, local_data.size,
+                                           app_id, access);
+        if (err != PSA_SST_ERR_SUCCESS) {
+            err = PSA_SST_ERR_ASSET_NOT_FOUND;
+            break;
+        }
+
+        if (access == TFM_MEMORY_ACCESS_RW) {
+            err = sst_am_read_buf(app_id, local_io.uuid, &s_token,
+                                  &local_data, 1);
+        } else {
+            err = sst_am_write_buf(app_id, local_io.uuid, &s_token,
+                                   &local_data, 1);
+        }
+
+        if (err != PSA_SST_ERR_SUCCESS) {
+            break;
+        }
+    }
+
+    sst_system_batch_unlock(area_mask);
+
+    sst_utils_memcpy(nbr_ios, &i, sizeof(uint32_t));
+
+    return err;
+}
+
+enum psa_sst_err_t sst_am_read_multi(uint32_t app_id,
+                                     const struct psa_sst_asset_io_t *ios,
+                                     uint32_t *nbr_ios)
+{
+    return sst_am_io_multi(app_id, ios, nbr_ios, TFM_MEMORY_ACCESS_RW);
+}
+
+enum psa_sst_err_t sst_am_write_multi(uint32_t app_id,
+                                      const struct psa_sst_asset_io_t *ios,
+                                      uint32_t *nbr_ios)
+{
+    return sst_am_io_multi(app_id, ios, nbr_ios, TFM_MEMORY_ACCESS_RO);
+}
+
+/**
+ * \brief Deletes an asset
+ *
+ * \param[in] app_id      Application ID of the caller
+ * \param[in] asset_uuid  Asset's unique identifier
+ * \param[in] s_token     Pointer to the asset's token \ref tfm_sst_token_t
+ * \param[in] batch       1 if the area of the asset is locked by
+ *                        sst_system_batch_lock, 0 otherwise
+ *
+ * \return Returns value specified in \ref psa_sst_err_t
+ */
+static enum psa_sst_err_t sst_am_delete_obj(uint32_t app_id,
+                                         uint32_t asset_uuid,
+                                         const struct tfm_sst_token_t *s_token,
+                                         uint32_t batch)
+{
     struct sst_asset_policy_t *db_entry;
 
-    /* Check application ID permissions */
     db_entry = sst_am_get_db_entry(app_id, asset_uuid, SST_PERM_WRITE);
     if (db_entry == NULL) {
         return PSA_SST_ERR_ASSET_NOT_FOUND;
     }
 
-    /* Make a local copy of the iovec data structure */
-    err = validate_copy_validate_iovec(data, &local_data,
-                                       app_id, TFM_MEMORY_ACCESS_RO);
+    if (batch) {
+        return sst_object_batch_delete(db_entry->area_id, asset_uuid, s_token);
+    }
+
+    return sst_object_delete(db_entry->area_id, asset_uuid, s_token);
+}
+
+enum psa_sst_err_t sst_am_delete(uint32_t app_id, uint32_t asset_uuid,
+                                 const struct tfm_sst_token_t *s_token)
+{
+    return sst_am_delete_obj(app_id, asset_uuid, s_token, 0);
+}
+
+enum psa_sst_err_t sst_am_get_wear_info(uint32_t app_id,
+                                        struct psa_sst_wear_info_t *info)
+{
+    enum psa_sst_err_t bound_check;
+    struct psa_sst_wear_info_t area_info;
+    struct psa_sst_wear_info_t tmp_info;
+    uint32_t area_id;
+    enum psa_sst_err_t err;
+
+    bound_check = sst_utils_memory_bound_check(info, PSA_SST_WEAR_INFO_SIZE,
+                                               app_id, TFM_MEMORY_ACCESS_RW);
+    if (bound_check != PSA_SST_ERR_SUCCESS) {
+        return PSA_SST_ERR_PARAM_ERROR;
+    }
+
+    /* The wear information covers the blocks of all the storage areas */
+    tmp_info.nbr_blocks = 0;
+    tmp_info.min_erase_count = UINT32_MAX;
+    tmp_info.max_erase_count = 0;
+
+    for (area_id = 0; area_id < SST_NBR_OF_AREAS; area_id++) {
+        err = sst_system_get_wear_info(area_id, &area_info);
+        if (err != PSA_SST_ERR_SUCCESS) {
+            return err;
+        }
+
+        tmp_info.nbr_blocks += area_info.nbr_blocks;
+        if (area_info.min_erase_count < tmp_info.min_erase_count) {
+            tmp_info.min_erase_count = area_info.min_erase_count;
+        }
+        if (area_info.max_erase_count > tmp_info.max_erase_count) {
+            tmp_info.max_erase_count = area_info.max_erase_count;
+        }
+    }
+
+    sst_utils_memcpy(info, &tmp_info, PSA_SST_WEAR_INFO_SIZE);
+
+    return PSA_SST_ERR_SUCCESS;
+}
+
+enum psa_sst_err_t sst_am_list_assets(uint32_t app_id, uint32_t *cursor,
+                                    struct psa_sst_asset_list_entry_t *entries,
+                                    uint32_t *nbr_entries)
+{
+    uint8_t all_perms = SST_PERM_REFERENCE | SST_PERM_READ | SST_PERM_WRITE;
+    struct sst_asset_policy_t *db_entry;
+    struct psa_sst_asset_list_entry_t entry;
+    uint32_t local_cursor;
+    uint32_t max_entries;
+    uint32_t area_id;
+    uint32_t index;
+    uint32_t count = 0;
+    enum psa_sst_err_t err;
+
+    /* The cursor and the number of entries are written back */
+    err = sst_utils_memory_bound_check(cursor, sizeof(uint32_t), app_id,
+                                       TFM_MEMORY_ACCESS_RW);
+    if (err == PSA_SST_ERR_SUCCESS) {
+        err = sst_utils_memory_bound_check(nbr_entries, sizeof(uint32_t),
+                                           app_id, TFM_MEMORY_ACCESS_RW);
+    }
     if (err != PSA_SST_ERR_SUCCESS) {
+        return PSA_SST_ERR_PARAM_ERROR;
+    }
+
+    sst_utils_memcpy(&local_cursor, cursor, sizeof(uint32_t));
+    sst_utils_memcpy(&max_entries, nbr_entries, sizeof(uint32_t));
+
+    if ((max_entries == 0) ||
+        (max_entries > (UINT32_MAX / PSA_SST_ASSET_LIST_ENTRY_SIZE))) {
+        return PSA_SST_ERR_PARAM_ERROR;
+    }
+
+    err = sst_utils_memory_bound_check(entries,
+                                 max_entries * PSA_SST_ASSET_LIST_ENTRY_SIZE,
+                                 app_id, TFM_MEMORY_ACCESS_RW);
+    if (err != PSA_SST_ERR_SUCCESS) {
+        return PSA_SST_ERR_PARAM_ERROR;
+    }
+
+    area_id = SST_AM_LIST_CURSOR_AREA(local_cursor);
+    index = SST_AM_LIST_CURSOR_INDEX(local_cursor);
+
+    /* The objects are listed straight from the object metadata of each
+     * storage area. The objects which are not in the policy database, like
+     * the key/value store's objects, or which the application can not
+     * access, are skipped.
+     */
+    while ((area_id < SST_NBR_OF_AREAS) && (count < max_entries)) {
+        err = sst_object_get_next(area_id, &index, &entry);
+        if (err == PSA_SST_ERR_ASSET_NOT_FOUND) {
+            area_id++;
+            index = 0;
+            continue;
+        }
+
+        if (err != PSA_SST_ERR_SUCCESS) {
+            return err;
+        }
+
+        db_entry = sst_am_get_db_entry(app_id, entry.uuid, all_perms);
+        if ((db_entry == NULL) || (db_entry->area_id != area_id)) {
+            continue;
+        }
+
+        sst_utils_memcpy(&entries[count], &entry,
+                         PSA_SST_ASSET_LIST_ENTRY_SIZE);
+        count++;
+    }
+
+    if (count == 0) {
         return PSA_SST_ERR_ASSET_NOT_FOUND;
     }
 
-    /* Boundary check the incoming request */
-    err = sst_utils_check_contained_in(0, db_entry->max_size,
-                                       local_data.offset, local_data.size);
+    local_cursor = SST_AM_LIST_CURSOR(area_id, index);
+    sst_utils_memcpy(cursor, &local_cursor, sizeof(uint32_t));
+    sst_utils_memcpy(nbr_entries, &count, sizeof(uint32_t));
+
+    return PSA_SST_ERR_SUCCESS;
+}
+
+/**
+ * \brief Checks that the caller is a secure entity calling on its own behalf.
+ *
+ * \param[in] app_id  Application ID
+ *
+ * \return Returns PSA_SST_ERR_SUCCESS if the caller is allowed, or
+ *         PSA_SST_ERR_PARAM_ERROR otherwise
+ */
+static enum psa_sst_err_t sst_am_check_s_caller(uint32_t app_id)
+{
+    if ((app_id != S_APP_ID) ||
+        (sst_utils_validate_secure_caller() != PSA_SST_ERR_SUCCESS)) {
+        return PSA_SST_ERR_PARAM_ERROR;
+    }
+
+    return PSA_SST_ERR_SUCCESS;
+}
+
+enum psa_sst_err_t sst_am_get_flash_stats(uint32_t app_id,
+                                          struct tfm_sst_flash_stats_t *stats)
+{
+    enum psa_sst_err_t bound_check;
+    struct tfm_sst_flash_stats_t tmp_stats;
+    enum psa_sst_err_t err;
 
+    err = sst_am_check_s_caller(app_id);
     if (err != PSA_SST_ERR_SUCCESS) {
         return err;
     }
 
-#ifndef SST_ENABLE_PARTIAL_ASSET_RW
-    if (data->offset != 0) {
+    bound_check = sst_utils_memory_bound_check(stats,
+                                           sizeof(struct tfm_sst_flash_stats_t),
+                                           app_id, TFM_MEMORY_ACCESS_RW);
+    if (bound_check != PSA_SST_ERR_SUCCESS) {
         return PSA_SST_ERR_PARAM_ERROR;
     }
-#endif
 
-    err = sst_object_write(asset_uuid, s_token, local_data.data,
-                           local_data.offset, local_data.size);
+    sst_system_get_flash_stats(&tmp_stats);
+    sst_utils_memcpy(stats, &tmp_stats, sizeof(struct tfm_sst_flash_stats_t));
 
-    return err;
+    return PSA_SST_ERR_SUCCESS;
 }
 
-enum psa_sst_err_t sst_am_delete(uint32_t app_id, uint32_t asset_uuid,
-                                 const struct tfm_sst_token_t *s_token)
+enum psa_sst_err_t sst_am_get_flash_trace(uint32_t app_id,
+                                         struct tfm_sst_flash_trace_t *entries,
+                                         uint32_t nbr_entries)
 {
+    enum psa_sst_err_t bound_check;
     enum psa_sst_err_t err;
+
+    err = sst_am_check_s_caller(app_id);
+    if (err != PSA_SST_ERR_SUCCESS) {
+        return err;
+    }
+
+    if ((nbr_entries == 0) ||
+        (nbr_entries > (UINT32_MAX / sizeof(struct tfm_sst_flash_trace_t)))) {
+        return PSA_SST_ERR_PARAM_ERROR;
+    }
+
+    bound_check = sst_utils_memory_bound_check(entries,
+                       nbr_entries * sizeof(struct tfm_sst_flash_trace_t),
+                       app_id, TFM_MEMORY_ACCESS_RW);
+    if (bound_check != PSA_SST_ERR_SUCCESS) {
+        return PSA_SST_ERR_PARAM_ERROR;
+    }
+
+    /* The caller is secure, so the entries are copied straight to its
+     * buffer.
+     */
+    return sst_system_get_flash_trace(entries, nbr_entries);
+}
+
+enum psa_sst_err_t sst_am_maintenance(uint32_t app_id)
+{
+    uint32_t area_id;
+    enum psa_sst_err_t err;
+
+    /* The maintenance does not access any asset, so it is allowed for any
+     * application.
+     */
+    (void)app_id;
+
+    for (area_id = 0; area_id < SST_NBR_OF_AREAS; area_id++) {
+        err = sst_system_maintenance(area_id);
+        if (err != PSA_SST_ERR_SUCCESS) {
+            return err;
+        }
+    }
+
+    return PSA_SST_ERR_SUCCESS;
+}
+
+enum psa_sst_err_t sst_am_apply_ops(uint32_t app_id,
+                                    const struct tfm_sst_token_t *s_token,
+                                    const struct psa_sst_asset_op_t *ops,
+                                    uint32_t nbr_ops)
+{
+    struct psa_sst_asset_op_t local_op;
+    struct tfm_sst_buf_t local_data;
     struct sst_asset_policy_t *db_entry;
+    uint32_t area_id;
+    uint32_t i;
+    enum psa_sst_err_t err;
 
-    db_entry = sst_am_get_db_entry(app_id, asset_uuid, SST_PERM_WRITE);
+    if ((nbr_ops == 0) || (nbr_ops > (UINT32_MAX / PSA_SST_ASSET_OP_SIZE))) {
+        return PSA_SST_ERR_PARAM_ERROR;
+    }
+
+    /* The descriptors are validated once, for the whole list */
+    err = sst_utils_memory_bound_check((void *)ops,
+                                       nbr_ops * PSA_SST_ASSET_OP_SIZE,
+                                       app_id, TFM_MEMORY_ACCESS_RO);
+    if (err != PSA_SST_ERR_SUCCESS) {
+        return PSA_SST_ERR_PARAM_ERROR;
+    }
+
+    /* A transaction only spans a single storage area, so all the assets
+     * must be stored in the area of the first one
+     */
+    sst_utils_memcpy(&local_op, &ops[0], PSA_SST_ASSET_OP_SIZE);
+    db_entry = sst_am_lookup_db_entry(local_op.uuid);
     if (db_entry == NULL) {
         return PSA_SST_ERR_ASSET_NOT_FOUND;
     }
+    area_id = db_entry->area_id;
+
+    /* The area lock is held from the start of the transaction until it is
+     * committed or aborted, so the transaction is not interleaved with the
+     * other requests to the area
+     */
+    sst_system_batch_lock(SST_SYSTEM_AREA_MASK(area_id));
+
+    err = sst_system_txn_begin(area_id);
+    if (err != PSA_SST_ERR_SUCCESS) {
+        sst_system_batch_unlock(SST_SYSTEM_AREA_MASK(area_id));
+        return err;
+    }
+
+    for (i = 0; i < nbr_ops; i++) {
+        /* Make a local copy of the descriptor */
+        sst_utils_memcpy(&local_op, &ops[i], PSA_SST_ASSET_OP_SIZE);
+
+        db_entry = sst_am_lookup_db_entry(local_op.uuid);
+        if (db_entry == NULL) {
+            err = PSA_SST_ERR_ASSET_NOT_FOUND;
+            break;
+        }
+
+        if (db_entry->area_id != area_id) {
+            err = PSA_SST_ERR_PARAM_ERROR;
+            break;
+        }
+
+        switch (local_op.type) {
+        case PSA_SST_ASSET_OP_CREATE:
+            err = sst_am_create_obj(app_id, local_op.uuid, s_token, 1);
+            break;
+        case PSA_SST_ASSET_OP_WRITE:
+            err = sst_utils_memory_bound_check((void *)local_op.data,
+                                               local_op.size, app_id,
+                                               TFM_MEMORY_ACCESS_RO);
+            if (err != PSA_SST_ERR_SUCCESS) {
+                err = PSA_SST_ERR_ASSET_NOT_FOUND;
+                break;
+            }
+
+            local_data.data = (uint8_t *)local_op.data;
+            local_data.size = local_op.size;
+            local_data.offset = local_op.offset;
+
+            err = sst_am_write_buf(app_id, local_op.uuid, s_token,
+                                   &local_data, 1);
+            break;
+        case PSA_SST_ASSET_OP_DELETE:
+            err = sst_am_delete_obj(app_id, local_op.uuid, s_token, 1);
+            break;
+        default:
+            err = PSA_SST_ERR_PARAM_ERROR;
+            break;
+        }
+
+        if (err != PSA_SST_ERR_SUCCESS) {
+            break;
+        }
+    }
+
+    if (err != PSA_SST_ERR_SUCCESS) {
+        /* Discard the operations already performed */
+        (void)sst_system_txn_abort(area_id);
+    } else {
+        err = sst_system_txn_commit(area_id);
+    }
 
-    err = sst_object_delete(asset_uuid, s_token);
+    sst_system_batch_unlock(SST_SYSTEM_AREA_MASK(area_id));
 
     return err;
 }
+
+#ifdef SST_KV
+/**
+ * \brief Checks that an application can access its keys of the key/value
+ *        store.
+ *
+ * \param[in] app_id        Application ID
+ * \param[in] request_type  Type of requested access
+ *
+ * \return Returns PSA_SST_ERR_SUCCESS if the access is allowed, or
+ *         PSA_SST_ERR_ASSET_NOT_FOUND otherwise
+ */
+static enum psa_sst_err_t sst_am_kv_check_access(uint32_t app_id,
+                                                 uint16_t request_type)
+{
+    /* The keys are owned by the application ID, so the policy database is
+     * not used. A secure caller on behalf of another application can only
+     * read its keys, as for the assets referenced by that application.
+     */
+    if (sst_am_check_s_ns_policy(app_id, request_type) == SST_PERM_FORBIDDEN) {
+        return PSA_SST_ERR_ASSET_NOT_FOUND;
+    }
+
+    return PSA_SST_ERR_SUCCESS;
+}
+
+/**
+ * \brief Validates the key vector of a key/value request, and makes a local
+ *        copy of the key.
+ *
+ * \param[in]  app_id   Application ID
+ * \param[in]  key      Pointer to the key vector \ref tfm_sst_buf_t
+ * \param[out] key_buf  Buffer to store the key
+ * \param[out] key_len  Pointer to store the key length
+ *
+ * \return Returns PSA_SST_ERR_SUCCESS if the key is valid, or
+ *         PSA_SST_ERR_PARAM_ERROR otherwise
+ */
+static enum psa_sst_err_t sst_am_kv_copy_key(uint32_t app_id,
+                                             const struct tfm_sst_buf_t *key,
+                                             uint8_t *key_buf,
+                                             uint32_t *key_len)
+{
+    struct tfm_sst_buf_t local_key;
+    enum psa_sst_err_t err;
+
+    err = validate_copy_validate_iovec(key, &local_key, app_id,
+                                       TFM_MEMORY_ACCESS_RO);
+    if ((err != PSA_SST_ERR_SUCCESS) || (local_key.size == 0) ||
+        (local_key.size > SST_KV_MAX_KEY_LEN)) {
+        return PSA_SST_ERR_PARAM_ERROR;
+    }
+
+    /* The key is hashed and compared, so it must not change meanwhile */
+    sst_utils_memcpy(key_buf, local_key.data, local_key.size);
+    *key_len = local_key.size;
+
+    return PSA_SST_ERR_SUCCESS;
+}
+
+enum psa_sst_err_t sst_am_kv_set(uint32_t app_id,
+                                 const struct tfm_sst_buf_t *key,
+                                 const struct tfm_sst_buf_t *data)
+{
+    struct tfm_sst_buf_t local_data;
+    uint8_t key_buf[SST_KV_MAX_KEY_LEN];
+    uint32_t key_len;
+    enum psa_sst_err_t err;
+
+    err = sst_am_kv_check_access(app_id, SST_PERM_WRITE);
+    if (err != PSA_SST_ERR_SUCCESS) {
+        return err;
+    }
+
+    err = sst_am_kv_copy_key(app_id, key, key_buf, &key_len);
+    if (err != PSA_SST_ERR_SUCCESS) {
+        return err;
+    }
+
+    err = validate_copy_validate_iovec(data, &local_data, app_id,
+                                       TFM_MEMORY_ACCESS_RO);
+    if (err != PSA_SST_ERR_SUCCESS) {
+        return PSA_SST_ERR_PARAM_ERROR;
+    }
+
+    return sst_kv_set(app_id, key_buf, key_len, local_data.data,
+                      local_data.size);
+}
+
+enum psa_sst_err_t sst_am_kv_get(uint32_t app_id,
+                                 const struct tfm_sst_buf_t *key,
+                                 struct tfm_sst_buf_t *data)
+{
+    struct tfm_sst_buf_t local_data;
+    uint8_t key_buf[SST_KV_MAX_KEY_LEN];
+    uint32_t key_len;
+    enum psa_sst_err_t err;
+
+    err = sst_am_kv_check_access(app_id, SST_PERM_READ);
+    if (err != PSA_SST_ERR_SUCCESS) {
+        return err;
+    }
+
+    err = sst_am_kv_copy_key(app_id, key, key_buf, &key_len);
+    if (err != PSA_SST_ERR_SUCCESS) {
+        return err;
+    }
+
+    /* The value size is written back to the data vector */
+    err = sst_utils_memory_bound_check(data, sizeof(struct tfm_sst_buf_t),
+                                       app_id, TFM_MEMORY_ACCESS_RW);
+    if (err == PSA_SST_ERR_SUCCESS) {
+        err = validate_copy_validate_iovec(data, &local_data, app_id,
+                                           TFM_MEMORY_ACCESS_RW);
+    }
+    if (err != PSA_SST_ERR_SUCCESS) {
+        return PSA_SST_ERR_PARAM_ERROR;
+    }
+
+    err = sst_kv_get(app_id, key_buf, key_len, local_data.data,
+                     &local_data.size);
+    if (err == PSA_SST_ERR_SUCCESS) {
+        sst_utils_memcpy(&data->size, &local_data.size, sizeof(uint32_t));
+    }
+
+    return err;
+}
+
+enum psa_sst_err_t sst_am_kv_delete(uint32_t app_id,
+                                    const struct tfm_sst_buf_t *key)
+{
+    uint8_t key_buf[SST_KV_MAX_KEY_LEN];
+    uint32_t key_len;
+    enum psa_sst_err_t err;
+
+    err = sst_am_kv_check_access(app_id, SST_PERM_WRITE);
+    if (err != PSA_SST_ERR_SUCCESS) {
+        return err;
+    }
+
+    err = sst_am_kv_copy_key(app_id, key, key_buf, &key_len);
+    if (err != PSA_SST_ERR_SUCCESS) {
+        return err;
+    }
+
+    return sst_kv_delete(app_id, key_buf, key_len);
+}
+
+enum psa_sst_err_t sst_am_kv_iterate(uint32_t app_id, uint32_t *cursor,
+                                     struct tfm_sst_buf_t *key)
+{
+    struct tfm_sst_buf_t local_key;
+    uint32_t local_cursor;
+    enum psa_sst_err_t err;
+
+    err = sst_am_kv_check_access(app_id, SST_PERM_READ);
+    if (err != PSA_SST_ERR_SUCCESS) {
+        return err;
+    }
+
+    /* The cursor and the key length are written back */
+    err = sst_utils_memory_bound_check(cursor, sizeof(uint32_t), app_id,
+                                       TFM_MEMORY_ACCESS_RW);
+    if (err == PSA_SST_ERR_SUCCESS) {
+        err = sst_utils_memory_bound_check(key, sizeof(struct tfm_sst_buf_t),
+                                           app_id, TFM_MEMORY_ACCESS_RW);
+    }
+    if (err == PSA_SST_ERR_SUCCESS) {
+        err = validate_copy_validate_iovec(key, &local_key, app_id,
+                                           TFM_MEMORY_ACCESS_RW);
+    }
+    if (err != PSA_SST_ERR_SUCCESS) {
+        return PSA_SST_ERR_PARAM_ERROR;
+    }
+
+    sst_utils_memcpy(&local_cursor, cursor, sizeof(uint32_t));
+
+    err = sst_kv_iterate(app_id, &local_cursor, local_key.data,
+                         &local_key.size);
+    if (err == PSA_SST_ERR_SUCCESS) {
+        sst_utils_memcpy(cursor, &local_cursor, sizeof(uint32_t));
+        sst_utils_memcpy(&key->size, &local_key.size, sizeof(uint32_t));
+    }
+
+    return err;
+}
+#else
+enum psa_sst_err_t sst_am_kv_set(uint32_t app_id,
+                                 const struct tfm_sst_buf_t *key,
+                                 const struct tfm_sst_buf_t *data)
+{
+    /* The key/value store is not built in */
+    (void)app_id;
+    (void)key;
+    (void)data;
+
+    return PSA_SST_ERR_PARAM_ERROR;
+}
+
+enum psa_sst_err_t sst_am_kv_get(uint32_t app_id,
+                                 const struct tfm_sst_buf_t *key,
+                                 struct tfm_sst_buf_t *data)
+{
+    (void)app_id;
+    (void)key;
+    (void)data;
+
+    return PSA_SST_ERR_PARAM_ERROR;
+}
+
+enum psa_sst_err_t sst_am_kv_delete(uint32_t app_id,
+                                    const struct tfm_sst_buf_t *key)
+{
+    (void)app_id;
+    (void)key;
+
+    return PSA_SST_ERR_PARAM_ERROR;
+}
+
+enum psa_sst_err_t sst_am_kv_iterate(uint32_t app_id, uint32_t *cursor,
+                                     struct tfm_sst_buf_t *key)
+{
+    (void)app_id;
+    (void)cursor;
+    (void)key;
+
+    return PSA_SST_ERR_PARAM_ERROR;
+}
+#endif /* SST_KV */
@@ -42,6 +42,7 @@ struct sst_asset_policy_t {
     uint16_t perms_count;  /*!< Number of permissions owned by this asset */
     uint16_t max_size;     /*!< Policy maximum size fo this asset */
     uint16_t perms_modes_start_idx; /*!< First permission index */
+    uint32_t area_id;      /*!< Storage area which stores the asset */
 };
 
 /**
@@ -146,6 +147,43 @@ enum psa_sst_err_t sst_am_write(uint32_t app_id, uint32_t asset_uuid,
                                 const struct tfm_sst_token_t *s_token,
                                 const struct tfm_sst_buf_t *data);
 
+/**
+ * \brief Reads a batch of assets, in a single request.
+ *
+ * \param[in]     app_id   Application ID
+ * \param[in]     ios      Pointer to the descriptors \ref psa_sst_asset_io_t
+ *                         of the reads
+ * \param[in/out] nbr_ios  Pointer to the number of descriptors. It is set to
+ *                         the number of assets read.
+ *
+ * \note The reads are done in order, under the locks of the storage areas of
+ *       the assets, and stop at the first one which fails.
+ *
+ * \return Returns error code as specified in \ref psa_sst_err_t
+ */
+enum psa_sst_err_t sst_am_read_multi(uint32_t app_id,
+                                     const struct psa_sst_asset_io_t *ios,
+                                     uint32_t *nbr_ios);
+
+/**
+ * \brief Writes a batch of assets, in a single request.
+ *
+ * \param[in]     app_id   Application ID
+ * \param[in]     ios      Pointer to the descriptors \ref psa_sst_asset_io_t
+ *                         of the writes
+ * \param[in/out] nbr_ios  Pointer to the number of descriptors. It is set to
+ *                         the number of assets written.
+ *
+ * \note The writes are done in order, under the locks of the storage areas of
+ *       the assets, and stop at the first one which fails. The assets written
+ *       before it keep their new content.
+ *
+ * \return Returns error code as specified in \ref psa_sst_err_t
+ */
+enum psa_sst_err_t sst_am_write_multi(uint32_t app_id,
+                                      const struct psa_sst_asset_io_t *ios,
+                                      uint32_t *nbr_ios);
+
 /**
  * \brief Deletes the asset referenced by the asset UUID.
  *
@@ -158,6 +196,171 @@ enum psa_sst_err_t sst_am_write(uint32_t app_id, uint32_t asset_uuid,
 enum psa_sst_err_t sst_am_delete(uint32_t app_id, uint32_t asset_uuid,
                                  const struct tfm_sst_token_t *s_token);
 
+/**
+ * \brief Gets the wear information of the flash blocks used by the secure
+ *        storage.
+ *
+ * \param[in]  app_id  Application ID
+ * \param[out] info    Pointer to store the wear information
+ *                     \ref psa_sst_wear_info_t
+ *
+ * \return Returns error code as specified in \ref psa_sst_err_t
+ */
+enum psa_sst_err_t sst_am_get_wear_info(uint32_t app_id,
+                                        struct psa_sst_wear_info_t *info);
+
+/**
+ * \brief Gets the counters of the flash operations performed by the secure
+ *        storage since boot. It is only allowed to secure callers using the
+ *        secure application ID.
+ *
+ * \param[in]  app_id  Application ID
+ * \param[out] stats   Pointer to store the flash counters
+ *                     \ref tfm_sst_flash_stats_t
+ *
+ * \return Returns error code as specified in \ref psa_sst_err_t
+ */
+enum psa_sst_err_t sst_am_get_flash_stats(uint32_t app_id,
+                                          struct tfm_sst_flash_stats_t *stats);
+
+/**
+ * \brief Gets the most recent entries of the flash operation trace. It is
+ *        only allowed to secure callers using the secure application ID.
+ *
+ * \param[in]  app_id       Application ID
+ * \param[out] entries      Pointer to store the entries, from the oldest to
+ *                          the most recent one
+ *                          \ref tfm_sst_flash_trace_t
+ * \param[in]  nbr_entries  Number of entries to get. It must not be greater
+ *                          than the trace size and the number of entries
+ *                          recorded, as given by \ref sst_am_get_flash_stats
+ *
+ * \return Returns error code as specified in \ref psa_sst_err_t
+ */
+enum psa_sst_err_t sst_am_get_flash_trace(uint32_t app_id,
+                                         struct tfm_sst_flash_trace_t *entries,
+                                         uint32_t nbr_entries);
+
+/**
+ * \brief Lists the assets which the application can access, with their sizes.
+ *
+ * \param[in]     app_id       Application ID
+ * \param[in/out] cursor       Pointer to the listing cursor, which must be set
+ *                             to 0 to get the first assets. It is updated to
+ *                             get the next assets.
+ * \param[out]    entries      Pointer to store the entries
+ *                             \ref psa_sst_asset_list_entry_t
+ * \param[in/out] nbr_entries  Pointer to the number of entries which can be
+ *                             stored. It is set to the number of entries
+ *                             stored.
+ *
+ * \note The entries are taken from the object metadata, so the assets are
+ *       not read. An asset which is created or deleted during the listing
+ *       may be skipped.
+ *
+ * \return Returns PSA_SST_ERR_ASSET_NOT_FOUND when there is no more asset,
+ *         or another error code as specified in \ref psa_sst_err_t
+ */
+enum psa_sst_err_t sst_am_list_assets(uint32_t app_id, uint32_t *cursor,
+                                    struct psa_sst_asset_list_entry_t *entries,
+                                    uint32_t *nbr_entries);
+
+/**
+ * \brief Performs the maintenance of the secure storage. It erases the flash
+ *        blocks retired by the previous updates, so that the next updates
+ *        do not have to erase them.
+ *
+ * \param[in] app_id  Application ID
+ *
+ * \return Returns error code as specified in \ref psa_sst_err_t
+ */
+enum psa_sst_err_t sst_am_maintenance(uint32_t app_id);
+
+/**
+ * \brief Performs a list of create, write and delete operations on assets as
+ *        a single atomic update. Either all the operations are performed or
+ *        none of them.
+ *
+ * \param[in] app_id   Application ID
+ * \param[in] s_token  Pointer to the asset's token \ref tfm_sst_token_t
+ * \param[in] ops      Pointer to the list of operations
+ *                     \ref psa_sst_asset_op_t
+ * \param[in] nbr_ops  Number of operations in the list
+ *
+ * \note All the assets must be stored in the same storage area. Otherwise,
+ *       PSA_SST_ERR_PARAM_ERROR is returned and none of the operations is
+ *       performed. The storage area is locked for the whole list.
+ *
+ * \return Returns error code as specified in \ref psa_sst_err_t
+ */
+enum psa_sst_err_t sst_am_apply_ops(uint32_t app_id,
+                                    const struct tfm_sst_token_t *s_token,
+                                    const struct psa_sst_asset_op_t *ops,
+                                    uint32_t nbr_ops);
+
+/**
+ * \brief Sets the value of a key of the key/value store, creating the key if
+ *        it does not exist. Each application ID has its own keys.
+ *
+ * \param[in] app_id  Application ID
+ * \param[in] key     Pointer to the key vector \ref tfm_sst_buf_t. Its offset
+ *                    is not used.
+ * \param[in] data    Pointer to the value vector \ref tfm_sst_buf_t. Its
+ *                    offset is not used.
+ *
+ * \note It returns PSA_SST_ERR_PARAM_ERROR if the secure storage is built
+ *       without the SST_KV flag.
+ *
+ * \return Returns error code as specified in \ref psa_sst_err_t
+ */
+enum psa_sst_err_t sst_am_kv_set(uint32_t app_id,
+                                 const struct tfm_sst_buf_t *key,
+                                 const struct tfm_sst_buf_t *data);
+
+/**
+ * \brief Gets the value of a key of the key/value store.
+ *
+ * \param[in]     app_id  Application ID
+ * \param[in]     key     Pointer to the key vector \ref tfm_sst_buf_t. Its
+ *                        offset is not used.
+ * \param[in/out] data    Pointer to the value vector \ref tfm_sst_buf_t. Its
+ *                        size is set to the value size when the value is
+ *                        read. Its offset is not used.
+ *
+ * \return Returns error code as specified in \ref psa_sst_err_t
+ */
+enum psa_sst_err_t sst_am_kv_get(uint32_t app_id,
+                                 const struct tfm_sst_buf_t *key,
+                                 struct tfm_sst_buf_t *data);
+
+/**
+ * \brief Deletes a key of the key/value store.
+ *
+ * \param[in] app_id  Application ID
+ * \param[in] key     Pointer to the key vector \ref tfm_sst_buf_t. Its offset
+ *                    is not used.
+ *
+ * \return Returns error code as specified in \ref psa_sst_err_t
+ */
+enum psa_sst_err_t sst_am_kv_delete(uint32_t app_id,
+                                    const struct tfm_sst_buf_t *key);
+
+/**
+ * \brief Gets the next key of the application in the key/value store.
+ *
+ * \param[in]     app_id  Application ID
+ * \param[in/out] cursor  Pointer to the iteration cursor, which must be set
+ *                        to 0 to get the first key
+ * \param[in/out] key     Pointer to the key vector \ref tfm_sst_buf_t. Its
+ *                        size is set to the key length when the key is
+ *                        copied. Its offset is not used.
+ *
+ * \return Returns PSA_SST_ERR_ASSET_NOT_FOUND when there is no more key, or
+ *         another error code as specified in \ref psa_sst_err_t
+ */
+enum psa_sst_err_t sst_am_kv_iterate(uint32_t app_id, uint32_t *cursor,
+                                     struct tfm_sst_buf_t *key);
+
 #ifdef __cplusplus
 }
 #endif
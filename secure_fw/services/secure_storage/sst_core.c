@@ -12,55 +12,66 @@
 #include "flash/sst_flash.h"
 #include "sst_object_defs.h"
 #include "sst_utils.h"
-
-#if ((SST_TOTAL_NUM_OF_BLOCKS < 2) || (SST_TOTAL_NUM_OF_BLOCKS == 3))
-  /* The minimum number of blocks is 2. In this case, metadata and data are
-   * stored in the same physical block, and the other block is required for
-   * power failure safe operation.
-   * If at least 1 data block is available, 1 data scratch block is required for
-   * power failure safe operation. So, in this case, the minimum number of
-   * blocks is 4 (2 metadata block + 2 data blocks).
-   */
-  #error "Total number of blocks should be 2 or bigger than 3"
+#ifdef SST_KV
+#include "sst_kv.h"
 #endif
 
-/* The numbers in the defines are physical block indexes, starting from 0,
- * except for SST_NUM_DEDICATED_DBLOCKS.
+/* Number of data blocks kept as scratch blocks when dedicated data blocks are
+ * available. The scratch data blocks which have been retired by the update
+ * operations are erased by sst_core_maintenance, so that up to this number of
+ * data block compactions can be done without erasing a block.
  */
-#if (SST_TOTAL_NUM_OF_BLOCKS == 2)
-  /* Metadata and data are stored in the same physical block, and the other
-   * block is required for power failure safe operation.
-   */
-
-  /* Initial position of scratch block is the scratch metadata block */
-  #define SST_INIT_SCRATCH_DBLOCK 1
+#ifndef SST_NUM_SCRATCH_DBLOCKS
+#define SST_NUM_SCRATCH_DBLOCKS 1
+#endif
 
-  /* Metadata and data are stored in the same block */
-  #define SST_INIT_DBLOCK_START 0
+#if (SST_NUM_SCRATCH_DBLOCKS < 1)
+  #error "Number of scratch data blocks should be 1 or bigger"
+#endif
 
-  /* There are no dedicated data blocks when only two blocks are available */
-  #define SST_NUM_DEDICATED_DBLOCKS 0
+#if ((SST_MAX_NUM_OF_BLOCKS < 2) || (SST_MAX_NUM_OF_BLOCKS == 3))
+  #error "Total number of blocks should be 2 or bigger than 3"
+#endif
 
-#else
-  /* Initial position of scratch block is immediately after metadata blocks */
-  #define SST_INIT_SCRATCH_DBLOCK 2
-
-  /* One metadata block and two scratch blocks are reserved. One scratch block
-   * for metadata operations and the other for assets data operations.
-   */
-  #define SST_INIT_DBLOCK_START 3
-
-  /* Number of blocks dedicated just for data is the number of blocks available
-   * beyond the initial datablock start index.
-   */
-  #define SST_NUM_DEDICATED_DBLOCKS (SST_TOTAL_NUM_OF_BLOCKS - \
-                                     SST_INIT_DBLOCK_START)
+#if ((SST_MAX_NUM_OF_BLOCKS > 2) && \
+     (SST_MAX_NUM_OF_BLOCKS < (SST_NUM_SCRATCH_DBLOCKS + 3)))
+  #error "Total number of blocks too small for the number of scratch blocks"
 #endif
 
-/* Total number of datablocks is the number of dedicated datablocks plus
+/* The layout of each storage area is set up at run time from the area's
+ * number of blocks, as described below. The numbers are physical block
+ * indexes, starting from 0, except for the number of dedicated data blocks.
+ *
+ * The minimum number of blocks is 2. In this case, metadata and data are
+ * stored in the same physical block, and the other block is required for
+ * power failure safe operation. The initial position of the scratch block is
+ * the scratch metadata block, and there are no dedicated data blocks.
+ *
+ * If at least 1 data block is available, 1 data scratch block is required for
+ * power failure safe operation. So, in this case, the minimum number of
+ * blocks is 4 (2 metadata block + 2 data blocks). The initial position of the
+ * scratch block is immediately after the metadata blocks. One metadata block
+ * and the scratch blocks are reserved: one scratch block for metadata
+ * operations and the others for assets data operations. The number of blocks
+ * dedicated just for data is the number of blocks available beyond the
+ * initial datablock start index.
+ *
+ * The total number of datablocks is the number of dedicated datablocks plus
  * logical datablock 0 stored in the metadata block.
  */
-#define SST_NUM_ACTIVE_DBLOCKS (SST_NUM_DEDICATED_DBLOCKS + 1)
+#define SST_TWO_BLOCKS_INIT_SCRATCH_DBLOCK 1
+#define SST_INIT_SCRATCH_DBLOCK            2
+
+/* Largest number of datablocks of the storage areas, which sizes the block
+ * metadata table
+ */
+#if (SST_MAX_NUM_OF_BLOCKS == 2)
+  #define SST_MAX_ACTIVE_DBLOCKS 1
+#else
+  #define SST_MAX_ACTIVE_DBLOCKS (SST_MAX_NUM_OF_BLOCKS - \
+                                  SST_INIT_SCRATCH_DBLOCK - \
+                                  SST_NUM_SCRATCH_DBLOCKS + 1)
+#endif
 
 #define SST_LOGICAL_DBLOCK0  0
 #define SST_DEFAULT_EMPTY_BUFF_VAL 0
@@ -76,34 +87,261 @@
 #error "The supported SST_FLASH_PROGRAM_UNIT values are 1, 2 or 4 bytes"
 #endif
 
-/* SST_ALIGNED_MAX_OBJECT_SIZE aligns the SST_MAX_OBJECT_SIZE with the
- * SST_FLASH_PROGRAM_UNIT
+/* Number of extra object metadata entries. An object which does not fit in
+ * the free space of a logical block is stored as a chain of extents located in
+ * several logical blocks, and each extent takes an object metadata entry.
+ */
+#ifndef SST_NUM_EXTRA_EXTENTS
+#define SST_NUM_EXTRA_EXTENTS 4
+#endif
+
+/* Number of object metadata entries. The objects of the key/value store are
+ * accounted when it is enabled by the SST_KV flag.
  */
-#define SST_ALIGNED_MAX_OBJECT_SIZE \
-((SST_FLASH_PROGRAM_UNIT - (SST_MAX_OBJECT_SIZE % SST_FLASH_PROGRAM_UNIT)) \
-  + SST_MAX_OBJECT_SIZE)
+#ifdef SST_KV
+#define SST_NUM_OBJECT_ENTRIES \
+    (SST_NUM_ASSETS + SST_NUM_EXTRA_EXTENTS + SST_KV_NBR_OBJECTS)
+#else
+#define SST_NUM_OBJECT_ENTRIES (SST_NUM_ASSETS + SST_NUM_EXTRA_EXTENTS)
+#endif
 
 #define SST_ALL_METADATA_SIZE \
 (sizeof(struct sst_metadata_block_header) + \
-(SST_NUM_ACTIVE_DBLOCKS * sizeof(struct sst_block_metadata)) + \
-(SST_NUM_ASSETS * sizeof(struct sst_assetmeta)))
+(SST_MAX_ACTIVE_DBLOCKS * sizeof(struct sst_block_metadata)) + \
+(SST_NUM_OBJECT_ENTRIES * sizeof(struct sst_assetmeta)) + \
+(SST_MAX_NUM_OF_BLOCKS * sizeof(uint32_t)) + \
+sizeof(struct sst_compact_cursor_t))
+
+/* Number of records in the metadata journal, which is stored in the active
+ * metadata block after the metadata. Metadata updates are appended to the
+ * journal, and the metadata blocks are only swapped when the journal is full
+ * or when the data stored in the logical block 0 changes.
+ */
+#ifndef SST_JOURNAL_NUM_RECORDS
+#define SST_JOURNAL_NUM_RECORDS 32
+#endif
 
-#ifndef SST_ENCRYPTION
-/* SST data buffer is used for metadata and object data. */
-static uint8_t sst_data_buf[SST_ALIGNED_MAX_OBJECT_SIZE];
-static uint8_t *sst_buf_plain_text = sst_data_buf;
-#else
-/* SST data buffer is used for metadata authentication */
-static uint8_t sst_data_buf[SST_ALL_METADATA_SIZE];
+/* Metadata journal record types. The erased flash value is not a valid type */
+#define SST_JOURNAL_BLOCK_META   0x0001
+#define SST_JOURNAL_OBJECT_META  0x0002
+#define SST_JOURNAL_COMMIT       0x0003
+#define SST_JOURNAL_ERASE_COUNT  0x0004
+#define SST_JOURNAL_COMPACT      0x0005
+#define SST_JOURNAL_CHECKPOINT   0x0006
+
+/* Offset and size of the metadata journal in the metadata block */
+#define SST_JOURNAL_OFFSET  SST_ALL_METADATA_SIZE
+#define SST_JOURNAL_SIZE \
+(SST_JOURNAL_NUM_RECORDS * sizeof(struct sst_journal_record_t))
+
+/* Offset in the metadata block where the data of logical block 0 starts */
+#define SST_DBLOCK0_DATA_START (SST_JOURNAL_OFFSET + SST_JOURNAL_SIZE)
+
+/* The data blocks are log-structured. Each object takes a space of its
+ * maximum size in its logical block, and a new content of an object is
+ * programmed in the erased space at the end of the block, instead of copying
+ * the whole block in the scratch block. The space of the previous contents
+ * and of the deleted objects is reclaimed when the block runs out of space
+ * and is compacted in the scratch block.
+ */
+
+/* Size of the buffer used to check that a flash area is erased */
+#define SST_ERASED_CHECK_BUF_SIZE 32
+
+/* The number of erases of each physical block is counted in the metadata.
+ * When the scratch data block has been erased this number of times more than
+ * the least erased data block, the data of the least erased data block is
+ * moved into the scratch data block, so that the blocks which hold data that
+ * is rarely updated also take part in the rotation of the scratch data block.
+ */
+#ifndef SST_WEAR_LEVELLING_THRESHOLD
+#define SST_WEAR_LEVELLING_THRESHOLD 16
 #endif
 
-static struct sst_asset_system_context sst_system_ctx;
+/* The dedicated data blocks are also compacted incrementally by
+ * sst_core_maintenance, when the space taken by the previous contents and the
+ * deleted objects of a block is bigger than its free space. Each maintenance
+ * call copies up to this number of bytes, and stores the progress of the
+ * compaction in the metadata, so that the updates rarely have to compact a
+ * block. An update which changes the block being compacted, or which needs
+ * its destination block, discards the compaction.
+ */
+#ifndef SST_COMPACT_STEP_SIZE
+#define SST_COMPACT_STEP_SIZE 1024
+#endif
 
-#ifdef SST_ENCRYPTION
-/* Check at compilation time if metadata fits in sst_data_buf */
-SST_UTILS_BOUND_CHECK(METADATA_NOT_FIT_IN_DATA_BUF,
-                      SST_ALL_METADATA_SIZE, sizeof(sst_data_buf));
+/* Value of the compaction cursor's logical block when no block is being
+ * compacted. It is the erased flash value.
+ */
+#define SST_COMPACT_NO_LBLOCK 0xFFFFFFFF
 
+/* Size of the buffers used to check the progress of a compaction */
+#define SST_COMPACT_CHECK_BUF_SIZE 32
+
+/* Size of the buffer used to program the new content of an object. The
+ * content is streamed through it, so the RAM needed does not depend on the
+ * size of the objects.
+ */
+#define SST_PATCH_BUF_SIZE 64
+
+/* New content of an object extent, made of its current content patched with
+ * the data written by the update
+ */
+struct sst_obj_patch_t {
+    const uint8_t *data;  /*!< Pointer to the written data */
+    uint32_t offset;      /*!< Offset of the written data in the extent */
+    uint32_t size;        /*!< Size of the written data */
+    uint32_t keep_size;   /*!< Size of the current content, which is kept
+                           *   where it is not overwritten
+                           */
+};
+
+/* Layout of the metadata stored at the beginning of a metadata block */
+struct sst_metadata_table_t {
+    struct sst_metadata_block_header header; /*!< Metadata block header */
+    struct sst_block_metadata block_meta[SST_MAX_ACTIVE_DBLOCKS]; /*!< Logical
+                                                                   *   blocks
+                                                                   *   metadata
+                                                                   */
+    struct sst_assetmeta object_meta[SST_NUM_OBJECT_ENTRIES]; /*!< Object
+                                                               *   extents
+                                                               *   metadata
+                                                               */
+    uint32_t erase_count[SST_MAX_NUM_OF_BLOCKS];      /*!< Number of erases
+                                                       *   of each physical
+                                                       *   block
+                                                       */
+    struct sst_compact_cursor_t compact;              /*!< Incremental
+                                                       *   compaction
+                                                       *   progress
+                                                       */
+};
+
+/* Checks at compile time if the metadata table layout matches the metadata
+ * size stored in flash (i.e. the structure has no padding).
+ */
+SST_UTILS_BOUND_CHECK(METADATA_TABLE_HAS_PADDING,
+                      sizeof(struct sst_metadata_table_t),
+                      SST_ALL_METADATA_SIZE);
+
+/* Transaction states */
+#define SST_TXN_IDLE    0
+#define SST_TXN_ACTIVE  1
+
+/* Erase states of the physical blocks, which are only tracked in RAM */
+#define SST_BLOCK_DIRTY   0  /* Block may contain programmed data */
+#define SST_BLOCK_ERASED  1  /* Block is erased and ready to be used as scratch
+                              * block
+                              */
+#define SST_BLOCK_IN_USE  2  /* Block is a scratch block programmed by the
+                              * update in progress
+                              */
+#define SST_BLOCK_COMPACT 3  /* Block is the destination of the incremental
+                              * compaction, and its progress has been checked
+                              */
+
+/* Number of physical blocks whose erased state can be recorded by a
+ * checkpoint. The erased state of the other blocks is not recorded.
+ */
+#define SST_CKPT_MAX_BLOCKS 32
+
+/* FNV-1a parameters of the active metadata hash stored in the checkpoints */
+#define SST_CKPT_HASH_BASIS 2166136261U
+#define SST_CKPT_HASH_PRIME 16777619U
+
+/* Number of entries in the object index hash table. It is kept bigger than
+ * the number of objects so that there is always an empty entry which ends
+ * the probing sequence, and the probing sequences are kept short.
+ */
+#define SST_INDEX_TABLE_SIZE (2 * SST_NUM_OBJECT_ENTRIES)
+
+/* Object index value used to mark an empty entry in the hash table */
+#define SST_INDEX_EMPTY_ENTRY SST_METADATA_INVALID_INDEX
+
+/* Number of bits in each word of the free object bitmap */
+#define SST_BITMAP_WORD_BITS 32
+
+/* Number of words required to hold one bit per object metadata entry */
+#define SST_FREE_OBJ_BITMAP_WORDS \
+((SST_NUM_OBJECT_ENTRIES + (SST_BITMAP_WORD_BITS - 1)) / SST_BITMAP_WORD_BITS)
+
+/* Entry in the object index hash table */
+struct sst_index_entry_t {
+    uint32_t uuid;         /*!< Unique ID of the object */
+    uint16_t object_index; /*!< Object's index in the metadata table */
+};
+
+/* Context of a storage area */
+struct sst_core_ctx_t {
+    uint32_t area_id;               /*!< Storage area ID */
+    uint32_t block_size;            /*!< Size of a physical block */
+    uint32_t nbr_blocks;            /*!< Number of physical blocks */
+    uint32_t init_scratch_dblock;   /*!< Initial physical ID of the scratch
+                                     *   data block
+                                     */
+    uint32_t init_dblock_start;     /*!< Initial physical ID of the first
+                                     *   dedicated data block
+                                     */
+    uint32_t nbr_dedicated_dblocks; /*!< Number of blocks dedicated just for
+                                     *   data
+                                     */
+    uint32_t nbr_active_dblocks;    /*!< Number of logical data blocks */
+    struct sst_asset_system_context sys; /*!< Active and scratch metadata
+                                          *   block IDs
+                                          */
+    /* RAM copies of the metadata. The active copy mirrors the content of the
+     * active metadata block. It is loaded and validated once in
+     * sst_core_prepare and all metadata reads are served from it. The scratch
+     * copy is where an update operation prepares the new metadata, which is
+     * then programmed into the scratch metadata block in a single sequential
+     * pass when the operation is finalized.
+     */
+    struct sst_metadata_table_t meta_active;
+    struct sst_metadata_table_t meta_scratch;
+    /* Staging buffer of the metadata journal records. It holds the records of
+     * an update before they are appended to the journal, and the journal
+     * content while it is replayed in sst_core_prepare.
+     */
+    struct sst_journal_record_t journal_buf[SST_JOURNAL_NUM_RECORDS];
+    /* Transaction state. While a transaction is active, the metadata
+     * updates are accumulated in the RAM copy of the scratch metadata, which
+     * is also used to serve the metadata reads. The data updates are
+     * programmed in flash as for the other updates, in erased space and in
+     * scratch blocks which are not referenced by the active metadata, so
+     * they only take effect when the transaction is committed.
+     */
+    uint8_t txn_state;
+    /* Erase state of each physical block. The scratch blocks retired by the
+     * update operations are left dirty, and they are erased by
+     * sst_core_maintenance. An update operation only erases a scratch block
+     * if the maintenance has not been done since the block was retired. All
+     * the blocks are dirty when the storage area is prepared.
+     */
+    uint8_t block_state[SST_MAX_NUM_OF_BLOCKS];
+    /* Last checkpoint of the active metadata block's journal. It is live
+     * while no update has been appended after it, and until a block it
+     * records as erased is claimed. A mount restores the erased state of the
+     * blocks from the live checkpoint, instead of erasing them again.
+     */
+    struct sst_journal_ckpt_t ckpt;
+    uint8_t ckpt_live;
+    /* Open-addressing hash table which maps object UUIDs to object metadata
+     * table indexes, and bitmap of the free object metadata table entries (a
+     * bit set to 1 means the entry is free). Both are built from the active
+     * metadata block in sst_core_prepare and updated after each successful
+     * create/delete, so that object lookups do not require to scan the
+     * metadata table in flash.
+     */
+    struct sst_index_entry_t index_table[SST_INDEX_TABLE_SIZE];
+    uint32_t free_obj_bitmap[SST_FREE_OBJ_BITMAP_WORDS];
+};
+
+/* Contexts of the storage areas. Each area has its own layout, metadata and
+ * transaction, so that the areas are fully independent.
+ */
+static struct sst_core_ctx_t sst_core_ctx[SST_NBR_OF_AREAS];
+
+#ifdef SST_ENCRYPTION
 /* Size of metadata at the beginning of the metadata header that is not
  * authenticated. Everything after the MAC is authenticated.
  * FIXME: an alternative crypto policy may require an alternative definition.
@@ -112,86 +350,142 @@ SST_UTILS_BOUND_CHECK(METADATA_NOT_FIT_IN_DATA_BUF,
 
 /* Offset in metadata at which authentication begins */
 #define SST_AUTH_METADATA_OFFSET SST_NON_AUTH_METADATA_SIZE
-#endif
 
-/* It is not required that all assets fit in SST area at the same time.
- * So, it is possible that a create action fails because SST area is full.
- * However, the larger asset must have enough space in the SST area to be
- * created, at least, when the SST area is empty.
+/* Size of the authenticated part of a journal update: its records and the
+ * commit record up to the crypto metadata.
  */
-/* Checks at compile time if the largest asset fits in the asset's data area */
-SST_UTILS_BOUND_CHECK(LARGEST_ASSET_NOT_FIT_IN_DATA_BLOCK,
-                      SST_ALIGNED_MAX_OBJECT_SIZE, SST_BLOCK_SIZE);
-
-#if (SST_TOTAL_NUM_OF_BLOCKS == 2)
-SST_UTILS_BOUND_CHECK(ASSET_NOT_FIT_IN_DATA_AREA, SST_ALIGNED_MAX_OBJECT_SIZE,
-                      (SST_BLOCK_SIZE - SST_ALL_METADATA_SIZE));
+#define SST_JOURNAL_AUTH_SIZE(nbr_records) \
+(((nbr_records) * sizeof(struct sst_journal_record_t)) + \
+ offsetof(struct sst_journal_record_t, data) + \
+ offsetof(struct sst_journal_commit_t, crypto))
 #endif
 
-/* Checks at compile time if the metadata fits in a flash block */
+/* Checks at compile time if the metadata and its journal fit in the largest
+ * flash block. The block size of each storage area is checked when the area
+ * is set up.
+ */
 SST_UTILS_BOUND_CHECK(METADATA_NOT_FIT_IN_METADATA_BLOCK,
-                      SST_ALL_METADATA_SIZE, SST_BLOCK_SIZE);
+                      SST_DBLOCK0_DATA_START, SST_MAX_BLOCK_SIZE);
+
+/* Checks at compile time if the journal records are aligned with the flash
+ * program unit, as they are appended one update at a time.
+ */
+SST_UTILS_BOUND_CHECK(JOURNAL_NOT_ALIGNED_WITH_PROGRAM_UNIT,
+                      ((SST_JOURNAL_OFFSET % SST_FLASH_PROGRAM_UNIT) +
+                       (sizeof(struct sst_journal_record_t) %
+                        SST_FLASH_PROGRAM_UNIT)), 0);
+
+/* Checks at compile time if the metadata block header is aligned with the
+ * flash program unit, as the metadata tables are programmed after it.
+ */
+SST_UTILS_BOUND_CHECK(META_HEADER_NOT_ALIGNED_WITH_PROGRAM_UNIT,
+                      (sizeof(struct sst_metadata_block_header) %
+                       SST_FLASH_PROGRAM_UNIT), 0);
+
+/* Checks at compile time if the compaction step size is aligned with the
+ * flash program unit, and not null.
+ */
+SST_UTILS_BOUND_CHECK(COMPACT_STEP_NOT_ALIGNED_WITH_PROGRAM_UNIT,
+                      (SST_COMPACT_STEP_SIZE % SST_FLASH_PROGRAM_UNIT), 0);
+SST_UTILS_BOUND_CHECK(COMPACT_STEP_TOO_SMALL, SST_FLASH_PROGRAM_UNIT,
+                      SST_COMPACT_STEP_SIZE);
 
 /**
- * \brief Gets the number of bytes aligned with the SST_FLASH_PROGRAM_UNIT.
+ * \brief Gets the context of a storage area
  *
- * \param[in] nbr_bytes  Number of bytes to write
+ * \param[in] area_id  Storage area ID
  *
- * \return Return number of bytes aligned with SST_FLASH_PROGRAM_UNIT
+ * \return Returns a pointer to the area's context, or NULL if the area ID is
+ *         not valid
  */
-static uint32_t sst_get_aligned_flash_bytes(uint32_t nbr_bytes)
+static struct sst_core_ctx_t *sst_core_get_ctx(uint32_t area_id)
 {
-    uint32_t align_flash_size;
-
-    /* Check if write parameters are aligned with the flash write
-     * program unit.
-     */
-    align_flash_size = (nbr_bytes % SST_FLASH_PROGRAM_UNIT);
-    if (align_flash_size != 0) {
-        /* Add offset to align object's size required with the flash write
-         * program unit.
-         */
-        align_flash_size = (SST_FLASH_PROGRAM_UNIT - align_flash_size);
+    if (area_id >= SST_NBR_OF_AREAS) {
+        return NULL;
     }
 
-    align_flash_size += nbr_bytes;
-
-    return align_flash_size;
+    return &sst_core_ctx[area_id];
 }
 
 /**
- * \brief Gets offset of a logical block's metadata in metadata block
+ * \brief Sets up the layout of a storage area from its flash geometry
  *
- * \param[in] idx  Logical block number
+ * \param[out] ctx      Pointer to the area's context
+ * \param[in]  area_id  Storage area ID
  *
- * \return Return offset value in metadata block
+ * \return Returns error code as specified in \ref psa_sst_err_t
  */
-static uint32_t sst_meta_block_meta_offset(uint32_t idx)
+static enum psa_sst_err_t sst_core_setup_ctx(struct sst_core_ctx_t *ctx,
+                                             uint32_t area_id)
 {
-    uint32_t offset;
+    const struct sst_flash_area_t *area;
+
+    area = sst_flash_get_area(area_id);
+    if (area == NULL) {
+        return PSA_SST_ERR_PARAM_ERROR;
+    }
+
+    /* The same constraints as the compile time checks apply to each area. The
+     * RAM tables and the metadata layout are sized for the largest area.
+     */
+    if ((area->nbr_blocks < 2) || (area->nbr_blocks == 3) ||
+        ((area->nbr_blocks > 2) &&
+         (area->nbr_blocks < (SST_NUM_SCRATCH_DBLOCKS + 3))) ||
+        (area->nbr_blocks > SST_MAX_NUM_OF_BLOCKS) ||
+        (area->block_size > SST_MAX_BLOCK_SIZE) ||
+        (area->block_size < SST_DBLOCK0_DATA_START)) {
+        return PSA_SST_ERR_SYSTEM_ERROR;
+    }
+
+    /* It is not required that all assets fit in SST area at the same time.
+     * So, it is possible that a create action fails because SST area is full.
+     * However, the larger asset must have enough space in the SST area to be
+     * created, at least, when the SST area is empty. As an object can be split
+     * in extents located in several data blocks, it is only checked when all
+     * the data is stored in the metadata block.
+     */
+    if ((area->nbr_blocks == 2) &&
+        (SST_MAX_OBJECT_SIZE > (area->block_size - SST_DBLOCK0_DATA_START))) {
+        return PSA_SST_ERR_SYSTEM_ERROR;
+    }
+
+    ctx->area_id = area_id;
+    ctx->block_size = area->block_size;
+    ctx->nbr_blocks = area->nbr_blocks;
+
+    if (ctx->nbr_blocks == 2) {
+        ctx->init_scratch_dblock = SST_TWO_BLOCKS_INIT_SCRATCH_DBLOCK;
+        ctx->init_dblock_start = 0;
+        ctx->nbr_dedicated_dblocks = 0;
+    } else {
+        ctx->init_scratch_dblock = SST_INIT_SCRATCH_DBLOCK;
+        ctx->init_dblock_start = (SST_INIT_SCRATCH_DBLOCK +
+                                  SST_NUM_SCRATCH_DBLOCKS);
+        ctx->nbr_dedicated_dblocks = (ctx->nbr_blocks -
+                                      ctx->init_dblock_start);
+    }
+    ctx->nbr_active_dblocks = (ctx->nbr_dedicated_dblocks + 1);
 
-    offset = sizeof(struct sst_metadata_block_header) +
-             (idx * sizeof(struct sst_block_metadata));
+    /* No transaction is in progress once the area is set up */
+    ctx->txn_state = SST_TXN_IDLE;
 
-    return offset;
+    return PSA_SST_ERR_SUCCESS;
 }
 
 /**
- * \brief Gets offset of an object's metadata in metadata block
+ * \brief Gets the number of bytes aligned with the SST_FLASH_PROGRAM_UNIT.
  *
- * \param[in] idx  Object's index
+ * \param[in] nbr_bytes  Number of bytes to write
  *
- * \return Return offset value in metadata block
+ * \return Return number of bytes aligned with SST_FLASH_PROGRAM_UNIT
  */
-static uint32_t sst_meta_object_meta_offset(uint32_t object_index)
+static uint32_t sst_get_aligned_flash_bytes(uint32_t nbr_bytes)
 {
-    uint32_t offset;
-
-    offset = sizeof(struct sst_metadata_block_header)
-             + (SST_NUM_ACTIVE_DBLOCKS * sizeof(struct sst_block_metadata))
-             + (object_index * sizeof(struct sst_assetmeta));
-
-    return offset;
+    /* Round the size up to the next multiple of the program unit, which is
+     * a power of two.
+     */
+    return ((nbr_bytes + (SST_FLASH_PROGRAM_UNIT - 1)) &
+            ~((uint32_t)SST_FLASH_PROGRAM_UNIT - 1));
 }
 
 /**
@@ -199,9 +493,9 @@ static uint32_t sst_meta_object_meta_offset(uint32_t object_index)
  *
  * \return scratch metablock's id
  */
-static uint32_t sst_meta_cur_meta_scratch(void)
+static uint32_t sst_meta_cur_meta_scratch(struct sst_core_ctx_t *ctx)
 {
-    return sst_system_ctx.scratch_metablock;
+    return ctx->sys.scratch_metablock;
 }
 
 /**
@@ -209,21 +503,21 @@ static uint32_t sst_meta_cur_meta_scratch(void)
  *
  * \return scratch metablock's id
  */
-static uint32_t sst_meta_cur_meta_active(void)
+static uint32_t sst_meta_cur_meta_active(struct sst_core_ctx_t *ctx)
 {
-    return sst_system_ctx.active_metablock;
+    return ctx->sys.active_metablock;
 }
 
 /**
  * \brief Swaps metablocks. Scratch becomes active and active becomes scratch
  */
-static void sst_meta_swap_metablocks(void)
+static void sst_meta_swap_metablocks(struct sst_core_ctx_t *ctx)
 {
     uint32_t tmp_block;
 
-    tmp_block = sst_system_ctx.scratch_metablock;
-    sst_system_ctx.scratch_metablock = sst_system_ctx.active_metablock;
-    sst_system_ctx.active_metablock = tmp_block;
+    tmp_block = ctx->sys.scratch_metablock;
+    ctx->sys.scratch_metablock = ctx->sys.active_metablock;
+    ctx->sys.active_metablock = tmp_block;
 }
 
 /**
@@ -233,27 +527,33 @@ static void sst_meta_swap_metablocks(void)
  *
  * \return current scratch data block
  */
-static uint32_t sst_meta_cur_data_scratch(uint32_t lblock)
+static uint32_t sst_meta_cur_data_scratch(struct sst_core_ctx_t *ctx,
+                                          uint32_t lblock)
 {
     if (lblock == SST_LOGICAL_DBLOCK0) {
         /* Scratch logical data block 0 physical IDs */
-        return sst_meta_cur_meta_scratch();
+        return sst_meta_cur_meta_scratch(ctx);
     }
 
-    return sst_system_ctx.meta_block_header.scratch_idx;
+    return ctx->sys.meta_block_header.scratch_idx;
 }
 
 /**
- * \brief Sets current data scratch block
+ * \brief Gets the RAM copy of the metadata which reflects the current state
+ *        of the objects
  *
- * \param[in] index   Physical id of scratch data block
- * \param[in] lblock  Logical block number
+ * \return Returns the scratch metadata while a transaction is active, as it
+ *         contains the transaction's updates. Otherwise, it returns the
+ *         active metadata.
  */
-static void sst_meta_set_data_scratch(uint32_t index, uint32_t lblock)
+static const struct sst_metadata_table_t *sst_meta_cur_table(
+                                                    struct sst_core_ctx_t *ctx)
 {
-    if (lblock != SST_LOGICAL_DBLOCK0) {
-        sst_system_ctx.meta_block_header.scratch_idx = index;
+    if (ctx->txn_state == SST_TXN_ACTIVE) {
+        return &ctx->meta_scratch;
     }
+
+    return &ctx->meta_active;
 }
 
 /**
@@ -318,20 +618,21 @@ static uint8_t sst_meta_latest_meta_block(
  * \return Returns error code as specified in \ref psa_sst_err_t
  */
 static enum psa_sst_err_t sst_meta_validate_block_meta(
+                                    struct sst_core_ctx_t *ctx,
                                     const struct sst_block_metadata *block_meta)
 {
     enum psa_sst_err_t err;
     /* for data blocks data start at position 0 */
     uint32_t valid_data_start_value = 0;
 
-    if (block_meta->phys_id >= SST_TOTAL_NUM_OF_BLOCKS) {
+    if (block_meta->phys_id >= ctx->nbr_blocks) {
         return PSA_SST_ERR_SYSTEM_ERROR;
     }
 
     /* boundary check: block data start + free size can not be bigger
      * than max block size.
      */
-    err = sst_utils_check_contained_in(0, SST_BLOCK_SIZE,
+    err = sst_utils_check_contained_in(0, ctx->block_size,
                                        block_meta->data_start,
                                        block_meta->free_size);
     if (err != PSA_SST_ERR_SUCCESS) {
@@ -342,9 +643,9 @@ static enum psa_sst_err_t sst_meta_validate_block_meta(
         block_meta->phys_id == SST_METADATA_BLOCK1) {
 
         /* for metadata + data block, data index must start after the
-         * metadata area.
+         * metadata and journal area.
          */
-        valid_data_start_value = sst_meta_object_meta_offset(SST_NUM_ASSETS);
+        valid_data_start_value = SST_DBLOCK0_DATA_START;
     }
 
     if (block_meta->data_start != valid_data_start_value) {
@@ -363,25 +664,22 @@ static enum psa_sst_err_t sst_meta_validate_block_meta(
  *
  * \return Returns error code as specified in \ref psa_sst_err_t
  */
-static enum psa_sst_err_t sst_meta_read_block_metadata(uint32_t lblock,
+static enum psa_sst_err_t sst_meta_read_block_metadata(
+                                          struct sst_core_ctx_t *ctx,
+                                          uint32_t lblock,
                                           struct sst_block_metadata *block_meta)
 {
-    enum psa_sst_err_t err;
-    uint32_t pos;
-    uint32_t metablock;
-
-    metablock = sst_meta_cur_meta_active();
-    pos = sst_meta_block_meta_offset(lblock);
-    err = sst_flash_read(metablock, (uint8_t *)block_meta,
-                         pos, sizeof(struct sst_block_metadata));
-
-#ifdef SST_VALIDATE_METADATA_FROM_FLASH
-    if (err == PSA_SST_ERR_SUCCESS) {
-        err = sst_meta_validate_block_meta(block_meta);
+    if (lblock >= ctx->nbr_active_dblocks) {
+        return PSA_SST_ERR_SYSTEM_ERROR;
     }
-#endif
 
-    return err;
+    /* The RAM copy of the active metadata has been validated when it was
+     * loaded from flash.
+     */
+    sst_utils_memcpy(block_meta, &sst_meta_cur_table(ctx)->block_meta[lblock],
+                     sizeof(struct sst_block_metadata));
+
+    return PSA_SST_ERR_SUCCESS;
 }
 
 #ifdef SST_VALIDATE_METADATA_FROM_FLASH
@@ -395,6 +693,7 @@ static enum psa_sst_err_t sst_meta_read_block_metadata(uint32_t lblock,
  * \return Returns error code as specified in \ref psa_sst_err_t
  */
 static enum psa_sst_err_t sst_meta_validate_object_meta(
+                                               struct sst_core_ctx_t *ctx,
                                                const struct sst_assetmeta *meta)
 {
     enum psa_sst_err_t err = PSA_SST_ERR_SUCCESS;
@@ -402,7 +701,7 @@ static enum psa_sst_err_t sst_meta_validate_object_meta(
     /* logical block ID can not be bigger or equal than number of
      * active blocks.
      */
-    if (meta->lblock >= SST_NUM_ACTIVE_DBLOCKS) {
+    if (meta->lblock >= ctx->nbr_active_dblocks) {
         return PSA_SST_ERR_ASSET_NOT_FOUND;
     }
 
@@ -411,7 +710,9 @@ static enum psa_sst_err_t sst_meta_validate_object_meta(
      */
     if (sst_utils_validate_uuid(meta->unique_id) == PSA_SST_ERR_SUCCESS) {
         /* validate objects values if object is in use */
-        if (meta->max_size > SST_MAX_OBJECT_SIZE) {
+        if ((meta->max_size > ctx->block_size) ||
+            ((meta->next != SST_METADATA_INVALID_INDEX) &&
+             (meta->next >= SST_NUM_OBJECT_ENTRIES))) {
             return PSA_SST_ERR_ASSET_NOT_FOUND;
         }
 
@@ -423,711 +724,2522 @@ static enum psa_sst_err_t sst_meta_validate_object_meta(
         }
 
         if (meta->lblock == SST_LOGICAL_DBLOCK0) {
-            /* in block 0, data index must be located after the metadata */
-            if (meta->data_index <
-                sst_meta_object_meta_offset(SST_NUM_ASSETS)) {
+            /* in block 0, data index must be located after the metadata
+             * and journal area.
+             */
+            if (meta->data_index < SST_DBLOCK0_DATA_START) {
                 return PSA_SST_ERR_ASSET_NOT_FOUND;
             }
         }
 
         /* Boundary check the incoming request */
-        err = sst_utils_check_contained_in(0, SST_BLOCK_SIZE, meta->data_index,
+        err = sst_utils_check_contained_in(0, ctx->block_size, meta->data_index,
                                            meta->max_size);
     }
 
     return err;
 }
-#endif
 
 /**
- * \brief Reads specified object's metadata
+ * \brief Validates the compaction cursor in order to guarantee that a
+ *        corruption or malicious change in stored metadata doesn't result in
+ *        an invalid access
  *
- * \param[in]  object_index  Object's index
- * \param[out] meta          Pointer to object meta structure
+ * \param[in] cursor  Pointer to compaction cursor structure
  *
  * \return Returns error code as specified in \ref psa_sst_err_t
  */
-enum psa_sst_err_t sst_meta_read_object_meta(uint32_t object_index,
-                                           struct sst_assetmeta *meta)
+static enum psa_sst_err_t sst_meta_validate_compact_cursor(
+                                     struct sst_core_ctx_t *ctx,
+                                     const struct sst_compact_cursor_t *cursor)
 {
-    enum psa_sst_err_t err;
-    uint32_t offset;
+    if (cursor->lblock == SST_COMPACT_NO_LBLOCK) {
+        return PSA_SST_ERR_SUCCESS;
+    }
 
-    offset = sst_meta_object_meta_offset(object_index);
-    err = sst_flash_read(sst_system_ctx.active_metablock,
-                         (uint8_t *)meta, offset, sizeof(struct sst_assetmeta));
+    /* Only the dedicated data blocks are compacted incrementally */
+    if ((cursor->lblock == SST_LOGICAL_DBLOCK0) ||
+        (cursor->lblock >= ctx->nbr_active_dblocks)) {
+        return PSA_SST_ERR_ASSET_NOT_FOUND;
+    }
 
-#ifdef SST_VALIDATE_METADATA_FROM_FLASH
-    if (err == PSA_SST_ERR_SUCCESS) {
-        err = sst_meta_validate_object_meta(meta);
+    if ((cursor->phys_id < ctx->init_scratch_dblock) ||
+        (cursor->phys_id >= ctx->nbr_blocks)) {
+        return PSA_SST_ERR_ASSET_NOT_FOUND;
     }
-#endif
 
-    return err;
+    if (cursor->object_index > SST_NUM_OBJECT_ENTRIES) {
+        return PSA_SST_ERR_ASSET_NOT_FOUND;
+    }
+
+    return sst_utils_check_contained_in(0, ctx->block_size, cursor->pos,
+                                        cursor->offset);
 }
+#endif
 
 /**
- * \brief Gets a free object metadata table entry
+ * \brief Reads specified object's metadata
  *
- * \return Return index of a free object meta entry
+ * \param[in]  object_index  Object's index
+ * \param[out] meta          Pointer to object meta structure
+ *
+ * \return Returns error code as specified in \ref psa_sst_err_t
  */
-static uint16_t sst_get_free_object_index(void)
+enum psa_sst_err_t sst_meta_read_object_meta(uint32_t area_id,
+                                             uint32_t object_index,
+                                             struct sst_assetmeta *meta)
 {
-    uint16_t i;
-    enum psa_sst_err_t err;
-    struct sst_assetmeta tmp_metadata;
+    struct sst_core_ctx_t *ctx;
 
-    for (i = 0; i < SST_NUM_ASSETS; i++) {
-        err = sst_meta_read_object_meta(i, &tmp_metadata);
-        if (err == PSA_SST_ERR_SUCCESS) {
-            /* Check if this entry is free by checking if unique_id values is an
-             * invalid UUID.
-             */
-            if (sst_utils_validate_uuid(tmp_metadata.unique_id) !=
-                                                          PSA_SST_ERR_SUCCESS) {
-                /* Found */
-                return i;
-            }
-        } else {
-            return SST_METADATA_INVALID_INDEX;
-        }
+    ctx = sst_core_get_ctx(area_id);
+    if (ctx == NULL) {
+        return PSA_SST_ERR_PARAM_ERROR;
     }
 
-    return SST_METADATA_INVALID_INDEX;
+    if (object_index >= SST_NUM_OBJECT_ENTRIES) {
+        return PSA_SST_ERR_SYSTEM_ERROR;
+    }
+
+    /* The RAM copy of the active metadata has been validated when it was
+     * loaded from flash.
+     */
+    sst_utils_memcpy(meta, &sst_meta_cur_table(ctx)->object_meta[object_index],
+                     sizeof(struct sst_assetmeta));
+
+    return PSA_SST_ERR_SUCCESS;
 }
 
 /**
- * \brief Converts logical data block number to physical number
+ * \brief Replays the metadata journal of the active metadata block on the RAM
+ *        copy of the active metadata
  *
- * \param[in] lblock  Logical block number
+ * \note An update is only applied when its commit record is valid. If the
+ *       journal contains records after the last valid commit record (e.g. an
+ *       update interrupted by a power failure), the journal is considered full
+ *       so that the next update swaps the metadata blocks.
  *
- * \return Return physical block number
+ * \return Returns error code as specified in \ref psa_sst_err_t
  */
-static uint32_t sst_dblock_lo_to_phy(uint32_t lblock)
+static enum psa_sst_err_t sst_journal_replay(struct sst_core_ctx_t *ctx)
 {
-    struct sst_block_metadata block_meta;
     enum psa_sst_err_t err;
+    struct sst_journal_record_t *record;
+    struct sst_journal_commit_t *commit;
+    const uint8_t *journal_tail;
+    uint32_t first_record = 0;
+    uint32_t i;
+    uint32_t j;
+
+    ctx->sys.journal_next_record = 0;
+    ctx->sys.journal_seq = 0;
+    ctx->ckpt_live = 0;
 
-    err = sst_meta_read_block_metadata(lblock, &block_meta);
+    err = sst_flash_read(ctx->area_id, sst_meta_cur_meta_active(ctx),
+                         (uint8_t *)ctx->journal_buf, SST_JOURNAL_OFFSET,
+                         SST_JOURNAL_SIZE);
     if (err != PSA_SST_ERR_SUCCESS) {
-        return SST_BLOCK_INVALID_ID;
+        return err;
     }
 
-    return block_meta.phys_id;
+#ifdef SST_ENCRYPTION
+    err = sst_crypto_getkey(ctx->sys.sst_key, SST_KEY_LEN_BYTES);
+    if (err != PSA_SST_ERR_SUCCESS) {
+        return err;
+    }
+
+    err = sst_crypto_setkey(ctx->sys.sst_key, SST_KEY_LEN_BYTES);
+    if (err != PSA_SST_ERR_SUCCESS) {
+        return err;
+    }
+#endif
+
+    for (i = 0; i < SST_JOURNAL_NUM_RECORDS; i++) {
+        record = &ctx->journal_buf[i];
+
+        if ((record->type == SST_JOURNAL_BLOCK_META) ||
+            (record->type == SST_JOURNAL_OBJECT_META) ||
+            (record->type == SST_JOURNAL_ERASE_COUNT) ||
+            (record->type == SST_JOURNAL_COMPACT)) {
+            /* Entry of an update, applied when its commit record is found */
+            continue;
+        }
+
+        if (record->type == SST_JOURNAL_CHECKPOINT) {
+            /* A checkpoint is stored between two updates */
+            if ((i != first_record) ||
+                (record->data.ckpt.seq != ctx->sys.journal_seq)) {
+                break;
+            }
+
+            sst_utils_memcpy(&ctx->ckpt, &record->data.ckpt,
+                             sizeof(struct sst_journal_ckpt_t));
+            ctx->ckpt_live = (ctx->ckpt.erased_blocks != 0);
+            first_record = i + 1;
+            continue;
+        }
+
+        if (record->type != SST_JOURNAL_COMMIT) {
+            break;
+        }
+
+        commit = &record->data.commit;
+        if ((commit->seq != ctx->sys.journal_seq) ||
+            (commit->nbr_records != (i - first_record))) {
+            break;
+        }
+
+#ifdef SST_ENCRYPTION
+        err = sst_crypto_authenticate(
+                                    &commit->crypto,
+                                    (uint8_t *)&ctx->journal_buf[first_record],
+                                    SST_JOURNAL_AUTH_SIZE(commit->nbr_records));
+        if (err != PSA_SST_ERR_SUCCESS) {
+            break;
+        }
+#endif
+
+        for (j = first_record; j < i; j++) {
+            record = &ctx->journal_buf[j];
+            if (record->type == SST_JOURNAL_BLOCK_META) {
+                if (record->index >= ctx->nbr_active_dblocks) {
+                    return PSA_SST_ERR_SYSTEM_ERROR;
+                }
+                sst_utils_memcpy(&ctx->meta_active.block_meta[record->index],
+                                 &record->data.block_meta,
+                                 sizeof(struct sst_block_metadata));
+            } else if (record->type == SST_JOURNAL_ERASE_COUNT) {
+                if (record->index >= ctx->nbr_blocks) {
+                    return PSA_SST_ERR_SYSTEM_ERROR;
+                }
+                ctx->meta_active.erase_count[record->index] =
+                                                     record->data.erase_count;
+            } else if (record->type == SST_JOURNAL_COMPACT) {
+                sst_utils_memcpy(&ctx->meta_active.compact,
+                                 &record->data.compact,
+                                 sizeof(struct sst_compact_cursor_t));
+            } else {
+                if (record->index >= SST_NUM_OBJECT_ENTRIES) {
+                    return PSA_SST_ERR_SYSTEM_ERROR;
+                }
+                sst_utils_memcpy(&ctx->meta_active.object_meta[record->index],
+                                 &record->data.object_meta,
+                                 sizeof(struct sst_assetmeta));
+            }
+        }
+
+        ctx->meta_active.header.scratch_idx = commit->scratch_idx;
+#ifdef SST_ENCRYPTION
+        /* Keep the IV of the latest update, so that it is not reused */
+        sst_utils_memcpy(&ctx->meta_active.header.crypto, &commit->crypto,
+                         sizeof(union sst_crypto_t));
+#endif
+
+        ctx->sys.journal_seq++;
+        first_record = i + 1;
+        ctx->ckpt_live = 0;
+    }
+
+    ctx->sys.journal_next_record = first_record;
+
+    /* The journal can not be appended after a partially programmed update */
+    journal_tail = (const uint8_t *)&ctx->journal_buf[first_record];
+    for (i = 0; i < ((SST_JOURNAL_NUM_RECORDS - first_record) *
+                     sizeof(struct sst_journal_record_t)); i++) {
+        if (journal_tail[i] != SST_FLASH_DEFAULT_VAL) {
+            ctx->sys.journal_next_record = SST_JOURNAL_NUM_RECORDS;
+            ctx->ckpt_live = 0;
+            break;
+        }
+    }
+
+    return PSA_SST_ERR_SUCCESS;
 }
 
 /**
- * \brief Updates the scratch datablock with requested data
- *        and copy rest of the data in the current block
- *
- * \param[in] cur_logical_block  Current datablock
- * \param[in] block_meta         Pointer to block meta
- * \param[in] data               Pointer to data buffer
- * \param[in] offset             Offset in the block
- * \param[in] size               Size of the incoming data
+ * \brief Loads the metadata stored in the active metadata block into the RAM
+ *        copy of the active metadata, replays the metadata journal on it, and
+ *        validates it
  *
  * \return Returns error code as specified in \ref psa_sst_err_t
  */
-static enum psa_sst_err_t sst_dblock_update_scratch(uint32_t cur_logical_block,
-                                    const struct sst_block_metadata *block_meta,
-                                    const uint8_t *data,
-                                    uint32_t offset,
-                                    uint32_t size)
+static enum psa_sst_err_t sst_meta_load_active_meta(struct sst_core_ctx_t *ctx)
 {
-    uint32_t scratch_block;
-    uint32_t end_data;
     enum psa_sst_err_t err;
+#ifdef SST_VALIDATE_METADATA_FROM_FLASH
+    uint32_t i;
+#endif
 
-    scratch_block = sst_meta_cur_data_scratch(cur_logical_block);
+#ifdef SST_ENCRYPTION
+    /* The metadata has been read from flash and authenticated in RAM when the
+     * active metadata block was selected. Reading it again from flash would
+     * make the content used differ from the content authenticated.
+     */
+    err = PSA_SST_ERR_SUCCESS;
+#else
+    err = sst_flash_read(ctx->area_id, sst_meta_cur_meta_active(ctx),
+                         (uint8_t *)&ctx->meta_active, 0,
+                         SST_ALL_METADATA_SIZE);
+    if (err != PSA_SST_ERR_SUCCESS) {
+        return err;
+    }
+#endif
 
-    err = sst_flash_write(scratch_block, data, offset, size);
+    err = sst_journal_replay(ctx);
     if (err != PSA_SST_ERR_SUCCESS) {
         return err;
     }
 
-    if (offset > block_meta->data_start) {
-        /* Copy rest of the block data from previous block */
-        /* Data before updated content */
-        err = sst_flash_block_to_block_move(scratch_block,
-                                            block_meta->data_start,
-                                            block_meta->phys_id,
-                                            block_meta->data_start,
-                                            (offset - block_meta->data_start));
+#ifdef SST_VALIDATE_METADATA_FROM_FLASH
+    for (i = 0; i < ctx->nbr_active_dblocks; i++) {
+        err = sst_meta_validate_block_meta(ctx,
+                                           &ctx->meta_active.block_meta[i]);
+        if (err != PSA_SST_ERR_SUCCESS) {
+            return err;
+        }
+    }
+
+    for (i = 0; i < SST_NUM_OBJECT_ENTRIES; i++) {
+        err = sst_meta_validate_object_meta(ctx,
+                                            &ctx->meta_active.object_meta[i]);
         if (err != PSA_SST_ERR_SUCCESS) {
             return err;
         }
     }
 
-    /* Calculate amount of used data in the block */
-    end_data = (SST_BLOCK_SIZE - (offset + size) - block_meta->free_size);
+    err = sst_meta_validate_compact_cursor(ctx, &ctx->meta_active.compact);
+#endif
 
-    /* Data after updated content */
-    err = sst_flash_block_to_block_move(scratch_block, (offset + size),
-                                        block_meta->phys_id, (offset + size),
-                                        end_data);
     return err;
 }
 
 /**
- * \brief Writes a metadata entry into scratch metadata block
+ * \brief Gets the home position of an object UUID in the object index table
  *
- * \param[in] object_index  Object's index in the metadata table
- * \param[in] obj_meta      Metadata pointer
+ * \param[in] uuid  Object's UUID
  *
- * \return Returns error code as specified in \ref psa_sst_err_t
+ * \return Returns the hash table position where the probing starts
  */
-static enum psa_sst_err_t sst_mblock_update_scratch_object_meta(
-                                                 uint32_t object_index,
-                                                 struct sst_assetmeta *obj_meta)
+static uint32_t sst_index_hash(uint32_t uuid)
 {
-    uint32_t scratch_block;
-    enum psa_sst_err_t err;
-    uint32_t pos;
-
-    scratch_block = sst_meta_cur_meta_scratch();
-    /* Calculate the position */
-    pos = sst_meta_object_meta_offset(object_index);
-    err = sst_flash_write(scratch_block, (uint8_t *)obj_meta, pos,
-                          sizeof(struct sst_assetmeta));
-    return err;
+    /* Multiplicative hashing spreads consecutive UUIDs across the table */
+    return ((uuid * 2654435761U) % SST_INDEX_TABLE_SIZE);
 }
 
 /**
- * \brief Erases data and meta scratch blocks
+ * \brief Sets the free state of an object metadata table entry
+ *
+ * \param[in] object_index  Object's index
+ * \param[in] is_free       1 if the entry is free, 0 if it is in use
  */
-static enum psa_sst_err_t sst_meta_erase_scratch_blocks(void)
+static void sst_index_set_free(struct sst_core_ctx_t *ctx,
+                               uint32_t object_index, uint32_t is_free)
 {
-    enum psa_sst_err_t err;
-    uint32_t scratch_datablock;
-    uint32_t scratch_metablock;
-
-    scratch_metablock = sst_meta_cur_meta_scratch();
+    uint32_t mask;
+    uint32_t word;
 
-    /* For the atomicity of the data update process
-     * and power-failure-safe operation, it is necessary that
-     * metadata scratch block is erased before data block.
-     */
-    err = sst_flash_erase_block(scratch_metablock);
-    if (err != PSA_SST_ERR_SUCCESS) {
-        return err;
-    }
+    word = (object_index / SST_BITMAP_WORD_BITS);
+    mask = (1U << (object_index % SST_BITMAP_WORD_BITS));
 
-    /* If the number of total blocks is not bigger than 2, it means there are
-     * not blocks which contains only data, and all data is stored in the
-     * same block where the meta data is stored. If the number of blocks
-     * is bigger than 2, the code needs to erase the scratch block used
-     * to process any change in the data block which contains only data.
-     */
-    if (SST_TOTAL_NUM_OF_BLOCKS > 2) {
-        scratch_datablock = sst_meta_cur_data_scratch(SST_LOGICAL_DBLOCK0+1);
-        err = sst_flash_erase_block(scratch_datablock);
+    if (is_free) {
+        ctx->free_obj_bitmap[word] |= mask;
+    } else {
+        ctx->free_obj_bitmap[word] &= ~mask;
     }
-
-    return err;
 }
 
 /**
- * \brief Puts logical block's metadata in scratch metadata block
+ * \brief Finds the position of an object UUID in the object index table
  *
- * \param[in] lblock      Logical block number
- * \param[in] block_meta  Pointer to block's metadata
+ * \param[in] uuid  Object's UUID
  *
- * \return Returns error code as specified in \ref psa_sst_err_t
+ * \return Returns the position in the table or SST_INDEX_TABLE_SIZE if the
+ *         UUID is not in the table
  */
-static enum psa_sst_err_t sst_mblock_update_scratch_block_meta(uint32_t lblock,
-                                          struct sst_block_metadata *block_meta)
+static uint32_t sst_index_find(struct sst_core_ctx_t *ctx, uint32_t uuid)
 {
-    uint32_t meta_block;
-    enum psa_sst_err_t err;
+    uint32_t i;
     uint32_t pos;
 
-    meta_block = sst_meta_cur_meta_scratch();
-    /* Calculate the position */
-    pos = sst_meta_block_meta_offset(lblock);
-    err = sst_flash_write(meta_block, (uint8_t *)block_meta, pos,
-                          sizeof(struct sst_block_metadata));
-    return err;
+    pos = sst_index_hash(uuid);
+
+    for (i = 0; i < SST_INDEX_TABLE_SIZE; i++) {
+        if (ctx->index_table[pos].object_index == SST_INDEX_EMPTY_ENTRY) {
+            break;
+        }
+
+        if (ctx->index_table[pos].uuid == uuid) {
+            return pos;
+        }
+
+        pos = ((pos + 1) % SST_INDEX_TABLE_SIZE);
+    }
+
+    return SST_INDEX_TABLE_SIZE;
 }
 
 /**
- * \brief Copies rest of the object metadata, except for the one pointed by
- *        index
- *
- * \param[in] idx  Object index to skip
+ * \brief Adds an object to the object index
  *
- * \return Returns error code as specified in \ref psa_sst_err_t
+ * \param[in] uuid          Object's UUID
+ * \param[in] object_index  Object's index in the metadata table
  */
-static enum psa_sst_err_t sst_mblock_copy_remaining_object_meta(
-                                                          uint32_t object_index)
+static void sst_index_insert(struct sst_core_ctx_t *ctx,
+                             uint32_t uuid, uint32_t object_index)
 {
-    uint32_t scratch_block;
-    uint32_t meta_block;
-    enum psa_sst_err_t err;
-    uint32_t end;
     uint32_t pos;
 
-    scratch_block = sst_meta_cur_meta_scratch();
-    meta_block = sst_meta_cur_meta_active();
-    /* Calculate the position */
-    pos = sst_meta_object_meta_offset(0);
-    /* Copy rest of the block data from previous blok */
-    /* Data before updated content */
-    err = sst_flash_block_to_block_move(scratch_block, pos, meta_block, pos,
-                                        (object_index *
-                                         sizeof(struct sst_assetmeta)));
-    if (err != PSA_SST_ERR_SUCCESS) {
-        return err;
-    }
-
-    /* Data after updated content */
-    pos = sst_meta_object_meta_offset(object_index+1);
+    pos = sst_index_hash(uuid);
 
-    /* Get end of object meta position which is the position after the last
-     * byte of object meta.
+    /* The table is bigger than the metadata table, so an empty entry is
+     * always found.
      */
-    end = sst_meta_object_meta_offset(SST_NUM_ASSETS);
-    if (end > pos) {
-        err = sst_flash_block_to_block_move(scratch_block, pos, meta_block,
-                                            pos, (end - pos));
+    while (ctx->index_table[pos].object_index != SST_INDEX_EMPTY_ENTRY) {
+        pos = ((pos + 1) % SST_INDEX_TABLE_SIZE);
     }
 
-    return err;
+    ctx->index_table[pos].uuid = uuid;
+    ctx->index_table[pos].object_index = (uint16_t)object_index;
+
+    sst_index_set_free(ctx, object_index, 0);
 }
 
 /**
- * \brief Copies rest of the block metadata, except for the one pointed by index
+ * \brief Removes an object from the object index
  *
- * \param[in] lblock  Logical block number to skip
- *
- * \return Returns error code as specified in \ref psa_sst_err_t
+ * \param[in] uuid  Object's UUID
  */
-static enum psa_sst_err_t sst_mblock_copy_remaining_block_meta(uint32_t lblock)
+static void sst_index_remove(struct sst_core_ctx_t *ctx, uint32_t uuid)
 {
-    struct sst_block_metadata block_meta;
-    enum psa_sst_err_t err;
-    uint32_t meta_block;
+    uint32_t hole;
+    uint32_t home;
     uint32_t pos;
-    uint32_t scratch_block;
-    uint32_t size;
 
-    scratch_block = sst_meta_cur_meta_scratch();
-    meta_block = sst_meta_cur_meta_active();
+    hole = sst_index_find(ctx, uuid);
+    if (hole == SST_INDEX_TABLE_SIZE) {
+        return;
+    }
+
+    sst_index_set_free(ctx, ctx->index_table[hole].object_index, 1);
 
-    if (lblock != SST_LOGICAL_DBLOCK0) {
-        /* The objects' data in the logical block 0 is stored in same physical
-         * block where the metadata is stored. A change in the metadata requires
-         * a swap of physical blocks. So, the physical block ID of logical block
-         * 0 needs to be updated to reflect this change, if the object processed
-         * is not located in logical block 0. If it is located in block 0,
-         * the physical block ID has been updated while processing the object's
-         * data.
-         */
-        err = sst_meta_read_block_metadata(SST_LOGICAL_DBLOCK0, &block_meta);
-        if (err != PSA_SST_ERR_SUCCESS) {
-            return PSA_SST_ERR_SYSTEM_ERROR;
+    /* Shift back the following entries of the probing sequence, so that no
+     * tombstones are needed to keep the rest of the entries reachable.
+     */
+    pos = hole;
+    for (;;) {
+        pos = ((pos + 1) % SST_INDEX_TABLE_SIZE);
+        if (ctx->index_table[pos].object_index == SST_INDEX_EMPTY_ENTRY) {
+            break;
         }
 
-        /* Update physical ID for logical block 0 to match with the
-         * metadata block physical ID.
-         */
-        block_meta.phys_id = scratch_block;
-        err = sst_mblock_update_scratch_block_meta(SST_LOGICAL_DBLOCK0,
-                                                   &block_meta);
-        if (err != PSA_SST_ERR_SUCCESS) {
-            return PSA_SST_ERR_SYSTEM_ERROR;
-        }
+        home = sst_index_hash(ctx->index_table[pos].uuid);
 
-        /* Copy the rest of metadata blocks between logical block 0 and
-         * the logical block provided in the function.
+        /* The entry can fill the hole only if its home position is not
+         * cyclically located in (hole, pos].
          */
-        size = ((lblock-1)*sizeof(struct sst_block_metadata));
-        if (size > 0) {
-            pos = sizeof(struct sst_metadata_block_header);
-            pos += sizeof(struct sst_block_metadata);
-
-            /* Copy rest of the block data from previous block */
-            /* Data before updated content */
-            err = sst_flash_block_to_block_move(scratch_block, pos, meta_block,
-                                                pos, size);
-            if (err != PSA_SST_ERR_SUCCESS) {
-                return err;
-            }
+        if ((hole < pos) ? ((home <= hole) || (home > pos)) :
+                           ((home <= hole) && (home > pos))) {
+            ctx->index_table[hole] = ctx->index_table[pos];
+            hole = pos;
         }
     }
 
-    /* Data after updated content */
-    pos = sst_meta_block_meta_offset(lblock+1);
-
-    size = sst_meta_object_meta_offset(0) - pos;
-
-    err = sst_flash_block_to_block_move(scratch_block, pos,
-                                        meta_block, pos, size);
-
-    return err;
+    ctx->index_table[hole].uuid = SST_INVALID_UUID;
+    ctx->index_table[hole].object_index = SST_INDEX_EMPTY_ENTRY;
 }
 
 /**
- * \brief Reads the object's content
+ * \brief Builds the object index from the active metadata block
  *
- * \param[in]  meta    Object's metadata
- * \param[in]  offset  Offset in the object
- * \param[in]  size    Size to be read
- * \param[out] buf     Buffer pointer to store the data
+ * \details The first extent of each object is indexed. The extents' chains
+ *          are checked, so that each extent in use belongs to a single object.
  *
  * \return Returns error code as specified in \ref psa_sst_err_t
  */
-static enum psa_sst_err_t sst_block_object_read_raw(struct sst_assetmeta *meta,
-                                                    uint32_t offset,
-                                                    uint32_t size,
-                                                    uint8_t *buf)
+static enum psa_sst_err_t sst_index_build(struct sst_core_ctx_t *ctx)
 {
-    enum psa_sst_err_t err;
-    uint32_t phys_block;
-    uint32_t pos;
+    uint32_t is_next[SST_FREE_OBJ_BITMAP_WORDS];
+    const struct sst_assetmeta *object_meta;
+    uint32_t nbr_extents = 0;
+    uint32_t nbr_chained = 0;
+    uint32_t mask;
+    uint32_t word;
+    uint32_t i;
+    uint32_t j;
 
-    phys_block = sst_dblock_lo_to_phy(meta->lblock);
-    if (phys_block == SST_BLOCK_INVALID_ID) {
-        return PSA_SST_ERR_SYSTEM_ERROR;
+    for (i = 0; i < SST_INDEX_TABLE_SIZE; i++) {
+        ctx->index_table[i].uuid = SST_INVALID_UUID;
+        ctx->index_table[i].object_index = SST_INDEX_EMPTY_ENTRY;
     }
-    pos = (meta->data_index + offset);
 
-    err = sst_flash_read(phys_block, buf, pos, size);
+    sst_utils_memset(is_next, 0, sizeof(is_next));
 
-    return err;
-}
+    object_meta = sst_meta_cur_table(ctx)->object_meta;
 
-#ifdef SST_ENCRYPTION
-/**
- * \brief Gets the length of metadata to be authenticated
- *        which is total metadata size minus the size of MAC
- *        in the beginning
- *
- * \return Size of autheticated metadata block memory
- */
-static uint32_t authenticated_meta_data_size(void)
-{
-    uint32_t auth_size;
+    /* Mark the extents which follow another extent of their object */
+    for (i = 0; i < SST_NUM_OBJECT_ENTRIES; i++) {
+        if (sst_utils_validate_uuid(object_meta[i].unique_id) !=
+                                                          PSA_SST_ERR_SUCCESS) {
+            sst_index_set_free(ctx, i, 1);
+            continue;
+        }
 
-    auth_size = SST_ALL_METADATA_SIZE - SST_NON_AUTH_METADATA_SIZE;
+        sst_index_set_free(ctx, i, 0);
+        nbr_extents++;
 
-    return auth_size;
-}
+        j = object_meta[i].next;
+        if (j == SST_METADATA_INVALID_INDEX) {
+            continue;
+        }
 
-/**
- * \brief Generates metadata block's authentication and commit to flash
- *
- * \param[in] block_id  ID of the current metadata block to authenticate
- *
- * \return Returns error code as specified in \ref psa_sst_err_t
- */
-static enum psa_sst_err_t sst_meta_auth_and_update(uint32_t block_id)
-{
-    enum psa_sst_err_t err;
-    uint32_t size;
-    uint8_t *addr;
-    union sst_crypto_t *crypto = &sst_system_ctx.meta_block_header.crypto;
+        word = (j / SST_BITMAP_WORD_BITS);
+        mask = (1U << (j % SST_BITMAP_WORD_BITS));
 
-    /* Get new IV */
-    sst_crypto_get_iv(crypto);
+        /* An extent which is referenced twice, or which belongs to another
+         * object, means that the metadata is corrupted.
+         */
+        if ((j >= SST_NUM_OBJECT_ENTRIES) || ((is_next[word] & mask) != 0) ||
+            (object_meta[j].unique_id != object_meta[i].unique_id)) {
+            return PSA_SST_ERR_SYSTEM_ERROR;
+        }
 
-    /* Get size and address of authenticated part of metadata header */
-    size = sizeof(struct sst_metadata_block_header)
-           - SST_NON_AUTH_METADATA_SIZE;
+        is_next[word] |= mask;
+    }
 
-    addr = (uint8_t *)(&sst_system_ctx.meta_block_header)
-           + SST_AUTH_METADATA_OFFSET;
+    for (i = 0; i < SST_NUM_OBJECT_ENTRIES; i++) {
+        if ((sst_utils_validate_uuid(object_meta[i].unique_id) !=
+                                                         PSA_SST_ERR_SUCCESS) ||
+            ((is_next[i / SST_BITMAP_WORD_BITS] &
+              (1U << (i % SST_BITMAP_WORD_BITS))) != 0)) {
+            continue;
+        }
 
-    /* Commit metadata header to flash, except for the non-authenticated part */
-    err = sst_flash_write(block_id, addr, SST_AUTH_METADATA_OFFSET, size);
-    if (err != PSA_SST_ERR_SUCCESS) {
-        return err;
-    }
+        /* A UUID stored twice means that the metadata is corrupted */
+        if (sst_index_find(ctx, object_meta[i].unique_id) !=
+            SST_INDEX_TABLE_SIZE) {
+            return PSA_SST_ERR_SYSTEM_ERROR;
+        }
 
-    size = authenticated_meta_data_size();
-    addr = sst_data_buf;
+        sst_index_insert(ctx, object_meta[i].unique_id, i);
 
-    /* Read all metadata to be authenticated
-     * FIXME: no need to read back metadata header we just wrote.
-     */
-    err = sst_flash_read(block_id, addr, SST_AUTH_METADATA_OFFSET, size);
-    if (err != PSA_SST_ERR_SUCCESS) {
-        return err;
+        for (j = i; j != SST_METADATA_INVALID_INDEX; j = object_meta[j].next) {
+            nbr_chained++;
+        }
     }
 
-    err = sst_crypto_getkey(sst_system_ctx.sst_key, SST_KEY_LEN_BYTES);
-    if (err != PSA_SST_ERR_SUCCESS) {
-        return err;
+    /* Extents which are not chained to the first extent of an object mean
+     * that the metadata is corrupted.
+     */
+    if (nbr_chained != nbr_extents) {
+        return PSA_SST_ERR_SYSTEM_ERROR;
     }
 
-    err = sst_crypto_setkey(sst_system_ctx.sst_key, SST_KEY_LEN_BYTES);
-    if (err != PSA_SST_ERR_SUCCESS) {
-        return err;
-    }
+    return PSA_SST_ERR_SUCCESS;
+}
 
-    err = sst_crypto_generate_auth_tag(crypto, addr, size);
-    if (err != PSA_SST_ERR_SUCCESS) {
-        return err;
+/**
+ * \brief Gets a free object metadata table entry
+ *
+ * \return Return index of a free object meta entry
+ */
+static uint16_t sst_get_free_object_index(struct sst_core_ctx_t *ctx)
+{
+    uint32_t bit;
+    uint32_t word;
+
+    for (word = 0; word < SST_FREE_OBJ_BITMAP_WORDS; word++) {
+        if (ctx->free_obj_bitmap[word] != 0) {
+            for (bit = 0; bit < SST_BITMAP_WORD_BITS; bit++) {
+                if (ctx->free_obj_bitmap[word] & (1U << bit)) {
+                    /* Found */
+                    return (uint16_t)((word * SST_BITMAP_WORD_BITS) + bit);
+                }
+            }
+        }
     }
 
-    /* Commit non-authenticated part of metadata header to flash */
-    err = sst_flash_write(block_id, (uint8_t *)crypto, 0,
-                          SST_NON_AUTH_METADATA_SIZE);
-    return err;
+    return SST_METADATA_INVALID_INDEX;
 }
 
 /**
- * \brief Authenticates metadata block
+ * \brief Converts logical data block number to physical number
  *
- * \param[in] block  Pointer to authenticated metablock memory
+ * \param[in] lblock  Logical block number
  *
- * \return Return offset value in metadata block
+ * \return Return physical block number
  */
-enum psa_sst_err_t sst_mblock_authenticate(uint32_t block)
+static uint32_t sst_dblock_lo_to_phy(struct sst_core_ctx_t *ctx,
+                                     uint32_t lblock)
 {
-    struct sst_metadata_block_header *metablock_header;
-    enum psa_sst_err_t err = 0;
-    const uint8_t *addr;
-    uint32_t addr_len;
-
-    metablock_header = (struct sst_metadata_block_header *)sst_data_buf;
+    struct sst_block_metadata block_meta;
+    enum psa_sst_err_t err;
 
-    /* Read block table and lookups (all metadata and header) */
-    err = sst_flash_read(block, (uint8_t *)metablock_header, 0,
-                         SST_ALL_METADATA_SIZE);
+    err = sst_meta_read_block_metadata(ctx, lblock, &block_meta);
     if (err != PSA_SST_ERR_SUCCESS) {
-        return err;
+        return SST_BLOCK_INVALID_ID;
     }
 
-    /* Address position and size of the meta-data to be authenticated */
-    addr = sst_data_buf + SST_AUTH_METADATA_OFFSET;
-    addr_len = authenticated_meta_data_size();
+    return block_meta.phys_id;
+}
 
-    err = sst_crypto_getkey(sst_system_ctx.sst_key, SST_KEY_LEN_BYTES);
-    if (err != PSA_SST_ERR_SUCCESS) {
-        return err;
-    }
+/**
+ * \brief Gets the space taken by the objects stored in a logical block
+ *
+ * \param[in] lblock  Logical block number
+ *
+ * \return Returns the size of the objects' space, aligned with the flash
+ *         program unit, according to the scratch metadata
+ */
+static uint32_t sst_dblock_live_size(struct sst_core_ctx_t *ctx,
+                                     uint32_t lblock)
+{
+    const struct sst_assetmeta *object_meta;
+    uint32_t live_size = 0;
+    uint32_t i;
 
-    err = sst_crypto_setkey(sst_system_ctx.sst_key, SST_KEY_LEN_BYTES);
-    if (err != PSA_SST_ERR_SUCCESS) {
-        return err;
+    for (i = 0; i < SST_NUM_OBJECT_ENTRIES; i++) {
+        object_meta = &ctx->meta_scratch.object_meta[i];
+        if ((object_meta->lblock == lblock) &&
+            (sst_utils_validate_uuid(object_meta->unique_id) ==
+                                                         PSA_SST_ERR_SUCCESS)) {
+            live_size += sst_get_aligned_flash_bytes(object_meta->max_size);
+        }
     }
 
-    /* Authenticate meta-data */
-    err = sst_crypto_authenticate(&metablock_header->crypto, addr, addr_len);
-
-    return err;
+    return live_size;
 }
-#endif
 
 /**
- * \brief Checks the validity of the metadata block's swap count
+ * \brief Checks if a flash area is erased, so that it can be programmed
  *
- * \param[in] swap_count  Swap count to validate
+ * \param[in] block_id  Physical block ID
+ * \param[in] offset    Offset in the block
+ * \param[in] size      Size of the area
  *
- * \return Returns error code as specified in \ref psa_sst_err_t
+ * \return Returns PSA_SST_ERR_SUCCESS if the area is erased. Otherwise, it
+ *         returns PSA_SST_ERR_SYSTEM_ERROR
  */
-static enum psa_sst_err_t sst_meta_validate_swap_count(uint8_t swap_count)
+static enum psa_sst_err_t sst_dblock_check_erased(struct sst_core_ctx_t *ctx,
+                                                  uint32_t block_id,
+                                                  uint32_t offset,
+                                                  uint32_t size)
 {
-    enum psa_sst_err_t err = PSA_SST_ERR_SUCCESS;
+    uint8_t buf[SST_ERASED_CHECK_BUF_SIZE];
+    enum psa_sst_err_t err;
+    uint32_t chunk_size;
+    uint32_t i;
 
-    /* When a flash block is erased, the default value
-     * is usually 0xFF (i.e. all 1s). Since the swap count
-     * is updated last (when encryption is disabled), it is
-     * possible that due to a power failure, the swap count
-     * value in metadata header is 0xFFFF..., which mean
-     * it will appear to be most recent block. Which isn't
-     * a problem in itself, as the rest of the metadata is fully
-     * valid (as it would have been written before swap count).
-     * However, this also means that previous update process
-     * wasn't complete. So, if the value is 0xFF..., revert
-     * back to previous metablock instead.
-     */
-    if (swap_count == SST_FLASH_DEFAULT_VAL) {
-        err = PSA_SST_ERR_SYSTEM_ERROR;
+    while (size > 0) {
+        chunk_size = (size < SST_ERASED_CHECK_BUF_SIZE) ?
+                     size : SST_ERASED_CHECK_BUF_SIZE;
+
+        err = sst_flash_read(ctx->area_id, block_id, buf, offset, chunk_size);
+        if (err != PSA_SST_ERR_SUCCESS) {
+            return PSA_SST_ERR_SYSTEM_ERROR;
+        }
+
+        for (i = 0; i < chunk_size; i++) {
+            if (buf[i] != SST_FLASH_DEFAULT_VAL) {
+                return PSA_SST_ERR_SYSTEM_ERROR;
+            }
+        }
+
+        offset += chunk_size;
+        size -= chunk_size;
     }
 
-    return err;
+    return PSA_SST_ERR_SUCCESS;
 }
 
 /**
- * \brief Checks the validatity FS version
+ * \brief Checks if the data appended to an object can be programmed in place,
+ *        in the erased space which follows the object's content in its space
  *
- * \param[in] swap_count  Swap count to validate
+ * \details The appended data must start at a flash program unit boundary,
+ *          as a program unit which holds committed content can not be
+ *          programmed again: it is not allowed by the flashes with ECC, and a
+ *          power failure during the program could corrupt the committed
+ *          content.
  *
- * \return Returns error code as specified in \ref psa_sst_err_t
+ * \param[in] meta      Pointer to the object metadata
+ * \param[in] block_id  Physical block ID where the object is stored
+ * \param[in] offset    Offset in the object where the data is appended
+ * \param[in] size      Size of the appended data
+ *
+ * \return Returns PSA_SST_ERR_SUCCESS if the data can be programmed in place.
+ *         Otherwise, it returns PSA_SST_ERR_SYSTEM_ERROR
  */
-static enum psa_sst_err_t sst_meta_validate_fs_version(uint8_t fs_version)
+static enum psa_sst_err_t sst_dblock_check_append(
+                                              struct sst_core_ctx_t *ctx,
+                                              const struct sst_assetmeta *meta,
+                                              uint32_t block_id,
+                                              uint32_t offset, uint32_t size)
 {
-    enum psa_sst_err_t err = PSA_SST_ERR_SUCCESS;
+    uint32_t pos;
 
-    /* Looks for exact version number.
-     * FIXME: backward compatibility could be considered in future revisions.
-     */
-    if (fs_version != SST_SUPPORTED_VERSION) {
-        err = PSA_SST_ERR_SYSTEM_ERROR;
+    if ((size == 0) || (offset != meta->cur_size) ||
+        (size > (meta->max_size - offset)) ||
+        ((offset % SST_FLASH_PROGRAM_UNIT) != 0)) {
+        return PSA_SST_ERR_SYSTEM_ERROR;
     }
 
-    return err;
+    pos = (meta->data_index + offset);
+
+    return sst_dblock_check_erased(ctx, block_id, pos,
+                                   (meta->data_index +
+                                    sst_get_aligned_flash_bytes(offset + size) -
+                                    pos));
 }
 
 /**
- * \brief Validates header metadata in order to guarantee that a corruption or
- *        malicious change in stored metadata doesn't result in an invalid
- *        access and the header version is correct.
+ * \brief Programs the data appended to an object in place. Only the flash
+ *        program units which contain the appended data are programmed.
  *
- * \param[in] meta  Pointer to metadata block header
+ * \param[in] meta      Pointer to the object metadata
+ * \param[in] block_id  Physical block ID where the object is stored
+ * \param[in] data      Pointer to the appended data
+ * \param[in] offset    Offset in the object where the data is appended
+ * \param[in] size      Size of the appended data
+ *
+ * \note \ref sst_dblock_check_append must have been called to check that the
+ *       area is erased and that the offset is aligned to the flash program
+ *       unit.
  *
  * \return Returns error code as specified in \ref psa_sst_err_t
  */
-static enum psa_sst_err_t sst_meta_validate_header_meta(
-                                         struct sst_metadata_block_header *meta)
+static enum psa_sst_err_t sst_dblock_append(struct sst_core_ctx_t *ctx,
+                                            const struct sst_assetmeta *meta,
+                                            uint32_t block_id,
+                                            const uint8_t *data,
+                                            uint32_t offset, uint32_t size)
 {
-    enum psa_sst_err_t err;
+    uint8_t unit[SST_FLASH_PROGRAM_UNIT];
+    enum psa_sst_err_t err = PSA_SST_ERR_SUCCESS;
+    uint32_t chunk_size;
+    uint32_t pos;
 
-    err = sst_meta_validate_fs_version(meta->fs_version);
-    if (err == PSA_SST_ERR_SUCCESS) {
-        err = sst_meta_validate_swap_count(meta->active_swap_count);
+    pos = (meta->data_index + offset);
+
+    /* Program the whole units straight from the given data */
+    chunk_size = (size - (size % SST_FLASH_PROGRAM_UNIT));
+    if (chunk_size > 0) {
+        err = sst_flash_write(ctx->area_id, block_id, data, pos, chunk_size);
+        if (err != PSA_SST_ERR_SUCCESS) {
+            return err;
+        }
+
+        data += chunk_size;
+        size -= chunk_size;
+        pos += chunk_size;
+    }
+
+    /* Program the last unit, padded with the erased value */
+    if (size > 0) {
+        sst_utils_memset(unit, SST_FLASH_DEFAULT_VAL, SST_FLASH_PROGRAM_UNIT);
+        sst_utils_memcpy(unit, data, size);
+        err = sst_flash_write(ctx->area_id, block_id, unit, pos,
+                              SST_FLASH_PROGRAM_UNIT);
     }
 
     return err;
 }
 
 /**
- * \brief Writes the scratch metadata's header
+ * \brief Programs the new content of an object extent in erased space
+ *
+ * \details The new content is streamed through a small buffer, in which the
+ *          current content kept by the update is read and patched with the
+ *          written data. The padding of the last flash program unit is
+ *          programmed with the erased value.
+ *
+ * \param[in] dst_block  Physical block ID where the new content is programmed
+ * \param[in] dst_pos    Offset in the block where the new content is
+ *                       programmed
+ * \param[in] src_block  Physical block ID where the current content is stored
+ * \param[in] src_pos    Offset of the current content in the block
+ * \param[in] new_size   Size of the new content
+ * \param[in] patch      Pointer to the extent's patch
  *
  * \return Returns error code as specified in \ref psa_sst_err_t
  */
-static enum psa_sst_err_t sst_meta_write_scratch_meta_header(void)
+static enum psa_sst_err_t sst_dblock_write_patch(struct sst_core_ctx_t *ctx,
+                                                 uint32_t dst_block,
+                                                 uint32_t dst_pos,
+                                                 uint32_t src_block,
+                                                 uint32_t src_pos,
+                                                 uint32_t new_size,
+                                          const struct sst_obj_patch_t *patch)
 {
+    uint8_t buf[SST_PATCH_BUF_SIZE];
     enum psa_sst_err_t err;
-    uint32_t scratch_metablock;
-#ifndef SST_ENCRYPTION
-    size_t swap_count_offset;
-#endif
+    uint32_t chunk_size;
+    uint32_t data_end;
+    uint32_t start;
+    uint32_t end;
+    uint32_t pos;
 
-    scratch_metablock = sst_meta_cur_meta_scratch();
+    new_size = sst_get_aligned_flash_bytes(new_size);
+    data_end = (patch->offset + patch->size);
 
-    /* Increment the swap count */
-    sst_system_ctx.meta_block_header.active_swap_count += 1;
+    for (pos = 0; pos < new_size; pos += chunk_size) {
+        chunk_size = ((new_size - pos) < SST_PATCH_BUF_SIZE) ?
+                     (new_size - pos) : SST_PATCH_BUF_SIZE;
 
-    err = sst_meta_validate_swap_count(
-                        sst_system_ctx.meta_block_header.active_swap_count);
-    if (err != PSA_SST_ERR_SUCCESS) {
-        /* Reset the swap count to 0 */
-        sst_system_ctx.meta_block_header.active_swap_count = 0;
-    }
+        sst_utils_memset(buf, SST_FLASH_DEFAULT_VAL, chunk_size);
 
-#ifdef SST_ENCRYPTION
-    err = sst_meta_auth_and_update(scratch_metablock);
-#else
-    /* In case of no encryption, the swap count decides the latest metadata
-     * block, so it is programmed last.
+        /* Current content before the written data */
+        end = (patch->offset < patch->keep_size) ?
+              patch->offset : patch->keep_size;
+        if (end > (pos + chunk_size)) {
+            end = (pos + chunk_size);
+        }
+        if (pos < end) {
+            err = sst_flash_read(ctx->area_id, src_block, buf,
+                                 (src_pos + pos), (end - pos));
+            if (err != PSA_SST_ERR_SUCCESS) {
+                return err;
+            }
+        }
+
+        /* Current content after the written data */
+        start = (data_end > pos) ? data_end : pos;
+        end = (patch->keep_size < (pos + chunk_size)) ?
+              patch->keep_size : (pos + chunk_size);
+        if (start < end) {
+            err = sst_flash_read(ctx->area_id, src_block, &buf[start - pos],
+                                 (src_pos + start), (end - start));
+            if (err != PSA_SST_ERR_SUCCESS) {
+                return err;
+            }
+        }
+
+        /* Written data */
+        start = (patch->offset > pos) ? patch->offset : pos;
+        end = (data_end < (pos + chunk_size)) ? data_end : (pos + chunk_size);
+        if (start < end) {
+            sst_utils_memcpy(&buf[start - pos],
+                             &patch->data[start - patch->offset],
+                             (end - start));
+        }
+
+        err = sst_flash_write(ctx->area_id, dst_block, buf, (dst_pos + pos),
+                              chunk_size);
+        if (err != PSA_SST_ERR_SUCCESS) {
+            return err;
+        }
+    }
+
+    return PSA_SST_ERR_SUCCESS;
+}
+
+/**
+ * \brief Counts an erase of a physical block in the scratch metadata
+ *
+ * \param[in] block_id  Physical block ID
+ */
+static void sst_meta_count_erase(struct sst_core_ctx_t *ctx, uint32_t block_id)
+{
+    /* The counter saturates instead of wrapping around */
+    if (ctx->meta_scratch.erase_count[block_id] != UINT32_MAX) {
+        ctx->meta_scratch.erase_count[block_id]++;
+    }
+}
+
+/**
+ * \brief Checks if a physical block holds the data of a logical block
+ *        other than the logical block 0, according to the given metadata
+ *
+ * \param[in] table     Pointer to the metadata
+ * \param[in] block_id  Physical block ID
+ *
+ * \return Returns 1 if the block holds data of a logical block, 0 otherwise
+ */
+static uint32_t sst_dblock_is_mapped(struct sst_core_ctx_t *ctx,
+                                     const struct sst_metadata_table_t *table,
+                                     uint32_t block_id)
+{
+    uint32_t lblock;
+
+    for (lblock = (SST_LOGICAL_DBLOCK0 + 1); lblock < ctx->nbr_active_dblocks;
+         lblock++) {
+        if (table->block_meta[lblock].phys_id == block_id) {
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * \brief Computes the hash of the RAM copy of the active metadata
+ *
+ * \return Returns the 32-bit FNV-1a hash of the active metadata
+ */
+static uint32_t sst_ckpt_meta_hash(struct sst_core_ctx_t *ctx)
+{
+    const uint8_t *meta = (const uint8_t *)&ctx->meta_active;
+    uint32_t hash = SST_CKPT_HASH_BASIS;
+    uint32_t i;
+
+    for (i = 0; i < SST_ALL_METADATA_SIZE; i++) {
+        hash = ((hash ^ meta[i]) * SST_CKPT_HASH_PRIME);
+    }
+
+    return hash;
+}
+
+/**
+ * \brief Appends a checkpoint record to the journal of the active metadata
+ *        block
+ *
+ * \param[in] erased_blocks  Bitmap of the erased physical blocks. The
+ *                           checkpoint is not live if it is 0.
+ *
+ * \return Returns error code as specified in \ref psa_sst_err_t
+ */
+static enum psa_sst_err_t sst_ckpt_append(struct sst_core_ctx_t *ctx,
+                                          uint32_t erased_blocks)
+{
+    struct sst_journal_record_t record;
+    enum psa_sst_err_t err;
+    uint32_t offset;
+
+    sst_utils_memset(&record, SST_FLASH_DEFAULT_VAL,
+                     sizeof(struct sst_journal_record_t));
+    record.type = SST_JOURNAL_CHECKPOINT;
+    record.index = 0;
+    record.data.ckpt.seq = ctx->sys.journal_seq;
+    record.data.ckpt.erased_blocks = erased_blocks;
+    record.data.ckpt.meta_hash = sst_ckpt_meta_hash(ctx);
+
+    offset = SST_JOURNAL_OFFSET + (ctx->sys.journal_next_record *
+                                   sizeof(struct sst_journal_record_t));
+
+    /* The previous checkpoint is stale, whether the record is programmed or
+     * not.
+     */
+    ctx->ckpt_live = 0;
+
+    err = sst_flash_write(ctx->area_id, sst_meta_cur_meta_active(ctx),
+                          (uint8_t *)&record, offset,
+                          sizeof(struct sst_journal_record_t));
+    if (err == PSA_SST_ERR_SUCCESS) {
+        /* The checkpoint ends an update, so it is not left pending in the
+         * flash interface.
+         */
+        err = sst_flash_flush(ctx->area_id);
+    }
+
+    if (err != PSA_SST_ERR_SUCCESS) {
+        /* The journal can not be appended after a partial record */
+        ctx->sys.journal_next_record = SST_JOURNAL_NUM_RECORDS;
+        return err;
+    }
+
+    ctx->sys.journal_next_record++;
+
+    sst_utils_memcpy(&ctx->ckpt, &record.data.ckpt,
+                     sizeof(struct sst_journal_ckpt_t));
+    ctx->ckpt_live = (erased_blocks != 0);
+
+    return PSA_SST_ERR_SUCCESS;
+}
+
+/**
+ * \brief Invalidates the live checkpoint before a block it records as erased
+ *        is programmed
+ *
+ * \details An update which is interrupted by a reset may have programmed the
+ *          block without appending any record to the journal. A checkpoint
+ *          which records no erased block is appended, so that the next mount
+ *          does not rely on the erased state of the block.
+ *
+ * \param[in] block_id  Physical block ID
+ *
+ * \return Returns error code as specified in \ref psa_sst_err_t
+ */
+static enum psa_sst_err_t sst_ckpt_invalidate(struct sst_core_ctx_t *ctx,
+                                              uint32_t block_id)
+{
+    if ((ctx->ckpt_live == 0) || (block_id >= SST_CKPT_MAX_BLOCKS) ||
+        ((ctx->ckpt.erased_blocks & (1U << block_id)) == 0)) {
+        return PSA_SST_ERR_SUCCESS;
+    }
+
+    return sst_ckpt_append(ctx, 0);
+}
+
+/**
+ * \brief Restores the erased state of the blocks from the live checkpoint
+ *
+ * \details The checkpoint is stale if the active metadata has changed since
+ *          it was taken, or if it records a block which stores data as
+ *          erased. In that case, the state of all the blocks is left dirty.
+ *
+ * \note It must be called once the active metadata has been loaded.
+ */
+static void sst_ckpt_restore(struct sst_core_ctx_t *ctx)
+{
+    const struct sst_compact_cursor_t *cursor = &ctx->meta_active.compact;
+    uint32_t i;
+
+    if (ctx->ckpt_live == 0) {
+        return;
+    }
+
+    if (ctx->ckpt.meta_hash != sst_ckpt_meta_hash(ctx)) {
+        ctx->ckpt_live = 0;
+        return;
+    }
+
+    for (i = 0; i < ctx->nbr_blocks; i++) {
+        if ((i >= SST_CKPT_MAX_BLOCKS) ||
+            ((ctx->ckpt.erased_blocks & (1U << i)) == 0)) {
+            continue;
+        }
+
+        if ((i == sst_meta_cur_meta_active(ctx)) ||
+            sst_dblock_is_mapped(ctx, &ctx->meta_active, i) ||
+            ((cursor->lblock != SST_COMPACT_NO_LBLOCK) &&
+             (cursor->phys_id == i))) {
+            ctx->ckpt_live = 0;
+            return;
+        }
+    }
+
+    for (i = 0; (i < ctx->nbr_blocks) && (i < SST_CKPT_MAX_BLOCKS);
+         i++) {
+        if ((ctx->ckpt.erased_blocks & (1U << i)) != 0) {
+            ctx->block_state[i] = SST_BLOCK_ERASED;
+        }
+    }
+}
+
+/**
+ * \brief Discards the incremental compaction in the scratch metadata
+ */
+static void sst_compact_cancel(struct sst_core_ctx_t *ctx)
+{
+    struct sst_compact_cursor_t *cursor = &ctx->meta_scratch.compact;
+
+    if (cursor->lblock == SST_COMPACT_NO_LBLOCK) {
+        return;
+    }
+
+    /* The progress of the compaction is not kept in the destination block */
+    if (ctx->block_state[cursor->phys_id] == SST_BLOCK_COMPACT) {
+        ctx->block_state[cursor->phys_id] = SST_BLOCK_DIRTY;
+    }
+
+    sst_utils_memset(cursor, SST_FLASH_DEFAULT_VAL,
+                     sizeof(struct sst_compact_cursor_t));
+}
+
+/**
+ * \brief Gets a scratch block ready to be programmed by the update in
+ *        progress
+ *
+ * \details The block is erased if it has not been erased since it was
+ *          retired. Once a block has been claimed, the next claims done by
+ *          the same update do not erase it.
+ *
+ * \param[in] block_id  Physical block ID of the scratch block
+ *
+ * \return Returns error code as specified in \ref psa_sst_err_t
+ */
+static enum psa_sst_err_t sst_scratch_claim(struct sst_core_ctx_t *ctx,
+                                            uint32_t block_id)
+{
+    enum psa_sst_err_t err;
+
+    /* The update discards the incremental compaction whose destination block
+     * is needed.
+     */
+    if ((ctx->meta_scratch.compact.lblock != SST_COMPACT_NO_LBLOCK) &&
+        (ctx->meta_scratch.compact.phys_id == block_id)) {
+        sst_compact_cancel(ctx);
+    }
+
+    err = sst_ckpt_invalidate(ctx, block_id);
+    if (err != PSA_SST_ERR_SUCCESS) {
+        return err;
+    }
+
+    if (ctx->block_state[block_id] == SST_BLOCK_DIRTY) {
+        err = sst_flash_erase_block(ctx->area_id, block_id);
+        if (err != PSA_SST_ERR_SUCCESS) {
+            return err;
+        }
+    }
+
+    ctx->block_state[block_id] = SST_BLOCK_IN_USE;
+
+    return PSA_SST_ERR_SUCCESS;
+}
+
+/**
+ * \brief Marks the scratch blocks claimed by the last update as dirty, and
+ *        the destination block of an incremental compaction which is not
+ *        stored in the active metadata
+ *
+ * \note It is called when an update ends, whether it has been committed or
+ *       not. Once committed, the claimed blocks hold the updated data.
+ */
+static void sst_scratch_release(struct sst_core_ctx_t *ctx)
+{
+    const struct sst_compact_cursor_t *cursor = &ctx->meta_active.compact;
+    uint32_t i;
+
+    for (i = 0; i < ctx->nbr_blocks; i++) {
+        if ((ctx->block_state[i] == SST_BLOCK_IN_USE) ||
+            ((ctx->block_state[i] == SST_BLOCK_COMPACT) &&
+             ((cursor->lblock == SST_COMPACT_NO_LBLOCK) ||
+              (cursor->phys_id != i)))) {
+            ctx->block_state[i] = SST_BLOCK_DIRTY;
+        }
+    }
+}
+
+/**
+ * \brief Selects the scratch data block for the next data block compaction
+ *        among the data blocks which are not used by the scratch metadata
+ *
+ * \details A block which is not used by the active metadata either is
+ *          preferred, so that it can be used by the update in progress. Then,
+ *          an erased block is preferred, so that the next compaction does not
+ *          have to erase it, and then the least erased block. The destination
+ *          block of the incremental compaction is not selected.
+ */
+static void sst_dblock_select_scratch(struct sst_core_ctx_t *ctx)
+{
+    const struct sst_compact_cursor_t *cursor = &ctx->meta_scratch.compact;
+    uint32_t best_id = ctx->nbr_blocks;
+    uint32_t rank;
+    uint32_t best_rank = 0;
+    uint32_t i;
+
+    if (ctx->nbr_dedicated_dblocks == 0) {
+        return;
+    }
+
+    for (i = ctx->init_scratch_dblock; i < ctx->nbr_blocks; i++) {
+        if (sst_dblock_is_mapped(ctx, &ctx->meta_scratch, i) ||
+            ((cursor->lblock != SST_COMPACT_NO_LBLOCK) &&
+             (cursor->phys_id == i))) {
+            continue;
+        }
+
+        rank = ((sst_dblock_is_mapped(ctx, &ctx->meta_active, i) == 0) << 1) |
+               (ctx->block_state[i] == SST_BLOCK_ERASED);
+        if ((best_id == ctx->nbr_blocks) || (rank > best_rank) ||
+            ((rank == best_rank) &&
+             (ctx->meta_scratch.erase_count[i] <
+              ctx->meta_scratch.erase_count[best_id]))) {
+            best_id = i;
+            best_rank = rank;
+        }
+    }
+
+    ctx->sys.meta_block_header.scratch_idx = best_id;
+}
+
+/**
+ * \brief Erases the scratch blocks which have been retired by the update
+ *        operations and have not been erased yet
+ *
+ * \return Returns error code as specified in \ref psa_sst_err_t
+ */
+static enum psa_sst_err_t sst_scratch_erase_retired(struct sst_core_ctx_t *ctx)
+{
+    enum psa_sst_err_t err;
+    uint32_t scratch_metablock;
+    uint32_t i;
+
+    scratch_metablock = sst_meta_cur_meta_scratch(ctx);
+
+    /* For the atomicity of the data update process
+     * and power-failure-safe operation, it is necessary that
+     * metadata scratch block is erased before data block.
+     */
+    if (ctx->block_state[scratch_metablock] == SST_BLOCK_DIRTY) {
+        err = sst_flash_erase_block(ctx->area_id, scratch_metablock);
+        if (err != PSA_SST_ERR_SUCCESS) {
+            return err;
+        }
+        ctx->block_state[scratch_metablock] = SST_BLOCK_ERASED;
+    }
+
+    /* If the number of total blocks is not bigger than 2, it means there are
+     * not blocks which contains only data, and all data is stored in the
+     * same block where the meta data is stored. If the number of blocks
+     * is bigger than 2, the code needs to erase the scratch blocks used
+     * to process any change in the data blocks which contain only data.
+     */
+    if (ctx->nbr_blocks > 2) {
+        for (i = ctx->init_scratch_dblock; i < ctx->nbr_blocks; i++) {
+            if ((ctx->block_state[i] != SST_BLOCK_DIRTY) ||
+                sst_dblock_is_mapped(ctx, &ctx->meta_active, i)) {
+                continue;
+            }
+
+            /* The destination block of the incremental compaction keeps its
+             * progress.
+             */
+            if ((ctx->meta_active.compact.lblock != SST_COMPACT_NO_LBLOCK) &&
+                (ctx->meta_active.compact.phys_id == i)) {
+                continue;
+            }
+
+            err = sst_flash_erase_block(ctx->area_id, i);
+            if (err != PSA_SST_ERR_SUCCESS) {
+                return err;
+            }
+            ctx->block_state[i] = SST_BLOCK_ERASED;
+        }
+    }
+
+    return PSA_SST_ERR_SUCCESS;
+}
+
+/**
+ * \brief Initializes the RAM copy of the scratch metadata with the content of
+ *        the active metadata
+ *
+ * \note It must be called at the beginning of each update operation, before
+ *       any change is done in the scratch metadata. It has no effect while a
+ *       transaction is active.
+ */
+static void sst_mblock_init_scratch_meta(struct sst_core_ctx_t *ctx)
+{
+    /* While a transaction is active, the scratch metadata contains the
+     * transaction's updates.
+     */
+    if (ctx->txn_state == SST_TXN_ACTIVE) {
+        return;
+    }
+
+    /* The scratch blocks claimed by a previous update which has failed are
+     * dirty, and the scratch data block selected by that update is not used.
+     */
+    sst_scratch_release(ctx);
+
+    sst_utils_memcpy(&ctx->meta_scratch, &ctx->meta_active,
+                     SST_ALL_METADATA_SIZE);
+    ctx->sys.meta_block_header.scratch_idx =
+                                           ctx->meta_active.header.scratch_idx;
+}
+
+/**
+ * \brief Writes a metadata entry into scratch metadata
+ *
+ * \param[in] object_index  Object's index in the metadata table
+ * \param[in] obj_meta      Metadata pointer
+ *
+ * \return Returns error code as specified in \ref psa_sst_err_t
+ */
+static enum psa_sst_err_t sst_mblock_update_scratch_object_meta(
+                                                 struct sst_core_ctx_t *ctx,
+                                                 uint32_t object_index,
+                                                 struct sst_assetmeta *obj_meta)
+{
+    if (object_index >= SST_NUM_OBJECT_ENTRIES) {
+        return PSA_SST_ERR_SYSTEM_ERROR;
+    }
+
+    sst_utils_memcpy(&ctx->meta_scratch.object_meta[object_index], obj_meta,
+                     sizeof(struct sst_assetmeta));
+
+    return PSA_SST_ERR_SUCCESS;
+}
+
+/**
+ * \brief Puts logical block's metadata in scratch metadata
+ *
+ * \param[in] lblock      Logical block number
+ * \param[in] block_meta  Pointer to block's metadata
+ *
+ * \return Returns error code as specified in \ref psa_sst_err_t
+ */
+static enum psa_sst_err_t sst_mblock_update_scratch_block_meta(
+                                          struct sst_core_ctx_t *ctx,
+                                          uint32_t lblock,
+                                          struct sst_block_metadata *block_meta)
+{
+    if (lblock >= ctx->nbr_active_dblocks) {
+        return PSA_SST_ERR_SYSTEM_ERROR;
+    }
+
+    sst_utils_memcpy(&ctx->meta_scratch.block_meta[lblock], block_meta,
+                     sizeof(struct sst_block_metadata));
+
+    return PSA_SST_ERR_SUCCESS;
+}
+
+/**
+ * \brief Sets the scratch block, in which the new data of a logical block has
+ *        been programmed, as the logical block's physical block in the scratch
+ *        metadata
+ *
+ * \details The previous physical block of the logical block is retired, and
+ *          its erase, which is done before it is reused, is counted. For the
+ *          logical blocks other than the logical block 0, the scratch data
+ *          block of the next compaction is selected.
+ *
+ * \param[in] lblock         Logical block number
+ * \param[in] block_meta     Pointer to the logical block's new metadata, which
+ *                           still contains the previous physical block ID
+ * \param[in] scratch_block  Physical ID of the scratch block
+ */
+static void sst_dblock_swap_scratch(struct sst_core_ctx_t *ctx,
+                                    uint32_t lblock,
+                                    struct sst_block_metadata *block_meta,
+                                    uint32_t scratch_block)
+{
+    if (lblock != SST_LOGICAL_DBLOCK0) {
+        sst_meta_count_erase(ctx, block_meta->phys_id);
+    }
+
+    block_meta->phys_id = scratch_block;
+    sst_utils_memcpy(&ctx->meta_scratch.block_meta[lblock], block_meta,
+                     sizeof(struct sst_block_metadata));
+
+    if (lblock != SST_LOGICAL_DBLOCK0) {
+        sst_dblock_select_scratch(ctx);
+    }
+}
+
+/**
+ * \brief Compacts the data of a logical block in its scratch block
+ *
+ * \details The objects stored in the logical block are copied one after the
+ *          other from the beginning of the block's data, so that the space of
+ *          the objects' previous contents and of the deleted objects is
+ *          reclaimed. The objects' location is updated in the scratch metadata
+ *          and the scratch and current data blocks are swapped.
+ *
+ * \param[in] lblock     Logical block to compact
+ * \param[in] obj_index  Index of the object extent for which the given new
+ *                       content is written instead of its current content, or
+ *                       SST_METADATA_INVALID_INDEX
+ * \param[in] patch      Pointer to the extent's new content, or NULL
+ *
+ * \return Returns PSA_SST_ERR_STORAGE_SYSTEM_FULL if the update has already
+ *         used the scratch block, and no other one is available. Otherwise,
+ *         it returns error code as specified in \ref psa_sst_err_t
+ */
+static enum psa_sst_err_t sst_compact_dblock(struct sst_core_ctx_t *ctx,
+                                             uint32_t lblock,
+                                             uint32_t obj_index,
+                                        const struct sst_obj_patch_t *patch)
+{
+    struct sst_block_metadata block_meta;
+    struct sst_assetmeta *object_meta;
+    enum psa_sst_err_t err = PSA_SST_ERR_SUCCESS;
+    uint32_t scratch_dblock_id;
+    uint32_t pos;
+    uint32_t i;
+
+    if (lblock >= ctx->nbr_active_dblocks) {
+        return PSA_SST_ERR_SYSTEM_ERROR;
+    }
+
+    sst_utils_memcpy(&block_meta, &ctx->meta_scratch.block_meta[lblock],
+                     sizeof(struct sst_block_metadata));
+
+    /* Save scratch data block physical IDs */
+    scratch_dblock_id = sst_meta_cur_data_scratch(ctx, lblock);
+
+    /* An update which compacts several blocks can only use a scratch block
+     * which does not hold data in the active metadata, as the update may not
+     * be committed.
+     */
+    if ((scratch_dblock_id == block_meta.phys_id) ||
+        ((lblock != SST_LOGICAL_DBLOCK0) &&
+         ((scratch_dblock_id >= ctx->nbr_blocks) ||
+          sst_dblock_is_mapped(ctx, &ctx->meta_active, scratch_dblock_id)))) {
+        return PSA_SST_ERR_STORAGE_SYSTEM_FULL;
+    }
+
+    err = sst_scratch_claim(ctx, scratch_dblock_id);
+    if (err != PSA_SST_ERR_SUCCESS) {
+        return err;
+    }
+
+    pos = block_meta.data_start;
+    for (i = 0; i < SST_NUM_OBJECT_ENTRIES; i++) {
+        object_meta = &ctx->meta_scratch.object_meta[i];
+        if ((object_meta->lblock != lblock) ||
+            (sst_utils_validate_uuid(object_meta->unique_id) !=
+                                                         PSA_SST_ERR_SUCCESS)) {
+            continue;
+        }
+
+        if (i == obj_index) {
+            err = sst_dblock_write_patch(ctx, scratch_dblock_id, pos,
+                                         block_meta.phys_id,
+                                         object_meta->data_index,
+                                         object_meta->cur_size, patch);
+        } else if (object_meta->cur_size > 0) {
+            err = sst_flash_block_to_block_move(ctx->area_id,
+                                                scratch_dblock_id, pos,
+                                                block_meta.phys_id,
+                                                object_meta->data_index,
+                                                sst_get_aligned_flash_bytes(
+                                                      object_meta->cur_size));
+        }
+
+        if (err != PSA_SST_ERR_SUCCESS) {
+            return PSA_SST_ERR_SYSTEM_ERROR;
+        }
+
+        object_meta->data_index = pos;
+        pos += sst_get_aligned_flash_bytes(object_meta->max_size);
+    }
+
+    block_meta.free_size = (ctx->block_size - pos);
+
+    /* Swap the scratch and current data blocks */
+    sst_dblock_swap_scratch(ctx, lblock, &block_meta, scratch_dblock_id);
+
+    return PSA_SST_ERR_SUCCESS;
+}
+
+/**
+ * \brief Reads the object's content
+ *
+ * \param[in]  meta    Object's metadata
+ * \param[in]  offset  Offset in the object
+ * \param[in]  size    Size to be read
+ * \param[out] buf     Buffer pointer to store the data
+ *
+ * \return Returns error code as specified in \ref psa_sst_err_t
+ */
+static enum psa_sst_err_t sst_block_object_read_raw(
+                                              struct sst_core_ctx_t *ctx,
+                                              const struct sst_assetmeta *meta,
+                                              uint32_t offset, uint32_t size,
+                                              uint8_t *buf)
+{
+    enum psa_sst_err_t err;
+    uint32_t phys_block;
+    uint32_t pos;
+
+    pos = (meta->data_index + offset);
+
+    phys_block = sst_dblock_lo_to_phy(ctx, meta->lblock);
+    if (phys_block == SST_BLOCK_INVALID_ID) {
+        return PSA_SST_ERR_SYSTEM_ERROR;
+    }
+
+    err = sst_flash_read(ctx->area_id, phys_block, buf, pos, size);
+
+    return err;
+}
+
+#ifdef SST_ENCRYPTION
+/**
+ * \brief Gets the length of metadata to be authenticated
+ *        which is total metadata size minus the size of MAC
+ *        in the beginning
+ *
+ * \return Size of autheticated metadata block memory
+ */
+static uint32_t authenticated_meta_data_size(void)
+{
+    uint32_t auth_size;
+
+    auth_size = SST_ALL_METADATA_SIZE - SST_NON_AUTH_METADATA_SIZE;
+
+    return auth_size;
+}
+
+/**
+ * \brief Generates the scratch metadata authentication and commits the
+ *        scratch metadata to flash
+ *
+ * \param[in] block_id  ID of the scratch metadata block
+ *
+ * \return Returns error code as specified in \ref psa_sst_err_t
+ */
+static enum psa_sst_err_t sst_meta_auth_and_update(struct sst_core_ctx_t *ctx,
+                                                   uint32_t block_id)
+{
+    enum psa_sst_err_t err;
+    uint32_t size;
+    uint8_t *addr;
+    union sst_crypto_t *crypto = &ctx->sys.meta_block_header.crypto;
+
+    /* Get new IV */
+    sst_crypto_get_iv(crypto);
+
+    /* Put the metadata header in the scratch metadata */
+    sst_utils_memcpy(&ctx->meta_scratch.header,
+                     &ctx->sys.meta_block_header,
+                     sizeof(struct sst_metadata_block_header));
+
+    /* Get size and address of authenticated part of the metadata */
+    size = authenticated_meta_data_size();
+    addr = (uint8_t *)&ctx->meta_scratch + SST_AUTH_METADATA_OFFSET;
+
+    err = sst_crypto_getkey(ctx->sys.sst_key, SST_KEY_LEN_BYTES);
+    if (err != PSA_SST_ERR_SUCCESS) {
+        return err;
+    }
+
+    err = sst_crypto_setkey(ctx->sys.sst_key, SST_KEY_LEN_BYTES);
+    if (err != PSA_SST_ERR_SUCCESS) {
+        return err;
+    }
+
+    err = sst_crypto_generate_auth_tag(crypto, addr, size);
+    if (err != PSA_SST_ERR_SUCCESS) {
+        return err;
+    }
+
+    sst_utils_memcpy(&ctx->meta_scratch.header.crypto, crypto,
+                     SST_NON_AUTH_METADATA_SIZE);
+
+    /* Commit all metadata to flash, except for the non-authenticated part */
+    err = sst_flash_write(ctx->area_id, block_id, addr,
+                          SST_AUTH_METADATA_OFFSET, size);
+    if (err != PSA_SST_ERR_SUCCESS) {
+        return err;
+    }
+
+    /* Commit non-authenticated part of metadata header to flash */
+    err = sst_flash_write(ctx->area_id, block_id, (uint8_t *)crypto, 0,
+                          SST_NON_AUTH_METADATA_SIZE);
+    return err;
+}
+
+/**
+ * \brief Reads the metadata of a metadata block into the RAM copy of the
+ *        active metadata and authenticates it
+ *
+ * \param[in] block  ID of the metadata block to authenticate
+ *
+ * \return Returns error code as specified in \ref psa_sst_err_t
+ */
+static enum psa_sst_err_t sst_mblock_authenticate(struct sst_core_ctx_t *ctx,
+                                                  uint32_t block)
+{
+    enum psa_sst_err_t err = 0;
+    const uint8_t *addr;
+    uint32_t addr_len;
+
+    /* Read block table and lookups (all metadata and header) */
+    err = sst_flash_read(ctx->area_id, block, (uint8_t *)&ctx->meta_active, 0,
+                         SST_ALL_METADATA_SIZE);
+    if (err != PSA_SST_ERR_SUCCESS) {
+        return err;
+    }
+
+    /* Address position and size of the meta-data to be authenticated */
+    addr = (uint8_t *)&ctx->meta_active + SST_AUTH_METADATA_OFFSET;
+    addr_len = authenticated_meta_data_size();
+
+    err = sst_crypto_getkey(ctx->sys.sst_key, SST_KEY_LEN_BYTES);
+    if (err != PSA_SST_ERR_SUCCESS) {
+        return err;
+    }
+
+    err = sst_crypto_setkey(ctx->sys.sst_key, SST_KEY_LEN_BYTES);
+    if (err != PSA_SST_ERR_SUCCESS) {
+        return err;
+    }
+
+    /* Authenticate meta-data */
+    err = sst_crypto_authenticate(&ctx->meta_active.header.crypto, addr,
+                                  addr_len);
+
+    return err;
+}
+#endif
+
+/**
+ * \brief Checks the validity of the metadata block's swap count
+ *
+ * \param[in] swap_count  Swap count to validate
+ *
+ * \return Returns error code as specified in \ref psa_sst_err_t
+ */
+static enum psa_sst_err_t sst_meta_validate_swap_count(uint8_t swap_count)
+{
+    enum psa_sst_err_t err = PSA_SST_ERR_SUCCESS;
+
+    /* When a flash block is erased, the default value
+     * is usually 0xFF (i.e. all 1s). Since the swap count
+     * is updated last (when encryption is disabled), it is
+     * possible that due to a power failure, the swap count
+     * value in metadata header is 0xFFFF..., which mean
+     * it will appear to be most recent block. Which isn't
+     * a problem in itself, as the rest of the metadata is fully
+     * valid (as it would have been written before swap count).
+     * However, this also means that previous update process
+     * wasn't complete. So, if the value is 0xFF..., revert
+     * back to previous metablock instead.
+     */
+    if (swap_count == SST_FLASH_DEFAULT_VAL) {
+        err = PSA_SST_ERR_SYSTEM_ERROR;
+    }
+
+    return err;
+}
+
+/**
+ * \brief Checks the validatity FS version
+ *
+ * \param[in] swap_count  Swap count to validate
+ *
+ * \return Returns error code as specified in \ref psa_sst_err_t
+ */
+static enum psa_sst_err_t sst_meta_validate_fs_version(uint8_t fs_version)
+{
+    enum psa_sst_err_t err = PSA_SST_ERR_SUCCESS;
+
+    /* Looks for exact version number.
+     * FIXME: backward compatibility could be considered in future revisions.
+     */
+    if (fs_version != SST_SUPPORTED_VERSION) {
+        err = PSA_SST_ERR_SYSTEM_ERROR;
+    }
+
+    return err;
+}
+
+/**
+ * \brief Validates header metadata in order to guarantee that a corruption or
+ *        malicious change in stored metadata doesn't result in an invalid
+ *        access and the header version is correct.
+ *
+ * \param[in] meta  Pointer to metadata block header
+ *
+ * \return Returns error code as specified in \ref psa_sst_err_t
+ */
+static enum psa_sst_err_t sst_meta_validate_header_meta(
+                                         struct sst_metadata_block_header *meta)
+{
+    enum psa_sst_err_t err;
+
+    err = sst_meta_validate_fs_version(meta->fs_version);
+    if (err == PSA_SST_ERR_SUCCESS) {
+        err = sst_meta_validate_swap_count(meta->active_swap_count);
+    }
+
+    return err;
+}
+
+/**
+ * \brief Writes the scratch metadata, header included, into the scratch
+ *        metadata block
+ *
+ * \return Returns error code as specified in \ref psa_sst_err_t
+ */
+static enum psa_sst_err_t sst_meta_write_scratch_meta(
+                                                    struct sst_core_ctx_t *ctx)
+{
+    enum psa_sst_err_t err;
+    uint32_t scratch_metablock;
+#ifndef SST_ENCRYPTION
+    size_t swap_count_offset;
+#endif
+
+    scratch_metablock = sst_meta_cur_meta_scratch(ctx);
+
+    err = sst_scratch_claim(ctx, scratch_metablock);
+    if (err != PSA_SST_ERR_SUCCESS) {
+        return err;
+    }
+
+    /* The objects' data in the logical block 0 is stored in same physical
+     * block where the metadata is stored, so it is located in the scratch
+     * metadata block once the metadata blocks are swapped.
+     */
+    ctx->meta_scratch.block_meta[SST_LOGICAL_DBLOCK0].phys_id =
+                                                             scratch_metablock;
+
+    /* Increment the swap count */
+    ctx->sys.meta_block_header.active_swap_count += 1;
+
+    err = sst_meta_validate_swap_count(
+                        ctx->sys.meta_block_header.active_swap_count);
+    if (err != PSA_SST_ERR_SUCCESS) {
+        /* Reset the swap count to 0 */
+        ctx->sys.meta_block_header.active_swap_count = 0;
+    }
+
+#ifdef SST_ENCRYPTION
+    err = sst_meta_auth_and_update(ctx, scratch_metablock);
+#else
+    /* Put the metadata header in the scratch metadata */
+    sst_utils_memcpy(&ctx->meta_scratch.header,
+                     &ctx->sys.meta_block_header,
+                     sizeof(struct sst_metadata_block_header));
+
+    /* In case of no encryption, the swap count decides the latest metadata
+     * block, so it is programmed last. It is programmed with the rest of its
+     * flash program unit.
+     */
+    swap_count_offset = offsetof(struct sst_metadata_block_header,
+                                 active_swap_count);
+    swap_count_offset -= (swap_count_offset % SST_FLASH_PROGRAM_UNIT);
+
+    /* Write the metadata block header up to the swap count */
+    err = sst_flash_write(ctx->area_id, scratch_metablock,
+                          (uint8_t *)(&ctx->meta_scratch.header),
+                          0, swap_count_offset);
+    if (err != PSA_SST_ERR_SUCCESS) {
+        return err;
+    }
+
+    /* Write the block and object metadata tables */
+    err = sst_flash_write(ctx->area_id, scratch_metablock,
+                          (uint8_t *)ctx->meta_scratch.block_meta,
+                          sizeof(struct sst_metadata_block_header),
+                          (SST_ALL_METADATA_SIZE -
+                           sizeof(struct sst_metadata_block_header)));
+    if (err != PSA_SST_ERR_SUCCESS) {
+        return err;
+    }
+
+    /* Write the swap count, the last member in the metadata block header */
+    err = sst_flash_write(ctx->area_id, scratch_metablock,
+                          ((uint8_t *)(&ctx->meta_scratch.header) +
+                           swap_count_offset),
+                          swap_count_offset,
+                          (sizeof(struct sst_metadata_block_header) -
+                           swap_count_offset));
+#endif
+
+    if (err != PSA_SST_ERR_SUCCESS) {
+        return err;
+    }
+
+    /* The metadata blocks are only swapped once the metadata is in flash */
+    return sst_flash_flush(ctx->area_id);
+}
+
+/**
+ * \brief Reads the active metadata block header into the area's context
+ *
+ * \return Returns error code as specified in \ref psa_sst_err_t
+ */
+static enum psa_sst_err_t sst_meta_read_meta_header(struct sst_core_ctx_t *ctx)
+{
+    enum psa_sst_err_t err;
+
+    sst_utils_memcpy(&ctx->sys.meta_block_header,
+                     &ctx->meta_active.header,
+                     sizeof(struct sst_metadata_block_header));
+
+    err = sst_meta_validate_header_meta(&ctx->sys.meta_block_header);
+
+    return err;
+}
+
+/**
+ * \brief Writes the objects' data area of logical block 0 into the scratch
+ *        block
+ *
+ * \note The objects' data in the logical block 0 is stored in same physical
+ *       block where the metadata is stored. A change in the metadata requires a
+ *       swap of physical blocks. So, the objects' data stored in the current
+ *       medadata block needs to be copied in the scratch block, unless
+ *       the data of the object processed is located in the logical block 0.
+ *
+ * \return Returns error code as specified in \ref psa_sst_err_t
+ */
+static enum psa_sst_err_t sst_mblock_migrate_data_to_scratch(
+                                                    struct sst_core_ctx_t *ctx)
+{
+    const struct sst_block_metadata *block_meta;
+    enum psa_sst_err_t err;
+    uint32_t current_metablock;
+    uint32_t scratch_metablock;
+    uint32_t data_size;
+
+    scratch_metablock = sst_meta_cur_meta_scratch(ctx);
+    current_metablock = sst_meta_cur_meta_active(ctx);
+
+    err = sst_scratch_claim(ctx, scratch_metablock);
+    if (err != PSA_SST_ERR_SUCCESS) {
+        return err;
+    }
+
+    /* The scratch metadata includes the data which may have been appended to
+     * the logical block 0 by the operation.
      */
-    swap_count_offset = offsetof(struct sst_metadata_block_header,
-                                 active_swap_count);
+    block_meta = &ctx->meta_scratch.block_meta[SST_LOGICAL_DBLOCK0];
 
-    /* Write the metadata block header up to the swap count */
-    err = sst_flash_write(scratch_metablock,
-                          (uint8_t *)(&sst_system_ctx.meta_block_header),
-                          0, swap_count_offset);
+    /* Calculate data size stored in the B0 block */
+    data_size = (ctx->block_size - block_meta->data_start -
+                 block_meta->free_size);
+
+    err = sst_flash_block_to_block_move(ctx->area_id, scratch_metablock,
+                                        block_meta->data_start,
+                                        current_metablock,
+                                        block_meta->data_start,
+                                        data_size);
+    return err;
+}
+
+/**
+ * \brief Puts a journal record in the journal staging buffer
+ *
+ * \param[in] record_idx  Index of the record in the staging buffer
+ * \param[in] type        Record type
+ * \param[in] index       Logical block or object index of the entry
+ * \param[in] entry       Pointer to the entry content
+ * \param[in] size        Size of the entry content
+ */
+static void sst_journal_put_record(struct sst_core_ctx_t *ctx,
+                                   uint32_t record_idx, uint16_t type,
+                                   uint16_t index, const void *entry,
+                                   uint32_t size)
+{
+    struct sst_journal_record_t *record = &ctx->journal_buf[record_idx];
+
+    sst_utils_memset(record, SST_FLASH_DEFAULT_VAL,
+                     sizeof(struct sst_journal_record_t));
+    record->type = type;
+    record->index = index;
+    sst_utils_memcpy(&record->data, entry, size);
+}
+
+/**
+ * \brief Appends the changes between the scratch and the active metadata to
+ *        the metadata journal of the active metadata block
+ *
+ * \return Returns PSA_SST_ERR_STORAGE_SYSTEM_FULL if the journal has not
+ *         enough free records to store the update. Otherwise, it returns error
+ *         code as specified in \ref psa_sst_err_t
+ */
+static enum psa_sst_err_t sst_journal_append_update(struct sst_core_ctx_t *ctx)
+{
+    enum psa_sst_err_t err;
+    struct sst_journal_commit_t commit;
+    uint32_t free_records;
+    uint32_t nbr_records = 0;
+    uint32_t offset;
+    uint32_t i;
+
+    /* One record is always needed for the commit record */
+    free_records = (SST_JOURNAL_NUM_RECORDS -
+                    ctx->sys.journal_next_record);
+    if (free_records == 0) {
+        return PSA_SST_ERR_STORAGE_SYSTEM_FULL;
+    }
+    free_records--;
+
+    for (i = 0; i < ctx->nbr_active_dblocks; i++) {
+        if (memcmp(&ctx->meta_scratch.block_meta[i],
+                   &ctx->meta_active.block_meta[i],
+                   sizeof(struct sst_block_metadata)) != 0) {
+            if (nbr_records == free_records) {
+                return PSA_SST_ERR_STORAGE_SYSTEM_FULL;
+            }
+            sst_journal_put_record(ctx, nbr_records, SST_JOURNAL_BLOCK_META, i,
+                                   &ctx->meta_scratch.block_meta[i],
+                                   sizeof(struct sst_block_metadata));
+            nbr_records++;
+        }
+    }
+
+    for (i = 0; i < SST_NUM_OBJECT_ENTRIES; i++) {
+        if (memcmp(&ctx->meta_scratch.object_meta[i],
+                   &ctx->meta_active.object_meta[i],
+                   sizeof(struct sst_assetmeta)) != 0) {
+            if (nbr_records == free_records) {
+                return PSA_SST_ERR_STORAGE_SYSTEM_FULL;
+            }
+            sst_journal_put_record(ctx, nbr_records, SST_JOURNAL_OBJECT_META, i,
+                                   &ctx->meta_scratch.object_meta[i],
+                                   sizeof(struct sst_assetmeta));
+            nbr_records++;
+        }
+    }
+
+    for (i = 0; i < ctx->nbr_blocks; i++) {
+        if (ctx->meta_scratch.erase_count[i] !=
+            ctx->meta_active.erase_count[i]) {
+            if (nbr_records == free_records) {
+                return PSA_SST_ERR_STORAGE_SYSTEM_FULL;
+            }
+            sst_journal_put_record(ctx, nbr_records, SST_JOURNAL_ERASE_COUNT, i,
+                                   &ctx->meta_scratch.erase_count[i],
+                                   sizeof(uint32_t));
+            nbr_records++;
+        }
+    }
+
+    if (memcmp(&ctx->meta_scratch.compact, &ctx->meta_active.compact,
+               sizeof(struct sst_compact_cursor_t)) != 0) {
+        if (nbr_records == free_records) {
+            return PSA_SST_ERR_STORAGE_SYSTEM_FULL;
+        }
+        sst_journal_put_record(ctx, nbr_records, SST_JOURNAL_COMPACT, 0,
+                               &ctx->meta_scratch.compact,
+                               sizeof(struct sst_compact_cursor_t));
+        nbr_records++;
+    }
+
+    commit.seq = ctx->sys.journal_seq;
+    commit.scratch_idx = ctx->sys.meta_block_header.scratch_idx;
+    commit.nbr_records = nbr_records;
+    sst_journal_put_record(ctx, nbr_records, SST_JOURNAL_COMMIT, 0, &commit,
+                           sizeof(struct sst_journal_commit_t));
+
+#ifdef SST_ENCRYPTION
+    /* Get new IV */
+    sst_crypto_get_iv(&ctx->journal_buf[nbr_records].data.commit.crypto);
+
+    err = sst_crypto_getkey(ctx->sys.sst_key, SST_KEY_LEN_BYTES);
+    if (err != PSA_SST_ERR_SUCCESS) {
+        return err;
+    }
+
+    err = sst_crypto_setkey(ctx->sys.sst_key, SST_KEY_LEN_BYTES);
+    if (err != PSA_SST_ERR_SUCCESS) {
+        return err;
+    }
+
+    err = sst_crypto_generate_auth_tag(
+                              &ctx->journal_buf[nbr_records].data.commit.crypto,
+                              (uint8_t *)ctx->journal_buf,
+                              SST_JOURNAL_AUTH_SIZE(nbr_records));
+    if (err != PSA_SST_ERR_SUCCESS) {
+        return err;
+    }
+
+    sst_utils_memcpy(&ctx->sys.meta_block_header.crypto,
+                     &ctx->journal_buf[nbr_records].data.commit.crypto,
+                     sizeof(union sst_crypto_t));
+#endif
+
+    offset = SST_JOURNAL_OFFSET + (ctx->sys.journal_next_record *
+                                   sizeof(struct sst_journal_record_t));
+
+    /* The records are programmed before the commit record, which decides if
+     * the update is valid.
+     */
+    if (nbr_records > 0) {
+        err = sst_flash_write(ctx->area_id, sst_meta_cur_meta_active(ctx),
+                              (uint8_t *)ctx->journal_buf, offset,
+                              (nbr_records *
+                               sizeof(struct sst_journal_record_t)));
+        if (err != PSA_SST_ERR_SUCCESS) {
+            /* The journal can not be appended after a partial update */
+            ctx->sys.journal_next_record = SST_JOURNAL_NUM_RECORDS;
+            return err;
+        }
+    }
+
+    err = sst_flash_write(ctx->area_id, sst_meta_cur_meta_active(ctx),
+                          (uint8_t *)&ctx->journal_buf[nbr_records],
+                          (offset + (nbr_records *
+                                     sizeof(struct sst_journal_record_t))),
+                          sizeof(struct sst_journal_record_t));
+    if (err == PSA_SST_ERR_SUCCESS) {
+        /* The update is only committed once it is in flash */
+        err = sst_flash_flush(ctx->area_id);
+    }
+    if (err != PSA_SST_ERR_SUCCESS) {
+        /* The journal can not be appended after a partial update */
+        ctx->sys.journal_next_record = SST_JOURNAL_NUM_RECORDS;
+        return err;
+    }
+
+    ctx->sys.journal_next_record += (nbr_records + 1);
+    ctx->sys.journal_seq++;
+
+    return PSA_SST_ERR_SUCCESS;
+}
+
+/**
+ * \brief Discards the incremental compaction if the update prepared in the
+ *        scratch metadata changes the logical block being compacted, as the
+ *        data already copied may not be up to date
+ */
+static void sst_compact_check_update(struct sst_core_ctx_t *ctx)
+{
+    uint32_t lblock = ctx->meta_scratch.compact.lblock;
+    const struct sst_assetmeta *scratch_meta;
+    const struct sst_assetmeta *active_meta;
+    uint32_t i;
+
+    if (lblock == SST_COMPACT_NO_LBLOCK) {
+        return;
+    }
+
+    if (memcmp(&ctx->meta_scratch.block_meta[lblock],
+               &ctx->meta_active.block_meta[lblock],
+               sizeof(struct sst_block_metadata)) != 0) {
+        sst_compact_cancel(ctx);
+        return;
+    }
+
+    for (i = 0; i < SST_NUM_OBJECT_ENTRIES; i++) {
+        scratch_meta = &ctx->meta_scratch.object_meta[i];
+        active_meta = &ctx->meta_active.object_meta[i];
+        if (((scratch_meta->lblock == lblock) ||
+             (active_meta->lblock == lblock)) &&
+            (memcmp(scratch_meta, active_meta,
+                    sizeof(struct sst_assetmeta)) != 0)) {
+            sst_compact_cancel(ctx);
+            return;
+        }
+    }
+}
+
+/**
+ * \brief Commits the update prepared in the scratch metadata
+ *
+ * \details If the logical block 0 has not been compacted in the scratch
+ *          metadata block, the update is appended to the metadata journal of
+ *          the active metadata block. Otherwise, or if the journal is full,
+ *          the scratch metadata is written in the scratch metadata block,
+ *          together with the data of the logical block 0, and the metadata
+ *          blocks are swapped. The blocks retired by the update are left to
+ *          be erased by the maintenance, and their erases are counted as part
+ *          of the update.
+ *
+ * \return Returns error code as specified in \ref psa_sst_err_t
+ */
+static enum psa_sst_err_t sst_meta_update_commit(struct sst_core_ctx_t *ctx)
+{
+    enum psa_sst_err_t err;
+
+    /* The checkpoint is stale once an update is appended after it */
+    ctx->ckpt_live = 0;
+
+    sst_compact_check_update(ctx);
+
+    /* The physical ID of the logical block 0 only changes when its data has
+     * been compacted in the scratch metadata block.
+     */
+    if (ctx->meta_scratch.block_meta[SST_LOGICAL_DBLOCK0].phys_id ==
+        ctx->meta_active.block_meta[SST_LOGICAL_DBLOCK0].phys_id) {
+
+        err = sst_journal_append_update(ctx);
+        if (err == PSA_SST_ERR_SUCCESS) {
+            /* Update the running context */
+            sst_utils_memcpy(&ctx->meta_scratch.header,
+                             &ctx->sys.meta_block_header,
+                             sizeof(struct sst_metadata_block_header));
+            sst_utils_memcpy(&ctx->meta_active, &ctx->meta_scratch,
+                             SST_ALL_METADATA_SIZE);
+            sst_scratch_release(ctx);
+
+            return PSA_SST_ERR_SUCCESS;
+        }
+
+        if (err != PSA_SST_ERR_STORAGE_SYSTEM_FULL) {
+            return err;
+        }
+
+        /* The objects' data in the logical block 0 is stored in same physical
+         * block where the metadata is stored. So, it needs to be copied in the
+         * scratch metadata block before swapping the metadata blocks.
+         */
+        err = sst_mblock_migrate_data_to_scratch(ctx);
+        if (err != PSA_SST_ERR_SUCCESS) {
+            return err;
+        }
+    }
+
+    /* The active metadata block is retired once the metadata blocks are
+     * swapped.
+     */
+    sst_meta_count_erase(ctx, sst_meta_cur_meta_active(ctx));
+
+    /* Commit the metadata to flash */
+    err = sst_meta_write_scratch_meta(ctx);
+    if (err != PSA_SST_ERR_SUCCESS) {
+        return err;
+    }
+    /* Update the running context */
+    sst_meta_swap_metablocks(ctx);
+    sst_utils_memcpy(&ctx->meta_active, &ctx->meta_scratch,
+                     SST_ALL_METADATA_SIZE);
+    ctx->sys.journal_next_record = 0;
+    ctx->sys.journal_seq = 0;
+    sst_scratch_release(ctx);
+
+    return PSA_SST_ERR_SUCCESS;
+}
+
+/**
+ * \brief Moves the data of the least erased data block into the scratch data
+ *        block, if the scratch data block has been erased at least
+ *        SST_WEAR_LEVELLING_THRESHOLD times more
+ *
+ * \return Returns error code as specified in \ref psa_sst_err_t
+ */
+static enum psa_sst_err_t sst_dblock_wear_level(struct sst_core_ctx_t *ctx)
+{
+    enum psa_sst_err_t err;
+    uint32_t cold_lblock = SST_LOGICAL_DBLOCK0 + 1;
+    uint32_t min_count = UINT32_MAX;
+    uint32_t scratch_count;
+    uint32_t phys_id;
+    uint32_t lblock;
+
+    if (ctx->nbr_dedicated_dblocks == 0) {
+        /* The only data block is the logical block 0, stored in the metadata
+         * blocks.
+         */
+        return PSA_SST_ERR_SUCCESS;
+    }
+
+    for (lblock = (SST_LOGICAL_DBLOCK0 + 1); lblock < ctx->nbr_active_dblocks;
+         lblock++) {
+        phys_id = ctx->meta_active.block_meta[lblock].phys_id;
+        if (ctx->meta_active.erase_count[phys_id] < min_count) {
+            min_count = ctx->meta_active.erase_count[phys_id];
+            cold_lblock = lblock;
+        }
+    }
+
+    phys_id = ctx->sys.meta_block_header.scratch_idx;
+    scratch_count = ctx->meta_active.erase_count[phys_id];
+    if ((scratch_count <= min_count) ||
+        ((scratch_count - min_count) < SST_WEAR_LEVELLING_THRESHOLD)) {
+        return PSA_SST_ERR_SUCCESS;
+    }
+
+    /* Compacting the block moves its data into the scratch data block, and
+     * the least erased block becomes the scratch data block.
+     */
+    sst_mblock_init_scratch_meta(ctx);
+
+    err = sst_compact_dblock(ctx, cold_lblock, SST_METADATA_INVALID_INDEX,
+                             NULL);
+    if (err != PSA_SST_ERR_SUCCESS) {
+        return err;
+    }
+
+    return sst_meta_update_commit(ctx);
+}
+
+/**
+ * \brief Finalizes an update operation
+ *        Last step when a create/write/delete is performed
+ *
+ * \details The update is committed, and then the wear of the data blocks is
+ *          levelled if needed.
+ *
+ * \return Returns error code as specified in \ref psa_sst_err_t
+ */
+static enum psa_sst_err_t sst_meta_update_finalize(struct sst_core_ctx_t *ctx)
+{
+    enum psa_sst_err_t err;
+
+    err = sst_meta_update_commit(ctx);
+    if (err != PSA_SST_ERR_SUCCESS) {
+        return err;
+    }
+
+    return sst_dblock_wear_level(ctx);
+}
+
+/**
+ * \brief Folds the metadata journal into the scratch metadata block
+ *
+ * \details The active metadata is written in the scratch metadata block,
+ *          together with the data of the logical block 0, and the metadata
+ *          blocks are swapped, so that the journal of the new active metadata
+ *          block is empty. The previous active metadata block is retired.
+ *
+ * \return Returns error code as specified in \ref psa_sst_err_t
+ */
+static enum psa_sst_err_t sst_journal_fold(struct sst_core_ctx_t *ctx)
+{
+    enum psa_sst_err_t err;
+
+    sst_mblock_init_scratch_meta(ctx);
+
+    err = sst_mblock_migrate_data_to_scratch(ctx);
     if (err != PSA_SST_ERR_SUCCESS) {
         return err;
     }
 
-    /* Write the swap count, the last member in the metadata block header */
-    err = sst_flash_write(scratch_metablock,
-                          &sst_system_ctx.meta_block_header.active_swap_count,
-                          swap_count_offset,
-                          sizeof(
-                           sst_system_ctx.meta_block_header.active_swap_count));
-#endif
+    /* The logical block 0 is moved to the scratch metadata block, so that the
+     * update swaps the metadata blocks instead of appending to the journal.
+     */
+    ctx->meta_scratch.block_meta[SST_LOGICAL_DBLOCK0].phys_id =
+                                                sst_meta_cur_meta_scratch(ctx);
+
+    return sst_meta_update_commit(ctx);
+}
+
+/**
+ * \brief Gets the bitmap of the erased physical blocks
+ *
+ * \return Returns the bitmap of the erased blocks, among the blocks which can
+ *         be recorded by a checkpoint
+ */
+static uint32_t sst_ckpt_erased_blocks(const struct sst_core_ctx_t *ctx)
+{
+    uint32_t erased_blocks = 0;
+    uint32_t i;
+
+    for (i = 0; (i < ctx->nbr_blocks) && (i < SST_CKPT_MAX_BLOCKS);
+         i++) {
+        if (ctx->block_state[i] == SST_BLOCK_ERASED) {
+            erased_blocks |= (1U << i);
+        }
+    }
+
+    return erased_blocks;
+}
+
+/**
+ * \brief Appends a checkpoint of the erased blocks to the journal, unless the
+ *        live checkpoint already records them
+ *
+ * \details A free journal record is kept after the checkpoint, so that it can
+ *          always be invalidated. If the journal has not enough free records
+ *          left, it is folded first, and the metadata block retired by the
+ *          fold is erased, so that the checkpoint is never skipped.
+ *
+ * \note It must not be called while a transaction is active.
+ *
+ * \return Returns error code as specified in \ref psa_sst_err_t
+ */
+static enum psa_sst_err_t sst_ckpt_update(struct sst_core_ctx_t *ctx)
+{
+    enum psa_sst_err_t err;
+    uint32_t erased_blocks;
+
+    erased_blocks = sst_ckpt_erased_blocks(ctx);
+    if ((erased_blocks == 0) ||
+        ((ctx->ckpt_live != 0) && (ctx->ckpt.erased_blocks == erased_blocks))) {
+        return PSA_SST_ERR_SUCCESS;
+    }
+
+    if ((SST_JOURNAL_NUM_RECORDS - ctx->sys.journal_next_record) < 2) {
+        err = sst_journal_fold(ctx);
+        if (err != PSA_SST_ERR_SUCCESS) {
+            return err;
+        }
+
+        err = sst_scratch_erase_retired(ctx);
+        if (err != PSA_SST_ERR_SUCCESS) {
+            return err;
+        }
+
+        erased_blocks = sst_ckpt_erased_blocks(ctx);
+    }
+
+    return sst_ckpt_append(ctx, erased_blocks);
+}
+
+/**
+ * \brief Selects the dedicated data block to compact incrementally
+ *
+ * \return Returns the logical block in which the space taken by the previous
+ *         contents and the deleted objects is the biggest, if it is bigger
+ *         than the block's free space. Otherwise, it returns
+ *         SST_COMPACT_NO_LBLOCK.
+ */
+static uint32_t sst_compact_select_lblock(struct sst_core_ctx_t *ctx)
+{
+    const struct sst_block_metadata *block_meta;
+    uint32_t best_lblock = SST_COMPACT_NO_LBLOCK;
+    uint32_t best_size = 0;
+    uint32_t used_size;
+    uint32_t dead_size;
+    uint32_t lblock;
+
+    for (lblock = (SST_LOGICAL_DBLOCK0 + 1); lblock < ctx->nbr_active_dblocks;
+         lblock++) {
+        block_meta = &ctx->meta_scratch.block_meta[lblock];
+        used_size = (ctx->block_size - block_meta->data_start -
+                     block_meta->free_size);
+        dead_size = used_size - sst_dblock_live_size(ctx, lblock);
+        if ((dead_size > block_meta->free_size) && (dead_size > best_size)) {
+            best_size = dead_size;
+            best_lblock = lblock;
+        }
+    }
+
+    return best_lblock;
+}
+
+/**
+ * \brief Checks that the destination block of the incremental compaction
+ *        contains the data copied up to the cursor, and that it is not used
+ *        by the storage
+ *
+ * \details It is required when the progress has been loaded from flash, as
+ *          an update which has been interrupted by a reset may have
+ *          programmed the destination block after discarding the compaction.
+ *
+ * \return Returns error code as specified in \ref psa_sst_err_t
+ */
+static enum psa_sst_err_t sst_compact_check_progress(struct sst_core_ctx_t *ctx)
+{
+    const struct sst_compact_cursor_t *cursor = &ctx->meta_scratch.compact;
+    const struct sst_block_metadata *block_meta;
+    const struct sst_assetmeta *object_meta;
+    uint8_t src_buf[SST_COMPACT_CHECK_BUF_SIZE];
+    uint8_t dst_buf[SST_COMPACT_CHECK_BUF_SIZE];
+    enum psa_sst_err_t err;
+    uint32_t chunk_size;
+    uint32_t size;
+    uint32_t pos;
+    uint32_t i;
+    uint32_t j;
+
+    if (sst_dblock_is_mapped(ctx, &ctx->meta_scratch, cursor->phys_id) ||
+        (cursor->phys_id == sst_meta_cur_meta_active(ctx)) ||
+        (cursor->phys_id == sst_meta_cur_meta_scratch(ctx))) {
+        return PSA_SST_ERR_SYSTEM_ERROR;
+    }
+
+    block_meta = &ctx->meta_scratch.block_meta[cursor->lblock];
+    pos = block_meta->data_start;
+    for (i = 0; i <= cursor->object_index && i < SST_NUM_OBJECT_ENTRIES; i++) {
+        object_meta = &ctx->meta_scratch.object_meta[i];
+        if ((object_meta->lblock != cursor->lblock) ||
+            (sst_utils_validate_uuid(object_meta->unique_id) !=
+                                                         PSA_SST_ERR_SUCCESS)) {
+            continue;
+        }
+
+        if (i == cursor->object_index) {
+            if (pos != cursor->pos) {
+                return PSA_SST_ERR_SYSTEM_ERROR;
+            }
+            size = cursor->offset;
+        } else {
+            size = sst_get_aligned_flash_bytes(object_meta->cur_size);
+        }
+
+        for (j = 0; j < size; j += chunk_size) {
+            chunk_size = ((size - j) < SST_COMPACT_CHECK_BUF_SIZE) ?
+                         (size - j) : SST_COMPACT_CHECK_BUF_SIZE;
+
+            err = sst_flash_read(ctx->area_id, block_meta->phys_id, src_buf,
+                                 object_meta->data_index + j, chunk_size);
+            if (err != PSA_SST_ERR_SUCCESS) {
+                return err;
+            }
+
+            err = sst_flash_read(ctx->area_id, cursor->phys_id, dst_buf,
+                                 pos + j, chunk_size);
+            if (err != PSA_SST_ERR_SUCCESS) {
+                return err;
+            }
+
+            if (memcmp(src_buf, dst_buf, chunk_size) != 0) {
+                return PSA_SST_ERR_SYSTEM_ERROR;
+            }
+        }
+
+        pos += sst_get_aligned_flash_bytes(object_meta->max_size);
+    }
 
-    return err;
+    return PSA_SST_ERR_SUCCESS;
 }
 
 /**
- * \brief Reads the active metadata block header into sst_system_ctx
+ * \brief Copies up to SST_COMPACT_STEP_SIZE bytes of the objects of the
+ *        logical block being compacted, and advances the compaction cursor
+ *        in the scratch metadata
  *
  * \return Returns error code as specified in \ref psa_sst_err_t
  */
-static enum psa_sst_err_t sst_meta_read_meta_header(void)
+static enum psa_sst_err_t sst_compact_copy(struct sst_core_ctx_t *ctx)
 {
+    struct sst_compact_cursor_t *cursor = &ctx->meta_scratch.compact;
+    const struct sst_assetmeta *object_meta;
+    uint32_t budget = SST_COMPACT_STEP_SIZE;
     enum psa_sst_err_t err;
+    uint32_t chunk_size;
+    uint32_t src_block;
+    uint32_t size;
 
-    err = sst_flash_read(sst_system_ctx.active_metablock,
-                         (uint8_t *)&sst_system_ctx.meta_block_header, 0,
-                         sizeof(struct sst_metadata_block_header));
-    if (err != PSA_SST_ERR_SUCCESS) {
-        return err;
-    }
+    src_block = ctx->meta_scratch.block_meta[cursor->lblock].phys_id;
+
+    while (cursor->object_index < SST_NUM_OBJECT_ENTRIES) {
+        object_meta = &ctx->meta_scratch.object_meta[cursor->object_index];
+        if ((object_meta->lblock == cursor->lblock) &&
+            (sst_utils_validate_uuid(object_meta->unique_id) ==
+                                                         PSA_SST_ERR_SUCCESS)) {
+            size = sst_get_aligned_flash_bytes(object_meta->cur_size);
+            if (cursor->offset < size) {
+                if (budget == 0) {
+                    break;
+                }
 
-    err = sst_meta_validate_header_meta(&sst_system_ctx.meta_block_header);
+                chunk_size = ((size - cursor->offset) < budget) ?
+                             (size - cursor->offset) : budget;
 
-    return err;
+                /* A reset may have interrupted a previous step after it had
+                 * programmed the area.
+                 */
+                err = sst_dblock_check_erased(ctx, cursor->phys_id,
+                                              cursor->pos + cursor->offset,
+                                              chunk_size);
+                if (err != PSA_SST_ERR_SUCCESS) {
+                    return err;
+                }
+
+                err = sst_flash_block_to_block_move(ctx->area_id,
+                                                    cursor->phys_id,
+                                                    cursor->pos +
+                                                    cursor->offset,
+                                                    src_block,
+                                                    object_meta->data_index +
+                                                    cursor->offset,
+                                                    chunk_size);
+                if (err != PSA_SST_ERR_SUCCESS) {
+                    return err;
+                }
+
+                cursor->offset += chunk_size;
+                budget -= chunk_size;
+                if (cursor->offset < size) {
+                    break;
+                }
+            }
+
+            cursor->pos += sst_get_aligned_flash_bytes(object_meta->max_size);
+        }
+
+        cursor->offset = 0;
+        cursor->object_index++;
+    }
+
+    return PSA_SST_ERR_SUCCESS;
 }
 
 /**
- * \brief Writes the objects' data area of logical block 0 into the scratch
- *        block
- *
- * \note The objects' data in the logical block 0 is stored in same physical
- *       block where the metadata is stored. A change in the metadata requires a
- *       swap of physical blocks. So, the objects' data stored in the current
- *       medadata block needs to be copied in the scratch block, unless
- *       the data of the object processed is located in the logical block 0.
- *
- * \return Returns error code as specified in \ref psa_sst_err_t
+ * \brief Sets the destination block of the completed incremental compaction
+ *        as the physical block of the compacted logical block, and updates
+ *        the objects' location in the scratch metadata
  */
-static enum psa_sst_err_t sst_mblock_migrate_data_to_scratch(void)
+static void sst_compact_complete(struct sst_core_ctx_t *ctx)
 {
+    struct sst_compact_cursor_t *cursor = &ctx->meta_scratch.compact;
     struct sst_block_metadata block_meta;
-    enum psa_sst_err_t err;
-    uint32_t current_metablock;
-    uint32_t scratch_metablock;
-    uint32_t data_size;
+    struct sst_assetmeta *object_meta;
+    uint32_t pos;
+    uint32_t i;
 
-    scratch_metablock = sst_meta_cur_meta_scratch();
-    current_metablock = sst_meta_cur_meta_active();
+    sst_utils_memcpy(&block_meta, &ctx->meta_scratch.block_meta[cursor->lblock],
+                     sizeof(struct sst_block_metadata));
 
-    err = sst_meta_read_block_metadata(SST_LOGICAL_DBLOCK0, &block_meta);
-    if (err != PSA_SST_ERR_SUCCESS) {
-        return err;
+    pos = block_meta.data_start;
+    for (i = 0; i < SST_NUM_OBJECT_ENTRIES; i++) {
+        object_meta = &ctx->meta_scratch.object_meta[i];
+        if ((object_meta->lblock != cursor->lblock) ||
+            (sst_utils_validate_uuid(object_meta->unique_id) !=
+                                                         PSA_SST_ERR_SUCCESS)) {
+            continue;
+        }
+
+        object_meta->data_index = pos;
+        pos += sst_get_aligned_flash_bytes(object_meta->max_size);
     }
 
-    /* Calculate data size stored in the B0 block */
-    data_size = (SST_BLOCK_SIZE - block_meta.data_start - block_meta.free_size);
+    block_meta.free_size = (ctx->block_size - pos);
 
-    err = sst_flash_block_to_block_move(scratch_metablock,
-                                        block_meta.data_start,
-                                        current_metablock,
-                                        block_meta.data_start,
-                                        data_size);
-    return err;
+    /* The destination block is part of the update, so that it is dirty once
+     * the update ends.
+     */
+    ctx->block_state[cursor->phys_id] = SST_BLOCK_IN_USE;
+    sst_dblock_swap_scratch(ctx, cursor->lblock, &block_meta, cursor->phys_id);
+
+    sst_utils_memset(cursor, SST_FLASH_DEFAULT_VAL,
+                     sizeof(struct sst_compact_cursor_t));
 }
 
 /**
- * \brief Finalizes an update operation
- *        Last step when a create/write/delete is performed
+ * \brief Performs a step of the incremental compaction of the dedicated data
+ *        blocks, and commits its progress
  *
- * \param[in] idx  Object's index
+ * \note The scratch blocks must have been erased before, so that the
+ *       compaction of a new block can start in the scratch data block.
  *
- * \return Returns offset value in metadata block
+ * \return Returns error code as specified in \ref psa_sst_err_t
  */
-static enum psa_sst_err_t sst_meta_update_finalize(void)
+static enum psa_sst_err_t sst_compact_step(struct sst_core_ctx_t *ctx)
 {
+    struct sst_compact_cursor_t *cursor = &ctx->meta_scratch.compact;
     enum psa_sst_err_t err;
+    uint32_t scratch_dblock;
+    uint32_t lblock;
+    uint32_t i;
+
+    if (ctx->nbr_dedicated_dblocks == 0) {
+        /* The logical block 0 is only compacted by the updates, as it is
+         * stored in the metadata blocks.
+         */
+        return PSA_SST_ERR_SUCCESS;
+    }
+
+    sst_mblock_init_scratch_meta(ctx);
+
+    if (cursor->lblock == SST_COMPACT_NO_LBLOCK) {
+        /* An erased block other than the scratch data block is preferred, so
+         * that the updates do not discard the compaction when they compact a
+         * data block.
+         */
+        scratch_dblock = ctx->sys.meta_block_header.scratch_idx;
+        for (i = ctx->init_scratch_dblock; i < ctx->nbr_blocks; i++) {
+            if ((i != scratch_dblock) &&
+                (ctx->block_state[i] == SST_BLOCK_ERASED) &&
+                !sst_dblock_is_mapped(ctx, &ctx->meta_scratch, i)) {
+                scratch_dblock = i;
+                break;
+            }
+        }
 
-    /* Commit the metadata block header to flash */
-    err = sst_meta_write_scratch_meta_header();
+        if (ctx->block_state[scratch_dblock] != SST_BLOCK_ERASED) {
+            return PSA_SST_ERR_SUCCESS;
+        }
+
+        lblock = sst_compact_select_lblock(ctx);
+        if (lblock == SST_COMPACT_NO_LBLOCK) {
+            return PSA_SST_ERR_SUCCESS;
+        }
+
+        err = sst_ckpt_invalidate(ctx, scratch_dblock);
+        if (err != PSA_SST_ERR_SUCCESS) {
+            return err;
+        }
+
+        cursor->lblock = lblock;
+        cursor->phys_id = scratch_dblock;
+        cursor->object_index = 0;
+        cursor->offset = 0;
+        cursor->pos = ctx->meta_scratch.block_meta[lblock].data_start;
+        ctx->block_state[scratch_dblock] = SST_BLOCK_COMPACT;
+    } else if (ctx->block_state[cursor->phys_id] != SST_BLOCK_COMPACT) {
+        /* The progress has been loaded from flash */
+        err = sst_compact_check_progress(ctx);
+        if (err != PSA_SST_ERR_SUCCESS) {
+            sst_compact_cancel(ctx);
+            return sst_meta_update_commit(ctx);
+        }
+        ctx->block_state[cursor->phys_id] = SST_BLOCK_COMPACT;
+    }
+
+    err = sst_compact_copy(ctx);
     if (err != PSA_SST_ERR_SUCCESS) {
-        return err;
+        sst_compact_cancel(ctx);
+        return sst_meta_update_commit(ctx);
     }
-    /* Update the running context */
-    sst_meta_swap_metablocks();
-    /* Erase meta block and current scratch block */
-    err = sst_meta_erase_scratch_blocks();
 
-    return err;
+    if (cursor->object_index < SST_NUM_OBJECT_ENTRIES) {
+        /* Store the progress of the compaction */
+        return sst_meta_update_commit(ctx);
+    }
+
+    sst_compact_complete(ctx);
+
+    return sst_meta_update_finalize(ctx);
 }
 
 /**
@@ -1137,30 +3249,72 @@ static enum psa_sst_err_t sst_meta_update_finalize(void)
  * \param[out] block_meta   Block metadata entry
  * \param[in]  size         Size of the object for which space is reserve
  *
+ * \note The space is reserved according to the scratch metadata, so it must
+ *       have been initialized by the caller. If no block has enough free
+ *       space at its end, a block is compacted to reclaim the space of the
+ *       previous contents of its objects and of the deleted objects.
+ *
  * \return Returns error code as specified in \ref psa_sst_err_t
  */
 static enum psa_sst_err_t sst_meta_reserve_object(
+                                         struct sst_core_ctx_t *ctx,
                                          struct sst_assetmeta *object_meta,
                                          struct sst_block_metadata *block_meta,
                                          uint32_t size)
 {
     uint32_t i;
+    uint32_t lblock;
+    uint32_t reclaim;
     enum psa_sst_err_t err;
     uint32_t size_in_flash;
 
     size_in_flash = sst_get_aligned_flash_bytes(size);
 
-    for (i = 0; i < SST_NUM_ACTIVE_DBLOCKS; i++) {
-        err = sst_meta_read_block_metadata(i, block_meta);
-        if (err != PSA_SST_ERR_SUCCESS) {
-            return PSA_SST_ERR_SYSTEM_ERROR;
-        }
-        if (block_meta->free_size >= size_in_flash) {
-            object_meta->lblock = i;
-            object_meta->data_index = SST_BLOCK_SIZE - block_meta->free_size;
-            block_meta->free_size -= size_in_flash;
-            object_meta->max_size = size;
-            return PSA_SST_ERR_SUCCESS;
+    /* The dedicated data blocks are used before the logical block 0, as a
+     * data change in the logical block 0 requires to swap the metadata blocks
+     * instead of appending the update to the metadata journal.
+     */
+    for (reclaim = 0; reclaim < 2; reclaim++) {
+        for (i = 1; i <= ctx->nbr_active_dblocks; i++) {
+            lblock = i % ctx->nbr_active_dblocks;
+
+            sst_utils_memcpy(block_meta, &ctx->meta_scratch.block_meta[lblock],
+                             sizeof(struct sst_block_metadata));
+
+            if ((reclaim == 1) && (block_meta->free_size < size_in_flash)) {
+                /* Compact the block if the space which can be reclaimed is
+                 * large enough to fit the requested object.
+                 */
+                if ((ctx->block_size - block_meta->data_start -
+                     sst_dblock_live_size(ctx, lblock)) < size_in_flash) {
+                    continue;
+                }
+
+                err = sst_compact_dblock(ctx, lblock,
+                                         SST_METADATA_INVALID_INDEX, NULL);
+                if (err == PSA_SST_ERR_STORAGE_SYSTEM_FULL) {
+                    /* The update has no scratch block left to compact the
+                     * block.
+                     */
+                    continue;
+                }
+                if (err != PSA_SST_ERR_SUCCESS) {
+                    return PSA_SST_ERR_SYSTEM_ERROR;
+                }
+
+                sst_utils_memcpy(block_meta,
+                                 &ctx->meta_scratch.block_meta[lblock],
+                                 sizeof(struct sst_block_metadata));
+            }
+
+            if (block_meta->free_size >= size_in_flash) {
+                object_meta->lblock = lblock;
+                object_meta->data_index = ctx->block_size -
+                                          block_meta->free_size;
+                block_meta->free_size -= size_in_flash;
+                object_meta->max_size = size;
+                return PSA_SST_ERR_SUCCESS;
+            }
         }
     }
 
@@ -1176,510 +3330,799 @@ static enum psa_sst_err_t sst_meta_reserve_object(
  *
  * \return Returns error code as specified in \ref psa_sst_err_t
  */
-static enum psa_sst_err_t sst_core_get_object_idx(uint32_t obj_uuid,
+static enum psa_sst_err_t sst_core_get_object_idx(struct sst_core_ctx_t *ctx,
+                                                  uint32_t obj_uuid,
                                                   uint32_t *obj_idx)
 {
-    uint32_t i;
+    uint32_t pos;
+
+    pos = sst_index_find(ctx, obj_uuid);
+    if (pos == SST_INDEX_TABLE_SIZE) {
+        return PSA_SST_ERR_ASSET_NOT_FOUND;
+    }
+
+    *obj_idx = ctx->index_table[pos].object_index;
+
+    return PSA_SST_ERR_SUCCESS;
+}
+
+enum psa_sst_err_t sst_core_object_exist(uint32_t area_id, uint32_t obj_uuid)
+{
+    struct sst_core_ctx_t *ctx;
+    uint32_t idx;
+    enum psa_sst_err_t err;
+
+    ctx = sst_core_get_ctx(area_id);
+    if (ctx == NULL) {
+        return PSA_SST_ERR_PARAM_ERROR;
+    }
+
+    err = sst_core_get_object_idx(ctx, obj_uuid, &idx);
+    if (err != PSA_SST_ERR_SUCCESS) {
+        return PSA_SST_ERR_ASSET_NOT_FOUND;
+    }
+
+    return PSA_SST_ERR_SUCCESS;
+}
+
+/**
+ * \brief Gets the size of the largest object extent which can be reserved
+ *
+ * \param[in] reclaim  1 to take into account the space which can be
+ *                     reclaimed by compacting a logical block, 0 to only take
+ *                     into account the free space at the end of the blocks
+ *
+ * \return Returns the largest extent size, according to the scratch metadata
+ */
+static uint32_t sst_meta_max_extent_size(struct sst_core_ctx_t *ctx,
+                                         uint32_t reclaim)
+{
+    const struct sst_block_metadata *block_meta;
+    uint32_t max_size = 0;
+    uint32_t lblock;
+    uint32_t size;
+
+    for (lblock = 0; lblock < ctx->nbr_active_dblocks; lblock++) {
+        block_meta = &ctx->meta_scratch.block_meta[lblock];
+        if (reclaim) {
+            size = (ctx->block_size - block_meta->data_start -
+                    sst_dblock_live_size(ctx, lblock));
+        } else {
+            size = block_meta->free_size;
+        }
+
+        if (size > max_size) {
+            max_size = size;
+        }
+    }
+
+    return max_size;
+}
+
+/**
+ * \brief Writes data in an object extent, as part of the metadata update in
+ *        progress
+ *
+ * \details Data appended to the extent is programmed in place, in the erased
+ *          space which follows the extent's content, when it is possible.
+ *          Otherwise, the extent's new content is programmed in erased space
+ *          of its data block: in the extent's space if nothing has been
+ *          programmed there since it was reserved, otherwise in the free space
+ *          at the end of the block. The erased state is checked as an
+ *          interrupted update may have left programmed data there. If the
+ *          block has run out of erased space, it is compacted in the scratch
+ *          block, together with the extent's new content.
+ *
+ * \param[in]     object_index  Index of the extent
+ * \param[in,out] patch         Pointer to the extent's patch. Its keep_size
+ *                              is set to the extent's current size.
+ *
+ * \note The scratch metadata must have been initialized by the caller.
+ *
+ * \return Returns error code as specified in \ref psa_sst_err_t
+ */
+static enum psa_sst_err_t sst_dblock_write_extent(struct sst_core_ctx_t *ctx,
+                                                  uint32_t object_index,
+                                                struct sst_obj_patch_t *patch)
+{
     enum psa_sst_err_t err;
-    struct sst_assetmeta tmp_metadata;
+    uint32_t data_index;
+    uint32_t new_size;
+    uint32_t slot_size;
+    uint32_t align_flash_nbr_bytes;
+    struct sst_assetmeta object_meta;
+    struct sst_block_metadata block_meta;
+
+    sst_utils_memcpy(&object_meta, &ctx->meta_scratch.object_meta[object_index],
+                     sizeof(struct sst_assetmeta));
+    sst_utils_memcpy(&block_meta,
+                     &ctx->meta_scratch.block_meta[object_meta.lblock],
+                     sizeof(struct sst_block_metadata));
+
+    patch->keep_size = object_meta.cur_size;
+    new_size = object_meta.cur_size;
+    if ((patch->offset + patch->size) > new_size) {
+        new_size = (patch->offset + patch->size);
+    }
 
-    for (i = 0; i < SST_NUM_ASSETS; i++) {
-        err = sst_meta_read_object_meta(i, &tmp_metadata);
-        /* Read from flash failed */
+    if (sst_dblock_check_append(ctx, &object_meta, block_meta.phys_id,
+                                       patch->offset, patch->size) ==
+                                                         PSA_SST_ERR_SUCCESS) {
+        err = sst_dblock_append(ctx, &object_meta, block_meta.phys_id,
+                                patch->data, patch->offset, patch->size);
         if (err != PSA_SST_ERR_SUCCESS) {
             return PSA_SST_ERR_SYSTEM_ERROR;
         }
+    } else {
+        align_flash_nbr_bytes = sst_get_aligned_flash_bytes(new_size);
+        slot_size = sst_get_aligned_flash_bytes(object_meta.max_size);
+        data_index = ctx->block_size;
+        if ((object_meta.cur_size == 0) &&
+            (sst_dblock_check_erased(ctx, block_meta.phys_id,
+                                     object_meta.data_index,
+                                     align_flash_nbr_bytes) ==
+                                                         PSA_SST_ERR_SUCCESS)) {
+            data_index = object_meta.data_index;
+        } else if ((block_meta.free_size >= slot_size) &&
+                   (sst_dblock_check_erased(ctx, block_meta.phys_id,
+                                      (ctx->block_size - block_meta.free_size),
+                                      align_flash_nbr_bytes) ==
+                                                         PSA_SST_ERR_SUCCESS)) {
+            data_index = (ctx->block_size - block_meta.free_size);
+            block_meta.free_size -= slot_size;
+        }
+
+        if (data_index == ctx->block_size) {
+            object_meta.cur_size = new_size;
+
+            /* Update object's metadata to reflect new attributes */
+            err = sst_mblock_update_scratch_object_meta(ctx, object_index,
+                                                        &object_meta);
+            if (err != PSA_SST_ERR_SUCCESS) {
+                return PSA_SST_ERR_SYSTEM_ERROR;
+            }
+
+            /* The block has run out of erased space. Compact it in the
+             * scratch block, together with the extent's new content.
+             */
+            err = sst_compact_dblock(ctx, object_meta.lblock, object_index,
+                                     patch);
+            if (err != PSA_SST_ERR_SUCCESS) {
+                return err;
+            }
 
-        /* Unique_id with value 0x00 means end of asset meta section */
-        if (tmp_metadata.unique_id == obj_uuid) {
-            /* Found */
-            *obj_idx = i;
             return PSA_SST_ERR_SUCCESS;
         }
 
+        err = sst_dblock_write_patch(ctx, block_meta.phys_id, data_index,
+                                     block_meta.phys_id,
+                                     object_meta.data_index, new_size, patch);
+        if (err != PSA_SST_ERR_SUCCESS) {
+            return PSA_SST_ERR_SYSTEM_ERROR;
+        }
+
+        object_meta.data_index = data_index;
+
+        /* Update block metadata in scratch metadata block */
+        err = sst_mblock_update_scratch_block_meta(ctx, object_meta.lblock,
+                                                   &block_meta);
+        if (err != PSA_SST_ERR_SUCCESS) {
+            return PSA_SST_ERR_SYSTEM_ERROR;
+        }
     }
 
-    return PSA_SST_ERR_ASSET_NOT_FOUND;
+    object_meta.cur_size = new_size;
+
+    /* Update object's metadata to reflect new attributes */
+    err = sst_mblock_update_scratch_object_meta(ctx, object_index,
+                                                &object_meta);
+    if (err != PSA_SST_ERR_SUCCESS) {
+        return PSA_SST_ERR_SYSTEM_ERROR;
+    }
+
+    return PSA_SST_ERR_SUCCESS;
 }
 
-enum psa_sst_err_t sst_core_object_exist(uint32_t obj_uuid)
+/**
+ * \brief Writes data in the extents of an object. The part of the data which
+ *        belongs to each extent is written by \ref sst_dblock_write_extent,
+ *        so that all the extents are committed by a single metadata update.
+ *
+ * \param[in] first_index  Index of the object's first extent
+ * \param[in] data         Pointer to the data to write
+ * \param[in] offset       Offset in the object
+ * \param[in] size         Size of the data
+ *
+ * \note The scratch metadata must have been initialized by the caller.
+ *
+ * \return Returns error code as specified in \ref psa_sst_err_t
+ */
+static enum psa_sst_err_t sst_dblock_write_extents(struct sst_core_ctx_t *ctx,
+                                                   uint32_t first_index,
+                                                 const uint8_t *data,
+                                                 uint32_t offset,
+                                                 uint32_t size)
 {
-    uint32_t idx;
+    const struct sst_assetmeta *object_meta;
+    struct sst_obj_patch_t patch;
     enum psa_sst_err_t err;
-
-    err = sst_core_get_object_idx(obj_uuid, &idx);
-    if (err != PSA_SST_ERR_SUCCESS) {
-        return PSA_SST_ERR_ASSET_NOT_FOUND;
+    uint32_t object_index;
+    uint32_t base = 0;
+    uint32_t end = (offset + size);
+
+    for (object_index = first_index;
+         (object_index != SST_METADATA_INVALID_INDEX) && (base < end);
+         object_index = object_meta->next) {
+        object_meta = &ctx->meta_scratch.object_meta[object_index];
+        if (offset < (base + object_meta->max_size)) {
+            patch.offset = (offset > base) ? (offset - base) : 0;
+            patch.size = ((end < (base + object_meta->max_size)) ?
+                          end : (base + object_meta->max_size)) -
+                         (base + patch.offset);
+            patch.data = &data[base + patch.offset - offset];
+
+            err = sst_dblock_write_extent(ctx, object_index, &patch);
+            if (err != PSA_SST_ERR_SUCCESS) {
+                return err;
+            }
+        }
+        base += object_meta->max_size;
     }
 
     return PSA_SST_ERR_SUCCESS;
 }
 
-enum psa_sst_err_t sst_core_object_create(uint32_t object_uuid, uint32_t size)
+enum psa_sst_err_t sst_core_object_create(uint32_t area_id,
+                                          uint32_t object_uuid, uint32_t size,
+                                          const uint8_t *data,
+                                          uint32_t data_size)
 {
-    uint16_t object_index;
+    struct sst_core_ctx_t *ctx;
+    uint32_t object_index;
+    uint32_t first_index = SST_METADATA_INVALID_INDEX;
+    uint32_t prev_index = SST_METADATA_INVALID_INDEX;
+    uint32_t extent_size;
+    uint32_t max_size;
     enum psa_sst_err_t err;
     struct sst_assetmeta object_meta;
     struct sst_block_metadata block_meta;
 
-    err = sst_meta_reserve_object(&object_meta, &block_meta, size);
+    ctx = sst_core_get_ctx(area_id);
+    if (ctx == NULL) {
+        return PSA_SST_ERR_PARAM_ERROR;
+    }
 
-    object_index = sst_get_free_object_index();
-    if ((err != PSA_SST_ERR_SUCCESS) ||
-       (object_index == SST_METADATA_INVALID_INDEX)) {
-        return PSA_SST_ERR_STORAGE_SYSTEM_FULL;
+    if (data_size > size) {
+        return PSA_SST_ERR_PARAM_ERROR;
     }
 
-    object_meta.unique_id = object_uuid;
-    object_meta.cur_size = 0;
-    object_meta.max_size = size;
+    sst_mblock_init_scratch_meta(ctx);
+
+    /* The object is split in several extents when no logical block can fit
+     * it.
+     */
+    do {
+        object_index = sst_get_free_object_index(ctx);
+        if (object_index == SST_METADATA_INVALID_INDEX) {
+            err = PSA_SST_ERR_STORAGE_SYSTEM_FULL;
+            break;
+        }
+
+        extent_size = size;
+        max_size = sst_meta_max_extent_size(ctx, 1);
+        if (extent_size > max_size) {
+            extent_size = max_size;
+        }
+
+        err = PSA_SST_ERR_STORAGE_SYSTEM_FULL;
+        if ((extent_size > 0) || (size == 0)) {
+            err = sst_meta_reserve_object(ctx, &object_meta, &block_meta,
+                                          extent_size);
+        }
+
+        if (err == PSA_SST_ERR_STORAGE_SYSTEM_FULL) {
+            /* The update can not compact another block, so the extent is
+             * reserved in the free space at the end of a block.
+             */
+            extent_size = sst_meta_max_extent_size(ctx, 0);
+            if (extent_size > size) {
+                extent_size = size;
+            }
+
+            if (extent_size > 0) {
+                err = sst_meta_reserve_object(ctx, &object_meta, &block_meta,
+                                              extent_size);
+            }
+        }
+
+        if (err != PSA_SST_ERR_SUCCESS) {
+            break;
+        }
+
+        object_meta.unique_id = object_uuid;
+        object_meta.cur_size = 0;
+        object_meta.max_size = extent_size;
+        object_meta.next = SST_METADATA_INVALID_INDEX;
+
+        err = sst_mblock_update_scratch_object_meta(ctx, object_index,
+                                                    &object_meta);
+        if (err != PSA_SST_ERR_SUCCESS) {
+            err = PSA_SST_ERR_SYSTEM_ERROR;
+            break;
+        }
+
+        err = sst_mblock_update_scratch_block_meta(ctx, object_meta.lblock,
+                                                   &block_meta);
+        if (err != PSA_SST_ERR_SUCCESS) {
+            err = PSA_SST_ERR_SYSTEM_ERROR;
+            break;
+        }
+
+        /* Link the extent to the previous one */
+        if (prev_index == SST_METADATA_INVALID_INDEX) {
+            first_index = object_index;
+        } else {
+            ctx->meta_scratch.object_meta[prev_index].next = object_index;
+        }
+
+        sst_index_set_free(ctx, object_index, 0);
+        prev_index = object_index;
+        size -= extent_size;
+    } while (size > 0);
+
+    /* The initial content is written as part of the same update, so that the
+     * object is never visible without it.
+     */
+    if ((err == PSA_SST_ERR_SUCCESS) && (data_size > 0)) {
+        err = sst_dblock_write_extents(ctx, first_index, data, 0, data_size);
+    }
 
-    err = sst_mblock_update_scratch_object_meta(object_index, &object_meta);
     if (err != PSA_SST_ERR_SUCCESS) {
-        return PSA_SST_ERR_SYSTEM_ERROR;
+        /* Release the object entries taken by the reserved extents */
+        for (object_index = first_index;
+             object_index != SST_METADATA_INVALID_INDEX;
+             object_index = ctx->meta_scratch.object_meta[object_index].next) {
+            sst_index_set_free(ctx, object_index, 1);
+        }
+        return err;
     }
 
-    /* If the object is in logical block 0, then update the physical ID to the
-     * current scratch metadata block so that it is correct after the metadata
-     * blocks are swapped.
-     */
-    if (object_meta.lblock == SST_LOGICAL_DBLOCK0) {
-        block_meta.phys_id = sst_meta_cur_meta_scratch();
+    /* Commit the metadata update, unless it is part of a transaction */
+    if (ctx->txn_state == SST_TXN_IDLE) {
+        err = sst_meta_update_finalize(ctx);
+        if (err != PSA_SST_ERR_SUCCESS) {
+            /* Resynchronize the object index with the active metadata block,
+             * as the update may have been committed or not.
+             */
+            (void)sst_index_build(ctx);
+            return PSA_SST_ERR_SYSTEM_ERROR;
+        }
     }
 
-    err = sst_mblock_update_scratch_block_meta(object_meta.lblock,
-                                               &block_meta);
-    if (err != PSA_SST_ERR_SUCCESS) {
-        return PSA_SST_ERR_SYSTEM_ERROR;
+    sst_index_insert(ctx, object_uuid, first_index);
+
+    return PSA_SST_ERR_SUCCESS;
+}
+
+enum psa_sst_err_t sst_core_object_get_info(uint32_t area_id,
+                                            uint32_t object_uuid,
+                                            struct sst_core_obj_info_t *info)
+{
+    struct sst_core_ctx_t *ctx;
+    const struct sst_metadata_table_t *table;
+    enum psa_sst_err_t err;
+    uint32_t object_index;
+
+    ctx = sst_core_get_ctx(area_id);
+    if (ctx == NULL) {
+        return PSA_SST_ERR_PARAM_ERROR;
     }
 
-    err = sst_mblock_copy_remaining_object_meta(object_index);
+    /* Get the meta data index */
+    err = sst_core_get_object_idx(ctx, object_uuid, &object_index);
     if (err != PSA_SST_ERR_SUCCESS) {
-        return PSA_SST_ERR_SYSTEM_ERROR;
+        return PSA_SST_ERR_ASSET_NOT_FOUND;
     }
 
-    err = sst_mblock_copy_remaining_block_meta(object_meta.lblock);
-    if (err != PSA_SST_ERR_SUCCESS) {
-        return PSA_SST_ERR_SYSTEM_ERROR;
-    }
+    table = sst_meta_cur_table(ctx);
 
-    /* The objects' data in the logical block 0 is stored in same physical block
-     * where the metadata is stored. A change in the metadata requires a
-     * swap of physical blocks. So, the objects' data stored in the current
-     * metadata block needs to be copied in the scratch block.
-     */
-    err = sst_mblock_migrate_data_to_scratch();
-    if (err != PSA_SST_ERR_SUCCESS) {
-        return PSA_SST_ERR_SYSTEM_ERROR;
+    /* Check if index is still referring to same object */
+    if (object_uuid != table->object_meta[object_index].unique_id) {
+        return PSA_SST_ERR_ASSET_NOT_FOUND;
     }
 
-    /* Write metadata header, swap metadata blocks and erase scratch blocks */
-    err = sst_meta_update_finalize();
-    if (err != PSA_SST_ERR_SUCCESS) {
-        return PSA_SST_ERR_SYSTEM_ERROR;
+    /* The object's sizes are the sums of the sizes of its extents */
+    info->size_max = 0;
+    info->size_current = 0;
+    while (object_index != SST_METADATA_INVALID_INDEX) {
+        info->size_max += table->object_meta[object_index].max_size;
+        info->size_current += table->object_meta[object_index].cur_size;
+        object_index = table->object_meta[object_index].next;
     }
 
     return PSA_SST_ERR_SUCCESS;
 }
 
-enum psa_sst_err_t sst_core_object_get_info(uint32_t object_uuid,
-                                            struct sst_core_obj_info_t *info)
+enum psa_sst_err_t sst_core_object_next(uint32_t area_id, uint32_t *index,
+                                        uint32_t *uuid,
+                                        struct sst_core_obj_info_t *info)
 {
-    enum psa_sst_err_t err = PSA_SST_ERR_SYSTEM_ERROR;
-    struct sst_assetmeta tmp_metadata;
+    struct sst_core_ctx_t *ctx;
+    const struct sst_metadata_table_t *table;
+    uint32_t first_index;
     uint32_t object_index;
+    uint32_t object_uuid;
 
-    /* Get the meta data index */
-    err = sst_core_get_object_idx(object_uuid, &object_index);
-    if (err != PSA_SST_ERR_SUCCESS) {
-        return PSA_SST_ERR_ASSET_NOT_FOUND;
+    ctx = sst_core_get_ctx(area_id);
+    if (ctx == NULL) {
+        return PSA_SST_ERR_PARAM_ERROR;
     }
 
-    /* Read object metadata */
-    err = sst_meta_read_object_meta(object_index, &tmp_metadata);
-    if (err == 0) {
-        /* Check if index is still referring to same object */
-        if (object_uuid != tmp_metadata.unique_id) {
-            err = PSA_SST_ERR_ASSET_NOT_FOUND;
-        } else {
-            info->size_max = tmp_metadata.max_size;
-            info->size_current = tmp_metadata.cur_size;
+    table = sst_meta_cur_table(ctx);
+
+    for (object_index = *index; object_index < SST_NUM_OBJECT_ENTRIES;
+         object_index++) {
+        object_uuid = table->object_meta[object_index].unique_id;
+        if (sst_utils_validate_uuid(object_uuid) != PSA_SST_ERR_SUCCESS) {
+            continue;
+        }
+
+        /* Only the first extent of an object is indexed, so the other
+         * extents are skipped.
+         */
+        if ((sst_core_get_object_idx(ctx, object_uuid, &first_index) !=
+                                                         PSA_SST_ERR_SUCCESS) ||
+            (first_index != object_index)) {
+            continue;
+        }
+
+        *uuid = object_uuid;
+        *index = (object_index + 1);
+
+        /* The object's sizes are the sums of the sizes of its extents */
+        info->size_max = 0;
+        info->size_current = 0;
+        while (object_index != SST_METADATA_INVALID_INDEX) {
+            info->size_max += table->object_meta[object_index].max_size;
+            info->size_current += table->object_meta[object_index].cur_size;
+            object_index = table->object_meta[object_index].next;
         }
+
+        return PSA_SST_ERR_SUCCESS;
     }
 
-    return err;
+    *index = SST_NUM_OBJECT_ENTRIES;
+
+    return PSA_SST_ERR_ASSET_NOT_FOUND;
 }
 
-enum psa_sst_err_t sst_core_object_write(uint32_t object_uuid,
+enum psa_sst_err_t sst_core_object_write(uint32_t area_id,
+                                         uint32_t object_uuid,
                                          const uint8_t *data, uint32_t offset,
                                          uint32_t size)
 {
-    uint32_t object_index;
+    struct sst_core_ctx_t *ctx;
+    struct sst_core_obj_info_t info;
     enum psa_sst_err_t err;
-    uint32_t cur_phys_block;
-    const uint8_t *prepared_buf;
-    struct sst_assetmeta object_meta;
-    struct sst_block_metadata block_meta;
-    uint32_t align_flash_nbr_bytes;
-#ifndef SST_ENABLE_PARTIAL_ASSET_RW
-    (void)offset;
-#endif
+    uint32_t first_index;
 
-    /* Get the object index */
-    err = sst_core_get_object_idx(object_uuid, &object_index);
-    if (err != PSA_SST_ERR_SUCCESS) {
-        return PSA_SST_ERR_ASSET_NOT_FOUND;
+    ctx = sst_core_get_ctx(area_id);
+    if (ctx == NULL) {
+        return PSA_SST_ERR_PARAM_ERROR;
     }
 
-    /* Read object metadata */
-    err = sst_meta_read_object_meta(object_index, &object_meta);
+    err = sst_core_object_get_info(ctx->area_id, object_uuid, &info);
     if (err != PSA_SST_ERR_SUCCESS) {
         return PSA_SST_ERR_ASSET_NOT_FOUND;
     }
 
-    /* Update block metadata */
-    err = sst_meta_read_block_metadata(object_meta.lblock, &block_meta);
-    if (err != PSA_SST_ERR_SUCCESS) {
-        return PSA_SST_ERR_SYSTEM_ERROR;
-    }
-
-#ifdef SST_ENABLE_PARTIAL_ASSET_RW
-    /* offset can not be bigger than the current asset's size to disallows gaps
-     * without content inside the asset.
+    /* offset can not be bigger than the current object's size to disallow
+     * gaps without content inside the object.
      */
-    if (offset > object_meta.cur_size) {
+    if ((offset > info.size_current) || (size > (info.size_max - offset))) {
         return PSA_SST_ERR_PARAM_ERROR;
     }
-#endif
 
-#ifndef SST_ENCRYPTION
-    prepared_buf = sst_buf_plain_text;
-
-    /* Clean previous data in sst_buf_plain_text */
-    sst_utils_memset(sst_buf_plain_text, SST_DEFAULT_EMPTY_BUFF_VAL,
-                     SST_ALIGNED_MAX_OBJECT_SIZE);
-
-    if (object_meta.cur_size > 0) {
-        /* Copy the current asset's data into the sst_buf_plain_text buffer. */
-        err = sst_block_object_read_raw(&object_meta,
-                                        SST_OBJECT_START_POSITION,
-                                        object_meta.cur_size,
-                                        sst_buf_plain_text);
-        if (err != PSA_SST_ERR_SUCCESS) {
-            return err;
-        }
+    if (size == 0) {
+        return PSA_SST_ERR_SUCCESS;
     }
 
-#ifdef SST_ENABLE_PARTIAL_ASSET_RW
-    /* sst_am_write has checked that offset + size value is not bigger than
-     * the asset's maximum size. So, it is not needed to check it at this
-     * point.
-     */
-    if ((offset + size) > object_meta.cur_size) {
-        /* Update the object metadata */
-        object_meta.cur_size = offset + size;
-    }
+    (void)sst_core_get_object_idx(ctx, object_uuid, &first_index);
 
-    /* Copy new data in the sst_buf_plain_text */
-    sst_utils_memcpy(sst_buf_plain_text + offset, data, size);
-#else
-    if (size > object_meta.cur_size) {
-        /* Update the object metadata */
-        object_meta.cur_size = size;
-    }
+    sst_mblock_init_scratch_meta(ctx);
 
-    /* Copy new data in the sst_buf_plain_text */
-    sst_utils_memcpy(sst_buf_plain_text, data, size);
-#endif /* SST_ENABLE_PARTIAL_ASSET_RW */
+    err = sst_dblock_write_extents(ctx, first_index, data, offset, size);
+    if (err != PSA_SST_ERR_SUCCESS) {
+        return err;
+    }
 
-#else
-    prepared_buf = data;
-    object_meta.cur_size = size;
+    /* Commit the metadata update, unless it is part of a transaction */
+    if (ctx->txn_state == SST_TXN_ACTIVE) {
+        return PSA_SST_ERR_SUCCESS;
+    }
 
-#endif /* SST_ENCRYPTION */
+    return sst_meta_update_finalize(ctx);
+}
 
-    align_flash_nbr_bytes = sst_get_aligned_flash_bytes(object_meta.cur_size);
+enum psa_sst_err_t sst_core_object_delete(uint32_t area_id,
+                                          uint32_t object_uuid)
+{
+    struct sst_core_ctx_t *ctx;
+    uint32_t del_obj_index;
+    uint32_t object_index;
+    uint32_t next_index;
+    enum psa_sst_err_t err;
+    struct sst_assetmeta object_meta;
 
-    /* Copy the content into scratch data buffer */
-    err = sst_dblock_update_scratch(object_meta.lblock, &block_meta,
-                                    prepared_buf, object_meta.data_index,
-                                    align_flash_nbr_bytes);
-    if (err != PSA_SST_ERR_SUCCESS) {
-        return PSA_SST_ERR_SYSTEM_ERROR;
+    ctx = sst_core_get_ctx(area_id);
+    if (ctx == NULL) {
+        return PSA_SST_ERR_PARAM_ERROR;
     }
 
-    cur_phys_block = block_meta.phys_id;
-    /* Cur scratch block become the active datablock */
-    block_meta.phys_id = sst_meta_cur_data_scratch(object_meta.lblock);
-    /* swap the scratch data block */
-    sst_meta_set_data_scratch(cur_phys_block, object_meta.lblock);
-
-    /* Update block metadata in scratch metadata block */
-    err = sst_mblock_update_scratch_block_meta(object_meta.lblock, &block_meta);
+    /* Get the object index */
+    err = sst_core_get_object_idx(ctx, object_uuid, &del_obj_index);
     if (err != PSA_SST_ERR_SUCCESS) {
-        return PSA_SST_ERR_SYSTEM_ERROR;
+        return PSA_SST_ERR_ASSET_NOT_FOUND;
     }
 
-    /* Update object's metadata to reflect new attributes */
-    err = sst_mblock_update_scratch_object_meta(object_index, &object_meta);
+    err = sst_meta_read_object_meta(ctx->area_id, del_obj_index, &object_meta);
     if (err != PSA_SST_ERR_SUCCESS) {
-        return PSA_SST_ERR_SYSTEM_ERROR;
+        return err;
     }
 
-    /* Copy rest of the block metadata entries */
-    err = sst_mblock_copy_remaining_block_meta(object_meta.lblock);
-    if (err != PSA_SST_ERR_SUCCESS) {
-        return PSA_SST_ERR_SYSTEM_ERROR;
+    if (sst_utils_validate_uuid(object_meta.unique_id) != PSA_SST_ERR_SUCCESS) {
+        return PSA_SST_ERR_ASSET_NOT_FOUND;
     }
 
-    /* Copy rest of the object metadata entries */
-    err = sst_mblock_copy_remaining_object_meta(object_index);
-    if (err != PSA_SST_ERR_SUCCESS) {
-        return PSA_SST_ERR_SYSTEM_ERROR;
-    }
+    sst_mblock_init_scratch_meta(ctx);
 
-    /* The objects' data in the logical block 0 is stored in same physical block
-     * where the metadata is stored. A change in the metadata requires a
-     * swap of physical blocks. So, the objects' data stored in the current
-     * metadata block needs to be copied in the scratch block, if the data
-     * of the object processed is not located in the logical block 0. When an
-     * object's data is located in the logical block 0, that copy has been done
-     * while processing the object's data.
+    /* Remove the metadata of the object's extents. The object's space is
+     * reclaimed when its logical blocks are compacted.
      */
-    if (object_meta.lblock != SST_LOGICAL_DBLOCK0) {
-        err = sst_mblock_migrate_data_to_scratch();
+    object_index = del_obj_index;
+    while (object_index != SST_METADATA_INVALID_INDEX) {
+        sst_utils_memcpy(&object_meta,
+                         &ctx->meta_scratch.object_meta[object_index],
+                         sizeof(struct sst_assetmeta));
+        next_index = object_meta.next;
+
+        object_meta.unique_id = SST_INVALID_UUID;
+        object_meta.lblock = 0;
+        object_meta.max_size = 0;
+        object_meta.cur_size = 0;
+        object_meta.next = SST_METADATA_INVALID_INDEX;
+
+        /* Update object's metadata in to the scratch block */
+        err = sst_mblock_update_scratch_object_meta(ctx, object_index,
+                                                    &object_meta);
         if (err != PSA_SST_ERR_SUCCESS) {
             return PSA_SST_ERR_SYSTEM_ERROR;
         }
+
+        /* The entries of the extents which follow the first one are released
+         * here, as they are not referenced by the object index.
+         */
+        if (object_index != del_obj_index) {
+            sst_index_set_free(ctx, object_index, 1);
+        }
+
+        object_index = next_index;
     }
 
-    /* Update the metablock header, swap scratch and active blocks,
-     * erase scratch blocks.
-     */
-    err = sst_meta_update_finalize();
+    /* Commit the metadata update, unless it is part of a transaction */
+    if (ctx->txn_state == SST_TXN_IDLE) {
+        err = sst_meta_update_finalize(ctx);
+        if (err != PSA_SST_ERR_SUCCESS) {
+            /* Resynchronize the object index with the active metadata block,
+             * as the update may have been committed or not.
+             */
+            (void)sst_index_build(ctx);
+            return err;
+        }
+    }
+
+    sst_index_remove(ctx, object_uuid);
 
     return err;
 }
 
-/**
- * \brief Compacts data block for the given logical block.
- *
- * \param[in] lblock      Logical block to compact
- * \param[in] obj_size    Available data size to compact
- * \param[in] src_offset  Offset in the current data block which points to the
- *                        data positon to realocate
- * \param[in] dst_offset  Offset in the scratch block which points to the
- *                        data position to store the data to be realocated
- * \param[in] size        Number of bytes to be realocated
- *
- * \return Returns error code as specified in \ref psa_sst_err_t
- */
-static enum psa_sst_err_t sst_compact_dblock(uint32_t lblock, uint32_t obj_size,
-                                       uint32_t src_offset, uint32_t dst_offset,
-                                       uint32_t size)
+enum psa_sst_err_t sst_core_object_read(uint32_t area_id,
+                                        uint32_t object_uuid, uint8_t *data,
+                                        uint32_t offset, uint32_t size)
 {
-    struct sst_block_metadata block_meta;
+    struct sst_core_ctx_t *ctx;
+    const struct sst_metadata_table_t *table;
+    const struct sst_assetmeta *object_meta;
+    struct sst_core_obj_info_t info;
     enum psa_sst_err_t err;
-    uint32_t scratch_dblock_id = 0;
+    uint32_t object_index;
+    uint32_t base = 0;
+    uint32_t start;
+    uint32_t end;
+
+    ctx = sst_core_get_ctx(area_id);
+    if (ctx == NULL) {
+        return PSA_SST_ERR_PARAM_ERROR;
+    }
 
-    /* Read current block meta */
-    err = sst_meta_read_block_metadata(lblock, &block_meta);
+    err = sst_core_object_get_info(ctx->area_id, object_uuid, &info);
     if (err != PSA_SST_ERR_SUCCESS) {
-        return err;
+        return PSA_SST_ERR_ASSET_NOT_FOUND;
+    }
+
+    /* Boundary check the incoming request */
+    err = sst_utils_check_contained_in(0, info.size_current, offset, size);
+    if (err != PSA_SST_ERR_SUCCESS) {
+        return PSA_SST_ERR_PARAM_ERROR;
     }
 
-    /* Release data from block meta */
-    block_meta.free_size += obj_size;
+    (void)sst_core_get_object_idx(ctx, object_uuid, &object_index);
+    table = sst_meta_cur_table(ctx);
 
-    /* Save scratch data block physical IDs */
-    scratch_dblock_id = sst_meta_cur_data_scratch(lblock);
+    /* Read the part of the requested data stored in each extent */
+    while ((object_index != SST_METADATA_INVALID_INDEX) &&
+           (base < (offset + size))) {
+        object_meta = &table->object_meta[object_index];
 
-    /* Check if there are bytes to be compacted */
-    if (size > 0) {
-        /* Move data from source offset in current data block to scratch block
-         * destination offset.
-         */
-        err = sst_flash_block_to_block_move(scratch_dblock_id, dst_offset,
-                                            block_meta.phys_id, src_offset,
-                                            size);
-        if (err != PSA_SST_ERR_SUCCESS) {
-            return PSA_SST_ERR_SYSTEM_ERROR;
+        start = (offset > base) ? offset : base;
+        end = (base + object_meta->cur_size);
+        if (end > (offset + size)) {
+            end = (offset + size);
         }
-    }
 
-    if (dst_offset > block_meta.data_start) {
-        /* Copy data from the beginning of data block until
-         * the position where the data will be realocated later
-         */
-        err = sst_flash_block_to_block_move(scratch_dblock_id,
-                                            block_meta.data_start,
-                                            block_meta.phys_id,
-                                            block_meta.data_start,
-                                            (dst_offset-block_meta.data_start));
-        if (err != PSA_SST_ERR_SUCCESS) {
-            return PSA_SST_ERR_SYSTEM_ERROR;
+        if (start < end) {
+            err = sst_block_object_read_raw(ctx, object_meta, (start - base),
+                                            (end - start),
+                                            &data[start - offset]);
+            if (err != PSA_SST_ERR_SUCCESS) {
+                return PSA_SST_ERR_SYSTEM_ERROR;
+            }
         }
+
+        base += object_meta->max_size;
+        object_index = object_meta->next;
     }
 
-    /* Swap the scratch and current data blocks. Must swap even with nothing
-     * to compact so that deleted object is left in scratch and erased as part
-     * of finalization.
-     */
-    sst_meta_set_data_scratch(block_meta.phys_id, lblock);
+    return PSA_SST_ERR_SUCCESS;
+}
 
-    /* Set scratch block ID as the one which contains the new data block */
-    block_meta.phys_id = scratch_dblock_id;
+enum psa_sst_err_t sst_core_txn_begin(uint32_t area_id)
+{
+    struct sst_core_ctx_t *ctx;
 
-    /* Update block metadata in scratch metadata block */
-    err = sst_mblock_update_scratch_block_meta(lblock, &block_meta);
-    if (err != PSA_SST_ERR_SUCCESS) {
-        /* Swap back the data block as there was an issue in the process */
-        sst_meta_set_data_scratch(scratch_dblock_id, lblock);
-        return err;
+    ctx = sst_core_get_ctx(area_id);
+    if (ctx == NULL) {
+        return PSA_SST_ERR_PARAM_ERROR;
     }
 
-    /* Copy rest of the block metadata entries */
-    err = sst_mblock_copy_remaining_block_meta(lblock);
-    if (err != PSA_SST_ERR_SUCCESS) {
-        /* Swap back the data block as there was an issue in the process */
-        sst_meta_set_data_scratch(scratch_dblock_id, lblock);
+    if (ctx->txn_state == SST_TXN_ACTIVE) {
+        return PSA_SST_ERR_SYSTEM_ERROR;
     }
 
-    return err;
+    sst_mblock_init_scratch_meta(ctx);
+    ctx->txn_state = SST_TXN_ACTIVE;
+
+    return PSA_SST_ERR_SUCCESS;
 }
 
-enum psa_sst_err_t sst_core_object_delete(uint32_t object_uuid)
+enum psa_sst_err_t sst_core_txn_commit(uint32_t area_id)
 {
-    uint32_t del_obj_data_index;
-    uint32_t del_obj_lblock;
-    uint32_t del_obj_index;
-    uint32_t del_obj_max_size;
+    struct sst_core_ctx_t *ctx;
     enum psa_sst_err_t err;
-    uint32_t src_offset = SST_BLOCK_SIZE;
-    uint32_t nbr_bytes_to_move = 0;
-    uint32_t obj_idx;
-    struct sst_assetmeta object_meta;
-
-    /* Get the object index */
-    err = sst_core_get_object_idx(object_uuid, &del_obj_index);
-    if (err != PSA_SST_ERR_SUCCESS) {
-        return PSA_SST_ERR_ASSET_NOT_FOUND;
-    }
 
-    err = sst_meta_read_object_meta(del_obj_index, &object_meta);
-    if (err != PSA_SST_ERR_SUCCESS) {
-        return err;
+    ctx = sst_core_get_ctx(area_id);
+    if (ctx == NULL) {
+        return PSA_SST_ERR_PARAM_ERROR;
     }
 
-    if (sst_utils_validate_uuid(object_meta.unique_id) != PSA_SST_ERR_SUCCESS) {
-        return PSA_SST_ERR_ASSET_NOT_FOUND;
+    if (ctx->txn_state != SST_TXN_ACTIVE) {
+        return PSA_SST_ERR_SYSTEM_ERROR;
     }
 
-    /* Save logical block, data_index and max_size to be used later on */
-    del_obj_lblock = object_meta.lblock;
-    del_obj_data_index = object_meta.data_index;
-    del_obj_max_size = sst_get_aligned_flash_bytes(object_meta.max_size);
-
-    /* Remove object metadata */
-    object_meta.unique_id = SST_INVALID_UUID;
-    object_meta.lblock = 0;
-    object_meta.max_size = 0;
-    object_meta.cur_size = 0;
+    ctx->txn_state = SST_TXN_IDLE;
 
-    /* Update object's metadata in to the scratch block */
-    sst_mblock_update_scratch_object_meta(del_obj_index, &object_meta);
-
-    /* Read all object metadata */
-    for (obj_idx = 0; obj_idx < SST_NUM_ASSETS; obj_idx++) {
-        if (obj_idx == del_obj_index) {
-            /* Skip deleted object */
-            continue;
-        }
+    /* Commit all the metadata updates at once. The data of the transaction
+     * has already been programmed.
+     */
+    err = sst_meta_update_finalize(ctx);
 
-        /* Read object meta for the given object index */
-        err = sst_meta_read_object_meta(obj_idx, &object_meta);
-        if (err != PSA_SST_ERR_SUCCESS) {
-            return err;
-        }
+    if (err != PSA_SST_ERR_SUCCESS) {
+        /* Resynchronize the object index with the active metadata block, as
+         * the transaction may have been committed or not.
+         */
+        (void)sst_index_build(ctx);
+        return PSA_SST_ERR_SYSTEM_ERROR;
+    }
 
-        /* Check if the object is located in the same logical block */
-        if (object_meta.lblock == del_obj_lblock) {
-            /* If an object is located after the data to delete, this
-             * needs to be moved.
-             */
-            if (object_meta.data_index > del_obj_data_index) {
-                /* Check if this is the position after the deleted
-                 * data. This will be the first asset's data to move.
-                 */
-                if (src_offset > object_meta.data_index) {
-                    src_offset = object_meta.data_index;
-                }
+    return PSA_SST_ERR_SUCCESS;
+}
 
-                /* Set the new object data index location in the
-                 * data block.
-                 */
-                object_meta.data_index -= del_obj_max_size;
+enum psa_sst_err_t sst_core_txn_abort(uint32_t area_id)
+{
+    struct sst_core_ctx_t *ctx;
 
-                /* Increase number of bytes to move */
-                nbr_bytes_to_move += sst_get_aligned_flash_bytes(
-                                                          object_meta.max_size);
-            }
-        }
-        /* Update object's metadata in to the scratch block */
-        sst_mblock_update_scratch_object_meta(obj_idx, &object_meta);
+    ctx = sst_core_get_ctx(area_id);
+    if (ctx == NULL) {
+        return PSA_SST_ERR_PARAM_ERROR;
     }
 
-    /* Compact data block */
-    err = sst_compact_dblock(del_obj_lblock, del_obj_max_size, src_offset,
-                             del_obj_data_index, nbr_bytes_to_move);
-    if (err != PSA_SST_ERR_SUCCESS) {
-        return err;
+    if (ctx->txn_state != SST_TXN_ACTIVE) {
+        return PSA_SST_ERR_SYSTEM_ERROR;
     }
 
-    /* Update the metablock header, swap scratch and active blocks,
-     * erase scratch blocks.
+    /* The data programmed by the transaction is not referenced by the
+     * active metadata. Discard the staged updates and resynchronize the
+     * object index with the active metadata block. The scratch blocks claimed
+     * by the transaction are released by the next update.
      */
-    sst_meta_update_finalize();
+    ctx->txn_state = SST_TXN_IDLE;
 
-    return err;
+    return sst_index_build(ctx);
 }
 
-enum psa_sst_err_t sst_core_object_read(uint32_t object_uuid, uint8_t *data,
-                                        uint32_t offset, uint32_t size)
+enum psa_sst_err_t sst_core_maintenance(uint32_t area_id)
 {
-    uint32_t object_index;
+    struct sst_core_ctx_t *ctx;
     enum psa_sst_err_t err;
-    struct sst_assetmeta tmp_metadata;
 
-    /* Get the object index */
-    err = sst_core_get_object_idx(object_uuid, &object_index);
+    ctx = sst_core_get_ctx(area_id);
+    if (ctx == NULL) {
+        return PSA_SST_ERR_PARAM_ERROR;
+    }
+
+    /* The scratch blocks claimed by an active transaction are in use, so
+     * only the retired blocks are erased while it is active.
+     */
+    err = sst_scratch_erase_retired(ctx);
     if (err != PSA_SST_ERR_SUCCESS) {
-        return PSA_SST_ERR_ASSET_NOT_FOUND;
+        return err;
     }
 
-    /* Read object metadata */
-    err = sst_meta_read_object_meta(object_index, &tmp_metadata);
+    /* The compaction is an update, which can not be done while the
+     * transaction's updates are staged in the scratch metadata.
+     */
+    if (ctx->txn_state == SST_TXN_ACTIVE) {
+        return PSA_SST_ERR_SUCCESS;
+    }
 
+    err = sst_compact_step(ctx);
     if (err != PSA_SST_ERR_SUCCESS) {
-        return PSA_SST_ERR_SYSTEM_ERROR;
+        return err;
     }
 
-    /* Check if index is still referring to same asset */
-    if (object_uuid != tmp_metadata.unique_id) {
-        return PSA_SST_ERR_ASSET_NOT_FOUND;
+    /* Once the compaction is done, record the erased blocks, so that the next
+     * mount does not erase them.
+     */
+    if (ctx->meta_active.compact.lblock != SST_COMPACT_NO_LBLOCK) {
+        return PSA_SST_ERR_SUCCESS;
     }
 
-    /* Boundary check the incoming request */
-    err = sst_utils_check_contained_in(0, tmp_metadata.cur_size,
-                                       offset, size);
-    if (err != PSA_SST_ERR_SUCCESS) {
+    return sst_ckpt_update(ctx);
+}
+
+enum psa_sst_err_t sst_core_get_wear_info(uint32_t area_id,
+                                          struct psa_sst_wear_info_t *info)
+{
+    struct sst_core_ctx_t *ctx;
+    uint32_t i;
+
+    ctx = sst_core_get_ctx(area_id);
+    if (ctx == NULL) {
         return PSA_SST_ERR_PARAM_ERROR;
     }
 
-    /* Read the object from flash */
-    err = sst_block_object_read_raw(&tmp_metadata, offset, size, data);
-    if (err != PSA_SST_ERR_SUCCESS) {
-        return PSA_SST_ERR_SYSTEM_ERROR;
+    info->nbr_blocks = ctx->nbr_blocks;
+    info->min_erase_count = UINT32_MAX;
+    info->max_erase_count = 0;
+
+    for (i = 0; i < ctx->nbr_blocks; i++) {
+        if (ctx->meta_active.erase_count[i] < info->min_erase_count) {
+            info->min_erase_count = ctx->meta_active.erase_count[i];
+        }
+
+        if (ctx->meta_active.erase_count[i] > info->max_erase_count) {
+            info->max_erase_count = ctx->meta_active.erase_count[i];
+        }
     }
 
     return PSA_SST_ERR_SUCCESS;
@@ -1690,7 +4133,8 @@ enum psa_sst_err_t sst_core_object_read(uint32_t object_uuid, uint8_t *data,
  *
  * \return Returns value as specified in \ref psa_sst_err_t
  */
-static enum psa_sst_err_t sst_init_get_active_metablock(void)
+static enum psa_sst_err_t sst_init_get_active_metablock(
+                                                    struct sst_core_ctx_t *ctx)
 {
     struct sst_metadata_block_header meta0;
     struct sst_metadata_block_header meta1;
@@ -1705,13 +4149,13 @@ static enum psa_sst_err_t sst_init_get_active_metablock(void)
      */
 
     /* Read the header of both the metdata blocks */
-    err = sst_flash_read(SST_METADATA_BLOCK0, (uint8_t *)&meta0,
+    err = sst_flash_read(ctx->area_id, SST_METADATA_BLOCK0, (uint8_t *)&meta0,
                          0, sizeof(struct sst_metadata_block_header));
     if (err != PSA_SST_ERR_SUCCESS) {
         return PSA_SST_ERR_SYSTEM_ERROR;
     }
 
-    err = sst_flash_read(SST_METADATA_BLOCK1, (uint8_t *) &meta1,
+    err = sst_flash_read(ctx->area_id, SST_METADATA_BLOCK1, (uint8_t *) &meta1,
                          0, sizeof(struct sst_metadata_block_header));
     if (err != PSA_SST_ERR_SUCCESS) {
         return PSA_SST_ERR_SYSTEM_ERROR;
@@ -1748,7 +4192,7 @@ static enum psa_sst_err_t sst_init_get_active_metablock(void)
      * of metadata entries decides valid metadata.
      */
     for (i = 0; i < num_valid_meta_blocks; i++) {
-        err = sst_mblock_authenticate(cur_meta_block);
+        err = sst_mblock_authenticate(ctx, cur_meta_block);
         if (err == PSA_SST_ERR_SUCCESS) {
              /* Valid metablock found, stop here */
             err = PSA_SST_ERR_SUCCESS;
@@ -1766,98 +4210,189 @@ static enum psa_sst_err_t sst_init_get_active_metablock(void)
         return PSA_SST_ERR_SYSTEM_ERROR;
     }
 #endif
-    sst_system_ctx.active_metablock = cur_meta_block;
-    sst_system_ctx.scratch_metablock = SST_OTHER_META_BLOCK(cur_meta_block);
+    ctx->sys.active_metablock = cur_meta_block;
+    ctx->sys.scratch_metablock = SST_OTHER_META_BLOCK(cur_meta_block);
 
     return PSA_SST_ERR_SUCCESS;
 }
 
-enum psa_sst_err_t sst_core_prepare(void)
+enum psa_sst_err_t sst_core_prepare(uint32_t area_id)
 {
+    struct sst_core_ctx_t *ctx;
     enum psa_sst_err_t err;
 
+    ctx = sst_core_get_ctx(area_id);
+    if (ctx == NULL) {
+        return PSA_SST_ERR_PARAM_ERROR;
+    }
+
+    err = sst_core_setup_ctx(ctx, area_id);
+    if (err != PSA_SST_ERR_SUCCESS) {
+        return err;
+    }
+
 #if SST_ENCRYPTION
     sst_crypto_init();
 #endif
 
-    err = sst_init_get_active_metablock();
+    err = sst_flash_init(ctx->area_id);
+    if (err != PSA_SST_ERR_SUCCESS) {
+        return err;
+    }
+
+    err = sst_init_get_active_metablock(ctx);
+    if (err != PSA_SST_ERR_SUCCESS) {
+        return PSA_SST_ERR_SYSTEM_ERROR;
+    }
+
+    /* The erase state of the blocks is unknown after a reset */
+    sst_utils_memset(ctx->block_state, SST_BLOCK_DIRTY,
+                     sizeof(ctx->block_state));
+
+    err = sst_meta_load_active_meta(ctx);
     if (err != PSA_SST_ERR_SUCCESS) {
         return PSA_SST_ERR_SYSTEM_ERROR;
     }
 
-    err = sst_meta_read_meta_header();
+    err = sst_meta_read_meta_header(ctx);
     if (err != PSA_SST_ERR_SUCCESS) {
         return PSA_SST_ERR_SYSTEM_ERROR;
     }
 
 #if SST_ENCRYPTION
     /* Provide the current IV value to the crypto layer */
-    sst_crypto_set_iv(&sst_system_ctx.meta_block_header.crypto);
+    sst_crypto_set_iv(&ctx->sys.meta_block_header.crypto);
 #endif
 
-    /* Erase the other scratch metadata block */
-    err = sst_meta_erase_scratch_blocks();
+    /* Build the RAM index of the objects stored in the active metadata */
+    err = sst_index_build(ctx);
+    if (err != PSA_SST_ERR_SUCCESS) {
+        return PSA_SST_ERR_SYSTEM_ERROR;
+    }
 
-    return err;
+    /* A clean mount takes the erased blocks from the checkpoint, so that only
+     * the blocks retired since it was taken are erased.
+     */
+    sst_ckpt_restore(ctx);
+
+    /* Erase the scratch blocks */
+    err = sst_scratch_erase_retired(ctx);
+    if (err != PSA_SST_ERR_SUCCESS) {
+        return err;
+    }
+
+    return sst_ckpt_update(ctx);
 }
 
-enum psa_sst_err_t sst_core_wipe_all(void)
+enum psa_sst_err_t sst_core_wipe_all(uint32_t area_id)
 {
+    struct sst_core_ctx_t *ctx;
     uint32_t i;
     enum psa_sst_err_t err;
     uint32_t metablock_to_erase_first = SST_METADATA_BLOCK0;
     struct sst_block_metadata block_meta;
     struct sst_assetmeta object_metadata;
 
+    ctx = sst_core_get_ctx(area_id);
+    if (ctx == NULL) {
+        return PSA_SST_ERR_PARAM_ERROR;
+    }
+
+    err = sst_core_setup_ctx(ctx, area_id);
+    if (err != PSA_SST_ERR_SUCCESS) {
+        return err;
+    }
+
 #if SST_ENCRYPTION
     sst_crypto_init();
 #endif
 
+    err = sst_flash_init(ctx->area_id);
+    if (err != PSA_SST_ERR_SUCCESS) {
+        return err;
+    }
+
+    /* Discard any transaction in progress */
+    ctx->txn_state = SST_TXN_IDLE;
+    ctx->ckpt_live = 0;
+
     /* Erase both metadata blocks. If at least one metadata block is valid,
      * ensure that the active metadata block is erased last to prevent rollback
      * in the case of a power failure between the two erases.
      */
-    if (sst_init_get_active_metablock() == PSA_SST_ERR_SUCCESS) {
-        metablock_to_erase_first = sst_system_ctx.scratch_metablock;
+    sst_utils_memset(ctx->meta_scratch.block_meta, 0,
+                     sizeof(ctx->meta_scratch.block_meta));
+    sst_utils_memset(ctx->meta_scratch.erase_count, 0,
+                     sizeof(ctx->meta_scratch.erase_count));
+    if (sst_init_get_active_metablock(ctx) == PSA_SST_ERR_SUCCESS) {
+        metablock_to_erase_first = ctx->sys.scratch_metablock;
+
+        /* Keep counting the erases of the blocks */
+        if (sst_meta_load_active_meta(ctx) == PSA_SST_ERR_SUCCESS) {
+            sst_utils_memcpy(ctx->meta_scratch.erase_count,
+                             ctx->meta_active.erase_count,
+                             sizeof(ctx->meta_scratch.erase_count));
+        }
     }
 
-    err = sst_flash_erase_block(metablock_to_erase_first);
+    sst_utils_memset(ctx->block_state, SST_BLOCK_DIRTY,
+                     sizeof(ctx->block_state));
+
+    err = sst_flash_erase_block(ctx->area_id, metablock_to_erase_first);
     if (err != PSA_SST_ERR_SUCCESS) {
         return err;
     }
+    sst_meta_count_erase(ctx, metablock_to_erase_first);
+    ctx->block_state[metablock_to_erase_first] = SST_BLOCK_ERASED;
 
-    err = sst_flash_erase_block(SST_OTHER_META_BLOCK(metablock_to_erase_first));
+    err = sst_flash_erase_block(ctx->area_id,
+                                SST_OTHER_META_BLOCK(metablock_to_erase_first));
     if (err != PSA_SST_ERR_SUCCESS) {
         return err;
     }
-
-    sst_system_ctx.meta_block_header.active_swap_count = 0;
-    sst_system_ctx.meta_block_header.scratch_idx = SST_INIT_SCRATCH_DBLOCK;
-    sst_system_ctx.meta_block_header.fs_version = SST_SUPPORTED_VERSION;
-    sst_system_ctx.scratch_metablock = SST_METADATA_BLOCK1;
-    sst_system_ctx.active_metablock = SST_METADATA_BLOCK0;
+    sst_meta_count_erase(ctx, SST_OTHER_META_BLOCK(metablock_to_erase_first));
+    ctx->block_state[SST_OTHER_META_BLOCK(metablock_to_erase_first)] =
+                                                              SST_BLOCK_ERASED;
+
+    ctx->sys.meta_block_header.active_swap_count = 0;
+    ctx->sys.meta_block_header.scratch_idx = ctx->init_scratch_dblock;
+    ctx->sys.meta_block_header.fs_version = SST_SUPPORTED_VERSION;
+    ctx->sys.scratch_metablock = SST_METADATA_BLOCK1;
+    ctx->sys.active_metablock = SST_METADATA_BLOCK0;
+    ctx->sys.journal_next_record = 0;
+    ctx->sys.journal_seq = 0;
 
     /* Fill the block metadata for logical datablock 0, which has the physical
-     * id of the active metadata block. For this datablock, the space available
-     * for data is from the end of the metadata to the end of the block.
+     * id of the metadata block which becomes active once the metadata is
+     * written. For this datablock, the space available for data is from the
+     * end of the metadata journal to the end of the block.
      */
-    block_meta.data_start = SST_ALL_METADATA_SIZE;
-    block_meta.free_size = (SST_BLOCK_SIZE - block_meta.data_start);
-    block_meta.phys_id = SST_METADATA_BLOCK0;
-    sst_mblock_update_scratch_block_meta(SST_LOGICAL_DBLOCK0, &block_meta);
+    block_meta.data_start = SST_DBLOCK0_DATA_START;
+    block_meta.free_size = (ctx->block_size - block_meta.data_start);
+    block_meta.phys_id = sst_meta_cur_meta_scratch(ctx);
+    sst_mblock_update_scratch_block_meta(ctx, SST_LOGICAL_DBLOCK0, &block_meta);
 
     /* Fill the block metadata for the dedicated datablocks, which have logical
-     * ids beginning from 1 and physical ids initially beginning from
-     * SST_INIT_DBLOCK_START. For these datablocks, the space available for
-     * data is the entire block.
+     * ids beginning from 1 and physical ids initially beginning after the
+     * scratch data blocks. For these datablocks, the space available for data
+     * is the entire block.
      */
     block_meta.data_start = 0;
-    block_meta.free_size = SST_BLOCK_SIZE;
-    for (i = SST_INIT_DBLOCK_START; i < SST_NUM_DEDICATED_DBLOCKS; i++) {
+    block_meta.free_size = ctx->block_size;
+    /* The scratch data blocks, located before the first dedicated data
+     * block, are erased as well, and they are ready to be used once the wipe
+     * is done.
+     */
+    for (i = ctx->init_scratch_dblock;
+         i < (ctx->init_dblock_start + ctx->nbr_dedicated_dblocks); i++) {
         /* If a flash error is detected, the code erases the rest
          * of the blocks anyway to remove all data stored in them.
          */
-        err |= sst_flash_erase_block(i);
+        err |= sst_flash_erase_block(ctx->area_id, i);
+        sst_meta_count_erase(ctx, i);
+        if (i < ctx->init_dblock_start) {
+            ctx->block_state[i] = SST_BLOCK_ERASED;
+        }
     }
 
     /* If an error is detected while erasing the flash, then return a
@@ -1867,34 +4402,48 @@ enum psa_sst_err_t sst_core_wipe_all(void)
         return PSA_SST_ERR_SYSTEM_ERROR;
     }
 
-    for (i = 0; i < SST_NUM_DEDICATED_DBLOCKS; i++) {
-        block_meta.phys_id = i + SST_INIT_DBLOCK_START;
-        err = sst_mblock_update_scratch_block_meta(i + 1, &block_meta);
+    for (i = 0; i < ctx->nbr_dedicated_dblocks; i++) {
+        block_meta.phys_id = i + ctx->init_dblock_start;
+        err = sst_mblock_update_scratch_block_meta(ctx, i + 1, &block_meta);
         if (err != PSA_SST_ERR_SUCCESS) {
             return PSA_SST_ERR_SYSTEM_ERROR;
         }
     }
 
+    /* No data block is being compacted */
+    sst_utils_memset(&ctx->meta_scratch.compact, SST_FLASH_DEFAULT_VAL,
+                     sizeof(struct sst_compact_cursor_t));
+
     /* Initialize object metadata table */
     sst_utils_memset(&object_metadata, SST_DEFAULT_EMPTY_BUFF_VAL,
                      sizeof(struct sst_assetmeta));
-    for (i = 0; i < SST_NUM_ASSETS; i++) {
+    object_metadata.next = SST_METADATA_INVALID_INDEX;
+    for (i = 0; i < SST_NUM_OBJECT_ENTRIES; i++) {
         /* In the beginning phys id is same as logical id */
         /* Update object's metadata to reflect new attributes */
-        err = sst_mblock_update_scratch_object_meta(i, &object_metadata);
+        err = sst_mblock_update_scratch_object_meta(ctx, i, &object_metadata);
         if (err != PSA_SST_ERR_SUCCESS) {
             return PSA_SST_ERR_SYSTEM_ERROR;
         }
     }
 
     /* FIXME: erase all the blocks first */
-    err = sst_meta_write_scratch_meta_header();
+    err = sst_meta_write_scratch_meta(ctx);
     if (err != PSA_SST_ERR_SUCCESS) {
         return PSA_SST_ERR_SYSTEM_ERROR;
     }
 
     /* Swap active and scratch metablocks */
-    sst_meta_swap_metablocks();
+    sst_meta_swap_metablocks(ctx);
+    sst_utils_memcpy(&ctx->meta_active, &ctx->meta_scratch,
+                     SST_ALL_METADATA_SIZE);
+    sst_scratch_release(ctx);
+
+    /* All object metadata entries are free after the wipe */
+    err = sst_index_build(ctx);
+    if (err != PSA_SST_ERR_SUCCESS) {
+        return PSA_SST_ERR_SYSTEM_ERROR;
+    }
 
     return PSA_SST_ERR_SUCCESS;
 }
@@ -17,7 +17,7 @@ extern "C" {
 #include "crypto/sst_crypto_interface.h"
 #include "assets/sst_asset_defs.h"
 
-#define SST_SUPPORTED_VERSION   0x01
+#define SST_SUPPORTED_VERSION   0x05
 
 #define SST_OTHER_META_BLOCK(metablock) \
 ((metablock == SST_METADATA_BLOCK0) ? \
@@ -63,13 +63,16 @@ struct sst_metadata_block_header {
                                      *   section's scratch block
                                      */
     uint8_t fs_version;             /*!< SST system version. Currently
-                                     *   0x01
+                                     *   0x05
                                      */
     uint8_t active_swap_count;      /*!< Physical block ID of the data */
 };
 
 
-/* Object metadata associated with each object */
+/* Object metadata associated with each object extent. The content of an
+ * object is split in a chain of extents, which all have the object's UUID.
+ * The object is referenced by its first extent.
+ */
 struct sst_assetmeta {
     uint32_t lblock;      /*!< Logical datablock where object is stored */
     uint32_t data_index;  /*!< Offset in the logical data block */
@@ -78,6 +81,78 @@ struct sst_assetmeta {
     uint32_t unique_id;   /*!< Unique ID of this asset, compiler generated
                            *   based on user defined user_defs.h
                            */
+    uint32_t next;        /*!< Index of the object's next extent, or
+                           *   SST_METADATA_INVALID_INDEX
+                           */
+};
+
+/* Commit record of a metadata journal update. The crypto member must be the
+ * last member to allow the authentication of the update's records and the
+ * rest of the commit record without having to copy/reorganize them.
+ */
+struct sst_journal_commit_t {
+    uint32_t seq;               /*!< Sequence number of the update in the
+                                 *   metadata journal
+                                 */
+    uint32_t scratch_idx;       /*!< Physical block ID of the data section's
+                                 *   scratch block after the update
+                                 */
+    uint32_t nbr_records;       /*!< Number of records in the update */
+#ifdef SST_ENCRYPTION
+    union sst_crypto_t crypto;  /*!< Crypto metadata of the update */
+#endif
+};
+
+/* Checkpoint record of the metadata journal. It records the physical blocks
+ * which are known to be erased, so that a mount does not have to erase them
+ * again. It is stale once an update has been appended after it.
+ */
+struct sst_journal_ckpt_t {
+    uint32_t seq;            /*!< Sequence number of the next journal update
+                              *   when the checkpoint was taken
+                              */
+    uint32_t erased_blocks;  /*!< Bitmap of the erased physical blocks */
+    uint32_t meta_hash;      /*!< Hash of the active metadata when the
+                              *   checkpoint was taken
+                              */
+};
+
+/* Progress of the incremental compaction of a logical data block. The objects
+ * of the logical block are copied in the destination block in the order of
+ * their object index.
+ */
+struct sst_compact_cursor_t {
+    uint32_t lblock;        /*!< Logical block being compacted, or
+                             *   SST_COMPACT_NO_LBLOCK
+                             */
+    uint32_t phys_id;       /*!< Physical block ID of the destination block */
+    uint32_t object_index;  /*!< Index of the next object to copy */
+    uint32_t offset;        /*!< Number of bytes of the next object which have
+                             *   already been copied
+                             */
+    uint32_t pos;           /*!< Offset of the next object in the destination
+                             *   block
+                             */
+};
+
+/* Metadata journal record. An update is stored as the block metadata, object
+ * metadata, erase count and compaction cursor entries which have changed,
+ * followed by a commit record. Checkpoint records can be stored between the
+ * updates.
+ */
+struct sst_journal_record_t {
+    uint16_t type;   /*!< Record type */
+    uint16_t index;  /*!< Logical block, object or physical block index of the
+                      *   entry
+                      */
+    union {
+        struct sst_block_metadata block_meta;  /*!< Block metadata entry */
+        struct sst_assetmeta object_meta;      /*!< Object metadata entry */
+        struct sst_journal_commit_t commit;    /*!< Commit record */
+        uint32_t erase_count;                  /*!< Erase count entry */
+        struct sst_compact_cursor_t compact;   /*!< Compaction cursor entry */
+        struct sst_journal_ckpt_t ckpt;        /*!< Checkpoint record */
+    } data;
 };
 
 struct sst_asset_system_context {
@@ -86,6 +161,12 @@ struct sst_asset_system_context {
                                                          */
     uint32_t active_metablock;           /*!< Active metadata block */
     uint32_t scratch_metablock;          /*!< Scratch meta block */
+    uint32_t journal_next_record;        /*!< Next free record in the active
+                                          *   metadata block's journal
+                                          */
+    uint32_t journal_seq;                /*!< Sequence number of the next
+                                          *   journal update
+                                          */
     uint8_t  sst_key[SST_KEY_LEN_BYTES]; /*!< Secure storage system key */
 };
 
@@ -100,48 +181,87 @@ struct sst_core_obj_info_t {
 };
 
 /**
- * \brief Prepares the core. Authenticates/validates the metadata.
+ * \brief Prepares the core of a storage area. Authenticates/validates the
+ *        metadata.
+ *
+ * \param[in] area_id  Storage area ID
  *
  * \return Returns error code as specified in \ref psa_sst_err_t
  */
-enum psa_sst_err_t sst_core_prepare(void);
+enum psa_sst_err_t sst_core_prepare(uint32_t area_id);
 
 /**
  * \brief Checks if an object exists.
  *
+ * \param[in]  area_id   Storage area ID
  * \param[in]  obj_uuid  Unique identifier for the object
  *
  * \return Returns PSA_SST_ERR_SUCCESS if object exist.  If object does not
  *         exist, it returns PSA_SST_ERR_ASSET_NOT_FOUND. If SST area is not
  *         prepared, it returns PSA_SST_ERR_ASSET_NOT_PREPARED.
  */
-enum psa_sst_err_t sst_core_object_exist(uint32_t obj_uuid);
+enum psa_sst_err_t sst_core_object_exist(uint32_t area_id, uint32_t obj_uuid);
 
 /**
- * \brief Creates an object in the storage area.
+ * \brief Creates an object in the storage area, with its initial content.
+ *
+ * \param[in] area_id    Storage area ID
+ * \param[in] obj_uuid   Unique identifier for the object
+ * \param[in] size       Size of the object to be created
+ * \param[in] data       Pointer to the initial content of the object
+ * \param[in] data_size  Size of the initial content
  *
- * \param[in] obj_uuid  Unique identifier for the object
- * \param[in] size      Size of the object to be created
+ * \note The object and its initial content are committed by the same
+ *       metadata update, so an interrupted creation never leaves the object
+ *       without its initial content.
  *
  * \return Returns error code as specified in \ref psa_sst_err_t
  */
-enum psa_sst_err_t sst_core_object_create(uint32_t obj_uuid, uint32_t size);
+enum psa_sst_err_t sst_core_object_create(uint32_t area_id,
+                                          uint32_t obj_uuid, uint32_t size,
+                                          const uint8_t *data,
+                                          uint32_t data_size);
 
 /**
  * \brief Gets the object information referenced by object UUID.
  *
+ * \param[in]  area_id   Storage area ID
  * \param[in]  obj_uuid  Unique identifier of the object
  * \param[out] info      Pointer to the information structure to store the
  *                       object information values \ref sst_core_obj_info_t
  *
  * \return Returns error code specified in \ref psa_sst_err_t
  */
-enum psa_sst_err_t sst_core_object_get_info(uint32_t obj_uuid,
+enum psa_sst_err_t sst_core_object_get_info(uint32_t area_id,
+                                            uint32_t obj_uuid,
                                             struct sst_core_obj_info_t *info);
 
+/**
+ * \brief Gets the next object of a storage area, in the order of the object
+ *        metadata table.
+ *
+ * \param[in]     area_id  Storage area ID
+ * \param[in/out] index    Pointer to the object metadata index to start the
+ *                         search from. It is set to the index following the
+ *                         object found.
+ * \param[out]    uuid     Pointer to store the unique identifier of the
+ *                         object
+ * \param[out]    info     Pointer to the information structure to store the
+ *                         object information values \ref sst_core_obj_info_t
+ *
+ * \note Only the metadata is read, from RAM.
+ *
+ * \return Returns PSA_SST_ERR_ASSET_NOT_FOUND when there is no more object,
+ *         or another error code as specified in \ref psa_sst_err_t
+ */
+enum psa_sst_err_t sst_core_object_next(uint32_t area_id, uint32_t *index,
+                                        uint32_t *uuid,
+                                        struct sst_core_obj_info_t *info);
+
 /**
  * \brief Writes data to an existing object.
  *
+ * \param[in] area_id   Storage area ID
  * \param[in] obj_uuid  Unique identifier of the object
  * \param[in] data      Pointer to buf containing data to be written
  * \param[in] offset    Offset in the object
@@ -149,13 +269,15 @@ enum psa_sst_err_t sst_core_object_get_info(uint32_t obj_uuid,
  *
  * \return Returns error code as specified in \ref psa_sst_err_t
  */
-enum psa_sst_err_t sst_core_object_write(uint32_t obj_uuid,
+enum psa_sst_err_t sst_core_object_write(uint32_t area_id,
+                                         uint32_t obj_uuid,
                                          const uint8_t *data,
                                          uint32_t offset, uint32_t size);
 
 /**
  * \brief Reads an object or part of it to given buffer.
  *
+ * \param[in]  area_id   Storage area ID
  * \param[in]  obj_uuid  Unique identifier of the object
  * \param[out] data      Pointer to buf
  * \param[in]  offset    Offset in the object
@@ -163,35 +285,111 @@ enum psa_sst_err_t sst_core_object_write(uint32_t obj_uuid,
  *
  * \return Returns error code as specified in \ref psa_sst_err_t
  */
-enum psa_sst_err_t sst_core_object_read(uint32_t obj_uuid, uint8_t *data,
+enum psa_sst_err_t sst_core_object_read(uint32_t area_id,
+                                        uint32_t obj_uuid, uint8_t *data,
                                         uint32_t offset, uint32_t size);
 
 /**
  * \brief Deletes object referred by the UUID.
  *
+ * \param[in] area_id   Storage area ID
  * \param[in] obj_uuid  Unique identifier of the object
  *
+ * \note The object's data remains in flash until the space it takes is
+ *       reclaimed by the compaction of its data block.
+ *
  * \return Returns error code as specified in \ref psa_sst_err_t
  */
-enum psa_sst_err_t sst_core_object_delete(uint32_t obj_uuid);
+enum psa_sst_err_t sst_core_object_delete(uint32_t area_id,
+                                          uint32_t obj_uuid);
+
+/**
+ * \brief Begins a transaction in a storage area.
+ *
+ * \param[in] area_id  Storage area ID
+ *
+ * \details The create, write and delete operations performed until the
+ *          transaction is committed or aborted are staged, and they are
+ *          committed to flash as a single atomic update. The operations
+ *          within a transaction can change the data of a single logical
+ *          block. Otherwise, the operation fails with
+ *          PSA_SST_ERR_STORAGE_SYSTEM_FULL. Each storage area has its own
+ *          transaction.
+ *
+ * \return Returns error code as specified in \ref psa_sst_err_t
+ */
+enum psa_sst_err_t sst_core_txn_begin(uint32_t area_id);
+
+/**
+ * \brief Commits all the operations staged by the active transaction.
+ *
+ * \param[in] area_id  Storage area ID
+ *
+ * \return Returns error code as specified in \ref psa_sst_err_t
+ */
+enum psa_sst_err_t sst_core_txn_commit(uint32_t area_id);
+
+/**
+ * \brief Discards all the operations staged by the active transaction.
+ *
+ * \param[in] area_id  Storage area ID
+ *
+ * \return Returns error code as specified in \ref psa_sst_err_t
+ */
+enum psa_sst_err_t sst_core_txn_abort(uint32_t area_id);
+
+/**
+ * \brief Erases the scratch blocks which have been retired by the update
+ *        operations, so that the next updates do not have to erase them.
+ *        Then, it performs a step of the incremental compaction of the data
+ *        blocks, which copies up to SST_COMPACT_STEP_SIZE bytes.
+ *
+ * \param[in] area_id  Storage area ID
+ *
+ * \details It is meant to be called periodically when the system is idle, as
+ *          erasing a flash block is the slowest flash operation. The progress
+ *          of the compaction is stored in the metadata, so it is resumed after
+ *          a reset.
+ *
+ * \return Returns error code as specified in \ref psa_sst_err_t
+ */
+enum psa_sst_err_t sst_core_maintenance(uint32_t area_id);
+
+/**
+ * \brief Gets the wear information of the flash blocks used by a storage
+ *        area, based on the number of erases counted for each block.
+ *
+ * \param[in]  area_id  Storage area ID
+ * \param[out] info     Pointer to the wear information structure
+ *                      \ref psa_sst_wear_info_t
+ *
+ * \return Returns error code as specified in \ref psa_sst_err_t
+ */
+enum psa_sst_err_t sst_core_get_wear_info(uint32_t area_id,
+                                          struct psa_sst_wear_info_t *info);
 
 /**
  * \brief Reads metadata associated with an object.
  *
+ * \param[in]  area_id      Storage area ID
  * \param[in]  object_index Index of the ojbect to be read
  * \param[out] meta         Pointer to meta buffer to read values
  *
  * \return Returns error code as specified in \ref psa_sst_err_t
  */
-enum psa_sst_err_t sst_meta_read_object_meta(uint32_t object_index,
+enum psa_sst_err_t sst_meta_read_object_meta(uint32_t area_id,
+                                             uint32_t object_index,
                                              struct sst_assetmeta *meta);
 
 /**
- * \brief Wipes all the storage and regenerate metadata block.
+ * \brief Wipes all the storage of a storage area and regenerate metadata
+ *        block.
+ *
+ * \param[in] area_id  Storage area ID
  *
  * \return Returns error code as specified in \ref sst_errno_t
  */
-enum psa_sst_err_t sst_core_wipe_all(void);
+enum psa_sst_err_t sst_core_wipe_all(uint32_t area_id);
 
 #ifdef __cplusplus
 }
@@ -31,7 +31,10 @@
 #define SST_OBJECT_START_POSITION  0
 #define SST_EMPTY_OBJECT_SIZE      0
 
-/* Buffer to store plaintext object data */
+/* Buffer to store plaintext object data. The buffer and the crypto context
+ * are shared by the storage areas, so the objects are encrypted and decrypted
+ * under the global lock.
+ */
 static uint8_t sst_plaintext_buf[SST_MAX_OBJECT_DATA_SIZE];
 
 /**
@@ -135,7 +138,7 @@ static enum psa_sst_err_t sst_object_auth_encrypt(uint32_t cur_size,
     return PSA_SST_ERR_SUCCESS;
 }
 
-enum psa_sst_err_t sst_encrypted_object_create(uint32_t uuid,
+enum psa_sst_err_t sst_encrypted_object_create(uint32_t area_id, uint32_t uuid,
                                           const struct tfm_sst_token_t *s_token,
                                           struct sst_object_t *obj)
 {
@@ -146,23 +149,21 @@ enum psa_sst_err_t sst_encrypted_object_create(uint32_t uuid,
      */
     (void)s_token;
 
-    /* Create an object in the object system */
-    err = sst_core_object_create(uuid,
-                                 SST_ENCRYPTED_SIZE(obj->header.info.size_max));
-    if (err != PSA_SST_ERR_SUCCESS) {
-        return err;
-    }
-
     /* Authenticate the header, with no data to encrypt */
+    sst_global_lock();
     err = sst_object_auth_encrypt(SST_EMPTY_OBJECT_SIZE, obj);
+    sst_global_unlock();
     if (err != PSA_SST_ERR_SUCCESS) {
         return err;
     }
 
-    /* Write the encrypted object to the object system */
-    err = sst_core_object_write(uuid, (uint8_t *)obj,
-                                SST_OBJECT_START_POSITION,
-                                SST_ENCRYPTED_SIZE(SST_EMPTY_OBJECT_SIZE));
+    /* Create an object in the object system, with the encrypted object as
+     * its initial content.
+     */
+    err = sst_core_object_create(area_id, uuid,
+                                 SST_ENCRYPTED_SIZE(obj->header.info.size_max),
+                                 (uint8_t *)obj,
+                                 SST_ENCRYPTED_SIZE(SST_EMPTY_OBJECT_SIZE));
 
     return err;
 }
@@ -171,13 +172,15 @@ enum psa_sst_err_t sst_encrypted_object_create(uint32_t uuid,
  * \brief Reads and decrypts data from the object referenced by the object
  *        UUID into the sst_plaintext_buf buffer.
  *
+ * \param[in]  area_id  Storage area ID
  * \param[in]  uuid     Object UUID
  * \param[in]  s_token  Pointer to the asset's token \ref tfm_sst_token_t
  * \param[out] obj      Pointer to the object structure to fill in
  *
  * \return Returns error code specified in \ref psa_sst_err_t
  */
-static enum psa_sst_err_t sst_read_encrypted_object(uint32_t uuid,
+static enum psa_sst_err_t sst_read_encrypted_object(uint32_t area_id,
+                                          uint32_t uuid,
                                           const struct tfm_sst_token_t *s_token,
                                           struct sst_object_t *obj)
 {
@@ -191,7 +194,7 @@ static enum psa_sst_err_t sst_read_encrypted_object(uint32_t uuid,
     (void)s_token;
 
     /* Get the current size of the encrypted object in the object system */
-    err = sst_core_object_get_info(uuid, &obj_info);
+    err = sst_core_object_get_info(area_id, uuid, &obj_info);
     if (err != PSA_SST_ERR_SUCCESS) {
         return err;
     }
@@ -203,7 +206,7 @@ static enum psa_sst_err_t sst_read_encrypted_object(uint32_t uuid,
     sst_utils_memset(obj, SST_CRYPTO_CLEAR_BUF_VALUE, SST_MAX_OBJECT_SIZE);
 
     /* Read the encrypted object from the object system */
-    err = sst_core_object_read(uuid, (uint8_t *)obj,
+    err = sst_core_object_read(area_id, uuid, (uint8_t *)obj,
                                SST_OBJECT_START_POSITION,
                                obj_info.size_current);
     if (err != PSA_SST_ERR_SUCCESS) {
@@ -211,7 +214,9 @@ static enum psa_sst_err_t sst_read_encrypted_object(uint32_t uuid,
     }
 
     /* Decrypt the object data */
+    sst_global_lock();
     err = sst_object_auth_decrypt(plaintext_size, obj);
+    sst_global_unlock();
     if (err != PSA_SST_ERR_SUCCESS) {
         return err;
     }
@@ -219,13 +224,13 @@ static enum psa_sst_err_t sst_read_encrypted_object(uint32_t uuid,
     return PSA_SST_ERR_SUCCESS;
 }
 
-enum psa_sst_err_t sst_encrypted_object_read(uint32_t uuid,
+enum psa_sst_err_t sst_encrypted_object_read(uint32_t area_id, uint32_t uuid,
                                           const struct tfm_sst_token_t *s_token,
                                           struct sst_object_t *obj)
 {
     enum psa_sst_err_t err;
 
-    err = sst_read_encrypted_object(uuid, s_token, obj);
+    err = sst_read_encrypted_object(area_id, uuid, s_token, obj);
     if (err != PSA_SST_ERR_SUCCESS) {
         return err;
     }
@@ -233,7 +238,7 @@ enum psa_sst_err_t sst_encrypted_object_read(uint32_t uuid,
     return PSA_SST_ERR_SUCCESS;
 }
 
-enum psa_sst_err_t sst_encrypted_object_write(uint32_t uuid,
+enum psa_sst_err_t sst_encrypted_object_write(uint32_t area_id, uint32_t uuid,
                                           const struct tfm_sst_token_t *s_token,
                                           struct sst_object_t *obj)
 {
@@ -245,13 +250,15 @@ enum psa_sst_err_t sst_encrypted_object_write(uint32_t uuid,
     (void)s_token;
 
     /* Encrypt the object data */
+    sst_global_lock();
     err = sst_object_auth_encrypt(obj->header.info.size_current, obj);
+    sst_global_unlock();
     if (err != PSA_SST_ERR_SUCCESS) {
         return err;
     }
 
     /* Write encrypted object to the object system */
-    err = sst_core_object_write(uuid, (uint8_t *)obj,
+    err = sst_core_object_write(area_id, uuid, (uint8_t *)obj,
                                 SST_OBJECT_START_POSITION,
                                 SST_ENCRYPTED_SIZE(
                                                 obj->header.info.size_current));
@@ -19,6 +19,7 @@ extern "C" {
 /**
  * \brief Creates a new encrypted object.
  *
+ * \param[in]     area_id  Storage area ID
  * \param[in]     uuid     Object UUID
  * \param[in]     s_token  Pointer to the asset's token \ref tfm_sst_token_t
  * \param[in/out] obj      Pointer to the object structure to be created.
@@ -30,26 +31,28 @@ extern "C" {
  *
  * \return Returns error code specified in \ref psa_sst_err_t
  */
-enum psa_sst_err_t sst_encrypted_object_create(uint32_t uuid,
+enum psa_sst_err_t sst_encrypted_object_create(uint32_t area_id, uint32_t uuid,
                                           const struct tfm_sst_token_t *s_token,
                                           struct sst_object_t *obj);
 
 /**
  * \brief Reads object referenced by the object UUID
  *
+ * \param[in]  area_id  Storage area ID
  * \param[in]  uuid     Object UUID
  * \param[in]  s_token  Pointer to the asset's token \ref tfm_sst_token_t
  * \param[out] obj      Pointer to the object structure to fill in
  *
  * \return Returns error code specified in \ref psa_sst_err_t
  */
-enum psa_sst_err_t sst_encrypted_object_read(uint32_t uuid,
+enum psa_sst_err_t sst_encrypted_object_read(uint32_t area_id, uint32_t uuid,
                                           const struct tfm_sst_token_t *s_token,
                                           struct sst_object_t *obj);
 
 /**
  * \brief Writes object referenced by the object UUID.
  *
+ * \param[in]     area_id  Storage area ID
  * \param[in]     uuid     Object UUID
  * \param[in]     s_token  Pointer to the asset's token \ref tfm_sst_token_t
  * \param[in/out] obj      Pointer to the object structure to write.
@@ -61,7 +64,7 @@ enum psa_sst_err_t sst_encrypted_object_read(uint32_t uuid,
  *
  * \return Returns error code specified in \ref psa_sst_err_t
  */
-enum psa_sst_err_t sst_encrypted_object_write(uint32_t uuid,
+enum psa_sst_err_t sst_encrypted_object_write(uint32_t area_id, uint32_t uuid,
                                           const struct tfm_sst_token_t *s_token,
                                           struct sst_object_t *obj);
 
@@ -0,0 +1,630 @@
+/*
+ * Copyright (c) 2018, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#include "sst_kv.h"
+
+#include <string.h>
+
+#include "sst_object_defs.h"
+#include "sst_object_system.h"
+#include "sst_utils.h"
+
+/* States of a directory entry. A deleted entry is kept as a tombstone, so
+ * that the lookup of the keys which were stored after it in the probe
+ * sequence does not stop on it.
+ */
+#define SST_KV_ENTRY_EMPTY    0
+#define SST_KV_ENTRY_USED     1
+#define SST_KV_ENTRY_DELETED  2
+
+/* States of a directory object */
+#define SST_KV_PAGE_NONE   0 /* The object does not exist */
+#define SST_KV_PAGE_EMPTY  1 /* The object exists, but has no data */
+#define SST_KV_PAGE_VALID  2 /* The object holds its directory entries */
+
+/* States of the directory in RAM */
+#define SST_KV_NOT_PREPARED 0 /* sst_kv_prepare has not loaded it yet */
+#define SST_KV_STALE        1 /* The storage area has been wiped or prepared
+                               * again, so it has to be loaded again
+                               */
+#define SST_KV_READY        2 /* It matches the directory objects */
+
+/* Invalid directory position */
+#define SST_KV_NO_POS  0xFFFFFFFF
+
+/* 32-bit FNV-1a hash parameters */
+#define SST_KV_FNV_OFFSET_BASIS  0x811C9DC5U
+#define SST_KV_FNV_PRIME         0x01000193U
+
+#if (SST_KV_NBR_SLOTS == 0) || (SST_KV_NBR_SLOTS > 0x100)
+#error "SST_KV_NBR_SLOTS must be between 1 and 256"
+#endif
+
+#if (SST_KV_MAX_KEY_LEN == 0) || (SST_KV_MAX_KEY_LEN > 0xFF)
+#error "SST_KV_MAX_KEY_LEN must be between 1 and 255"
+#endif
+
+/* Directory entry, which maps a key of an application ID to the slot object
+ * at the same position
+ */
+struct sst_kv_entry_t {
+    uint32_t app_id;                 /*!< Application ID owning the key */
+    uint8_t state;                   /*!< Entry state */
+    uint8_t key_len;                 /*!< Key length */
+    uint16_t reserved;               /*!< Reserved, set to 0 */
+    uint8_t key[SST_KV_MAX_KEY_LEN]; /*!< Key */
+};
+
+#define SST_KV_ENTRY_SIZE     sizeof(struct sst_kv_entry_t)
+#define SST_KV_DIR_PAGE_SIZE  (SST_KV_ENTRY_SIZE * SST_KV_DIR_PAGE_ENTRIES)
+
+#ifdef SST_ENCRYPTION
+/* An encrypted object is staged in the object buffer as a whole */
+SST_UTILS_BOUND_CHECK(KV_DIR_PAGE_NOT_FIT_IN_OBJECT, SST_KV_DIR_PAGE_SIZE,
+                      SST_MAX_OBJECT_DATA_SIZE);
+SST_UTILS_BOUND_CHECK(KV_VALUE_NOT_FIT_IN_OBJECT, SST_KV_MAX_VALUE_SIZE,
+                      SST_MAX_OBJECT_DATA_SIZE);
+#endif
+
+/* Directory, laid out as the content of the directory objects */
+static struct sst_kv_entry_t sst_kv_dir[SST_KV_NBR_DIR_PAGES *
+                                        SST_KV_DIR_PAGE_ENTRIES];
+static uint8_t sst_kv_page_state[SST_KV_NBR_DIR_PAGES];
+static volatile uint8_t sst_kv_state = SST_KV_NOT_PREPARED;
+
+/**
+ * \brief Hashes a key of an application ID.
+ *
+ * \param[in] app_id   Application ID
+ * \param[in] key      Key
+ * \param[in] key_len  Key length
+ *
+ * \return Returns the hash
+ */
+static uint32_t sst_kv_hash(uint32_t app_id, const uint8_t *key,
+                            uint32_t key_len)
+{
+    uint32_t hash = SST_KV_FNV_OFFSET_BASIS;
+    uint32_t i;
+
+    for (i = 0; i < sizeof(app_id); i++) {
+        hash = (hash ^ ((app_id >> (8 * i)) & 0xFF)) * SST_KV_FNV_PRIME;
+    }
+
+    for (i = 0; i < key_len; i++) {
+        hash = (hash ^ key[i]) * SST_KV_FNV_PRIME;
+    }
+
+    return hash;
+}
+
+/**
+ * \brief Looks up a key of an application ID in the directory.
+ *
+ * \param[in]  app_id    Application ID
+ * \param[in]  key       Key
+ * \param[in]  key_len   Key length
+ * \param[out] free_pos  Position where the key can be added if it is not
+ *                       found, or SST_KV_NO_POS if the directory is full
+ *
+ * \return Returns the position of the key, or SST_KV_NO_POS if it is not
+ *         found
+ */
+static uint32_t sst_kv_lookup(uint32_t app_id, const uint8_t *key,
+                              uint32_t key_len, uint32_t *free_pos)
+{
+    const struct sst_kv_entry_t *entry;
+    uint32_t pos;
+    uint32_t i;
+
+    *free_pos = SST_KV_NO_POS;
+    pos = sst_kv_hash(app_id, key, key_len) % SST_KV_NBR_SLOTS;
+
+    for (i = 0; i < SST_KV_NBR_SLOTS; i++) {
+        entry = &sst_kv_dir[pos];
+
+        if (entry->state == SST_KV_ENTRY_EMPTY) {
+            /* The key would have been stored here, or before */
+            if (*free_pos == SST_KV_NO_POS) {
+                *free_pos = pos;
+            }
+            return SST_KV_NO_POS;
+        }
+
+        if (entry->state == SST_KV_ENTRY_USED) {
+            if ((entry->app_id == app_id) && (entry->key_len == key_len) &&
+                (memcmp(entry->key, key, key_len) == 0)) {
+                return pos;
+            }
+        } else if (*free_pos == SST_KV_NO_POS) {
+            /* The first tombstone can be reused for a new key */
+            *free_pos = pos;
+        }
+
+        pos = (pos + 1) % SST_KV_NBR_SLOTS;
+    }
+
+    return SST_KV_NO_POS;
+}
+
+/**
+ * \brief Updates a directory entry, in RAM and in its directory object.
+ *
+ * \param[in] pos    Position of the entry
+ * \param[in] entry  New content of the entry
+ *
+ * \note The entry is left unchanged if the update fails.
+ *
+ * \return Returns error code as specified in \ref psa_sst_err_t
+ */
+static enum psa_sst_err_t sst_kv_update_entry(uint32_t pos,
+                                           const struct sst_kv_entry_t *entry)
+{
+    struct sst_kv_entry_t old_entry;
+    uint32_t page = pos / SST_KV_DIR_PAGE_ENTRIES;
+    uint32_t uuid = SST_KV_DIR_UUID(page);
+    enum psa_sst_err_t err = PSA_SST_ERR_SUCCESS;
+
+    old_entry = sst_kv_dir[pos];
+    sst_kv_dir[pos] = *entry;
+
+    /* The directory objects are created on the first update of one of
+     * their entries
+     */
+    if (sst_kv_page_state[page] == SST_KV_PAGE_NONE) {
+        err = sst_object_create(SST_KV_AREA_ID, uuid, NULL,
+                                PSA_SST_ASSET_CAT_RAW_DATA,
+                                SST_KV_DIR_PAGE_SIZE);
+        if (err == PSA_SST_ERR_SUCCESS) {
+            sst_kv_page_state[page] = SST_KV_PAGE_EMPTY;
+        }
+    }
+
+    if (err == PSA_SST_ERR_SUCCESS) {
+#ifdef SST_ENABLE_PARTIAL_ASSET_RW
+        if (sst_kv_page_state[page] == SST_KV_PAGE_VALID) {
+            /* Only the updated entry is written */
+            err = sst_object_write(SST_KV_AREA_ID, uuid, NULL,
+                              (const uint8_t *)&sst_kv_dir[pos],
+                              (pos % SST_KV_DIR_PAGE_ENTRIES) *
+                              SST_KV_ENTRY_SIZE,
+                              SST_KV_ENTRY_SIZE);
+        } else
+#endif
+        {
+            err = sst_object_write(SST_KV_AREA_ID, uuid, NULL,
+                    (const uint8_t *)&sst_kv_dir[page *
+                                                 SST_KV_DIR_PAGE_ENTRIES],
+                    0, SST_KV_DIR_PAGE_SIZE);
+            if (err == PSA_SST_ERR_SUCCESS) {
+                sst_kv_page_state[page] = SST_KV_PAGE_VALID;
+            }
+        }
+    }
+
+    if (err != PSA_SST_ERR_SUCCESS) {
+        sst_kv_dir[pos] = old_entry;
+    }
+
+    return err;
+}
+
+/**
+ * \brief Stores a value in the slot object at a directory position. The slot
+ *        object is sized to the value, so it is only written in place when
+ *        the value keeps the same size. Otherwise, the object is replaced by
+ *        a new one in a single transaction, so that an interrupted update
+ *        leaves the previous value.
+ *
+ * \param[in] pos   Position of the slot
+ * \param[in] data  Value
+ * \param[in] size  Value size
+ *
+ * \note The slot object may already exist for a free position, if it has
+ *       been left by a failed set. It is then replaced.
+ *
+ * \return Returns error code as specified in \ref psa_sst_err_t
+ */
+static enum psa_sst_err_t sst_kv_store_value(uint32_t pos,
+                                             const uint8_t *data,
+                                             uint32_t size)
+{
+    struct psa_sst_asset_info_t info;
+    uint32_t uuid = SST_KV_SLOT_UUID(pos);
+    uint32_t exists;
+    enum psa_sst_err_t err;
+
+    err = sst_object_get_info(SST_KV_AREA_ID, uuid, NULL, &info);
+    if (err == PSA_SST_ERR_ASSET_NOT_FOUND) {
+        exists = 0;
+    } else if (err == PSA_SST_ERR_SUCCESS) {
+        exists = 1;
+        if ((info.size_max == size) && (info.size_current == size)) {
+            /* The value is replaced by a single object update */
+            if (size == 0) {
+                return PSA_SST_ERR_SUCCESS;
+            }
+            return sst_object_write(SST_KV_AREA_ID, uuid, NULL, data, 0,
+                                    size);
+        }
+    } else {
+        return err;
+    }
+
+    sst_system_batch_lock(SST_SYSTEM_AREA_MASK(SST_KV_AREA_ID));
+
+    err = sst_system_txn_begin(SST_KV_AREA_ID);
+    if (err == PSA_SST_ERR_SUCCESS) {
+        if (exists) {
+            err = sst_object_batch_delete(SST_KV_AREA_ID, uuid, NULL);
+        }
+
+        if (err == PSA_SST_ERR_SUCCESS) {
+            err = sst_object_batch_create(SST_KV_AREA_ID, uuid, NULL,
+                                          PSA_SST_ASSET_CAT_RAW_DATA, size);
+        }
+
+        if ((err == PSA_SST_ERR_SUCCESS) && (size != 0)) {
+            err = sst_object_batch_write(SST_KV_AREA_ID, uuid, NULL, data, 0,
+                                         size);
+        }
+
+        if (err == PSA_SST_ERR_SUCCESS) {
+            err = sst_system_txn_commit(SST_KV_AREA_ID);
+        } else {
+            (void)sst_system_txn_abort(SST_KV_AREA_ID);
+        }
+    }
+
+    sst_system_batch_unlock(SST_SYSTEM_AREA_MASK(SST_KV_AREA_ID));
+
+    return err;
+}
+
+/**
+ * \brief Checks the length of a key.
+ *
+ * \param[in] key_len  Key length
+ *
+ * \return Returns PSA_SST_ERR_SUCCESS if the length is valid, or
+ *         PSA_SST_ERR_PARAM_ERROR otherwise
+ */
+static enum psa_sst_err_t sst_kv_check_key(uint32_t key_len)
+{
+    if ((key_len == 0) || (key_len > SST_KV_MAX_KEY_LEN)) {
+        return PSA_SST_ERR_PARAM_ERROR;
+    }
+
+    return PSA_SST_ERR_SUCCESS;
+}
+
+/**
+ * \brief Loads the key/value directory, and deletes the slot objects which
+ *        are not referenced by it.
+ *
+ * \note The key/value directory lock must be held.
+ *
+ * \return Returns error code as specified in \ref psa_sst_err_t
+ */
+static enum psa_sst_err_t sst_kv_load(void)
+{
+    struct psa_sst_asset_info_t info;
+    const struct sst_kv_entry_t *entry;
+    enum psa_sst_err_t err = PSA_SST_ERR_SUCCESS;
+    uint32_t page;
+    uint32_t pos;
+    uint32_t uuid;
+
+    sst_kv_state = SST_KV_NOT_PREPARED;
+    sst_utils_memset(sst_kv_dir, 0, sizeof(sst_kv_dir));
+
+    for (page = 0; page < SST_KV_NBR_DIR_PAGES; page++) {
+        uuid = SST_KV_DIR_UUID(page);
+
+        err = sst_object_get_info(SST_KV_AREA_ID, uuid, NULL, &info);
+        if (err == PSA_SST_ERR_ASSET_NOT_FOUND) {
+            sst_kv_page_state[page] = SST_KV_PAGE_NONE;
+            err = PSA_SST_ERR_SUCCESS;
+            continue;
+        }
+
+        if (err != PSA_SST_ERR_SUCCESS) {
+            break;
+        }
+
+        /* The object is created before its entries are written, so its
+         * creation may have been interrupted by a power failure
+         */
+        if (info.size_current < SST_KV_DIR_PAGE_SIZE) {
+            sst_kv_page_state[page] = SST_KV_PAGE_EMPTY;
+            continue;
+        }
+
+        err = sst_object_read(SST_KV_AREA_ID, uuid, NULL,
+                    (uint8_t *)&sst_kv_dir[page * SST_KV_DIR_PAGE_ENTRIES],
+                    0, SST_KV_DIR_PAGE_SIZE);
+        if (err != PSA_SST_ERR_SUCCESS) {
+            break;
+        }
+        sst_kv_page_state[page] = SST_KV_PAGE_VALID;
+    }
+
+    for (pos = 0; (err == PSA_SST_ERR_SUCCESS) &&
+                  (pos < (SST_KV_NBR_DIR_PAGES * SST_KV_DIR_PAGE_ENTRIES));
+         pos++) {
+        entry = &sst_kv_dir[pos];
+
+        /* The directory must have been written with the same layout */
+        if ((entry->state > SST_KV_ENTRY_DELETED) ||
+            ((entry->state != SST_KV_ENTRY_EMPTY) &&
+             (pos >= SST_KV_NBR_SLOTS)) ||
+            ((entry->state == SST_KV_ENTRY_USED) &&
+             (sst_kv_check_key(entry->key_len) != PSA_SST_ERR_SUCCESS))) {
+            err = PSA_SST_ERR_SYSTEM_ERROR;
+            break;
+        }
+
+        /* A slot object which is not referenced by the directory has been
+         * left by an interrupted set or delete
+         */
+        if ((pos < SST_KV_NBR_SLOTS) &&
+            (entry->state != SST_KV_ENTRY_USED)) {
+            err = sst_object_delete(SST_KV_AREA_ID, SST_KV_SLOT_UUID(pos),
+                                    NULL);
+            if (err == PSA_SST_ERR_ASSET_NOT_FOUND) {
+                err = PSA_SST_ERR_SUCCESS;
+            }
+        }
+    }
+
+    if (err == PSA_SST_ERR_SUCCESS) {
+        sst_kv_state = SST_KV_READY;
+    }
+
+    return err;
+}
+
+/**
+ * \brief Checks that the key/value directory is loaded, and loads it again
+ *        if it is stale.
+ *
+ * \note The key/value directory lock must be held.
+ *
+ * \return Returns error code as specified in \ref psa_sst_err_t
+ */
+static enum psa_sst_err_t sst_kv_check_ready(void)
+{
+    enum psa_sst_err_t err;
+
+    if (sst_kv_state == SST_KV_READY) {
+        return PSA_SST_ERR_SUCCESS;
+    }
+
+    if (sst_kv_state == SST_KV_NOT_PREPARED) {
+        return PSA_SST_ERR_ASSET_NOT_PREPARED;
+    }
+
+    err = sst_kv_load();
+    if (err != PSA_SST_ERR_SUCCESS) {
+        /* The load is tried again by the next operation */
+        sst_kv_state = SST_KV_STALE;
+    }
+
+    return err;
+}
+
+enum psa_sst_err_t sst_kv_prepare(void)
+{
+    enum psa_sst_err_t err;
+
+    sst_kv_lock();
+    err = sst_kv_load();
+    sst_kv_unlock();
+
+    return err;
+}
+
+void sst_kv_invalidate(void)
+{
+    if (sst_kv_state == SST_KV_READY) {
+        sst_kv_state = SST_KV_STALE;
+    }
+}
+
+enum psa_sst_err_t sst_kv_set(uint32_t app_id, const uint8_t *key,
+                              uint32_t key_len, const uint8_t *data,
+                              uint32_t size)
+{
+    struct sst_kv_entry_t entry;
+    enum psa_sst_err_t err;
+    uint32_t free_pos;
+    uint32_t pos;
+    uint32_t new_key = 0;
+
+    if ((sst_kv_check_key(key_len) != PSA_SST_ERR_SUCCESS) ||
+        (size > SST_KV_MAX_VALUE_SIZE)) {
+        return PSA_SST_ERR_PARAM_ERROR;
+    }
+
+    sst_kv_lock();
+
+    err = sst_kv_check_ready();
+    if (err != PSA_SST_ERR_SUCCESS) {
+        sst_kv_unlock();
+        return err;
+    }
+
+    pos = sst_kv_lookup(app_id, key, key_len, &free_pos);
+    if (pos == SST_KV_NO_POS) {
+        if (free_pos == SST_KV_NO_POS) {
+            sst_kv_unlock();
+            return PSA_SST_ERR_STORAGE_SYSTEM_FULL;
+        }
+
+        pos = free_pos;
+        new_key = 1;
+    }
+
+    err = sst_kv_store_value(pos, data, size);
+
+    /* The key is only added to the directory once its value is stored */
+    if ((err == PSA_SST_ERR_SUCCESS) && new_key) {
+        sst_utils_memset(&entry, 0, SST_KV_ENTRY_SIZE);
+        entry.app_id = app_id;
+        entry.state = SST_KV_ENTRY_USED;
+        entry.key_len = (uint8_t)key_len;
+        sst_utils_memcpy(entry.key, key, key_len);
+
+        err = sst_kv_update_entry(pos, &entry);
+    }
+
+    sst_kv_unlock();
+
+    return err;
+}
+
+enum psa_sst_err_t sst_kv_get(uint32_t app_id, const uint8_t *key,
+                              uint32_t key_len, uint8_t *data,
+                              uint32_t *size)
+{
+    struct psa_sst_asset_info_t info;
+    enum psa_sst_err_t err;
+    uint32_t free_pos;
+    uint32_t pos;
+
+    if (sst_kv_check_key(key_len) != PSA_SST_ERR_SUCCESS) {
+        return PSA_SST_ERR_PARAM_ERROR;
+    }
+
+    sst_kv_lock();
+
+    err = sst_kv_check_ready();
+    if (err != PSA_SST_ERR_SUCCESS) {
+        sst_kv_unlock();
+        return err;
+    }
+
+    pos = sst_kv_lookup(app_id, key, key_len, &free_pos);
+    if (pos == SST_KV_NO_POS) {
+        sst_kv_unlock();
+        return PSA_SST_ERR_ASSET_NOT_FOUND;
+    }
+
+    /* The value size is the current size of the slot object, and the value
+     * is read straight into the buffer
+     */
+    err = sst_object_get_info(SST_KV_AREA_ID, SST_KV_SLOT_UUID(pos), NULL,
+                              &info);
+    if (err == PSA_SST_ERR_SUCCESS) {
+        if (info.size_current > SST_KV_MAX_VALUE_SIZE) {
+            err = PSA_SST_ERR_SYSTEM_ERROR;
+        } else if (info.size_current > *size) {
+            err = PSA_SST_ERR_PARAM_ERROR;
+        } else if (info.size_current != 0) {
+            err = sst_object_read(SST_KV_AREA_ID, SST_KV_SLOT_UUID(pos), NULL,
+                                  data, 0, info.size_current);
+        }
+    }
+
+    if (err == PSA_SST_ERR_SUCCESS) {
+        *size = info.size_current;
+    }
+
+    sst_kv_unlock();
+
+    return err;
+}
+
+enum psa_sst_err_t sst_kv_delete(uint32_t app_id, const uint8_t *key,
+                                 uint32_t key_len)
+{
+    struct sst_kv_entry_t entry;
+    enum psa_sst_err_t err;
+    uint32_t free_pos;
+    uint32_t pos;
+
+    if (sst_kv_check_key(key_len) != PSA_SST_ERR_SUCCESS) {
+        return PSA_SST_ERR_PARAM_ERROR;
+    }
+
+    sst_kv_lock();
+
+    err = sst_kv_check_ready();
+    if (err != PSA_SST_ERR_SUCCESS) {
+        sst_kv_unlock();
+        return err;
+    }
+
+    pos = sst_kv_lookup(app_id, key, key_len, &free_pos);
+    if (pos == SST_KV_NO_POS) {
+        sst_kv_unlock();
+        return PSA_SST_ERR_ASSET_NOT_FOUND;
+    }
+
+    /* A tombstone is only needed if the probe sequence continues after the
+     * entry
+     */
+    sst_utils_memset(&entry, 0, SST_KV_ENTRY_SIZE);
+    if (sst_kv_dir[(pos + 1) % SST_KV_NBR_SLOTS].state ==
+                                                         SST_KV_ENTRY_EMPTY) {
+        entry.state = SST_KV_ENTRY_EMPTY;
+    } else {
+        entry.state = SST_KV_ENTRY_DELETED;
+    }
+
+    /* The key is removed from the directory before its value, so that an
+     * interrupted delete leaves an unreferenced slot object, which is
+     * deleted by the next prepare
+     */
+    err = sst_kv_update_entry(pos, &entry);
+    if (err == PSA_SST_ERR_SUCCESS) {
+        err = sst_object_delete(SST_KV_AREA_ID, SST_KV_SLOT_UUID(pos), NULL);
+    }
+
+    sst_kv_unlock();
+
+    return err;
+}
+
+enum psa_sst_err_t sst_kv_iterate(uint32_t app_id, uint32_t *cursor,
+                                  uint8_t *key, uint32_t *key_len)
+{
+    const struct sst_kv_entry_t *entry;
+    enum psa_sst_err_t err;
+    uint32_t pos;
+
+    sst_kv_lock();
+
+    err = sst_kv_check_ready();
+    if (err != PSA_SST_ERR_SUCCESS) {
+        sst_kv_unlock();
+        return err;
+    }
+
+    err = PSA_SST_ERR_ASSET_NOT_FOUND;
+
+    for (pos = *cursor; pos < SST_KV_NBR_SLOTS; pos++) {
+        entry = &sst_kv_dir[pos];
+        if ((entry->state != SST_KV_ENTRY_USED) || (entry->app_id != app_id)) {
+            continue;
+        }
+
+        if (entry->key_len > *key_len) {
+            err = PSA_SST_ERR_PARAM_ERROR;
+        } else {
+            sst_utils_memcpy(key, entry->key, entry->key_len);
+            *key_len = entry->key_len;
+            *cursor = pos + 1;
+            err = PSA_SST_ERR_SUCCESS;
+        }
+        break;
+    }
+
+    sst_kv_unlock();
+
+    return err;
+}
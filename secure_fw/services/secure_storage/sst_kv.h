@@ -0,0 +1,167 @@
+/*
+ * Copyright (c) 2018, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#ifndef __SST_KV_H__
+#define __SST_KV_H__
+
+#include <stdint.h>
+#include "tfm_sst_defs.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Key/value store built on top of the object system. Each value is stored
+ * in a slot object sized to the value, out of SST_KV_NBR_SLOTS slots, and the
+ * keys in a directory which is hashed by application ID and key. The directory is
+ * stored in SST_KV_NBR_DIR_PAGES objects and kept in RAM, so a lookup only
+ * reads the slot object of the key from the storage. Each application ID has
+ * its own key namespace.
+ *
+ * The key/value operations are serialized by the key/value directory lock,
+ * and each object call takes the lock of SST_KV_AREA_ID below it.
+ */
+
+/* Number of slots, which is the number of keys which can be stored. Each
+ * slot takes an object metadata entry of SST_KV_AREA_ID, and a directory
+ * entry in RAM.
+ */
+#ifndef SST_KV_NBR_SLOTS
+#define SST_KV_NBR_SLOTS 64
+#endif
+
+/* Largest key length, in bytes */
+#ifndef SST_KV_MAX_KEY_LEN
+#define SST_KV_MAX_KEY_LEN 24
+#endif
+
+/* Largest value size, in bytes. A value only takes its own size in the
+ * storage. With SST_ENCRYPTION, it must fit in the object buffer.
+ */
+#ifndef SST_KV_MAX_VALUE_SIZE
+#define SST_KV_MAX_VALUE_SIZE 256
+#endif
+
+/* Number of directory entries stored in a directory object */
+#ifndef SST_KV_DIR_PAGE_ENTRIES
+#define SST_KV_DIR_PAGE_ENTRIES 8
+#endif
+
+/* Storage area which stores the key/value objects */
+#ifndef SST_KV_AREA_ID
+#define SST_KV_AREA_ID 0
+#endif
+
+/* Number of directory objects */
+#define SST_KV_NBR_DIR_PAGES \
+    ((SST_KV_NBR_SLOTS + SST_KV_DIR_PAGE_ENTRIES - 1) / SST_KV_DIR_PAGE_ENTRIES)
+
+/* Number of objects used by the key/value store, which must be accounted in
+ * the object metadata table of its storage area
+ */
+#define SST_KV_NBR_OBJECTS (SST_KV_NBR_SLOTS + SST_KV_NBR_DIR_PAGES)
+
+/* Object UUIDs of the directory and slot objects. They are out of the range
+ * of the asset UUIDs of the policy database.
+ */
+#define SST_KV_UUID_BASE      0x4B560000
+#define SST_KV_DIR_UUID(page) (SST_KV_UUID_BASE + (page))
+#define SST_KV_SLOT_UUID(pos) (SST_KV_UUID_BASE + 0x100 + (pos))
+
+/**
+ * \brief Loads the key/value directory, and deletes the slot objects which
+ *        are not referenced by it, left by an update interrupted by a power
+ *        failure.
+ *
+ * \note The storage area SST_KV_AREA_ID must be prepared.
+ *
+ * \return Returns error code as specified in \ref psa_sst_err_t
+ */
+enum psa_sst_err_t sst_kv_prepare(void);
+
+/**
+ * \brief Marks the key/value directory in RAM as stale, when the storage area
+ *        SST_KV_AREA_ID is wiped or prepared again. The next key/value
+ *        operation loads it again from the storage.
+ *
+ * \note It does not take the key/value directory lock, as it is called with
+ *       the area lock held, or without any lock by sst_system_wipe_all.
+ */
+void sst_kv_invalidate(void);
+
+/**
+ * \brief Sets the value of a key, creating the key if it does not exist.
+ *
+ * \param[in] app_id   Application ID, which owns the key
+ * \param[in] key      Key
+ * \param[in] key_len  Key length, from 1 to SST_KV_MAX_KEY_LEN
+ * \param[in] data     Value
+ * \param[in] size     Value size, up to SST_KV_MAX_VALUE_SIZE
+ *
+ * \return Returns PSA_SST_ERR_STORAGE_SYSTEM_FULL if all the slots are used,
+ *         or another error code as specified in \ref psa_sst_err_t
+ */
+enum psa_sst_err_t sst_kv_set(uint32_t app_id, const uint8_t *key,
+                              uint32_t key_len, const uint8_t *data,
+                              uint32_t size);
+
+/**
+ * \brief Gets the value of a key.
+ *
+ * \param[in]     app_id   Application ID, which owns the key
+ * \param[in]     key      Key
+ * \param[in]     key_len  Key length
+ * \param[out]    data     Buffer to store the value
+ * \param[in/out] size     Size of the buffer. It is set to the value size
+ *                         when the value is read.
+ *
+ * \return Returns PSA_SST_ERR_ASSET_NOT_FOUND if the key does not exist,
+ *         PSA_SST_ERR_PARAM_ERROR if the value does not fit in the buffer,
+ *         or another error code as specified in \ref psa_sst_err_t
+ */
+enum psa_sst_err_t sst_kv_get(uint32_t app_id, const uint8_t *key,
+                              uint32_t key_len, uint8_t *data,
+                              uint32_t *size);
+
+/**
+ * \brief Deletes a key and its value.
+ *
+ * \param[in] app_id   Application ID, which owns the key
+ * \param[in] key      Key
+ * \param[in] key_len  Key length
+ *
+ * \return Returns PSA_SST_ERR_ASSET_NOT_FOUND if the key does not exist,
+ *         or another error code as specified in \ref psa_sst_err_t
+ */
+enum psa_sst_err_t sst_kv_delete(uint32_t app_id, const uint8_t *key,
+                                 uint32_t key_len);
+
+/**
+ * \brief Gets the next key of an application ID.
+ *
+ * \param[in]     app_id   Application ID, which owns the keys
+ * \param[in/out] cursor   Iteration cursor, which must be set to 0 to get
+ *                         the first key. It is updated to get the next key.
+ * \param[out]    key      Buffer to store the key
+ * \param[in/out] key_len  Size of the buffer. It is set to the key length
+ *                         when the key is copied.
+ *
+ * \note The keys are returned in the order of the directory. A key which is
+ *       set or deleted during the iteration may be skipped.
+ *
+ * \return Returns PSA_SST_ERR_ASSET_NOT_FOUND when there is no more key,
+ *         PSA_SST_ERR_PARAM_ERROR if the key does not fit in the buffer,
+ *         or another error code as specified in \ref psa_sst_err_t
+ */
+enum psa_sst_err_t sst_kv_iterate(uint32_t app_id, uint32_t *cursor,
+                                  uint8_t *key, uint32_t *key_len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __SST_KV_H__ */
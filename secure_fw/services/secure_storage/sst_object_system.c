@@ -14,12 +14,25 @@
 #include "sst_object_system.h"
 #include "sst_core.h"
 #include "sst_utils.h"
+#include "flash/sst_flash.h"
+#ifdef SST_KV
+#include "sst_kv.h"
+#endif
 
 #define SST_SYSTEM_READY     1
 #define SST_SYSTEM_NOT_READY 0
 
-/* Set to 1 once sst_system_prepare has been called */
-static uint8_t sst_system_ready = SST_SYSTEM_NOT_READY;
+/* Set to 1 once sst_system_prepare has been called for the area */
+static uint8_t sst_system_ready[SST_NBR_OF_AREAS];
+
+/* Set to 1 while the area lock is held by sst_system_batch_lock. It is only
+ * changed with the area lock held.
+ */
+static uint8_t sst_system_batch_locked[SST_NBR_OF_AREAS];
+
+#if (SST_NBR_OF_AREAS > 32)
+#error "The storage areas of a batch must fit in a 32-bit mask"
+#endif
 
 /* Gets the size of object written to the object system below */
 #define SST_OBJECT_SIZE(max_size) (SST_OBJECT_HEADER_SIZE + max_size)
@@ -27,357 +40,727 @@ static uint8_t sst_system_ready = SST_SYSTEM_NOT_READY;
 
 #define SST_DEFAULT_EMPTY_BUFF_VAL 0
 
-static struct sst_object_t g_sst_object;
+#ifdef SST_ENCRYPTION
+/* The encrypted object data is authenticated as a whole, so an encrypted
+ * object is staged in RAM. The object data of the non-encrypted objects is
+ * streamed from and to the storage instead.
+ */
+static struct sst_object_t g_sst_object[SST_NBR_OF_AREAS];
+#endif
 
 /**
- * \brief Initialize an object based on the input parameters.
+ * \brief Checks if a storage area is prepared.
  *
- * \param[in]  uuid  Object UUID
- * \param[in]  type  Object type
- * \param[in]  size  Object size
- * \param[out] obj   Object to
+ * \param[in] area_id  Storage area ID
  *
- * \return Returns error code as specified in \ref psa_sst_err_t
+ * \return Returns 1 if the area ID is valid and the area is prepared,
+ *         0 otherwise
+ */
+static uint32_t sst_system_is_ready(uint32_t area_id)
+{
+    return ((area_id < SST_NBR_OF_AREAS) &&
+            (sst_system_ready[area_id] == SST_SYSTEM_READY));
+}
+
+/**
+ * \brief Initialize an object header based on the input parameters.
+ *
+ * \param[in]  uuid    Object UUID
+ * \param[in]  type    Object type
+ * \param[in]  size    Object size
+ * \param[out] header  Object header to initialize
  */
-static void sst_object_init_object(uint32_t uuid, uint32_t type, uint32_t size,
-                                   struct sst_object_t *obj)
+static void sst_object_init_header(uint32_t uuid, uint32_t type, uint32_t size,
+                                   struct sst_obj_header_t *header)
 {
-    /* Set all object data to 0 */
-    sst_utils_memset(obj, SST_DEFAULT_EMPTY_BUFF_VAL, SST_MAX_OBJECT_SIZE);
+    /* Set all header data to 0 */
+    sst_utils_memset(header, SST_DEFAULT_EMPTY_BUFF_VAL,
+                     SST_OBJECT_HEADER_SIZE);
 
     /* Set object header properties based on input parameters */
-    obj->header.uuid = uuid;
-    obj->header.version = 0;
-    obj->header.info.size_max = size;
-    obj->header.info.type = type;
+    header->uuid = uuid;
+    header->version = 0;
+    header->info.size_max = size;
+    header->info.type = type;
 }
 
-enum psa_sst_err_t sst_system_prepare(void)
+#ifndef SST_ENCRYPTION
+/**
+ * \brief Reads the header of an object.
+ *
+ * \details The current size of the object data is taken from the object
+ *          metadata, as the data appended to the object is written without
+ *          updating the header.
+ *
+ * \param[in]  area_id  Storage area ID
+ * \param[in]  uuid     Object UUID
+ * \param[out] header   Pointer to the object header to fill in
+ *
+ * \return Returns error code as specified in \ref psa_sst_err_t
+ */
+static enum psa_sst_err_t sst_object_read_header(uint32_t area_id,
+                                                uint32_t uuid,
+                                                struct sst_obj_header_t *header)
 {
+    struct sst_core_obj_info_t info;
     enum psa_sst_err_t err;
 
-    sst_global_lock();
-    err = sst_core_prepare();
-    if (err == PSA_SST_ERR_SUCCESS) {
-        sst_system_ready = SST_SYSTEM_READY;
+    err = sst_core_object_get_info(area_id, uuid, &info);
+    if (err != PSA_SST_ERR_SUCCESS) {
+        return err;
     }
-    sst_global_unlock();
 
-    return err;
+    if (info.size_current < SST_OBJECT_HEADER_SIZE) {
+        return PSA_SST_ERR_SYSTEM_ERROR;
+    }
+
+    err = sst_core_object_read(area_id, uuid, (uint8_t *)header,
+                               SST_OBJECT_START_POSITION,
+                               SST_OBJECT_HEADER_SIZE);
+    if (err != PSA_SST_ERR_SUCCESS) {
+        return err;
+    }
+
+    header->info.size_current = (info.size_current - SST_OBJECT_HEADER_SIZE);
+
+    return PSA_SST_ERR_SUCCESS;
 }
 
-enum psa_sst_err_t sst_object_read(uint32_t uuid,
-                                   const struct tfm_sst_token_t *s_token,
-                                   uint8_t *data, uint32_t offset,
-                                   uint32_t size)
+/**
+ * \brief Reads part of the object data from the storage straight into the
+ *        given buffer, without staging the object in RAM.
+ *
+ * \param[in]  area_id  Storage area ID
+ * \param[in]  uuid     Object UUID
+ * \param[out] data     Pointer to the buffer to store the data
+ * \param[in]  offset   Offset in the object data
+ * \param[in]  size     Size of the data to read
+ *
+ * \return Returns error code as specified in \ref psa_sst_err_t
+ */
+static enum psa_sst_err_t sst_object_read_data(uint32_t area_id, uint32_t uuid,
+                                               uint8_t *data, uint32_t offset,
+                                               uint32_t size)
 {
-    enum psa_sst_err_t err = PSA_SST_ERR_SYSTEM_ERROR;
+    enum psa_sst_err_t err;
+    struct sst_obj_header_t header;
+    uint32_t pos;
 
-#ifndef SST_ENCRYPTION
-    (void)s_token;
-#endif
+    err = sst_object_read_header(area_id, uuid, &header);
+    if (err != PSA_SST_ERR_SUCCESS) {
+        return err;
+    }
 
-#ifndef SST_ENABLE_PARTIAL_ASSET_RW
-    (void)offset;
+    /* Boundary check the incoming request */
+    err = sst_utils_check_contained_in(SST_OBJECT_START_POSITION,
+                                       header.info.size_current,
+                                       offset, size);
+    if (err != PSA_SST_ERR_SUCCESS) {
+        return err;
+    }
+
+#ifdef SST_ENABLE_PARTIAL_ASSET_RW
+    pos = SST_OBJECT_HEADER_SIZE + offset;
+#else
+    pos = SST_OBJECT_HEADER_SIZE;
 #endif
 
-    if (sst_system_ready == SST_SYSTEM_READY) {
-        sst_global_lock();
+    return sst_core_object_read(area_id, uuid, data, pos, size);
+}
+#endif /* SST_ENCRYPTION */
 
+/**
+ * \brief Reads object data, with the lock of the storage area held.
+ *
+ * \param[in]  area_id  Storage area ID
+ * \param[in]  uuid     Object UUID
+ * \param[in]  s_token  Pointer to the asset's token \ref tfm_sst_token_t
+ * \param[out] data     Data buffer to store the object data
+ * \param[in]  offset   Offset from where the read is going to start
+ * \param[in]  size     Data buffer size
+ *
+ * \return Returns error code specified in \ref psa_sst_err_t
+ */
+static enum psa_sst_err_t sst_object_read_locked(uint32_t area_id,
+                                         uint32_t uuid,
+                                         const struct tfm_sst_token_t *s_token,
+                                         uint8_t *data, uint32_t offset,
+                                         uint32_t size)
+{
 #ifdef SST_ENCRYPTION
-        err = sst_encrypted_object_read(uuid, s_token, &g_sst_object);
-#else
-        /* Read object header */
-        err = sst_core_object_read(uuid, (uint8_t *)&g_sst_object.header,
-                                   SST_OBJECT_START_POSITION,
-                                   SST_OBJECT_HEADER_SIZE);
-        if (err != PSA_SST_ERR_SUCCESS) {
-            return err;
-        }
-
-        /* Read object data if any */
-        if (g_sst_object.header.info.size_current > 0) {
-            err = sst_core_object_read(uuid, g_sst_object.data,
-                                       SST_OBJECT_HEADER_SIZE,
-                                       g_sst_object.header.info.size_current);
-        }
-#endif
-        if (err != PSA_SST_ERR_SUCCESS) {
-            return err;
-        }
+    struct sst_object_t *obj = &g_sst_object[area_id];
+    enum psa_sst_err_t err;
 
+    /* The object data is authenticated as a whole, so the full object is
+     * decrypted before copying the requested part
+     */
+    err = sst_encrypted_object_read(area_id, uuid, s_token, obj);
+    if (err == PSA_SST_ERR_SUCCESS) {
         /* Boundary check the incoming request */
         err = sst_utils_check_contained_in(SST_OBJECT_START_POSITION,
-                                          g_sst_object.header.info.size_current,
-                                          offset, size);
-        if (err != PSA_SST_ERR_SUCCESS) {
-            return err;
-        }
+                                           obj->header.info.size_current,
+                                           offset, size);
+    }
 
+    if (err == PSA_SST_ERR_SUCCESS) {
         /* Copy the decrypted object data to the output buffer */
 #ifdef SST_ENABLE_PARTIAL_ASSET_RW
-        sst_utils_memcpy(data, g_sst_object.data + offset, size);
+        sst_utils_memcpy(data, obj->data + offset, size);
 #else
-        sst_utils_memcpy(data, g_sst_object.data, size);
+        sst_utils_memcpy(data, obj->data, size);
 #endif
-
-        sst_global_unlock();
     }
 
     return err;
+#else
+    (void)s_token;
+
+    return sst_object_read_data(area_id, uuid, data, offset, size);
+#endif
 }
 
-enum psa_sst_err_t sst_object_create(uint32_t uuid,
-                                     const struct tfm_sst_token_t *s_token,
-                                     uint32_t type, uint32_t size)
+/**
+ * \brief Writes object data, with the lock of the storage area held.
+ *
+ * \param[in] area_id  Storage area ID
+ * \param[in] uuid     Object UUID
+ * \param[in] s_token  Pointer to the asset's token \ref tfm_sst_token_t
+ * \param[in] data     Data buffer to write into the object
+ * \param[in] offset   Offset from where the write is going to start
+ * \param[in] size     Data buffer size
+ *
+ * \return Returns error code specified in \ref psa_sst_err_t
+ */
+static enum psa_sst_err_t sst_object_write_locked(uint32_t area_id,
+                                         uint32_t uuid,
+                                         const struct tfm_sst_token_t *s_token,
+                                         const uint8_t *data, uint32_t offset,
+                                         uint32_t size)
 {
-    enum psa_sst_err_t err = PSA_SST_ERR_SYSTEM_ERROR;
+#ifdef SST_ENCRYPTION
+    struct sst_object_t *obj = &g_sst_object[area_id];
+    enum psa_sst_err_t err;
+#else
+    (void)s_token;
+#endif
+
+#ifndef SST_ENABLE_PARTIAL_ASSET_RW
+    /* The data is written at the start of the object data */
+    offset = 0;
+#endif
+
+#ifdef SST_ENCRYPTION
+    /* Read the object from the object system */
+    err = sst_encrypted_object_read(area_id, uuid, s_token, obj);
+    if (err != PSA_SST_ERR_SUCCESS) {
+        return err;
+    }
+
+    /* Offset must not be larger than the object's current size to
+     * prevent gaps being created in the object data. The data must fit
+     * in the object buffer.
+     */
+    if ((offset > obj->header.info.size_current) ||
+        (size > (SST_MAX_OBJECT_DATA_SIZE - offset))) {
+        return PSA_SST_ERR_PARAM_ERROR;
+    }
+
+    /* Update the object data */
+    sst_utils_memcpy(obj->data + offset, data, size);
+
+    /* Update the current object size if necessary */
+    if ((offset + size) > obj->header.info.size_current) {
+        obj->header.info.size_current = offset + size;
+    }
+
+    return sst_encrypted_object_write(area_id, uuid, s_token, obj);
+#else
+    /* Only the given part of the object data is streamed to the storage.
+     * The header is not updated, as the object's current size is taken
+     * from the object metadata. The core checks that the offset does not
+     * create a gap in the object data.
+     */
+    return sst_core_object_write(area_id, uuid, data,
+                                 (SST_OBJECT_HEADER_SIZE + offset), size);
+#endif
+}
+
+/**
+ * \brief Creates an object, with the lock of the storage area held.
+ *
+ * \param[in] area_id  Storage area ID
+ * \param[in] uuid     Object UUID
+ * \param[in] s_token  Pointer to the asset's token \ref tfm_sst_token_t
+ * \param[in] type     Object type
+ * \param[in] size     Object size
+ *
+ * \return Returns error code specified in \ref psa_sst_err_t
+ */
+static enum psa_sst_err_t sst_object_create_locked(uint32_t area_id,
+                                         uint32_t uuid,
+                                         const struct tfm_sst_token_t *s_token,
+                                         uint32_t type, uint32_t size)
+{
+    enum psa_sst_err_t err;
+#ifdef SST_ENCRYPTION
+    struct sst_object_t *obj = &g_sst_object[area_id];
+#else
+    struct sst_obj_header_t header;
 
-#ifndef SST_ENCRYPTION
     (void)s_token;
 #endif
 
-    if (sst_system_ready == SST_SYSTEM_READY) {
-        sst_global_lock();
-        /* Check if it already exists */
-        err = sst_core_object_exist(uuid);
-        if (err == PSA_SST_ERR_ASSET_NOT_FOUND) {
-            /* Initialize object based on the input arguments */
-            sst_object_init_object(uuid, type, size, &g_sst_object);
+    /* Check if it already exists */
+    err = sst_core_object_exist(area_id, uuid);
+    if (err != PSA_SST_ERR_ASSET_NOT_FOUND) {
+        return err;
+    }
 
 #ifdef SST_ENCRYPTION
-            err = sst_encrypted_object_create(uuid, s_token, &g_sst_object);
+    /* The whole encrypted object must fit in the object buffer */
+    if (size > SST_MAX_OBJECT_DATA_SIZE) {
+        return PSA_SST_ERR_PARAM_ERROR;
+    }
+
+    /* Initialize object based on the input arguments */
+    sst_utils_memset(obj->data, SST_DEFAULT_EMPTY_BUFF_VAL,
+                     SST_MAX_OBJECT_DATA_SIZE);
+    sst_object_init_header(uuid, type, size, &obj->header);
+
+    return sst_encrypted_object_create(area_id, uuid, s_token, obj);
 #else
-            /* FixMe: This is an inefficient way to write the object header.
-             *        The create function should allow to write content
-             *        in the object.
-             */
-            err = sst_core_object_create(uuid, SST_OBJECT_SIZE(size));
-            if (err != PSA_SST_ERR_SUCCESS) {
-                return err;
-            }
+    /* Initialize object header based on the input arguments */
+    sst_object_init_header(uuid, type, size, &header);
 
-            err = sst_core_object_write(uuid, (uint8_t *)&g_sst_object,
-                                        SST_OBJECT_START_POSITION,
-                                        SST_OBJECT_HEADER_SIZE);
+    /* Create the object with its header as initial content */
+    return sst_core_object_create(area_id, uuid, SST_OBJECT_SIZE(size),
+                                  (uint8_t *)&header, SST_OBJECT_HEADER_SIZE);
 #endif
-        }
-        sst_global_unlock();
+}
+
+/**
+ * \brief Deletes an object, with the lock of the storage area held.
+ *
+ * \param[in] area_id  Storage area ID
+ * \param[in] uuid     Object UUID
+ * \param[in] s_token  Pointer to the asset's token \ref tfm_sst_token_t
+ *
+ * \return Returns error code specified in \ref psa_sst_err_t
+ */
+static enum psa_sst_err_t sst_object_delete_locked(uint32_t area_id,
+                                         uint32_t uuid,
+                                         const struct tfm_sst_token_t *s_token)
+{
+    /* FIXME: Authenticate object data to validate token before delete it. */
+    (void)s_token;
+
+    return sst_core_object_delete(area_id, uuid);
+}
+
+/**
+ * \brief Checks if a storage area is prepared, and locked by
+ *        sst_system_batch_lock.
+ *
+ * \param[in] area_id  Storage area ID
+ *
+ * \return Returns 1 if the area can be accessed by the batch, 0 otherwise
+ */
+static uint32_t sst_system_is_batch_locked(uint32_t area_id)
+{
+    return (sst_system_is_ready(area_id) &&
+            (sst_system_batch_locked[area_id] != 0));
+}
+
+enum psa_sst_err_t sst_system_prepare(uint32_t area_id)
+{
+    enum psa_sst_err_t err;
+
+    sst_area_lock(area_id);
+    err = sst_core_prepare(area_id);
+    if (err == PSA_SST_ERR_SUCCESS) {
+        sst_system_ready[area_id] = SST_SYSTEM_READY;
+    }
+#ifdef SST_KV
+    /* The key/value directory may no longer match the area content */
+    if (area_id == SST_KV_AREA_ID) {
+        sst_kv_invalidate();
+    }
+#endif
+    sst_area_unlock(area_id);
+
+    return err;
+}
+
+enum psa_sst_err_t sst_object_read(uint32_t area_id, uint32_t uuid,
+                                   const struct tfm_sst_token_t *s_token,
+                                   uint8_t *data, uint32_t offset,
+                                   uint32_t size)
+{
+    enum psa_sst_err_t err = PSA_SST_ERR_SYSTEM_ERROR;
+
+    if (sst_system_is_ready(area_id)) {
+        sst_area_lock(area_id);
+        err = sst_object_read_locked(area_id, uuid, s_token, data, offset,
+                                     size);
+        sst_area_unlock(area_id);
+    }
+
+    return err;
+}
+
+enum psa_sst_err_t sst_object_create(uint32_t area_id, uint32_t uuid,
+                                     const struct tfm_sst_token_t *s_token,
+                                     uint32_t type, uint32_t size)
+{
+    enum psa_sst_err_t err = PSA_SST_ERR_SYSTEM_ERROR;
+
+    if (sst_system_is_ready(area_id)) {
+        sst_area_lock(area_id);
+        err = sst_object_create_locked(area_id, uuid, s_token, type, size);
+        sst_area_unlock(area_id);
     }
 
     return err;
 }
 
-enum psa_sst_err_t sst_object_write(uint32_t uuid,
+enum psa_sst_err_t sst_object_write(uint32_t area_id, uint32_t uuid,
                                     const struct tfm_sst_token_t *s_token,
                                     const uint8_t *data, uint32_t offset,
                                     uint32_t size)
 {
     enum psa_sst_err_t err = PSA_SST_ERR_SYSTEM_ERROR;
 
-#ifndef SST_ENCRYPTION
-    (void)s_token;
-#endif
+    if (sst_system_is_ready(area_id)) {
+        sst_area_lock(area_id);
+        err = sst_object_write_locked(area_id, uuid, s_token, data, offset,
+                                      size);
+        sst_area_unlock(area_id);
+    }
 
-#ifndef SST_ENABLE_PARTIAL_ASSET_RW
-    (void)offset;
-#endif
+    return err;
+}
 
-    if (sst_system_ready == SST_SYSTEM_READY) {
-        sst_global_lock();
+void sst_system_batch_lock(uint32_t area_mask)
+{
+    uint32_t area_id;
 
-        /* Read the object from the object system */
-#ifdef SST_ENCRYPTION
-        err = sst_encrypted_object_read(uuid, s_token, &g_sst_object);
-#else
-        /* Read object header */
-        err = sst_core_object_read(uuid, (uint8_t *)&g_sst_object.header,
-                                   SST_OBJECT_START_POSITION,
-                                   SST_OBJECT_HEADER_SIZE);
-        if (err != PSA_SST_ERR_SUCCESS) {
-            return err;
+    /* The area locks are always taken in ascending area order, so that two
+     * batches spanning the same areas can not deadlock
+     */
+    for (area_id = 0; area_id < SST_NBR_OF_AREAS; area_id++) {
+        if ((area_mask & SST_SYSTEM_AREA_MASK(area_id)) != 0) {
+            sst_area_lock(area_id);
+            sst_system_batch_locked[area_id] = 1;
         }
+    }
+}
 
-        /* Read object data if any */
-        if (g_sst_object.header.info.size_current > 0) {
-            err = sst_core_object_read(uuid, g_sst_object.data,
-                                       SST_OBJECT_HEADER_SIZE,
-                                       g_sst_object.header.info.size_current);
-        }
-#endif
-        if (err != PSA_SST_ERR_SUCCESS) {
-            return err;
-        }
+void sst_system_batch_unlock(uint32_t area_mask)
+{
+    uint32_t area_id = SST_NBR_OF_AREAS;
 
-        /* Offset must not be larger than the object's current size to
-         * prevent gaps being created in the object data.
-         */
-        if (offset > g_sst_object.header.info.size_current) {
-            return PSA_SST_ERR_PARAM_ERROR;
+    while (area_id > 0) {
+        area_id--;
+        if ((area_mask & SST_SYSTEM_AREA_MASK(area_id)) != 0) {
+            sst_system_batch_locked[area_id] = 0;
+            sst_area_unlock(area_id);
         }
+    }
+}
 
+enum psa_sst_err_t sst_object_batch_read(uint32_t area_id, uint32_t uuid,
+                                         const struct tfm_sst_token_t *s_token,
+                                         uint8_t *data, uint32_t offset,
+                                         uint32_t size)
+{
+    if (!sst_system_is_batch_locked(area_id)) {
+        return PSA_SST_ERR_SYSTEM_ERROR;
+    }
 
-#ifdef SST_ENABLE_PARTIAL_ASSET_RW
-        /* Update the object data */
-        sst_utils_memcpy(g_sst_object.data + offset, data, size);
+    return sst_object_read_locked(area_id, uuid, s_token, data, offset, size);
+}
 
-        /* Update the current object size if necessary */
-        if ((offset + size) > g_sst_object.header.info.size_current) {
-            g_sst_object.header.info.size_current = offset + size;
-        }
-#else
-        /* Update the object data */
-        sst_utils_memcpy(g_sst_object.data, data, size);
+enum psa_sst_err_t sst_object_batch_write(uint32_t area_id, uint32_t uuid,
+                                        const struct tfm_sst_token_t *s_token,
+                                        const uint8_t *data, uint32_t offset,
+                                        uint32_t size)
+{
+    if (!sst_system_is_batch_locked(area_id)) {
+        return PSA_SST_ERR_SYSTEM_ERROR;
+    }
 
-        /* Update the current object size if necessary */
-        if (size > g_sst_object.header.info.size_current) {
-            g_sst_object.header.info.size_current = size;
-        }
-#endif
+    return sst_object_write_locked(area_id, uuid, s_token, data, offset, size);
+}
 
-#ifdef SST_ENCRYPTION
-        err = sst_encrypted_object_write(uuid, s_token, &g_sst_object);
-#else
-        err = sst_core_object_write(uuid, (uint8_t *)&g_sst_object,
-                                    SST_OBJECT_START_POSITION,
-                                    SST_OBJECT_SIZE(
-                                        g_sst_object.header.info.size_current));
-#endif
-        sst_global_unlock();
+enum psa_sst_err_t sst_object_batch_create(uint32_t area_id, uint32_t uuid,
+                                        const struct tfm_sst_token_t *s_token,
+                                        uint32_t type, uint32_t size)
+{
+    if (!sst_system_is_batch_locked(area_id)) {
+        return PSA_SST_ERR_SYSTEM_ERROR;
     }
 
-    return err;
+    return sst_object_create_locked(area_id, uuid, s_token, type, size);
+}
+
+enum psa_sst_err_t sst_object_batch_delete(uint32_t area_id, uint32_t uuid,
+                                        const struct tfm_sst_token_t *s_token)
+{
+    if (!sst_system_is_batch_locked(area_id)) {
+        return PSA_SST_ERR_SYSTEM_ERROR;
+    }
+
+    return sst_object_delete_locked(area_id, uuid, s_token);
 }
 
-enum psa_sst_err_t sst_object_get_info(uint32_t uuid,
+enum psa_sst_err_t sst_object_get_info(uint32_t area_id, uint32_t uuid,
                                        const struct tfm_sst_token_t *s_token,
                                        struct psa_sst_asset_info_t *info)
 {
     enum psa_sst_err_t err = PSA_SST_ERR_SYSTEM_ERROR;
+#ifdef SST_ENCRYPTION
+    struct sst_object_t *obj;
+#else
+    struct sst_obj_header_t header;
 
-#ifndef SST_ENCRYPTION
     (void)s_token;
 #endif
 
-    if (sst_system_ready == SST_SYSTEM_READY) {
-        sst_global_lock();
+    if (sst_system_is_ready(area_id)) {
+        sst_area_lock(area_id);
+#ifdef SST_ENCRYPTION
+        obj = &g_sst_object[area_id];
 
         /* Read the object from the object system */
-#ifdef SST_ENCRYPTION
-        err = sst_encrypted_object_read(uuid, s_token, &g_sst_object);
+        err = sst_encrypted_object_read(area_id, uuid, s_token, obj);
+        if (err == PSA_SST_ERR_SUCCESS) {
+            sst_utils_memcpy(info, &obj->header.info,
+                             PSA_SST_ASSET_INFO_SIZE);
+        }
 #else
-        err = sst_core_object_read(uuid, (uint8_t *)&g_sst_object,
-                                   SST_OBJECT_START_POSITION,
-                                   SST_OBJECT_HEADER_SIZE);
-#endif
-        if (err != PSA_SST_ERR_SUCCESS) {
-            return err;
+        /* Only the object header is read */
+        err = sst_object_read_header(area_id, uuid, &header);
+        if (err == PSA_SST_ERR_SUCCESS) {
+            sst_utils_memcpy(info, &header.info, PSA_SST_ASSET_INFO_SIZE);
         }
+#endif
+
+        sst_area_unlock(area_id);
+    }
 
-        sst_utils_memcpy(info, &g_sst_object.header.info,
-                         PSA_SST_ASSET_INFO_SIZE);
+    return err;
+}
+
+enum psa_sst_err_t sst_object_get_next(uint32_t area_id, uint32_t *index,
+                                      struct psa_sst_asset_list_entry_t *entry)
+{
+    struct sst_core_obj_info_t info;
+    enum psa_sst_err_t err = PSA_SST_ERR_SYSTEM_ERROR;
+    uint32_t uuid;
+
+    if (sst_system_is_ready(area_id)) {
+        sst_area_lock(area_id);
+
+        err = sst_core_object_next(area_id, index, &uuid, &info);
+        if (err == PSA_SST_ERR_SUCCESS) {
+            /* The object header is stored, encrypted or not, in front of
+             * the object data.
+             */
+            if ((info.size_current < SST_OBJECT_HEADER_SIZE) ||
+                (info.size_max < info.size_current)) {
+                err = PSA_SST_ERR_SYSTEM_ERROR;
+            } else {
+                entry->uuid = uuid;
+                entry->size_current = (info.size_current -
+                                       SST_OBJECT_HEADER_SIZE);
+                entry->size_max = (info.size_max - SST_OBJECT_HEADER_SIZE);
+            }
+        }
 
-        sst_global_unlock();
+        sst_area_unlock(area_id);
     }
 
     return err;
 }
 
-enum psa_sst_err_t sst_object_get_attributes(uint32_t uuid,
+enum psa_sst_err_t sst_object_get_attributes(uint32_t area_id, uint32_t uuid,
                                           const struct tfm_sst_token_t *s_token,
                                           struct psa_sst_asset_attrs_t *attrs)
 {
     enum psa_sst_err_t err = PSA_SST_ERR_SYSTEM_ERROR;
+#ifdef SST_ENCRYPTION
+    struct sst_object_t *obj;
+#else
+    struct sst_obj_header_t header;
 
-#ifndef SST_ENCRYPTION
     (void)s_token;
 #endif
 
-    if (sst_system_ready == SST_SYSTEM_READY) {
-        sst_global_lock();
+    if (sst_system_is_ready(area_id)) {
+        sst_area_lock(area_id);
+#ifdef SST_ENCRYPTION
+        obj = &g_sst_object[area_id];
 
         /* Read the object from the object system */
-#ifdef SST_ENCRYPTION
-        err = sst_encrypted_object_read(uuid, s_token, &g_sst_object);
+        err = sst_encrypted_object_read(area_id, uuid, s_token, obj);
+        if (err == PSA_SST_ERR_SUCCESS) {
+            sst_utils_memcpy(attrs, &obj->header.attr,
+                             PSA_SST_ASSET_ATTR_SIZE);
+        }
 #else
-        err = sst_core_object_read(uuid, (uint8_t *)&g_sst_object,
-                                   SST_OBJECT_START_POSITION,
-                                   SST_OBJECT_HEADER_SIZE);
-#endif
-        if (err != PSA_SST_ERR_SUCCESS) {
-            return err;
+        /* Only the object header is read */
+        err = sst_object_read_header(area_id, uuid, &header);
+        if (err == PSA_SST_ERR_SUCCESS) {
+            sst_utils_memcpy(attrs, &header.attr, PSA_SST_ASSET_ATTR_SIZE);
         }
+#endif
 
-        sst_utils_memcpy(attrs, &g_sst_object.header.attr,
-                         PSA_SST_ASSET_ATTR_SIZE);
-
-        sst_global_unlock();
+        sst_area_unlock(area_id);
     }
 
     return err;
 }
 
-enum psa_sst_err_t sst_object_set_attributes(uint32_t uuid,
+enum psa_sst_err_t sst_object_set_attributes(uint32_t area_id, uint32_t uuid,
                                       const struct tfm_sst_token_t *s_token,
                                       const struct psa_sst_asset_attrs_t *attrs)
 {
     enum psa_sst_err_t err = PSA_SST_ERR_SYSTEM_ERROR;
+#ifdef SST_ENCRYPTION
+    struct sst_object_t *obj;
+#else
+    struct sst_obj_header_t header;
 
-#ifndef SST_ENCRYPTION
     (void)s_token;
 #endif
 
-    if (sst_system_ready == SST_SYSTEM_READY) {
-        sst_global_lock();
-
-        /* Read the object from the object system */
+    if (sst_system_is_ready(area_id)) {
+        sst_area_lock(area_id);
 #ifdef SST_ENCRYPTION
-        err = sst_encrypted_object_read(uuid, s_token, &g_sst_object);
-#else
-        err = sst_core_object_read(uuid, (uint8_t *)&g_sst_object,
-                                   SST_OBJECT_START_POSITION,
-                                   SST_OBJECT_HEADER_SIZE);
-#endif
-        if (err != PSA_SST_ERR_SUCCESS) {
-            return err;
-        }
+        obj = &g_sst_object[area_id];
 
-        /* Set new attributes */
-        sst_utils_memcpy(&g_sst_object.header.attr,
-                         attrs, PSA_SST_ASSET_ATTR_SIZE);
+        /* Read the object from the object system */
+        err = sst_encrypted_object_read(area_id, uuid, s_token, obj);
+        if (err == PSA_SST_ERR_SUCCESS) {
+            /* Set new attributes */
+            sst_utils_memcpy(&obj->header.attr,
+                             attrs, PSA_SST_ASSET_ATTR_SIZE);
 
-#ifdef SST_ENCRYPTION
-        err = sst_encrypted_object_write(uuid, s_token, &g_sst_object);
+            err = sst_encrypted_object_write(area_id, uuid, s_token, obj);
+        }
 #else
-        err = sst_core_object_write(uuid, (uint8_t *)&g_sst_object,
+        /* Only the object header is read and written again */
+        err = sst_core_object_read(area_id, uuid, (uint8_t *)&header,
                                    SST_OBJECT_START_POSITION,
                                    SST_OBJECT_HEADER_SIZE);
+        if (err == PSA_SST_ERR_SUCCESS) {
+            /* Set new attributes */
+            sst_utils_memcpy(&header.attr, attrs, PSA_SST_ASSET_ATTR_SIZE);
+
+            err = sst_core_object_write(area_id, uuid, (uint8_t *)&header,
+                                        SST_OBJECT_START_POSITION,
+                                        SST_OBJECT_HEADER_SIZE);
+        }
 #endif
 
-        sst_global_unlock();
+        sst_area_unlock(area_id);
     }
 
     return err;
 }
 
-enum psa_sst_err_t sst_object_delete(uint32_t uuid,
+enum psa_sst_err_t sst_object_delete(uint32_t area_id, uint32_t uuid,
                                      const struct tfm_sst_token_t *s_token)
 {
     enum psa_sst_err_t err = PSA_SST_ERR_SYSTEM_ERROR;
 
-    /* FIXME: Authenticate object data to validate token before delete it. */
-    (void)s_token;
+    if (sst_system_is_ready(area_id)) {
+        sst_area_lock(area_id);
+        err = sst_object_delete_locked(area_id, uuid, s_token);
+        sst_area_unlock(area_id);
+    }
+
+    return err;
+}
+
+enum psa_sst_err_t sst_system_txn_begin(uint32_t area_id)
+{
+    if (!sst_system_is_batch_locked(area_id)) {
+        return PSA_SST_ERR_SYSTEM_ERROR;
+    }
+
+    return sst_core_txn_begin(area_id);
+}
+
+enum psa_sst_err_t sst_system_txn_commit(uint32_t area_id)
+{
+    if (!sst_system_is_batch_locked(area_id)) {
+        return PSA_SST_ERR_SYSTEM_ERROR;
+    }
+
+    return sst_core_txn_commit(area_id);
+}
+
+enum psa_sst_err_t sst_system_txn_abort(uint32_t area_id)
+{
+    if (!sst_system_is_batch_locked(area_id)) {
+        return PSA_SST_ERR_SYSTEM_ERROR;
+    }
+
+    return sst_core_txn_abort(area_id);
+}
 
-    if (sst_system_ready == SST_SYSTEM_READY) {
-        sst_global_lock();
-        err = sst_core_object_delete(uuid);
-        sst_global_unlock();
+enum psa_sst_err_t sst_system_get_wear_info(uint32_t area_id,
+                                            struct psa_sst_wear_info_t *info)
+{
+    enum psa_sst_err_t err = PSA_SST_ERR_SYSTEM_ERROR;
+
+    if (sst_system_is_ready(area_id)) {
+        sst_area_lock(area_id);
+        err = sst_core_get_wear_info(area_id, info);
+        sst_area_unlock(area_id);
     }
 
     return err;
 }
 
-enum psa_sst_err_t sst_system_wipe_all(void)
+void sst_system_get_flash_stats(struct tfm_sst_flash_stats_t *stats)
+{
+    /* The counters are valid before the system is prepared, as they also
+     * account the flash operations performed to prepare it.
+     */
+    sst_global_lock();
+    sst_flash_get_stats(stats);
+    sst_global_unlock();
+}
+
+enum psa_sst_err_t sst_system_get_flash_trace(
+                                         struct tfm_sst_flash_trace_t *entries,
+                                         uint32_t nbr_entries)
+{
+    enum psa_sst_err_t err;
+
+    sst_global_lock();
+    err = sst_flash_get_trace(entries, nbr_entries);
+    sst_global_unlock();
+
+    return err;
+}
+
+enum psa_sst_err_t sst_system_maintenance(uint32_t area_id)
+{
+    enum psa_sst_err_t err = PSA_SST_ERR_SYSTEM_ERROR;
+
+    if (sst_system_is_ready(area_id)) {
+        sst_area_lock(area_id);
+        err = sst_core_maintenance(area_id);
+        sst_area_unlock(area_id);
+    }
+
+    return err;
+}
+
+enum psa_sst_err_t sst_system_wipe_all(uint32_t area_id)
 {
     enum psa_sst_err_t err;
     /* This function may get called as a corrective action
@@ -387,7 +770,12 @@ enum psa_sst_err_t sst_system_wipe_all(void)
      * this function doesn't block on the lock and directly
      * moves to erasing the flash instead.
      */
-    err = sst_core_wipe_all();
+    err = sst_core_wipe_all(area_id);
+#ifdef SST_KV
+    if (area_id == SST_KV_AREA_ID) {
+        sst_kv_invalidate();
+    }
+#endif
 
     return err;
 }
@@ -15,18 +15,24 @@ extern "C" {
 #include <inttypes.h>
 #include "tfm_sst_defs.h"
 
+/* Bit of a storage area in the area mask of a batch */
+#define SST_SYSTEM_AREA_MASK(area_id) (1U << (area_id))
+
 /**
  * \brief Prepares the secure storage system for usage, populating internal
  *        structures.
- *        It identifies and validates the system metadata.
+ *        It identifies and validates the system metadata of a storage area.
+ *
+ * \param[in] area_id  Storage area ID
  *
  * \return Returns PSA_SST_ERR_SUCCESS or PSA_SST_ERR_INIT_FAILED
  */
-enum psa_sst_err_t sst_system_prepare(void);
+enum psa_sst_err_t sst_system_prepare(uint32_t area_id);
 
 /**
  * \brief Creates a new object with given object UUID.
  *
+ * \param[in] area_id  Storage area ID
  * \param[in] uuid     Object UUID
  * \param[in] s_token  Pointer to the asset's token \ref tfm_sst_token_t
  * \param[in] type     Object type
@@ -34,7 +40,7 @@ enum psa_sst_err_t sst_system_prepare(void);
  *
  * \return Returns error code specified in \ref psa_sst_err_t
  */
-enum psa_sst_err_t sst_object_create(uint32_t uuid,
+enum psa_sst_err_t sst_object_create(uint32_t area_id, uint32_t uuid,
                                      const struct tfm_sst_token_t *s_token,
                                      uint32_t type, uint32_t size);
 
@@ -42,6 +48,7 @@ enum psa_sst_err_t sst_object_create(uint32_t uuid,
  * \brief Gets object's data referenced by object UUID, and stores it
  *        in the data buffer.
  *
+ * \param[in]  area_id  Storage area ID
  * \param[in]  uuid     Object UUID
  * \param[in]  s_token  Pointer to the asset's token \ref tfm_sst_token_t
  * \param[out] data     Data buffer to store the object data
@@ -50,13 +57,14 @@ enum psa_sst_err_t sst_object_create(uint32_t uuid,
  *
  * \return Returns error code specified in \ref psa_sst_err_t
  */
-enum psa_sst_err_t sst_object_read(uint32_t uuid,
+enum psa_sst_err_t sst_object_read(uint32_t area_id, uint32_t uuid,
                                    const struct tfm_sst_token_t *s_token,
                                    uint8_t *data, uint32_t offset,
                                    uint32_t size);
 /**
  * \brief Writes data into the object referenced by object UUID.
  *
+ * \param[in] area_id  Storage area ID
  * \param[in] uuid     Object UUID
  * \param[in] s_token  Pointer to the asset's token \ref tfm_sst_token_t
  * \param[in] data     Data buffer to write into object object
@@ -65,24 +73,92 @@ enum psa_sst_err_t sst_object_read(uint32_t uuid,
  *
  * \return Returns number of bytes read or a relevant error \ref psa_sst_err_t
  */
-enum psa_sst_err_t sst_object_write(uint32_t uuid,
+enum psa_sst_err_t sst_object_write(uint32_t area_id, uint32_t uuid,
                                     const struct tfm_sst_token_t *s_token,
                                     const uint8_t *data, uint32_t offset,
                                     uint32_t size);
+
+/**
+ * \brief Acquires the locks of the storage areas of a batch of object
+ *        operations, in ascending area order. The objects of these areas are
+ *        then accessed with the sst_object_batch_* functions, within an
+ *        optional transaction, and the other requests to these areas are not
+ *        interleaved with the batch until sst_system_batch_unlock is called.
+ *
+ * \param[in] area_mask  Mask of the storage areas, built with
+ *                       SST_SYSTEM_AREA_MASK
+ */
+void sst_system_batch_lock(uint32_t area_mask);
+
+/**
+ * \brief Releases the locks acquired by sst_system_batch_lock.
+ *
+ * \param[in] area_mask  Mask of the storage areas given to
+ *                       sst_system_batch_lock
+ */
+void sst_system_batch_unlock(uint32_t area_mask);
+
+/**
+ * \brief Same as sst_object_read, for an area locked by
+ *        sst_system_batch_lock.
+ *
+ * \return Returns PSA_SST_ERR_SYSTEM_ERROR if the area is not locked by the
+ *         batch, or another error code specified in \ref psa_sst_err_t
+ */
+enum psa_sst_err_t sst_object_batch_read(uint32_t area_id, uint32_t uuid,
+                                         const struct tfm_sst_token_t *s_token,
+                                         uint8_t *data, uint32_t offset,
+                                         uint32_t size);
+
+/**
+ * \brief Same as sst_object_write, for an area locked by
+ *        sst_system_batch_lock.
+ *
+ * \return Returns PSA_SST_ERR_SYSTEM_ERROR if the area is not locked by the
+ *         batch, or another error code specified in \ref psa_sst_err_t
+ */
+enum psa_sst_err_t sst_object_batch_write(uint32_t area_id, uint32_t uuid,
+                                        const struct tfm_sst_token_t *s_token,
+                                        const uint8_t *data, uint32_t offset,
+                                        uint32_t size);
+
+/**
+ * \brief Same as sst_object_create, for an area locked by
+ *        sst_system_batch_lock.
+ *
+ * \return Returns PSA_SST_ERR_SYSTEM_ERROR if the area is not locked by the
+ *         batch, or another error code specified in \ref psa_sst_err_t
+ */
+enum psa_sst_err_t sst_object_batch_create(uint32_t area_id, uint32_t uuid,
+                                        const struct tfm_sst_token_t *s_token,
+                                        uint32_t type, uint32_t size);
+
+/**
+ * \brief Same as sst_object_delete, for an area locked by
+ *        sst_system_batch_lock.
+ *
+ * \return Returns PSA_SST_ERR_SYSTEM_ERROR if the area is not locked by the
+ *         batch, or another error code specified in \ref psa_sst_err_t
+ */
+enum psa_sst_err_t sst_object_batch_delete(uint32_t area_id, uint32_t uuid,
+                                        const struct tfm_sst_token_t *s_token);
+
 /**
  * \brief Deletes the object referenced by object UUID.
  *
- * \param[in] uuid  Object UUID
+ * \param[in] area_id  Storage area ID
+ * \param[in] uuid     Object UUID
  * \param[in] s_token  Pointer to the asset's token \ref tfm_sst_token_t
  *
  * \return Returns error code specified in \ref psa_sst_err_t
  */
-enum psa_sst_err_t sst_object_delete(uint32_t uuid,
+enum psa_sst_err_t sst_object_delete(uint32_t area_id, uint32_t uuid,
                                      const struct tfm_sst_token_t *s_token);
 
 /**
  * \brief Gets the object information referenced by object UUID.
  *
+ * \param[in]  area_id  Storage area ID
  * \param[in]  uuid     Object UUID
  * \param[in]  s_token  Pointer to the asset's token \ref tfm_sst_token_t
  * \param[out] info     Pointer to store the object's information
@@ -90,13 +166,34 @@ enum psa_sst_err_t sst_object_delete(uint32_t uuid,
  *
  * \return Returns error code specified in \ref psa_sst_err_t
  */
-enum psa_sst_err_t sst_object_get_info(uint32_t uuid,
+enum psa_sst_err_t sst_object_get_info(uint32_t area_id, uint32_t uuid,
                                        const struct tfm_sst_token_t *s_token,
                                        struct psa_sst_asset_info_t *info);
 
+/**
+ * \brief Gets the next object of a storage area, in the order of the object
+ *        metadata table.
+ *
+ * \param[in]     area_id  Storage area ID
+ * \param[in/out] index    Pointer to the object metadata index to start the
+ *                         search from, 0 to get the first object. It is set
+ *                         to the index following the object found.
+ * \param[out]    entry    Pointer to store the object's UUID and sizes
+ *                         \ref psa_sst_asset_list_entry_t
+ *
+ * \note The object's sizes are taken from the object metadata, so the object
+ *       is neither read nor authenticated.
+ *
+ * \return Returns PSA_SST_ERR_ASSET_NOT_FOUND when there is no more object,
+ *         or another error code as specified in \ref psa_sst_err_t
+ */
+enum psa_sst_err_t sst_object_get_next(uint32_t area_id, uint32_t *index,
+                                     struct psa_sst_asset_list_entry_t *entry);
+
 /**
  * \brief Gets the object attributes referenced by object UUID.
  *
+ * \param[in]  area_id  Storage area ID
  * \param[in]  uuid     Object UUID
  * \param[in]  s_token  Pointer to the asset's token \ref tfm_sst_token_t
  * \param[out] attrs    Pointer to store the object's attributes
@@ -104,12 +201,13 @@ enum psa_sst_err_t sst_object_get_info(uint32_t uuid,
  *
  * \return Returns error code as specified in \ref psa_sst_err_t
  */
-enum psa_sst_err_t sst_object_get_attributes(uint32_t uuid,
+enum psa_sst_err_t sst_object_get_attributes(uint32_t area_id, uint32_t uuid,
                                           const struct tfm_sst_token_t *s_token,
                                           struct psa_sst_asset_attrs_t *attrs);
 /**
  * \brief Sets the specific object attributes referenced by object UUID.
  *
+ * \param[in] area_id  Storage area ID
  * \param[in] uuid     Object UUID \ref tfm_sst_token_t
  * \param[in] s_token  Pointer to the asset's token \ref tfm_sst_token_t
  * \param[in] attrs    Pointer to new the object's attributes
@@ -117,16 +215,101 @@ enum psa_sst_err_t sst_object_get_attributes(uint32_t uuid,
  *
  * \return Returns error code as specified in \ref psa_sst_err_t
  */
-enum psa_sst_err_t sst_object_set_attributes(uint32_t uuid,
+enum psa_sst_err_t sst_object_set_attributes(uint32_t area_id, uint32_t uuid,
                                      const struct tfm_sst_token_t *s_token,
                                      const struct psa_sst_asset_attrs_t *attrs);
 
 /**
- * \brief Wipes secure storage system and all object data.
+ * \brief Begins a transaction. The object create, write and delete operations
+ *        performed until the transaction is committed or aborted are
+ *        committed to flash as a single atomic update.
+ *        A transaction only spans the objects of a single storage area.
+ *
+ * \param[in] area_id  Storage area ID
+ *
+ * \note The area must be locked by sst_system_batch_lock from the start of
+ *       the transaction until it is committed or aborted, and its objects
+ *       accessed with the sst_object_batch_* functions in between.
+ *
+ * \return Returns PSA_SST_ERR_SYSTEM_ERROR if the area is not locked by a
+ *         batch, or another error code specified in \ref psa_sst_err_t
+ */
+enum psa_sst_err_t sst_system_txn_begin(uint32_t area_id);
+
+/**
+ * \brief Commits the operations performed in the active transaction.
+ *
+ * \param[in] area_id  Storage area ID
+ *
+ * \return Returns PSA_SST_ERR_SYSTEM_ERROR if the area is not locked by a
+ *         batch, or another error code specified in \ref psa_sst_err_t
+ */
+enum psa_sst_err_t sst_system_txn_commit(uint32_t area_id);
+
+/**
+ * \brief Discards the operations performed in the active transaction.
+ *
+ * \param[in] area_id  Storage area ID
+ *
+ * \return Returns PSA_SST_ERR_SYSTEM_ERROR if the area is not locked by a
+ *         batch, or another error code specified in \ref psa_sst_err_t
+ */
+enum psa_sst_err_t sst_system_txn_abort(uint32_t area_id);
+
+/**
+ * \brief Gets the wear information of the flash blocks used by the secure
+ *        storage area.
+ *
+ * \param[in]  area_id  Storage area ID
+ * \param[out] info     Pointer to the wear information structure
+ *                      \ref psa_sst_wear_info_t
+ *
+ * \return Returns error code specified in \ref psa_sst_err_t
+ */
+enum psa_sst_err_t sst_system_get_wear_info(uint32_t area_id,
+                                            struct psa_sst_wear_info_t *info);
+
+/**
+ * \brief Gets the counters of the flash operations performed by the secure
+ *        storage system since boot.
+ *
+ * \param[out] stats  Pointer to the flash counters structure
+ *                    \ref tfm_sst_flash_stats_t
+ */
+void sst_system_get_flash_stats(struct tfm_sst_flash_stats_t *stats);
+
+/**
+ * \brief Gets the most recent entries of the flash operation trace.
+ *
+ * \param[out] entries      Pointer to store the entries, from the oldest to
+ *                          the most recent one
+ *                          \ref tfm_sst_flash_trace_t
+ * \param[in]  nbr_entries  Number of entries to get
+ *
+ * \return Returns error code specified in \ref psa_sst_err_t
+ */
+enum psa_sst_err_t sst_system_get_flash_trace(
+                                         struct tfm_sst_flash_trace_t *entries,
+                                         uint32_t nbr_entries);
+
+/**
+ * \brief Erases the flash blocks retired by the previous updates of a
+ *        storage area.
+ *
+ * \param[in] area_id  Storage area ID
+ *
+ * \return Returns error code specified in \ref psa_sst_err_t
+ */
+enum psa_sst_err_t sst_system_maintenance(uint32_t area_id);
+
+/**
+ * \brief Wipes a storage area and all its object data.
+ *
+ * \param[in] area_id  Storage area ID
  *
  * \return Returns error code specified in \ref sst_errno_t
  */
-enum psa_sst_err_t sst_system_wipe_all(void);
+enum psa_sst_err_t sst_system_wipe_all(uint32_t area_id);
 
 #ifdef __cplusplus
 }
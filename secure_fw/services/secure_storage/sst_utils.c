@@ -23,6 +23,32 @@ void sst_global_unlock(void)
     return;
 }
 
+void sst_area_lock(uint32_t area_id)
+{
+    /* FIXME: a system call to be added for acquiring the area's lock */
+    (void)area_id;
+    return;
+}
+
+void sst_area_unlock(uint32_t area_id)
+{
+    /* FIXME: a system call to be added for releasing the area's lock */
+    (void)area_id;
+    return;
+}
+
+void sst_kv_lock(void)
+{
+    /* FIXME: a system call to be added for acquiring the directory's lock */
+    return;
+}
+
+void sst_kv_unlock(void)
+{
+    /* FIXME: a system call to be added for releasing the directory's lock */
+    return;
+}
+
 enum psa_sst_err_t sst_utils_memory_bound_check(void *addr,
                                                 uint32_t size,
                                                 uint32_t app_id,
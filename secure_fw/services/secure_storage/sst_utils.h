@@ -41,6 +41,34 @@ void sst_global_lock(void);
  */
 void sst_global_unlock(void);
 
+/**
+ * \brief Acquires the lock of a storage area. This lock is used for
+ *        serializing the accesses to the area, while the accesses to the
+ *        other areas can proceed.
+ *
+ * \param[in] area_id  Storage area ID
+ */
+void sst_area_lock(uint32_t area_id);
+
+/**
+ * \brief Releases the lock of a storage area
+ *
+ * \param[in] area_id  Storage area ID
+ */
+void sst_area_unlock(uint32_t area_id);
+
+/**
+ * \brief Acquires the lock of the key/value directory. It is taken before the
+ *        lock of the storage area which stores the key/value objects, and
+ *        never while an area lock or the sst system lock is held.
+ */
+void sst_kv_lock(void);
+
+/**
+ * \brief Releases the lock of the key/value directory
+ */
+void sst_kv_unlock(void);
+
 /**
  * \brief Checks if the provided memory region is a valid address for
  *        the given application ID to read/write
@@ -14,6 +14,7 @@
 #include "test/suites/log/secure/log_s_tests.h"
 #include "test/suites/invert/secure/invert_s_tests.h"
 #include "secure_fw/services/secure_storage/sst_object_system.h"
+#include "secure_fw/services/secure_storage/flash/sst_flash.h"
 
 static struct test_suite_t test_suites[] = {
 #ifdef SERVICES_TEST_S
@@ -41,9 +42,13 @@ static void setup_integ_test(void)
 
 static void tear_down_integ_test(void)
 {
-    /* Leave the SST area clean after execute the tests */
-    sst_system_wipe_all();
-    sst_system_prepare();
+    uint32_t area_id;
+
+    /* Leave the SST areas clean after execute the tests */
+    for (area_id = 0; area_id < SST_NBR_OF_AREAS; area_id++) {
+        sst_system_wipe_all(area_id);
+        sst_system_prepare(area_id);
+    }
 }
 
 void start_integ_test(void)
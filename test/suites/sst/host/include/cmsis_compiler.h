@@ -0,0 +1,18 @@
+/*
+ * Copyright (c) 2018, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#ifndef __CMSIS_COMPILER_H__
+#define __CMSIS_COMPILER_H__
+
+/* Subset of the CMSIS compiler definitions used by the SST code, for the
+ * host compiler.
+ */
+#ifndef __STATIC_INLINE
+#define __STATIC_INLINE static inline
+#endif
+
+#endif /* __CMSIS_COMPILER_H__ */
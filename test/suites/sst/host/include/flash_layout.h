@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2018, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#ifndef __FLASH_LAYOUT_H__
+#define __FLASH_LAYOUT_H__
+
+/* Flash layout of the emulated flash device used by the SST host harness.
+ * The first SST area starts at the beginning of the emulated device. The sector
+ * size, the number of sectors in a block and the number of sectors can be
+ * overridden by the build. By default, the area has 5 blocks.
+ */
+#define SST_FLASH_AREA_ADDR     0x0
+
+#ifndef SST_SECTOR_SIZE
+#define SST_SECTOR_SIZE         0x1000   /* 4 KB */
+#endif
+
+#ifndef SST_SECTORS_PER_BLOCK
+#define SST_SECTORS_PER_BLOCK   1
+#endif
+
+#ifndef SST_NBR_OF_SECTORS
+#define SST_NBR_OF_SECTORS      (5 * SST_SECTORS_PER_BLOCK)
+#endif
+
+/* With SST_HOST_MULTI_AREA, a second storage area of
+ * SST_HOST_AREA1_NBR_OF_BLOCKS blocks follows the first one.
+ */
+#ifdef SST_HOST_MULTI_AREA
+#define SST_HOST_AREA1_NBR_OF_BLOCKS 4
+#define SST_NBR_OF_AREAS        2
+#define SST_FLASH_AREAS \
+    {SST_FLASH_AREA_ADDR, SST_FLASH_BLOCK_SIZE, SST_FLASH_NBR_OF_BLOCKS}, \
+    {(SST_FLASH_AREA_ADDR + (SST_SECTOR_SIZE * SST_NBR_OF_SECTORS)), \
+     SST_FLASH_BLOCK_SIZE, SST_HOST_AREA1_NBR_OF_BLOCKS}
+#define SST_HOST_FLASH_NBR_OF_SECTORS \
+    (SST_NBR_OF_SECTORS + \
+     (SST_HOST_AREA1_NBR_OF_BLOCKS * SST_SECTORS_PER_BLOCK))
+#else
+#define SST_HOST_FLASH_NBR_OF_SECTORS SST_NBR_OF_SECTORS
+#endif
+
+#ifndef SST_FLASH_PROGRAM_UNIT
+#define SST_FLASH_PROGRAM_UNIT  0x4
+#endif
+
+/* With SST_HOST_PROGRAM_PAGE_SIZE, a program operation of the emulated flash
+ * device can not cross a boundary of the program pages of that size.
+ */
+#ifdef SST_HOST_PROGRAM_PAGE_SIZE
+#define SST_FLASH_PROGRAM_PAGE_SIZE SST_HOST_PROGRAM_PAGE_SIZE
+#endif
+
+/* The emulated flash device can be read as memory-mapped flash */
+#ifdef SST_HOST_FLASH_MAPPED
+#include <stdint.h>
+extern uint8_t sst_host_flash_mem[];
+#define SST_FLASH_MAPPED_BASE   sst_host_flash_mem
+#endif
+
+/* Name of the emulated flash driver */
+#define FLASH_DEV_NAME Driver_FLASH0
+
+#endif /* __FLASH_LAYOUT_H__ */
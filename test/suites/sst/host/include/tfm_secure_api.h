@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) 2018, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#ifndef __TFM_SECURE_API_H__
+#define __TFM_SECURE_API_H__
+
+#include <stdint.h>
+
+/* Host replacement of the TF-M core secure API used by the SST service. The
+ * secure functions are called directly by the veneers, and the caller is
+ * considered to be secure or non-secure as set by
+ * tfm_host_set_secure_caller. The functions are implemented in
+ * tfm_host_platform.c.
+ */
+
+#define __tfm_secure_gateway_attributes__
+
+enum tfm_buffer_share_region_e {
+    TFM_BUFFER_SHARE_DISABLE,
+    TFM_BUFFER_SHARE_NS_CODE,
+    TFM_BUFFER_SHARE_SCRATCH,
+    TFM_BUFFER_SHARE_PRIV,
+    TFM_BUFFER_SHARE_DEFAULT,
+};
+
+enum tfm_memory_access_e {
+    TFM_MEMORY_ACCESS_RO = 1,
+    TFM_MEMORY_ACCESS_RW = 2,
+};
+
+extern int32_t tfm_core_validate_secure_caller(void);
+
+extern int32_t tfm_core_memory_permission_check(
+        void *ptr, uint32_t size, int32_t access);
+
+/**
+ * \brief Calls a secure function on behalf of a veneer.
+ *
+ * \param[in] id   Partition ID
+ * \param[in] fn   Secure function
+ * \param[in] a-d  Arguments of the secure function
+ *
+ * \return Returns the value returned by the secure function
+ */
+extern int32_t tfm_core_partition_request(uint32_t id, void *fn,
+                                          uintptr_t a, uintptr_t b,
+                                          uintptr_t c, uintptr_t d);
+
+#define TFM_CORE_SFN_REQUEST(id, fn, a, b, c, d) \
+        return tfm_core_partition_request(id, (void *)fn, (uintptr_t)a, \
+            (uintptr_t)b, (uintptr_t)c, (uintptr_t)d)
+
+#endif /* __TFM_SECURE_API_H__ */
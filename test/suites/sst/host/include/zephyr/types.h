@@ -0,0 +1,23 @@
+/*
+ * Copyright (c) 2018, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#ifndef __ZEPHYR_TYPES_H__
+#define __ZEPHYR_TYPES_H__
+
+/* Host replacement of the Zephyr integer types used by the JWT interface */
+#include <stdint.h>
+
+typedef int8_t   s8_t;
+typedef int16_t  s16_t;
+typedef int32_t  s32_t;
+typedef int64_t  s64_t;
+typedef uint8_t  u8_t;
+typedef uint16_t u16_t;
+typedef uint32_t u32_t;
+typedef uint64_t u64_t;
+
+#endif /* __ZEPHYR_TYPES_H__ */
@@ -0,0 +1,1004 @@
+/*
+ * Copyright (c) 2018, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+/* Host benchmark of the secure storage service. It runs a reproducible
+ * workload of create, read, write and delete operations, generated from a
+ * seed, through the non-secure interface (the SVC handlers called by the
+ * psa_sst_* functions) or the secure interface (sst_am_* functions), on top
+ * of the emulated flash device. It reports the throughput, the latency
+ * percentiles of each operation and the flash usage. The flash usage is
+ * deterministic for a given workload, so it can be compared with limits to
+ * gate regressions. The workload can also run on the keys of the key/value
+ * store, when it is built in. After the workload, the assets are listed and
+ * checked against the state of the workload.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "tfm_sst_defs.h"
+#include "tfm_sst_svc_handler.h"
+#include "sst_asset_management.h"
+#include "assets/sst_asset_defs.h"
+#include "sst_object_system.h"
+#include "flash/sst_flash.h"
+#include "sst_host_flash.h"
+#include "tfm_host_platform.h"
+#ifdef SST_KV
+#include "sst_kv.h"
+#endif
+
+/* Default parameters of the benchmark */
+#define SST_BENCH_DEFAULT_NBR_OPS    2000U
+#define SST_BENCH_DEFAULT_DATA_SIZE  64U
+
+/* Largest asset size defined by the policy database */
+#define SST_BENCH_MAX_DATA_SIZE      4096U
+
+/* Largest number of assets or keys used by the benchmark */
+#if defined(SST_KV) && (SST_KV_NBR_SLOTS > SST_NUM_ASSETS)
+#define SST_BENCH_MAX_ASSETS         SST_KV_NBR_SLOTS
+#else
+#define SST_BENCH_MAX_ASSETS         SST_NUM_ASSETS
+#endif
+
+/* Size of the buffer of a key name, including the null terminator */
+#define SST_BENCH_KEY_BUF_SIZE       16U
+
+/* Number of entries listed by each asset listing call of the inventory */
+#define SST_BENCH_LIST_BATCH         4U
+
+/* Policy database */
+extern struct sst_asset_policy_t asset_perms[];
+extern struct sst_asset_perm_t asset_perms_modes[];
+
+/* Benchmark operations */
+enum sst_bench_op_t {
+    SST_BENCH_OP_CREATE = 0,
+    SST_BENCH_OP_READ,
+    SST_BENCH_OP_WRITE,
+    SST_BENCH_OP_DELETE,
+    SST_BENCH_NBR_OPS,
+};
+
+/* Interface used to access the storage */
+enum sst_bench_if_t {
+    SST_BENCH_IF_NS = 0,
+    SST_BENCH_IF_S,
+    SST_BENCH_NBR_IFS,
+};
+
+/* Workload, as the percentage of each operation */
+struct sst_bench_workload_t {
+    const char *name;                    /*!< Name of the workload */
+    uint32_t mix[SST_BENCH_NBR_OPS];     /*!< Percentage of each operation */
+};
+
+/* Asset used by the benchmark */
+struct sst_bench_asset_t {
+    uint32_t uuid;     /*!< Asset UUID, or key index */
+    uint32_t app_id;   /*!< Application ID used by the non-secure interface */
+    uint32_t size;     /*!< Size of the data read and written */
+    uint32_t exists;   /*!< Whether the asset exists */
+    uint32_t written;  /*!< Whether the asset data has been written */
+};
+
+/* Options of the benchmark */
+struct sst_bench_options_t {
+    const struct sst_bench_workload_t *workload; /*!< Workload */
+    uint32_t nbr_ops;       /*!< Number of measured operations */
+    uint32_t nbr_assets;    /*!< Maximum number of assets */
+    uint32_t data_size;     /*!< Size of the data read and written */
+    uint32_t seed;          /*!< Seed of the workload */
+    uint32_t ifs;           /*!< Bitmap of the interfaces to benchmark */
+    uint32_t json;          /*!< Reports in JSON */
+    uint32_t kv;            /*!< Uses keys of the key/value store */
+    uint32_t async;         /*!< Completes the flash operations
+                             *   asynchronously
+                             */
+    uint64_t max_program_bytes; /*!< Limit of bytes programmed, or 0 */
+    uint64_t max_erases;    /*!< Limit of erases, or 0 */
+};
+
+/* Inventory of the assets, taken after the workload */
+struct sst_bench_inventory_t {
+    uint32_t nbr_assets;   /*!< Number of assets listed */
+    uint32_t list_calls;   /*!< Number of asset listing calls */
+    uint64_t list_ns;      /*!< Time taken by the asset listing calls */
+    uint32_t nbr_probes;   /*!< Number of assets found by probing each
+                            *   asset of the policy database with get_info
+                            */
+    uint64_t probe_ns;     /*!< Time taken by the get_info probes */
+};
+
+/* Load of the assets written, as done at boot, taken after the workload */
+struct sst_bench_load_t {
+    uint32_t nbr_assets;   /*!< Number of assets loaded */
+    uint64_t single_ns;    /*!< Time taken to read the assets one by one */
+    uint64_t multi_ns;     /*!< Time taken to read the assets in a batch */
+};
+
+/* Latencies of an operation, in nanoseconds */
+struct sst_bench_latency_t {
+    uint64_t *samples;   /*!< Latency of each operation */
+    uint32_t count;      /*!< Number of operations */
+};
+
+static const struct sst_bench_workload_t sst_bench_workloads[] = {
+    /* name       create read write delete */
+    { "mixed",    { 10,   40,  40,   10 } },
+    { "read",     {  2,   90,   6,    2 } },
+    { "write",    {  2,    6,  90,    2 } },
+    { "churn",    { 40,   10,  10,   40 } },
+};
+
+static const char * const sst_bench_op_names[SST_BENCH_NBR_OPS] = {
+    "create", "read", "write", "delete",
+};
+
+static const char * const sst_bench_if_names[SST_BENCH_NBR_IFS] = {
+    "ns", "s",
+};
+
+static struct tfm_sst_token_t sst_bench_token = { .token = NULL,
+                                                  .token_size = 0 };
+static struct sst_bench_options_t sst_bench_opts;
+static struct sst_bench_asset_t sst_bench_assets[SST_BENCH_MAX_ASSETS];
+static uint32_t sst_bench_nbr_assets;
+static struct sst_bench_latency_t sst_bench_lat[SST_BENCH_NBR_OPS];
+static struct sst_bench_inventory_t sst_bench_inv;
+static struct psa_sst_asset_list_entry_t sst_bench_list[SST_NUM_ASSETS];
+static struct sst_bench_load_t sst_bench_ld;
+static struct psa_sst_asset_io_t sst_bench_ios[SST_NUM_ASSETS];
+static uint8_t sst_bench_load_buf[SST_NUM_ASSETS][SST_BENCH_MAX_DATA_SIZE];
+static uint32_t sst_bench_rng_state;
+static uint8_t sst_bench_buf[SST_BENCH_MAX_DATA_SIZE];
+
+/**
+ * \brief Generates the next pseudo-random number of the workload.
+ *
+ * \return Returns a pseudo-random number
+ */
+static uint32_t sst_bench_rand(void)
+{
+    sst_bench_rng_state = (sst_bench_rng_state * 1103515245U) + 12345U;
+
+    return sst_bench_rng_state >> 8;
+}
+
+/**
+ * \brief Gets the current time.
+ *
+ * \return Returns the current time in nanoseconds
+ */
+static uint64_t sst_bench_now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return ((uint64_t)ts.tv_sec * 1000000000U) + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * \brief Selects the assets which can be used through both interfaces: an
+ *        application ID needs to have the read and write permissions on them.
+ */
+static void sst_bench_select_assets(void)
+{
+    const struct sst_asset_perm_t *perm;
+    uint32_t i;
+    uint32_t j;
+
+    sst_bench_nbr_assets = 0;
+    for (i = 0; (i < SST_NUM_ASSETS) &&
+                (sst_bench_nbr_assets < sst_bench_opts.nbr_assets); i++) {
+        for (j = 0; j < asset_perms[i].perms_count; j++) {
+            perm = &asset_perms_modes[asset_perms[i].perms_modes_start_idx + j];
+            if ((perm->perm & (SST_PERM_READ | SST_PERM_WRITE)) ==
+                (SST_PERM_READ | SST_PERM_WRITE)) {
+                break;
+            }
+        }
+
+        if (j == asset_perms[i].perms_count) {
+            continue;
+        }
+
+        sst_bench_assets[sst_bench_nbr_assets].uuid = asset_perms[i].asset_uuid;
+        sst_bench_assets[sst_bench_nbr_assets].app_id = perm->app;
+        sst_bench_assets[sst_bench_nbr_assets].size =
+                         (sst_bench_opts.data_size < asset_perms[i].max_size) ?
+                         sst_bench_opts.data_size : asset_perms[i].max_size;
+        sst_bench_nbr_assets++;
+    }
+}
+
+#ifdef SST_KV
+/**
+ * \brief Selects the keys of the key/value store used by the benchmark. They
+ *        are owned by two applications through the non-secure interface.
+ */
+static void sst_bench_select_keys(void)
+{
+    uint32_t i;
+
+    sst_bench_nbr_assets = 0;
+    for (i = 0; (i < SST_KV_NBR_SLOTS) && (i < sst_bench_opts.nbr_assets);
+         i++) {
+        sst_bench_assets[i].uuid = i;
+        sst_bench_assets[i].app_id = (i % 2) ? SST_APP_ID_1 : SST_APP_ID_0;
+        sst_bench_assets[i].size =
+                         (sst_bench_opts.data_size < SST_KV_MAX_VALUE_SIZE) ?
+                         sst_bench_opts.data_size : SST_KV_MAX_VALUE_SIZE;
+        sst_bench_nbr_assets++;
+    }
+}
+
+/**
+ * \brief Performs an operation on a key of the key/value store through an
+ *        interface. A create or a write sets the value of the key.
+ *
+ * \param[in] itf    Interface
+ * \param[in] op     Operation
+ * \param[in] asset  Key
+ * \param[in] buf    Data vector of the value
+ *
+ * \return Returns error code as specified in \ref psa_sst_err_t
+ */
+static enum psa_sst_err_t sst_bench_do_kv_op(enum sst_bench_if_t itf,
+                                          enum sst_bench_op_t op,
+                                          const struct sst_bench_asset_t *asset,
+                                          struct tfm_sst_buf_t *buf)
+{
+    char name[SST_BENCH_KEY_BUF_SIZE];
+    struct tfm_sst_buf_t key;
+
+    key.data = (uint8_t *)name;
+    key.size = (uint32_t)snprintf(name, sizeof(name), "bench.%u",
+                                  asset->uuid);
+    key.offset = 0;
+
+    if (itf == SST_BENCH_IF_NS) {
+        switch (op) {
+        case SST_BENCH_OP_CREATE:
+        case SST_BENCH_OP_WRITE:
+            return tfm_sst_svc_kv_set(&key, buf);
+        case SST_BENCH_OP_READ:
+            return tfm_sst_svc_kv_get(&key, buf);
+        case SST_BENCH_OP_DELETE:
+        default:
+            return tfm_sst_svc_kv_delete(&key);
+        }
+    }
+
+    switch (op) {
+    case SST_BENCH_OP_CREATE:
+    case SST_BENCH_OP_WRITE:
+        return sst_am_kv_set(S_APP_ID, &key, buf);
+    case SST_BENCH_OP_READ:
+        return sst_am_kv_get(S_APP_ID, &key, buf);
+    case SST_BENCH_OP_DELETE:
+    default:
+        return sst_am_kv_delete(S_APP_ID, &key);
+    }
+}
+#endif
+
+/**
+ * \brief Performs an operation on an asset through an interface.
+ *
+ * \param[in] itf    Interface
+ * \param[in] op     Operation
+ * \param[in] asset  Asset
+ *
+ * \return Returns error code as specified in \ref psa_sst_err_t
+ */
+static enum psa_sst_err_t sst_bench_do_op(enum sst_bench_if_t itf,
+                                          enum sst_bench_op_t op,
+                                          const struct sst_bench_asset_t *asset)
+{
+    struct tfm_sst_buf_t buf;
+
+    buf.data = sst_bench_buf;
+    buf.size = asset->size;
+    buf.offset = 0;
+
+    if (itf == SST_BENCH_IF_NS) {
+        /* The psa_sst_* functions pack their arguments and call these SVC
+         * handlers, with the caller's application ID set by the NS identity
+         * manager.
+         */
+        tfm_host_set_secure_caller(0);
+        tfm_host_set_ns_app_id(asset->app_id);
+    } else {
+        tfm_host_set_secure_caller(1);
+    }
+
+#ifdef SST_KV
+    if (sst_bench_opts.kv) {
+        return sst_bench_do_kv_op(itf, op, asset, &buf);
+    }
+#endif
+
+    if (itf == SST_BENCH_IF_NS) {
+        switch (op) {
+        case SST_BENCH_OP_CREATE:
+            return tfm_sst_svc_create(asset->uuid, &sst_bench_token);
+        case SST_BENCH_OP_READ:
+            return tfm_sst_svc_read(asset->uuid, &sst_bench_token, &buf);
+        case SST_BENCH_OP_WRITE:
+            return tfm_sst_svc_write(asset->uuid, &sst_bench_token, &buf);
+        case SST_BENCH_OP_DELETE:
+        default:
+            return tfm_sst_svc_delete(asset->uuid, &sst_bench_token);
+        }
+    }
+
+    switch (op) {
+    case SST_BENCH_OP_CREATE:
+        return sst_am_create(S_APP_ID, asset->uuid, &sst_bench_token);
+    case SST_BENCH_OP_READ:
+        return sst_am_read(S_APP_ID, asset->uuid, &sst_bench_token, &buf);
+    case SST_BENCH_OP_WRITE:
+        return sst_am_write(S_APP_ID, asset->uuid, &sst_bench_token, &buf);
+    case SST_BENCH_OP_DELETE:
+    default:
+        return sst_am_delete(S_APP_ID, asset->uuid, &sst_bench_token);
+    }
+}
+
+/**
+ * \brief Picks the next operation of the workload, and adapts it to the state
+ *        of the asset: an asset which does not exist is created, an asset
+ *        which exists is written instead of being created, and an asset
+ *        which has no data yet is written instead of being read.
+ *
+ * \param[in] asset  Asset of the operation
+ *
+ * \return Returns the operation
+ */
+static enum sst_bench_op_t sst_bench_next_op(
+                                         const struct sst_bench_asset_t *asset)
+{
+    const uint32_t *mix = sst_bench_opts.workload->mix;
+    uint32_t r = sst_bench_rand() % 100;
+    enum sst_bench_op_t op = SST_BENCH_OP_CREATE;
+
+    while ((op < SST_BENCH_OP_DELETE) && (r >= mix[op])) {
+        r -= mix[op];
+        op++;
+    }
+
+    if (!asset->exists) {
+        return SST_BENCH_OP_CREATE;
+    }
+
+    if ((op == SST_BENCH_OP_CREATE) ||
+        ((op == SST_BENCH_OP_READ) && !asset->written)) {
+        return SST_BENCH_OP_WRITE;
+    }
+
+    return op;
+}
+
+/**
+ * \brief Takes the inventory of the assets through the secure interface, by
+ *        listing them and by probing each asset of the policy database with
+ *        get_info, and checks it against the state of the workload.
+ *
+ * \return Returns 1 if the inventory matches the workload, 0 otherwise
+ */
+static uint32_t sst_bench_inventory(void)
+{
+    const struct sst_bench_asset_t *asset;
+    struct psa_sst_asset_info_t info;
+    enum psa_sst_err_t err;
+    uint32_t nbr_entries;
+    uint32_t nbr_existing = 0;
+    uint32_t cursor = 0;
+    uint64_t start;
+    uint32_t i;
+    uint32_t j;
+
+    sst_bench_inv.nbr_assets = 0;
+    sst_bench_inv.list_calls = 0;
+    sst_bench_inv.nbr_probes = 0;
+
+    tfm_host_set_secure_caller(1);
+
+    start = sst_bench_now_ns();
+    do {
+        nbr_entries = SST_NUM_ASSETS - sst_bench_inv.nbr_assets;
+        if (nbr_entries > SST_BENCH_LIST_BATCH) {
+            nbr_entries = SST_BENCH_LIST_BATCH;
+        } else if (nbr_entries == 0) {
+            break;
+        }
+
+        err = sst_am_list_assets(S_APP_ID, &cursor,
+                                 &sst_bench_list[sst_bench_inv.nbr_assets],
+                                 &nbr_entries);
+        sst_bench_inv.list_calls++;
+        if (err == PSA_SST_ERR_SUCCESS) {
+            sst_bench_inv.nbr_assets += nbr_entries;
+        }
+    } while (err == PSA_SST_ERR_SUCCESS);
+    sst_bench_inv.list_ns = sst_bench_now_ns() - start;
+
+    if ((err != PSA_SST_ERR_SUCCESS) && (err != PSA_SST_ERR_ASSET_NOT_FOUND)) {
+        printf("asset listing failed with error %d\r\n", err);
+        return 0;
+    }
+
+    start = sst_bench_now_ns();
+    for (i = 0; i < SST_NUM_ASSETS; i++) {
+        err = sst_am_get_info(S_APP_ID, asset_perms[i].asset_uuid,
+                              &sst_bench_token, &info);
+        if (err == PSA_SST_ERR_SUCCESS) {
+            sst_bench_inv.nbr_probes++;
+        }
+    }
+    sst_bench_inv.probe_ns = sst_bench_now_ns() - start;
+
+    /* The keys of the key/value store are not assets, so they are not
+     * listed.
+     */
+    if (!sst_bench_opts.kv) {
+        for (i = 0; i < sst_bench_nbr_assets; i++) {
+            asset = &sst_bench_assets[i];
+            if (!asset->exists) {
+                continue;
+            }
+            nbr_existing++;
+
+            for (j = 0; j < sst_bench_inv.nbr_assets; j++) {
+                if (sst_bench_list[j].uuid == asset->uuid) {
+                    break;
+                }
+            }
+
+            if ((j == sst_bench_inv.nbr_assets) ||
+                (sst_bench_list[j].size_current !=
+                                          (asset->written ? asset->size : 0))) {
+                printf("asset %u is not listed with its size\r\n",
+                       asset->uuid);
+                return 0;
+            }
+        }
+    }
+
+    if ((sst_bench_inv.nbr_assets != nbr_existing) ||
+        (sst_bench_inv.nbr_probes != nbr_existing)) {
+        printf("%u assets listed and %u assets probed, instead of %u\r\n",
+               sst_bench_inv.nbr_assets, sst_bench_inv.nbr_probes,
+               nbr_existing);
+        return 0;
+    }
+
+    return 1;
+}
+
+/**
+ * \brief Loads the assets written by the workload through the secure
+ *        interface, one by one and then in a single batch, and checks their
+ *        data.
+ *
+ * \return Returns 1 if the assets are loaded with their data, 0 otherwise
+ */
+static uint32_t sst_bench_load(void)
+{
+    const struct sst_bench_asset_t *asset;
+    struct psa_sst_asset_io_t *io;
+    struct tfm_sst_buf_t buf;
+    enum psa_sst_err_t err;
+    uint32_t nbr_ios;
+    uint64_t start;
+    uint32_t i;
+
+    sst_bench_ld.nbr_assets = 0;
+
+    /* The keys of the key/value store are not assets */
+    if (sst_bench_opts.kv) {
+        return 1;
+    }
+
+    for (i = 0; i < sst_bench_nbr_assets; i++) {
+        asset = &sst_bench_assets[i];
+        if (!asset->written) {
+            continue;
+        }
+
+        io = &sst_bench_ios[sst_bench_ld.nbr_assets];
+        io->uuid = asset->uuid;
+        io->token = sst_bench_token.token;
+        io->token_size = sst_bench_token.token_size;
+        io->size = asset->size;
+        io->offset = 0;
+        io->data = sst_bench_load_buf[sst_bench_ld.nbr_assets];
+        sst_bench_ld.nbr_assets++;
+    }
+
+    if (sst_bench_ld.nbr_assets == 0) {
+        return 1;
+    }
+
+    tfm_host_set_secure_caller(1);
+
+    start = sst_bench_now_ns();
+    for (i = 0; i < sst_bench_ld.nbr_assets; i++) {
+        buf.data = sst_bench_ios[i].data;
+        buf.size = sst_bench_ios[i].size;
+        buf.offset = 0;
+
+        err = sst_am_read(S_APP_ID, sst_bench_ios[i].uuid, &sst_bench_token,
+                          &buf);
+        if (err != PSA_SST_ERR_SUCCESS) {
+            printf("read of asset %u failed with error %d\r\n",
+                   sst_bench_ios[i].uuid, err);
+            return 0;
+        }
+    }
+    sst_bench_ld.single_ns = sst_bench_now_ns() - start;
+
+    /* Every write of the workload writes the start of the same buffer */
+    for (i = 0; i < sst_bench_ld.nbr_assets; i++) {
+        if (memcmp(sst_bench_ios[i].data, sst_bench_buf,
+                   sst_bench_ios[i].size) != 0) {
+            printf("asset %u read with wrong data\r\n",
+                   sst_bench_ios[i].uuid);
+            return 0;
+        }
+        memset(sst_bench_ios[i].data, 0, sst_bench_ios[i].size);
+    }
+
+    nbr_ios = sst_bench_ld.nbr_assets;
+    start = sst_bench_now_ns();
+    err = sst_am_read_multi(S_APP_ID, sst_bench_ios, &nbr_ios);
+    sst_bench_ld.multi_ns = sst_bench_now_ns() - start;
+
+    if ((err != PSA_SST_ERR_SUCCESS) || (nbr_ios != sst_bench_ld.nbr_assets)) {
+        printf("batched read failed with error %d after %u assets\r\n",
+               err, nbr_ios);
+        return 0;
+    }
+
+    for (i = 0; i < sst_bench_ld.nbr_assets; i++) {
+        if (memcmp(sst_bench_ios[i].data, sst_bench_buf,
+                   sst_bench_ios[i].size) != 0) {
+            printf("asset %u batch read with wrong data\r\n",
+                   sst_bench_ios[i].uuid);
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+static int sst_bench_cmp_u64(const void *a, const void *b)
+{
+    uint64_t va = *(const uint64_t *)a;
+    uint64_t vb = *(const uint64_t *)b;
+
+    return (va > vb) - (va < vb);
+}
+
+/**
+ * \brief Gets a percentile of sorted latencies.
+ *
+ * \param[in] lat  Sorted latencies
+ * \param[in] pct  Percentile
+ *
+ * \return Returns the latency in nanoseconds
+ */
+static uint64_t sst_bench_percentile(const struct sst_bench_latency_t *lat,
+                                     uint32_t pct)
+{
+    if (lat->count == 0) {
+        return 0;
+    }
+
+    return lat->samples[((uint64_t)(lat->count - 1) * pct) / 100];
+}
+
+/**
+ * \brief Reports the results of a benchmark run.
+ *
+ * \param[in] itf       Interface
+ * \param[in] total_ns  Time taken by the measured operations
+ * \param[in] before    Flash statistics before the measured operations
+ * \param[in] after     Flash statistics after the measured operations
+ * \param[in] cache     Read cache counters of the measured operations
+ */
+static void sst_bench_report(enum sst_bench_if_t itf, uint64_t total_ns,
+                             const struct sst_host_flash_stats_t *before,
+                             const struct sst_host_flash_stats_t *after,
+                             const struct tfm_sst_flash_stats_t *cache)
+{
+    const struct sst_bench_latency_t *lat;
+    double ops_per_s = 0;
+    uint32_t op;
+
+    if (total_ns != 0) {
+        ops_per_s = ((double)sst_bench_opts.nbr_ops * 1e9) / (double)total_ns;
+    }
+
+    if (sst_bench_opts.json) {
+        printf("{\"interface\": \"%s\", \"workload\": \"%s\", \"ops\": %u, "
+               "\"kv\": %u, \"assets\": %u, \"data_size\": %u, "
+               "\"seed\": %u, "
+               "\"async\": %u, \"ops_per_s\": %.0f, \"host_us\": %llu, "
+               "\"flash_est_us\": %llu, \"read_bytes\": %llu, "
+               "\"program_bytes\": %llu, \"programs\": %u, \"erases\": %u, "
+               "\"cache_hits\": %u, \"cache_misses\": %u, "
+               "\"inventory\": {\"assets\": %u, \"list_calls\": %u, "
+               "\"list_ns\": %llu, \"probes\": %u, \"probe_ns\": %llu}, "
+               "\"load\": {\"assets\": %u, \"single_ns\": %llu, "
+               "\"multi_ns\": %llu}, "
+               "\"latency_ns\": {",
+               sst_bench_if_names[itf], sst_bench_opts.workload->name,
+               sst_bench_opts.nbr_ops, sst_bench_opts.kv, sst_bench_nbr_assets,
+               sst_bench_opts.data_size, sst_bench_opts.seed,
+               sst_bench_opts.async, ops_per_s,
+               (unsigned long long)(total_ns / 1000),
+               (unsigned long long)sst_host_flash_estimate_us(before, after),
+               (unsigned long long)(after->read_bytes - before->read_bytes),
+               (unsigned long long)(after->program_bytes -
+                                    before->program_bytes),
+               after->programs - before->programs,
+               after->erases - before->erases, cache->cache_hits,
+               cache->cache_misses, sst_bench_inv.nbr_assets,
+               sst_bench_inv.list_calls,
+               (unsigned long long)sst_bench_inv.list_ns,
+               (uint32_t)SST_NUM_ASSETS,
+               (unsigned long long)sst_bench_inv.probe_ns,
+               sst_bench_ld.nbr_assets,
+               (unsigned long long)sst_bench_ld.single_ns,
+               (unsigned long long)sst_bench_ld.multi_ns);
+        for (op = 0; op < SST_BENCH_NBR_OPS; op++) {
+            lat = &sst_bench_lat[op];
+            printf("%s\"%s\": {\"count\": %u, \"p50\": %llu, \"p99\": %llu}",
+                   (op == 0) ? "" : ", ", sst_bench_op_names[op], lat->count,
+                   (unsigned long long)sst_bench_percentile(lat, 50),
+                   (unsigned long long)sst_bench_percentile(lat, 99));
+        }
+        printf("}}\r\n");
+        return;
+    }
+
+    printf("interface %s, workload %s: %u ops on %u %s of %u bytes, "
+           "seed %u%s\r\n", sst_bench_if_names[itf],
+           sst_bench_opts.workload->name, sst_bench_opts.nbr_ops,
+           sst_bench_nbr_assets, sst_bench_opts.kv ? "keys" : "assets",
+           sst_bench_opts.data_size,
+           sst_bench_opts.seed,
+           sst_bench_opts.async ? ", asynchronous flash" : "");
+    printf("  throughput: %.0f ops/s (host %llu us, estimated flash %llu us)"
+           "\r\n", ops_per_s, (unsigned long long)(total_ns / 1000),
+           (unsigned long long)sst_host_flash_estimate_us(before, after));
+    printf("  flash: %llu bytes read, %llu bytes programmed in %u programs, "
+           "%u erases\r\n",
+           (unsigned long long)(after->read_bytes - before->read_bytes),
+           (unsigned long long)(after->program_bytes - before->program_bytes),
+           after->programs - before->programs,
+           after->erases - before->erases);
+    if (cache->cache_size != 0) {
+        printf("  read cache: %u pages, %u hits, %u misses\r\n",
+               cache->cache_size, cache->cache_hits, cache->cache_misses);
+    }
+    printf("  inventory: %u assets listed in %u calls (%llu ns), "
+           "%u get_info probes (%llu ns)\r\n", sst_bench_inv.nbr_assets,
+           sst_bench_inv.list_calls, (unsigned long long)sst_bench_inv.list_ns,
+           (uint32_t)SST_NUM_ASSETS,
+           (unsigned long long)sst_bench_inv.probe_ns);
+    if (sst_bench_ld.nbr_assets != 0) {
+        printf("  load: %u assets read one by one (%llu ns), in a batch "
+               "(%llu ns)\r\n", sst_bench_ld.nbr_assets,
+               (unsigned long long)sst_bench_ld.single_ns,
+               (unsigned long long)sst_bench_ld.multi_ns);
+    }
+    for (op = 0; op < SST_BENCH_NBR_OPS; op++) {
+        lat = &sst_bench_lat[op];
+        printf("  %-6s: %6u ops, p50 %8llu ns, p99 %8llu ns\r\n",
+               sst_bench_op_names[op], lat->count,
+               (unsigned long long)sst_bench_percentile(lat, 50),
+               (unsigned long long)sst_bench_percentile(lat, 99));
+    }
+}
+
+/**
+ * \brief Runs the benchmark through an interface, on a freshly formatted
+ *        storage.
+ *
+ * \param[in] itf  Interface
+ *
+ * \return Returns 1 if the benchmark passes, 0 otherwise
+ */
+static uint32_t sst_bench_run(enum sst_bench_if_t itf)
+{
+    struct sst_host_flash_stats_t before;
+    struct sst_host_flash_stats_t after;
+    struct tfm_sst_flash_stats_t sst_before;
+    struct tfm_sst_flash_stats_t sst_after;
+    struct sst_bench_asset_t *asset;
+    enum sst_bench_op_t op;
+    enum psa_sst_err_t err;
+    uint64_t total_ns = 0;
+    uint64_t start;
+    uint64_t elapsed;
+    uint32_t area_id;
+    uint32_t i;
+
+    sst_bench_rng_state = sst_bench_opts.seed;
+    for (i = 0; i < SST_BENCH_MAX_DATA_SIZE; i++) {
+        sst_bench_buf[i] = (uint8_t)sst_bench_rand();
+    }
+
+    sst_host_flash_init();
+    sst_host_flash_set_async(sst_bench_opts.async);
+    for (area_id = 0; area_id < SST_NBR_OF_AREAS; area_id++) {
+        if (sst_system_wipe_all(area_id) != PSA_SST_ERR_SUCCESS) {
+            printf("unable to format the storage area %u\r\n", area_id);
+            return 0;
+        }
+    }
+
+    if (sst_am_prepare() != PSA_SST_ERR_SUCCESS) {
+        printf("unable to format the storage\r\n");
+        return 0;
+    }
+
+    /* Preload the assets, so that the workload starts in a steady state */
+    for (i = 0; i < sst_bench_nbr_assets; i++) {
+        asset = &sst_bench_assets[i];
+        if ((sst_bench_do_op(itf, SST_BENCH_OP_CREATE, asset) !=
+                                                      PSA_SST_ERR_SUCCESS) ||
+            (sst_bench_do_op(itf, SST_BENCH_OP_WRITE, asset) !=
+                                                      PSA_SST_ERR_SUCCESS)) {
+            printf("unable to preload %s %u\r\n",
+                   sst_bench_opts.kv ? "key" : "asset", asset->uuid);
+            return 0;
+        }
+        asset->exists = 1;
+        asset->written = 1;
+    }
+
+    for (i = 0; i < SST_BENCH_NBR_OPS; i++) {
+        sst_bench_lat[i].count = 0;
+    }
+
+    sst_host_flash_get_stats(&before);
+    sst_flash_get_stats(&sst_before);
+
+    for (i = 0; i < sst_bench_opts.nbr_ops; i++) {
+        asset = &sst_bench_assets[sst_bench_rand() % sst_bench_nbr_assets];
+        op = sst_bench_next_op(asset);
+
+        start = sst_bench_now_ns();
+        err = sst_bench_do_op(itf, op, asset);
+        elapsed = sst_bench_now_ns() - start;
+
+        if (err != PSA_SST_ERR_SUCCESS) {
+            printf("%s op %u on asset %u failed with error %d\r\n",
+                   sst_bench_op_names[op], i, asset->uuid, err);
+            return 0;
+        }
+
+        if (op == SST_BENCH_OP_CREATE) {
+            asset->exists = 1;
+        } else if (op == SST_BENCH_OP_WRITE) {
+            asset->written = 1;
+        } else if (op == SST_BENCH_OP_DELETE) {
+            asset->exists = 0;
+            asset->written = 0;
+        }
+
+        total_ns += elapsed;
+        sst_bench_lat[op].samples[sst_bench_lat[op].count++] = elapsed;
+    }
+
+    /* The flash operations still queued are accounted to the run */
+    for (area_id = 0; area_id < SST_NBR_OF_AREAS; area_id++) {
+        if (sst_flash_flush(area_id) != PSA_SST_ERR_SUCCESS) {
+            printf("flash operations failed\r\n");
+            return 0;
+        }
+    }
+    sst_host_flash_get_stats(&after);
+
+    for (i = 0; i < SST_BENCH_NBR_OPS; i++) {
+        qsort(sst_bench_lat[i].samples, sst_bench_lat[i].count,
+              sizeof(uint64_t), sst_bench_cmp_u64);
+    }
+
+    sst_flash_get_stats(&sst_after);
+    sst_after.cache_hits -= sst_before.cache_hits;
+    sst_after.cache_misses -= sst_before.cache_misses;
+
+    if (!sst_bench_inventory() || !sst_bench_load()) {
+        return 0;
+    }
+
+    sst_bench_report(itf, total_ns, &before, &after, &sst_after);
+
+    if ((sst_bench_opts.max_program_bytes != 0) &&
+        ((after.program_bytes - before.program_bytes) >
+                                          sst_bench_opts.max_program_bytes)) {
+        printf("programmed bytes above the limit of %llu\r\n",
+               (unsigned long long)sst_bench_opts.max_program_bytes);
+        return 0;
+    }
+
+    if ((sst_bench_opts.max_erases != 0) &&
+        ((after.erases - before.erases) > sst_bench_opts.max_erases)) {
+        printf("erases above the limit of %llu\r\n",
+               (unsigned long long)sst_bench_opts.max_erases);
+        return 0;
+    }
+
+    return 1;
+}
+
+/**
+ * \brief Prints the usage of the benchmark.
+ *
+ * \param[in] name  Name of the executable
+ */
+static void sst_bench_usage(const char *name)
+{
+    printf("usage: %s [-i ns|s|all] [-w mixed|read|write|churn] [-n nbr_ops]"
+           "\r\n       [-a nbr_assets] [-z data_size] [-s seed] [-j] [-A]"
+           " [-k]\r\n       [-P max_program_bytes] [-E max_erases]\r\n",
+           name);
+}
+
+/**
+ * \brief Parses the command line options.
+ *
+ * \param[in] argc  Number of arguments
+ * \param[in] argv  Arguments
+ *
+ * \return Returns 1 if the options are valid, 0 otherwise
+ */
+static uint32_t sst_bench_parse_options(int argc, char *argv[])
+{
+    const char *arg;
+    uint32_t i;
+    int n;
+
+    sst_bench_opts.workload = &sst_bench_workloads[0];
+    sst_bench_opts.nbr_ops = SST_BENCH_DEFAULT_NBR_OPS;
+    sst_bench_opts.nbr_assets = SST_NUM_ASSETS;
+    sst_bench_opts.data_size = SST_BENCH_DEFAULT_DATA_SIZE;
+    sst_bench_opts.seed = 1;
+    sst_bench_opts.ifs = (1U << SST_BENCH_IF_NS) | (1U << SST_BENCH_IF_S);
+
+    for (n = 1; n < argc; n++) {
+        if (strcmp(argv[n], "-j") == 0) {
+            sst_bench_opts.json = 1;
+            continue;
+        }
+
+        if (strcmp(argv[n], "-A") == 0) {
+            sst_bench_opts.async = 1;
+            continue;
+        }
+
+#ifdef SST_KV
+        if (strcmp(argv[n], "-k") == 0) {
+            sst_bench_opts.kv = 1;
+            continue;
+        }
+#endif
+
+        if ((argv[n][0] != '-') || (n + 1 >= argc)) {
+            return 0;
+        }
+        arg = argv[++n];
+
+        switch (argv[n - 1][1]) {
+        case 'i':
+            if (strcmp(arg, "ns") == 0) {
+                sst_bench_opts.ifs = (1U << SST_BENCH_IF_NS);
+            } else if (strcmp(arg, "s") == 0) {
+                sst_bench_opts.ifs = (1U << SST_BENCH_IF_S);
+            } else if (strcmp(arg, "all") != 0) {
+                return 0;
+            }
+            break;
+        case 'w':
+            for (i = 0; i < (sizeof(sst_bench_workloads) /
+                             sizeof(sst_bench_workloads[0])); i++) {
+                if (strcmp(arg, sst_bench_workloads[i].name) == 0) {
+                    sst_bench_opts.workload = &sst_bench_workloads[i];
+                    break;
+                }
+            }
+            if (i == (sizeof(sst_bench_workloads) /
+                      sizeof(sst_bench_workloads[0]))) {
+                return 0;
+            }
+            break;
+        case 'n':
+            sst_bench_opts.nbr_ops = (uint32_t)strtoul(arg, NULL, 0);
+            break;
+        case 'a':
+            sst_bench_opts.nbr_assets = (uint32_t)strtoul(arg, NULL, 0);
+            break;
+        case 'z':
+            sst_bench_opts.data_size = (uint32_t)strtoul(arg, NULL, 0);
+            break;
+        case 's':
+            sst_bench_opts.seed = (uint32_t)strtoul(arg, NULL, 0);
+            break;
+        case 'P':
+            sst_bench_opts.max_program_bytes = strtoull(arg, NULL, 0);
+            break;
+        case 'E':
+            sst_bench_opts.max_erases = strtoull(arg, NULL, 0);
+            break;
+        default:
+            return 0;
+        }
+    }
+
+    if ((sst_bench_opts.data_size == 0) ||
+        (sst_bench_opts.data_size > SST_BENCH_MAX_DATA_SIZE)) {
+        return 0;
+    }
+
+    return 1;
+}
+
+int main(int argc, char *argv[])
+{
+    uint32_t itf;
+    uint32_t i;
+
+    if (!sst_bench_parse_options(argc, argv)) {
+        sst_bench_usage(argv[0]);
+        return 2;
+    }
+
+#ifdef SST_KV
+    if (sst_bench_opts.kv) {
+        sst_bench_select_keys();
+    } else {
+        sst_bench_select_assets();
+    }
+#else
+    sst_bench_select_assets();
+#endif
+    if (sst_bench_nbr_assets == 0) {
+        printf("no asset can be used by the benchmark\r\n");
+        return 2;
+    }
+
+    for (i = 0; i < SST_BENCH_NBR_OPS; i++) {
+        sst_bench_lat[i].samples = malloc(sst_bench_opts.nbr_ops *
+                                          sizeof(uint64_t));
+        if (sst_bench_lat[i].samples == NULL) {
+            printf("out of memory\r\n");
+            return 2;
+        }
+    }
+
+    for (itf = 0; itf < SST_BENCH_NBR_IFS; itf++) {
+        if ((sst_bench_opts.ifs & (1U << itf)) == 0) {
+            continue;
+        }
+
+        if (!sst_bench_run((enum sst_bench_if_t)itf)) {
+            printf("FAILED: interface %s\r\n", sst_bench_if_names[itf]);
+            return 1;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,402 @@
+/*
+ * Copyright (c) 2018, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#include "sst_host_flash.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "Driver_Flash.h"
+
+/* Emulated NOR flash device with ECC. A program unit can only be programmed
+ * once after its sector is erased, even with the same value or to clear more
+ * bits, as its ECC bits would be programmed again. Programming a unit which is
+ * not erased is reported as a fatal error.
+ *
+ * In asynchronous mode, the device stays busy after a program or erase
+ * operation until its status is polled, which signals the completion of the
+ * operation to the event handler. Accessing the device while it is busy is
+ * rejected, as a real device would. The data of a program operation is only
+ * read from the caller's buffer when the operation completes, so a buffer
+ * which is released before the completion programs corrupted data.
+ */
+
+#ifndef ARG_UNUSED
+#define ARG_UNUSED(arg)  ((void)arg)
+#endif
+
+#define SST_HOST_FLASH_ERASED_VAL 0xFF
+
+/* Driver version */
+#define ARM_FLASH_DRV_VERSION    ARM_DRIVER_VERSION_MAJOR_MINOR(1, 0)
+
+static const ARM_DRIVER_VERSION DriverVersion = {
+    ARM_FLASH_API_VERSION,
+    ARM_FLASH_DRV_VERSION
+};
+
+static ARM_FLASH_CAPABILITIES DriverCapabilities = {
+    0, /* event_ready */
+    2, /* data_width = 0:8-bit, 1:16-bit, 2:32-bit */
+    1, /* erase_chip */
+    0  /* reserved */
+};
+
+static ARM_FLASH_INFO FlashInfo = {
+    .sector_info  = NULL,                  /* Uniform sector layout */
+    .sector_count = SST_HOST_FLASH_NBR_OF_SECTORS,
+    .sector_size  = SST_SECTOR_SIZE,
+#ifdef SST_FLASH_PROGRAM_PAGE_SIZE
+    .page_size    = SST_FLASH_PROGRAM_PAGE_SIZE,
+#else
+    .page_size    = SST_SECTOR_SIZE,
+#endif
+    .program_unit = SST_FLASH_PROGRAM_UNIT,
+    .erased_value = SST_HOST_FLASH_ERASED_VAL
+};
+
+static ARM_FLASH_STATUS FlashStatus = {0, 0, 0};
+
+/* Content of the emulated flash, which is also read directly when the flash
+ * is used as memory-mapped flash
+ */
+uint8_t sst_host_flash_mem[SST_HOST_FLASH_SIZE];
+static struct sst_host_flash_stats_t sst_host_flash_stats;
+static int32_t sst_host_flash_ops_to_cut = SST_HOST_FLASH_NO_POWER_CUT;
+static uint32_t sst_host_flash_cut;
+static ARM_Flash_SignalEvent_t sst_host_flash_cb_event;
+
+/* Program operation in progress in asynchronous mode */
+static uint32_t sst_host_flash_prog_addr;
+static const uint8_t *sst_host_flash_prog_data;
+static uint32_t sst_host_flash_prog_cnt;
+
+/**
+ * \brief Checks if the power is cut before a program or erase operation.
+ *
+ * \return Returns 1 if the operation must not be performed, 0 otherwise
+ */
+static uint32_t sst_host_flash_check_power(void)
+{
+    if (sst_host_flash_ops_to_cut == 0) {
+        sst_host_flash_ops_to_cut = SST_HOST_FLASH_NO_POWER_CUT;
+        sst_host_flash_cut = 1;
+    }
+
+    if (sst_host_flash_cut) {
+        return 1;
+    }
+
+    if (sst_host_flash_ops_to_cut > 0) {
+        sst_host_flash_ops_to_cut--;
+    }
+
+    return 0;
+}
+
+/**
+ * \brief Starts a program or erase operation in asynchronous mode.
+ *
+ * \param[in] failed  Set if the operation fails
+ */
+static void sst_host_flash_start(uint32_t failed)
+{
+    FlashStatus.busy = 1;
+    FlashStatus.error = failed;
+    sst_host_flash_stats.async_ops++;
+}
+
+/**
+ * \brief Programs data in the emulated flash.
+ *
+ * \param[in] addr    Flash address
+ * \param[in] p_data  Data to program
+ * \param[in] cnt     Number of bytes to program
+ */
+static void sst_host_flash_program(uint32_t addr, const uint8_t *p_data,
+                                   uint32_t cnt)
+{
+    uint32_t i;
+
+    for (i = 0; i < cnt; i++) {
+        if (sst_host_flash_mem[addr + i] != SST_HOST_FLASH_ERASED_VAL) {
+            printf("ECC flash violation: programming 0x%02x over 0x%02x at "
+                   "address 0x%x\r\n", p_data[i],
+                   sst_host_flash_mem[addr + i], (unsigned int)(addr + i));
+            abort();
+        }
+        sst_host_flash_mem[addr + i] = p_data[i];
+    }
+}
+
+static int32_t is_range_valid(uint32_t addr, uint32_t cnt)
+{
+    if (addr > SST_HOST_FLASH_SIZE || cnt > (SST_HOST_FLASH_SIZE - addr)) {
+        return -1;
+    }
+
+    return 0;
+}
+
+static ARM_DRIVER_VERSION ARM_Flash_GetVersion(void)
+{
+    return DriverVersion;
+}
+
+static ARM_FLASH_CAPABILITIES ARM_Flash_GetCapabilities(void)
+{
+    return DriverCapabilities;
+}
+
+static int32_t ARM_Flash_Initialize(ARM_Flash_SignalEvent_t cb_event)
+{
+    sst_host_flash_cb_event = cb_event;
+    return ARM_DRIVER_OK;
+}
+
+static int32_t ARM_Flash_Uninitialize(void)
+{
+    /* Nothing to be done */
+    return ARM_DRIVER_OK;
+}
+
+static int32_t ARM_Flash_PowerControl(ARM_POWER_STATE state)
+{
+    switch (state) {
+    case ARM_POWER_FULL:
+        /* Nothing to be done */
+        return ARM_DRIVER_OK;
+
+    case ARM_POWER_OFF:
+    case ARM_POWER_LOW:
+    default:
+        return ARM_DRIVER_ERROR_UNSUPPORTED;
+    }
+}
+
+static int32_t ARM_Flash_ReadData(uint32_t addr, void *data, uint32_t cnt)
+{
+    if (FlashStatus.busy) {
+        return ARM_DRIVER_ERROR_BUSY;
+    }
+
+    if (is_range_valid(addr, cnt) != 0) {
+        return ARM_DRIVER_ERROR_PARAMETER;
+    }
+
+    sst_host_flash_stats.reads++;
+    sst_host_flash_stats.read_bytes += cnt;
+
+    memcpy(data, &sst_host_flash_mem[addr], cnt);
+    return ARM_DRIVER_OK;
+}
+
+static int32_t ARM_Flash_ProgramData(uint32_t addr, const void *data,
+                                     uint32_t cnt)
+{
+    if (FlashStatus.busy) {
+        return ARM_DRIVER_ERROR_BUSY;
+    }
+
+    /* Check flash memory boundaries and alignment with minimal write size */
+    if (is_range_valid(addr, cnt) != 0
+        || (addr % SST_FLASH_PROGRAM_UNIT) != 0
+        || (cnt % SST_FLASH_PROGRAM_UNIT) != 0) {
+        return ARM_DRIVER_ERROR_PARAMETER;
+    }
+
+#ifdef SST_FLASH_PROGRAM_PAGE_SIZE
+    /* A program operation can not cross a program page boundary */
+    if (cnt > (SST_FLASH_PROGRAM_PAGE_SIZE -
+               (addr % SST_FLASH_PROGRAM_PAGE_SIZE))) {
+        return ARM_DRIVER_ERROR_PARAMETER;
+    }
+#endif
+
+    /* In asynchronous mode, the power cut is reported by the completion */
+    if (sst_host_flash_check_power()) {
+        if (DriverCapabilities.event_ready) {
+            sst_host_flash_start(1);
+            return ARM_DRIVER_OK;
+        }
+        return ARM_DRIVER_ERROR;
+    }
+
+    sst_host_flash_stats.programs++;
+    sst_host_flash_stats.program_bytes += cnt;
+
+    if (DriverCapabilities.event_ready) {
+        /* The data is programmed when the operation completes */
+        sst_host_flash_start(0);
+        sst_host_flash_prog_addr = addr;
+        sst_host_flash_prog_data = data;
+        sst_host_flash_prog_cnt = cnt;
+        return ARM_DRIVER_OK;
+    }
+
+    sst_host_flash_program(addr, data, cnt);
+
+    return ARM_DRIVER_OK;
+}
+
+static int32_t ARM_Flash_EraseSector(uint32_t addr)
+{
+    if (FlashStatus.busy) {
+        return ARM_DRIVER_ERROR_BUSY;
+    }
+
+    if (is_range_valid(addr, SST_SECTOR_SIZE) != 0
+        || (addr % SST_SECTOR_SIZE) != 0) {
+        return ARM_DRIVER_ERROR_PARAMETER;
+    }
+
+    if (sst_host_flash_check_power()) {
+        if (DriverCapabilities.event_ready) {
+            sst_host_flash_start(1);
+            return ARM_DRIVER_OK;
+        }
+        return ARM_DRIVER_ERROR;
+    }
+
+    if (DriverCapabilities.event_ready) {
+        sst_host_flash_start(0);
+    }
+
+    sst_host_flash_stats.erases++;
+    sst_host_flash_stats.sector_erases[addr / SST_SECTOR_SIZE]++;
+
+    memset(&sst_host_flash_mem[addr], SST_HOST_FLASH_ERASED_VAL,
+           SST_SECTOR_SIZE);
+    return ARM_DRIVER_OK;
+}
+
+static ARM_FLASH_STATUS ARM_Flash_GetStatus(void);
+
+static int32_t ARM_Flash_EraseChip(void)
+{
+    uint32_t addr;
+    int32_t err;
+
+    for (addr = 0; addr < SST_HOST_FLASH_SIZE; addr += SST_SECTOR_SIZE) {
+        while (FlashStatus.busy) {
+            (void)ARM_Flash_GetStatus();
+        }
+        err = ARM_Flash_EraseSector(addr);
+        if (err != ARM_DRIVER_OK) {
+            return err;
+        }
+    }
+
+    return ARM_DRIVER_OK;
+}
+
+static ARM_FLASH_STATUS ARM_Flash_GetStatus(void)
+{
+    ARM_FLASH_STATUS status = FlashStatus;
+
+    /* The operation in progress completes when the status is polled */
+    if (FlashStatus.busy) {
+        if (sst_host_flash_prog_data != NULL) {
+            sst_host_flash_program(sst_host_flash_prog_addr,
+                                   sst_host_flash_prog_data,
+                                   sst_host_flash_prog_cnt);
+            sst_host_flash_prog_data = NULL;
+        }
+        FlashStatus.busy = 0;
+        if (sst_host_flash_cb_event != NULL) {
+            sst_host_flash_cb_event(FlashStatus.error ?
+                                    ARM_FLASH_EVENT_ERROR :
+                                    ARM_FLASH_EVENT_READY);
+        }
+    }
+
+    return status;
+}
+
+static ARM_FLASH_INFO * ARM_Flash_GetInfo(void)
+{
+    return &FlashInfo;
+}
+
+ARM_DRIVER_FLASH FLASH_DEV_NAME = {
+    ARM_Flash_GetVersion,
+    ARM_Flash_GetCapabilities,
+    ARM_Flash_Initialize,
+    ARM_Flash_Uninitialize,
+    ARM_Flash_PowerControl,
+    ARM_Flash_ReadData,
+    ARM_Flash_ProgramData,
+    ARM_Flash_EraseSector,
+    ARM_Flash_EraseChip,
+    ARM_Flash_GetStatus,
+    ARM_Flash_GetInfo
+};
+
+void sst_host_flash_init(void)
+{
+    memset(sst_host_flash_mem, SST_HOST_FLASH_ERASED_VAL,
+           sizeof(sst_host_flash_mem));
+    memset(&sst_host_flash_stats, 0, sizeof(sst_host_flash_stats));
+    FlashStatus.busy = 0;
+    FlashStatus.error = 0;
+    sst_host_flash_prog_data = NULL;
+    sst_host_flash_power_restore();
+}
+
+void sst_host_flash_set_async(uint32_t enable)
+{
+    DriverCapabilities.event_ready = (enable != 0);
+}
+
+void sst_host_flash_get_stats(struct sst_host_flash_stats_t *stats)
+{
+    *stats = sst_host_flash_stats;
+}
+
+uint64_t sst_host_flash_estimate_us(
+                                   const struct sst_host_flash_stats_t *before,
+                                   const struct sst_host_flash_stats_t *after)
+{
+    uint64_t time_us;
+
+    time_us = ((after->read_bytes - before->read_bytes)
+               * SST_HOST_FLASH_READ_US_PER_KB) / 1024;
+    time_us += ((after->program_bytes - before->program_bytes)
+                * SST_HOST_FLASH_PROGRAM_US_PER_KB) / 1024;
+    time_us += (uint64_t)(after->erases - before->erases)
+               * SST_HOST_FLASH_ERASE_US;
+
+    return time_us;
+}
+
+void sst_host_flash_set_power_cut(int32_t nbr_ops)
+{
+    sst_host_flash_ops_to_cut = nbr_ops;
+    sst_host_flash_cut = 0;
+}
+
+uint32_t sst_host_flash_power_is_cut(void)
+{
+    return sst_host_flash_cut;
+}
+
+void sst_host_flash_power_restore(void)
+{
+    sst_host_flash_set_power_cut(SST_HOST_FLASH_NO_POWER_CUT);
+}
+
+void sst_host_flash_save(uint8_t *buf)
+{
+    memcpy(buf, sst_host_flash_mem, SST_HOST_FLASH_SIZE);
+}
+
+void sst_host_flash_restore(const uint8_t *buf)
+{
+    /* The operation in progress completes before the content is replaced */
+    (void)ARM_Flash_GetStatus();
+    memcpy(sst_host_flash_mem, buf, SST_HOST_FLASH_SIZE);
+}
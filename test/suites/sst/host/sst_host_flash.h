@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) 2018, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#ifndef __SST_HOST_FLASH_H__
+#define __SST_HOST_FLASH_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include "flash_layout.h"
+
+/* Size of the emulated flash device */
+#define SST_HOST_FLASH_SIZE (SST_SECTOR_SIZE * SST_HOST_FLASH_NBR_OF_SECTORS)
+
+/* Value to pass to sst_host_flash_set_power_cut to disable the power cut */
+#define SST_HOST_FLASH_NO_POWER_CUT (-1)
+
+/* Estimated duration of the flash operations, in microseconds, used to
+ * estimate the time taken by a sequence of operations on a typical embedded
+ * NOR flash. The time taken by the host is not representative of it.
+ */
+#define SST_HOST_FLASH_READ_US_PER_KB     10U
+#define SST_HOST_FLASH_PROGRAM_US_PER_KB  2000U
+#define SST_HOST_FLASH_ERASE_US           20000U
+
+/* Statistics of the operations performed on the emulated flash device */
+struct sst_host_flash_stats_t {
+    uint32_t reads;          /*!< Number of read operations */
+    uint32_t programs;       /*!< Number of program operations */
+    uint32_t erases;         /*!< Number of sector erases */
+    uint64_t read_bytes;     /*!< Number of bytes read */
+    uint64_t program_bytes;  /*!< Number of bytes programmed */
+    uint32_t async_ops;      /*!< Number of program and erase operations
+                              *   started in asynchronous mode
+                              */
+    uint32_t sector_erases[SST_HOST_FLASH_NBR_OF_SECTORS]; /*!< Number of
+                                                            *   erases of
+                                                            *   each sector
+                                                            */
+};
+
+/**
+ * \brief Erases the whole emulated flash device and resets the statistics.
+ */
+void sst_host_flash_init(void);
+
+/**
+ * \brief Enables or disables the asynchronous mode, in which the driver
+ *        reports the event_ready capability and signals the completion of the
+ *        program and erase operations. It is taken into account when the
+ *        driver capabilities are read by the secure storage.
+ *
+ * \param[in] enable  1 to enable the asynchronous mode, 0 to disable it
+ */
+void sst_host_flash_set_async(uint32_t enable);
+
+/**
+ * \brief Gets the statistics of the emulated flash device.
+ *
+ * \param[out] stats  Pointer to the structure to store the statistics
+ */
+void sst_host_flash_get_stats(struct sst_host_flash_stats_t *stats);
+
+/**
+ * \brief Estimates the time taken by the flash operations counted between
+ *        two statistics snapshots.
+ *
+ * \param[in] before  Statistics at the beginning of the operations
+ * \param[in] after   Statistics at the end of the operations
+ *
+ * \return Returns the estimated time in microseconds
+ */
+uint64_t sst_host_flash_estimate_us(
+                                   const struct sst_host_flash_stats_t *before,
+                                   const struct sst_host_flash_stats_t *after);
+
+/**
+ * \brief Schedules a power cut. The power is cut before the program or erase
+ *        operation which follows the given number of program and erase
+ *        operations. Then, all the program and erase operations fail until
+ *        the power is restored.
+ *
+ * \param[in] nbr_ops  Number of program and erase operations to perform
+ *                     before the power cut, or SST_HOST_FLASH_NO_POWER_CUT
+ */
+void sst_host_flash_set_power_cut(int32_t nbr_ops);
+
+/**
+ * \brief Checks if the power has been cut.
+ *
+ * \return Returns 1 if the power has been cut, 0 otherwise
+ */
+uint32_t sst_host_flash_power_is_cut(void);
+
+/**
+ * \brief Restores the power and cancels any scheduled power cut.
+ */
+void sst_host_flash_power_restore(void);
+
+/**
+ * \brief Saves the content of the emulated flash device.
+ *
+ * \param[out] buf  Buffer of SST_HOST_FLASH_SIZE bytes
+ */
+void sst_host_flash_save(uint8_t *buf);
+
+/**
+ * \brief Restores the content of the emulated flash device.
+ *
+ * \param[in] buf  Buffer of SST_HOST_FLASH_SIZE bytes
+ */
+void sst_host_flash_restore(const uint8_t *buf);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __SST_HOST_FLASH_H__ */
@@ -0,0 +1,909 @@
+/*
+ * Copyright (c) 2018, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+/* Host harness of the secure storage service. It runs a pseudo-random
+ * workload, generated from a seed, on the object system backed by an
+ * emulated NOR flash device, and checks the content of the assets against a
+ * model after every operation. Then, it reports the write amplification and
+ * the mount cost, and it replays part of the workload with a power cut
+ * before each of the flash program and erase operations, to check that the
+ * storage recovers either the state before or after the interrupted
+ * operation.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "tfm_sst_defs.h"
+#include "assets/sst_asset_defs.h"
+#include "sst_object_system.h"
+#include "flash/sst_flash.h"
+#include "sst_host_flash.h"
+
+/* Default number of operations of the workload */
+#define SST_HOST_DEFAULT_NBR_OPS 300U
+
+/* Largest asset size */
+#define SST_HOST_MAX_ASSET_SIZE SST_ASSET_MAX_SIZE_X509_CERT_LARGE
+
+/* Number of assets used by the workload */
+#define SST_HOST_NBR_ASSETS 10U
+
+/* Maximum number of operations in a transaction */
+#define SST_HOST_MAX_TXN_OPS 4U
+
+/* Maximum size of an append */
+#define SST_HOST_MAX_APPEND_SIZE 8U
+
+/* Type of operation of the workload */
+enum sst_host_op_t {
+    SST_HOST_OP_CREATE = 0,
+    SST_HOST_OP_WRITE,
+    SST_HOST_OP_DELETE,
+    SST_HOST_OP_TXN,
+    SST_HOST_OP_MAINTENANCE,
+};
+
+/* Expected state of an asset */
+struct sst_host_model_t {
+    uint32_t exists;                      /*!< Whether the asset exists */
+    uint32_t size;                        /*!< Current size of the asset */
+    uint8_t data[SST_HOST_MAX_ASSET_SIZE]; /*!< Content of the asset */
+};
+
+/* Options of the workload */
+struct sst_host_options_t {
+    uint32_t nbr_ops;      /*!< Number of operations */
+    uint32_t seed;         /*!< Seed of the workload */
+    uint32_t txn;          /*!< Groups some operations in transactions */
+    uint32_t maintenance;  /*!< Calls the maintenance between operations */
+    uint32_t append;       /*!< Favours appends over random writes */
+    uint32_t async;        /*!< Signals the completion of the flash program
+                            *   and erase operations
+                            */
+};
+
+/* Counters of the logical operations which have succeeded */
+struct sst_host_counters_t {
+    uint32_t writes;          /*!< Number of create, write and delete
+                               *   operations
+                               */
+    uint64_t bytes;           /*!< Number of bytes written */
+    uint32_t txn_commits;     /*!< Number of committed transactions */
+    uint32_t txn_aborts;      /*!< Number of aborted transactions */
+    uint32_t max_op_erases;   /*!< Maximum number of erases of an operation */
+    uint64_t max_op_program;  /*!< Maximum number of bytes programmed by an
+                               *   operation
+                               */
+};
+
+static const uint32_t sst_host_uuids[SST_HOST_NBR_ASSETS] = {
+    SST_ASSET_ID_AES_KEY_128,
+    SST_ASSET_ID_AES_KEY_192,
+    SST_ASSET_ID_AES_KEY_256,
+    SST_ASSET_ID_RSA_KEY_1024,
+    SST_ASSET_ID_RSA_KEY_2048,
+    SST_ASSET_ID_RSA_KEY_4096,
+    SST_ASSET_ID_X509_CERT_SMALL,
+    SST_ASSET_ID_X509_CERT_LARGE,
+    SST_ASSET_ID_SHA224_HASH,
+    SST_ASSET_ID_SHA384_HASH,
+};
+
+static const uint32_t sst_host_max_sizes[SST_HOST_NBR_ASSETS] = {
+    SST_ASSET_MAX_SIZE_AES_KEY_128,
+    SST_ASSET_MAX_SIZE_AES_KEY_192,
+    SST_ASSET_MAX_SIZE_AES_KEY_256,
+    SST_ASSET_MAX_SIZE_RSA_KEY_1024,
+    SST_ASSET_MAX_SIZE_RSA_KEY_2048,
+    SST_ASSET_MAX_SIZE_RSA_KEY_4096,
+    SST_ASSET_MAX_SIZE_X509_CERT_SMALL,
+    SST_ASSET_MAX_SIZE_X509_CERT_LARGE,
+    SST_ASSET_MAX_SIZE_SHA224_HASH,
+    SST_ASSET_MAX_SIZE_SHA384_HASH,
+};
+
+static const uint32_t sst_host_areas[SST_HOST_NBR_ASSETS] = {
+    SST_ASSET_AREA_AES_KEY_128,
+    SST_ASSET_AREA_AES_KEY_192,
+    SST_ASSET_AREA_AES_KEY_256,
+    SST_ASSET_AREA_RSA_KEY_1024,
+    SST_ASSET_AREA_RSA_KEY_2048,
+    SST_ASSET_AREA_RSA_KEY_4096,
+    SST_ASSET_AREA_X509_CERT_SMALL,
+    SST_ASSET_AREA_X509_CERT_LARGE,
+    SST_ASSET_AREA_SHA224_HASH,
+    SST_ASSET_AREA_SHA384_HASH,
+};
+
+static struct tfm_sst_token_t sst_host_token = { .token = NULL,
+                                                 .token_size = 0 };
+static struct sst_host_options_t sst_host_opts;
+static struct sst_host_counters_t sst_host_cnt;
+static struct sst_host_model_t sst_host_model[SST_HOST_NBR_ASSETS];
+static uint32_t sst_host_rng_state;
+
+/* Buffers used for the data of the operations */
+static uint8_t sst_host_write_buf[SST_HOST_MAX_ASSET_SIZE];
+static uint8_t sst_host_read_buf[SST_HOST_MAX_ASSET_SIZE + 1];
+
+/**
+ * \brief Generates the next pseudo-random number of the workload.
+ *
+ * \return Returns a pseudo-random number
+ */
+static uint32_t sst_host_rand(void)
+{
+    sst_host_rng_state = (sst_host_rng_state * 1103515245U) + 12345U;
+
+    return sst_host_rng_state >> 8;
+}
+
+/**
+ * \brief Calls a function of the secure storage for each storage area.
+ *
+ * \param[in] area_fn  Function to call with the ID of each area
+ *
+ * \return Returns the first error returned by the function, or
+ *         PSA_SST_ERR_SUCCESS
+ */
+static enum psa_sst_err_t sst_host_all_areas(
+                                     enum psa_sst_err_t (*area_fn)(uint32_t))
+{
+    enum psa_sst_err_t area_err;
+    enum psa_sst_err_t err = PSA_SST_ERR_SUCCESS;
+    uint32_t area_id;
+
+    for (area_id = 0; area_id < SST_NBR_OF_AREAS; area_id++) {
+        area_err = area_fn(area_id);
+        if (err == PSA_SST_ERR_SUCCESS) {
+            err = area_err;
+        }
+    }
+
+    return err;
+}
+
+/**
+ * \brief Checks that an asset has the expected state.
+ *
+ * \param[in] asset  Index of the asset
+ * \param[in] model  Expected state of the asset
+ *
+ * \return Returns 1 if the asset has the expected state, 0 otherwise
+ */
+static uint32_t sst_host_check_asset(uint32_t asset,
+                                     const struct sst_host_model_t *model)
+{
+    struct psa_sst_asset_info_t info;
+    enum psa_sst_err_t err;
+    uint32_t area_id = sst_host_areas[asset];
+    uint32_t uuid = sst_host_uuids[asset];
+#ifdef SST_ENABLE_PARTIAL_ASSET_RW
+    uint32_t offset;
+    uint32_t size;
+#endif
+
+    err = sst_object_get_info(area_id, uuid, &sst_host_token, &info);
+    if (!model->exists) {
+        return (err == PSA_SST_ERR_ASSET_NOT_FOUND);
+    }
+
+    if (err != PSA_SST_ERR_SUCCESS || info.size_current != model->size) {
+        return 0;
+    }
+
+    if (model->size == 0) {
+        return 1;
+    }
+
+    memset(sst_host_read_buf, 0xAA, sizeof(sst_host_read_buf));
+    err = sst_object_read(area_id, uuid, &sst_host_token, sst_host_read_buf,
+                          0, model->size);
+    if (err != PSA_SST_ERR_SUCCESS
+        || memcmp(sst_host_read_buf, model->data, model->size) != 0) {
+        return 0;
+    }
+
+#ifdef SST_ENABLE_PARTIAL_ASSET_RW
+    /* Reads a random part of the asset */
+    offset = sst_host_rand() % model->size;
+    size = sst_host_rand() % (model->size - offset + 1);
+    memset(sst_host_read_buf, 0xAA, sizeof(sst_host_read_buf));
+    err = sst_object_read(area_id, uuid, &sst_host_token, sst_host_read_buf,
+                          offset, size);
+    if (err != PSA_SST_ERR_SUCCESS
+        || memcmp(sst_host_read_buf, &model->data[offset], size) != 0) {
+        return 0;
+    }
+
+    /* Reading past the end of the asset must fail */
+    err = sst_object_read(area_id, uuid, &sst_host_token, sst_host_read_buf,
+                          offset, model->size - offset + 1);
+    if (err != PSA_SST_ERR_PARAM_ERROR) {
+        return 0;
+    }
+#endif
+
+    return 1;
+}
+
+/**
+ * \brief Checks that all the assets have the expected state.
+ *
+ * \param[in] model  Expected state of the assets
+ *
+ * \return Returns 1 if all the assets have the expected state, 0 otherwise
+ */
+static uint32_t sst_host_check_all(const struct sst_host_model_t *model)
+{
+    uint32_t asset;
+
+    for (asset = 0; asset < SST_HOST_NBR_ASSETS; asset++) {
+        if (!sst_host_check_asset(asset, &model[asset])) {
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+/**
+ * \brief Performs a create, write or delete operation on an asset, and
+ *        updates the model when it succeeds.
+ *
+ * \param[in]  asset  Index of the asset
+ * \param[out] op     Type of the operation performed
+ * \param[in]  batch  1 if the storage area is locked by
+ *                    sst_system_batch_lock, 0 otherwise
+ *
+ * \return Returns error code as specified in \ref psa_sst_err_t
+ */
+static enum psa_sst_err_t sst_host_single_op(uint32_t asset,
+                                             enum sst_host_op_t *op,
+                                             uint32_t batch)
+{
+    struct sst_host_model_t *model = &sst_host_model[asset];
+    uint32_t max_size = sst_host_max_sizes[asset];
+    uint32_t area_id = sst_host_areas[asset];
+    enum psa_sst_err_t err;
+    uint32_t offset;
+    uint32_t size;
+    uint32_t i;
+
+    if (!model->exists) {
+        *op = SST_HOST_OP_CREATE;
+        if (batch) {
+            err = sst_object_batch_create(area_id, sst_host_uuids[asset],
+                                          &sst_host_token, 0, max_size);
+        } else {
+            err = sst_object_create(area_id, sst_host_uuids[asset],
+                                    &sst_host_token, 0, max_size);
+        }
+        if (err == PSA_SST_ERR_SUCCESS) {
+            model->exists = 1;
+            model->size = 0;
+            sst_host_cnt.writes++;
+        }
+        return err;
+    }
+
+    if (sst_host_rand() % 4 == 0) {
+        *op = SST_HOST_OP_DELETE;
+        if (batch) {
+            err = sst_object_batch_delete(area_id, sst_host_uuids[asset],
+                                          &sst_host_token);
+        } else {
+            err = sst_object_delete(area_id, sst_host_uuids[asset],
+                                    &sst_host_token);
+        }
+        if (err == PSA_SST_ERR_SUCCESS) {
+            model->exists = 0;
+            sst_host_cnt.writes++;
+        }
+        return err;
+    }
+
+    *op = SST_HOST_OP_WRITE;
+    if (sst_host_opts.append && model->size < max_size
+        && sst_host_rand() % 4 != 0) {
+        offset = model->size;
+        size = 1 + sst_host_rand() % SST_HOST_MAX_APPEND_SIZE;
+    } else {
+        offset = sst_host_rand() % (model->size + 1);
+        if (offset >= max_size) {
+            offset = 0;
+        }
+        size = 1 + sst_host_rand() % (max_size - offset);
+    }
+    if (size > max_size - offset) {
+        size = max_size - offset;
+    }
+#ifndef SST_ENABLE_PARTIAL_ASSET_RW
+    offset = 0;
+#endif
+
+    for (i = 0; i < size; i++) {
+        sst_host_write_buf[i] = (uint8_t)sst_host_rand();
+    }
+
+    if (batch) {
+        err = sst_object_batch_write(area_id, sst_host_uuids[asset],
+                                     &sst_host_token, sst_host_write_buf,
+                                     offset, size);
+    } else {
+        err = sst_object_write(area_id, sst_host_uuids[asset],
+                               &sst_host_token, sst_host_write_buf, offset,
+                               size);
+    }
+    if (err == PSA_SST_ERR_SUCCESS) {
+        memcpy(&model->data[offset], sst_host_write_buf, size);
+        if (offset + size > model->size) {
+            model->size = offset + size;
+        }
+        sst_host_cnt.writes++;
+        sst_host_cnt.bytes += size;
+    }
+
+    return err;
+}
+
+/**
+ * \brief Performs a transaction made of several operations, the first one
+ *        being on the given asset and the next ones on the assets of the same
+ *        storage area, and updates the model when it is committed.
+ *
+ * \param[in] asset  Index of the asset of the first operation
+ *
+ * \note The area lock is held from the start of the transaction until it is
+ *       committed or aborted.
+ *
+ * \return Returns error code as specified in \ref psa_sst_err_t
+ */
+static enum psa_sst_err_t sst_host_txn_op(uint32_t asset)
+{
+    static struct sst_host_model_t saved_model[SST_HOST_NBR_ASSETS];
+    struct sst_host_counters_t saved_cnt = sst_host_cnt;
+    uint32_t area_id = sst_host_areas[asset];
+    enum psa_sst_err_t err;
+    enum sst_host_op_t op;
+    uint32_t nbr_ops;
+    uint32_t i;
+
+    memcpy(saved_model, sst_host_model, sizeof(saved_model));
+
+    sst_system_batch_lock(SST_SYSTEM_AREA_MASK(area_id));
+
+    err = sst_system_txn_begin(area_id);
+    if (err != PSA_SST_ERR_SUCCESS) {
+        sst_system_batch_unlock(SST_SYSTEM_AREA_MASK(area_id));
+        return err;
+    }
+
+    nbr_ops = 2 + sst_host_rand() % (SST_HOST_MAX_TXN_OPS - 1);
+    for (i = 0; i < nbr_ops && err == PSA_SST_ERR_SUCCESS; i++) {
+        err = sst_host_single_op(asset, &op, 1);
+        do {
+            asset = sst_host_rand() % SST_HOST_NBR_ASSETS;
+        } while (sst_host_areas[asset] != area_id);
+    }
+
+    if (err != PSA_SST_ERR_SUCCESS) {
+        memcpy(sst_host_model, saved_model, sizeof(saved_model));
+        sst_host_cnt = saved_cnt;
+        sst_host_cnt.txn_aborts++;
+        if (sst_system_txn_abort(area_id) != PSA_SST_ERR_SUCCESS) {
+            err = PSA_SST_ERR_SYSTEM_ERROR;
+        }
+        sst_system_batch_unlock(SST_SYSTEM_AREA_MASK(area_id));
+        return err;
+    }
+
+    err = sst_system_txn_commit(area_id);
+    sst_system_batch_unlock(SST_SYSTEM_AREA_MASK(area_id));
+    if (err != PSA_SST_ERR_SUCCESS) {
+        memcpy(sst_host_model, saved_model, sizeof(saved_model));
+        sst_host_cnt = saved_cnt;
+        return err;
+    }
+
+    sst_host_cnt.txn_commits++;
+    return PSA_SST_ERR_SUCCESS;
+}
+
+/**
+ * \brief Performs the next operation of the workload.
+ *
+ * \param[in]  asset  Index of the asset of the operation
+ * \param[out] op     Type of the operation performed
+ *
+ * \return Returns error code as specified in \ref psa_sst_err_t
+ */
+static enum psa_sst_err_t sst_host_next_op(uint32_t asset,
+                                           enum sst_host_op_t *op)
+{
+    enum psa_sst_err_t flush_err;
+    enum psa_sst_err_t err;
+
+    if (sst_host_opts.maintenance && sst_host_rand() % 3 == 0) {
+        *op = SST_HOST_OP_MAINTENANCE;
+        err = sst_host_all_areas(sst_system_maintenance);
+    } else if (sst_host_opts.txn && sst_host_rand() % 4 == 0) {
+        *op = SST_HOST_OP_TXN;
+        err = sst_host_txn_op(asset);
+    } else {
+        err = sst_host_single_op(asset, op, 0);
+    }
+
+    /* Lets the flash operations still queued complete, so that their cost
+     * and the power cuts before them are attributed to this operation.
+     */
+    flush_err = sst_host_all_areas(sst_flash_flush);
+    if (err == PSA_SST_ERR_SUCCESS) {
+        err = flush_err;
+    }
+
+    return err;
+}
+
+/**
+ * \brief Mounts the storage and reports its cost.
+ *
+ * \param[in] name   Name of the mount in the report
+ * \param[in] clean  Set if the storage has not been modified since it was
+ *                   last mounted, in which case the mount must not erase any
+ *                   block
+ *
+ * \return Returns 1 if the mount succeeds, 0 otherwise
+ */
+static uint32_t sst_host_mount(const char *name, uint32_t clean)
+{
+    struct sst_host_flash_stats_t before;
+    struct sst_host_flash_stats_t after;
+    struct timespec start;
+    struct timespec end;
+    enum psa_sst_err_t err;
+    uint64_t host_ns;
+
+    sst_host_flash_get_stats(&before);
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    err = sst_host_all_areas(sst_system_prepare);
+    if (err == PSA_SST_ERR_SUCCESS) {
+        err = sst_host_all_areas(sst_flash_flush);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    sst_host_flash_get_stats(&after);
+
+    if (err != PSA_SST_ERR_SUCCESS) {
+        printf("%s: mount failed with error %d\r\n", name, err);
+        return 0;
+    }
+
+    host_ns = (uint64_t)(end.tv_sec - start.tv_sec) * 1000000000U
+              + end.tv_nsec - start.tv_nsec;
+
+    printf("%s: host %llu us, estimated flash %llu us, reads %u (%llu bytes), "
+           "programs %u, erases %u\r\n", name,
+           (unsigned long long)(host_ns / 1000),
+           (unsigned long long)sst_host_flash_estimate_us(&before, &after),
+           after.reads - before.reads,
+           (unsigned long long)(after.read_bytes - before.read_bytes),
+           after.programs - before.programs, after.erases - before.erases);
+
+    if (clean && (after.erases != before.erases)) {
+        printf("%s: a clean mount erases blocks\r\n", name);
+        return 0;
+    }
+
+    return 1;
+}
+
+/**
+ * \brief Checks that the flash counters of the secure storage account the
+ *        operations performed by the flash device.
+ *
+ * \param[in] dev_start  Flash device statistics before the operations
+ * \param[in] dev_end    Flash device statistics after the operations
+ * \param[in] start      Flash counters before the operations
+ * \param[in] end        Flash counters after the operations
+ *
+ * \return Returns 1 if the counters are consistent, 0 otherwise
+ */
+static uint32_t sst_host_check_flash_stats(
+                                 const struct sst_host_flash_stats_t *dev_start,
+                                  const struct sst_host_flash_stats_t *dev_end,
+                                  const struct tfm_sst_flash_stats_t *start,
+                                  const struct tfm_sst_flash_stats_t *end)
+{
+    struct tfm_sst_flash_op_stats_t ops[TFM_SST_FLASH_NBR_OPS];
+    const struct tfm_sst_flash_op_stats_t *read;
+    const struct tfm_sst_flash_op_stats_t *write;
+    const struct tfm_sst_flash_op_stats_t *move;
+    struct tfm_sst_flash_trace_t entry;
+    uint64_t move_read_bytes;
+    uint64_t cache_read_bytes;
+    uint64_t dev_read_bytes;
+    uint32_t min_programs;
+    uint32_t erase_sectors;
+    uint32_t calls = 0;
+    uint32_t i;
+
+    for (i = 0; i < TFM_SST_FLASH_NBR_OPS; i++) {
+        ops[i].calls = end->ops[i].calls - start->ops[i].calls;
+        ops[i].errors = end->ops[i].errors - start->ops[i].errors;
+        ops[i].bytes = end->ops[i].bytes - start->ops[i].bytes;
+        calls += ops[i].calls;
+        if (ops[i].errors != 0) {
+            printf("flash counters: %u failed calls\r\n", ops[i].errors);
+            return 0;
+        }
+    }
+
+    read = &ops[TFM_SST_FLASH_OP_READ];
+    write = &ops[TFM_SST_FLASH_OP_WRITE];
+    move = &ops[TFM_SST_FLASH_OP_MOVE];
+
+    /* A move programs the source data in the destination by chunks, which
+     * are read first unless the flash is memory-mapped.
+     */
+#ifdef SST_FLASH_MAPPED_BASE
+    move_read_bytes = 0;
+#else
+    move_read_bytes = move->bytes;
+#endif
+    dev_read_bytes = dev_end->read_bytes - dev_start->read_bytes;
+
+    /* The read cache reads whole pages on a miss, and serves the hits
+     * without reading the flash. The reads larger than the cache bypass it.
+     */
+    cache_read_bytes = (uint64_t)(end->cache_misses - start->cache_misses) *
+                       SST_FLASH_CACHE_PAGE_SIZE;
+    if (end->cache_size == 0 &&
+        ((dev_end->reads - dev_start->reads) < read->calls ||
+         dev_read_bytes != (read->bytes + move_read_bytes))) {
+        printf("flash counters differ from the flash device statistics\r\n");
+        return 0;
+    }
+
+    if (end->cache_size != 0 &&
+        (dev_read_bytes < (cache_read_bytes + move_read_bytes) ||
+         dev_read_bytes >
+                        (cache_read_bytes + move_read_bytes + read->bytes))) {
+        printf("flash counters differ from the read cache statistics\r\n");
+        return 0;
+    }
+
+    /* Each write takes one program operation at least, unless the writes are
+     * combined in program pages. A move of no data programs nothing. A block
+     * is erased one sector at a time.
+     */
+#ifdef SST_FLASH_PROGRAM_PAGE_SIZE
+    min_programs = 0;
+#else
+    min_programs = write->calls;
+#endif
+    erase_sectors = (uint32_t)(ops[TFM_SST_FLASH_OP_ERASE].bytes /
+                               SST_SECTOR_SIZE);
+
+    if ((dev_end->programs - dev_start->programs) < min_programs ||
+        (dev_end->program_bytes - dev_start->program_bytes) !=
+                                               (write->bytes + move->bytes) ||
+        (dev_end->erases - dev_start->erases) != erase_sectors) {
+        printf("flash counters differ from the flash device statistics\r\n");
+        return 0;
+    }
+
+    if (end->trace_size != 0) {
+        if ((end->trace_count - start->trace_count) != calls ||
+            sst_flash_get_trace(&entry, 1) != PSA_SST_ERR_SUCCESS ||
+            entry.op >= TFM_SST_FLASH_NBR_OPS) {
+            printf("flash trace is inconsistent with the counters\r\n");
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+/**
+ * \brief Runs the workload and reports the write amplification.
+ *
+ * \return Returns 1 if the workload passes, 0 otherwise
+ */
+static uint32_t sst_host_run_workload(void)
+{
+    struct sst_host_flash_stats_t start;
+    struct sst_host_flash_stats_t before;
+    struct sst_host_flash_stats_t after;
+    struct sst_host_flash_stats_t end;
+    struct tfm_sst_flash_stats_t sst_start;
+    struct tfm_sst_flash_stats_t sst_end;
+    struct psa_sst_wear_info_t wear;
+    enum psa_sst_err_t err;
+    enum sst_host_op_t op;
+    uint32_t area_id;
+    uint32_t asset;
+    uint32_t i;
+
+    sst_host_flash_get_stats(&start);
+    sst_flash_get_stats(&sst_start);
+
+    for (i = 0; i < sst_host_opts.nbr_ops; i++) {
+        asset = sst_host_rand() % SST_HOST_NBR_ASSETS;
+
+        sst_host_flash_get_stats(&before);
+        err = sst_host_next_op(asset, &op);
+        sst_host_flash_get_stats(&after);
+
+        if (err != PSA_SST_ERR_SUCCESS
+            && err != PSA_SST_ERR_STORAGE_SYSTEM_FULL) {
+            printf("op %u (type %d) on asset %u failed with error %d\r\n",
+                   i, op, asset, err);
+            return 0;
+        }
+
+        if (op != SST_HOST_OP_MAINTENANCE) {
+            if (after.erases - before.erases > sst_host_cnt.max_op_erases) {
+                sst_host_cnt.max_op_erases = after.erases - before.erases;
+            }
+            if (after.program_bytes - before.program_bytes
+                > sst_host_cnt.max_op_program) {
+                sst_host_cnt.max_op_program = after.program_bytes
+                                              - before.program_bytes;
+            }
+        }
+
+        if (!sst_host_check_all(sst_host_model)) {
+            printf("assets differ from the model after op %u (type %d) "
+                   "on asset %u\r\n", i, op, asset);
+            return 0;
+        }
+    }
+
+    sst_host_flash_get_stats(&end);
+    sst_flash_get_stats(&sst_end);
+    if (!sst_host_check_flash_stats(&start, &end, &sst_start, &sst_end)) {
+        return 0;
+    }
+
+    printf("workload: %u ops, %u logical writes, %llu bytes written, "
+           "%u transactions committed, %u aborted\r\n",
+           sst_host_opts.nbr_ops, sst_host_cnt.writes,
+           (unsigned long long)sst_host_cnt.bytes, sst_host_cnt.txn_commits,
+           sst_host_cnt.txn_aborts);
+    printf("flash: %u programs (%llu bytes), %u erases, %llu bytes read\r\n",
+           after.programs - start.programs,
+           (unsigned long long)(after.program_bytes - start.program_bytes),
+           after.erases - start.erases,
+           (unsigned long long)(after.read_bytes - start.read_bytes));
+    if (sst_host_opts.async) {
+        printf("async: %u program and erase operations signalled their "
+               "completion\r\n", after.async_ops - start.async_ops);
+    }
+    if (sst_end.cache_size != 0) {
+        printf("read cache: %u pages, %u hits, %u misses\r\n",
+               sst_end.cache_size, sst_end.cache_hits - sst_start.cache_hits,
+               sst_end.cache_misses - sst_start.cache_misses);
+    }
+
+    if (sst_host_cnt.writes != 0 && sst_host_cnt.bytes != 0) {
+        printf("write amplification: %.2f programmed bytes per byte written, "
+               "%.3f erases per logical write\r\n",
+               (double)(after.program_bytes - start.program_bytes)
+               / (double)sst_host_cnt.bytes,
+               (double)(after.erases - start.erases)
+               / (double)sst_host_cnt.writes);
+    }
+    printf("worst op: %u erases, %llu bytes programmed\r\n",
+           sst_host_cnt.max_op_erases,
+           (unsigned long long)sst_host_cnt.max_op_program);
+
+    for (area_id = 0; area_id < SST_NBR_OF_AREAS; area_id++) {
+        if (sst_system_get_wear_info(area_id, &wear) != PSA_SST_ERR_SUCCESS) {
+            printf("wear info of area %u failed\r\n", area_id);
+            return 0;
+        }
+        printf("wear: area %u, %u blocks, erase count min %u max %u\r\n",
+               area_id, wear.nbr_blocks, wear.min_erase_count,
+               wear.max_erase_count);
+    }
+    printf("wear: sectors:");
+    for (i = 0; i < SST_HOST_FLASH_NBR_OF_SECTORS; i++) {
+        printf(" %u", after.sector_erases[i]);
+    }
+    printf("\r\n");
+
+    return 1;
+}
+
+/**
+ * \brief Replays operations of the workload with a power cut before each of
+ *        their flash program and erase operations. After each power cut, the
+ *        storage is mounted again and it must contain the assets as they
+ *        were either before or after the operation.
+ *
+ * \param[in] nbr_ops  Number of operations to replay
+ *
+ * \return Returns 1 if the storage always recovers, 0 otherwise
+ */
+static uint32_t sst_host_run_power_cuts(uint32_t nbr_ops)
+{
+    static uint8_t flash_before[SST_HOST_FLASH_SIZE];
+    static struct sst_host_model_t model_before[SST_HOST_NBR_ASSETS];
+    static struct sst_host_model_t model_after[SST_HOST_NBR_ASSETS];
+    struct sst_host_counters_t cnt_before;
+    enum psa_sst_err_t err;
+    enum sst_host_op_t op;
+    uint32_t rng_before;
+    uint32_t rng_after;
+    uint32_t nbr_cuts = 0;
+    uint32_t asset;
+    uint32_t recovered;
+    int32_t cut;
+    uint32_t i;
+
+    for (i = 0; i < nbr_ops; i++) {
+        asset = sst_host_rand() % SST_HOST_NBR_ASSETS;
+
+        /* Runs the operation without power cut to get the state after it */
+        sst_host_flash_save(flash_before);
+        memcpy(model_before, sst_host_model, sizeof(model_before));
+        cnt_before = sst_host_cnt;
+        rng_before = sst_host_rng_state;
+
+        err = sst_host_next_op(asset, &op);
+        if (err != PSA_SST_ERR_SUCCESS
+            && err != PSA_SST_ERR_STORAGE_SYSTEM_FULL) {
+            printf("power cut op %u (type %d) failed with error %d\r\n",
+                   i, op, err);
+            return 0;
+        }
+
+        memcpy(model_after, sst_host_model, sizeof(model_after));
+        rng_after = sst_host_rng_state;
+
+        for (cut = 0; ; cut++) {
+            sst_host_flash_restore(flash_before);
+            if (sst_host_all_areas(sst_system_prepare) !=
+                                                        PSA_SST_ERR_SUCCESS) {
+                printf("mount failed before power cut op %u\r\n", i);
+                return 0;
+            }
+            memcpy(sst_host_model, model_before, sizeof(model_before));
+            sst_host_rng_state = rng_before;
+
+            sst_host_flash_set_power_cut(cut);
+            (void)sst_host_next_op(asset, &op);
+            if (!sst_host_flash_power_is_cut()) {
+                sst_host_flash_power_restore();
+                break;
+            }
+
+            sst_host_flash_power_restore();
+            nbr_cuts++;
+
+            if (sst_host_all_areas(sst_system_prepare) !=
+                                                        PSA_SST_ERR_SUCCESS) {
+                printf("mount failed after power cut %d of op %u "
+                       "(type %d)\r\n", cut, i, op);
+                return 0;
+            }
+
+            recovered = sst_host_check_all(model_before)
+                        || sst_host_check_all(model_after);
+            if (!recovered) {
+                printf("inconsistent assets after power cut %d of op %u "
+                       "(type %d) on asset %u\r\n", cut, i, op, asset);
+                return 0;
+            }
+        }
+
+        /* Continues from the state after the operation */
+        memcpy(sst_host_model, model_after, sizeof(model_after));
+        sst_host_cnt = cnt_before;
+        sst_host_rng_state = rng_after;
+        if (!sst_host_check_all(sst_host_model)) {
+            printf("assets differ from the model after power cut op %u\r\n",
+                   i);
+            return 0;
+        }
+    }
+
+    printf("power cuts: %u ops, %u power cuts recovered\r\n", nbr_ops,
+           nbr_cuts);
+
+    return 1;
+}
+
+/**
+ * \brief Parses the command line options.
+ *
+ * \param[in] argc  Number of arguments
+ * \param[in] argv  Arguments
+ *
+ * \return Returns 1 if the options are valid, 0 otherwise
+ */
+static uint32_t sst_host_parse_options(int argc, char *argv[])
+{
+    int i;
+
+    sst_host_opts.nbr_ops = SST_HOST_DEFAULT_NBR_OPS;
+    sst_host_opts.seed = 1;
+
+    for (i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) {
+            sst_host_opts.nbr_ops = (uint32_t)strtoul(argv[++i], NULL, 0);
+        } else if (strcmp(argv[i], "-s") == 0 && i + 1 < argc) {
+            sst_host_opts.seed = (uint32_t)strtoul(argv[++i], NULL, 0);
+        } else if (strcmp(argv[i], "-t") == 0) {
+            sst_host_opts.txn = 1;
+        } else if (strcmp(argv[i], "-m") == 0) {
+            sst_host_opts.maintenance = 1;
+        } else if (strcmp(argv[i], "-a") == 0) {
+            sst_host_opts.append = 1;
+        } else if (strcmp(argv[i], "-A") == 0) {
+            sst_host_opts.async = 1;
+        } else {
+            printf("usage: %s [-n nbr_ops] [-s seed] [-t] [-m] [-a] [-A]\r\n"
+                   "  -t  group operations in transactions\r\n"
+                   "  -m  call the maintenance between operations\r\n"
+                   "  -a  favour appends over random writes\r\n"
+                   "  -A  complete the flash operations asynchronously\r\n",
+                   argv[0]);
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+int main(int argc, char *argv[])
+{
+    if (!sst_host_parse_options(argc, argv)) {
+        return 2;
+    }
+
+    sst_host_rng_state = sst_host_opts.seed;
+    sst_host_flash_init();
+    sst_host_flash_set_async(sst_host_opts.async);
+
+    if (sst_host_all_areas(sst_system_wipe_all) != PSA_SST_ERR_SUCCESS
+        || !sst_host_mount("first mount", 0)) {
+        printf("FAILED: unable to format the storage\r\n");
+        return 1;
+    }
+
+    if (!sst_host_run_workload()) {
+        printf("FAILED: workload\r\n");
+        return 1;
+    }
+
+    if (!sst_host_mount("mount", 0) || !sst_host_mount("second mount", 1)
+        || !sst_host_check_all(sst_host_model)) {
+        printf("FAILED: mount\r\n");
+        return 1;
+    }
+
+    if (sst_host_opts.maintenance) {
+        if (sst_host_all_areas(sst_system_maintenance) != PSA_SST_ERR_SUCCESS
+            || !sst_host_mount("mount after maintenance", 0)
+            || !sst_host_check_all(sst_host_model)) {
+            printf("FAILED: mount after maintenance\r\n");
+            return 1;
+        }
+    }
+
+    if (!sst_host_run_power_cuts(sst_host_opts.nbr_ops / 3)) {
+        printf("FAILED: power cuts\r\n");
+        return 1;
+    }
+
+    printf("PASSED\r\n");
+    return 0;
+}
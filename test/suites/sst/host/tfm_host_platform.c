@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2018, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+/* Host replacements of the TF-M core, NS identity manager and JWT functions
+ * used by the SST service, so that the service can be built and run on the
+ * host machine.
+ */
+
+#include <errno.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "tfm_host_platform.h"
+#include "tfm_secure_api.h"
+#include "tfm_id_mngr.h"
+#include "jwt.h"
+
+/* Return value of the TF-M core functions on success */
+#define TFM_HOST_SUCCESS 0
+#define TFM_HOST_ERROR   1
+
+typedef int32_t (*tfm_host_sfn_t)(uintptr_t, uintptr_t, uintptr_t, uintptr_t);
+
+static uint32_t tfm_host_secure_caller = 1;
+static uint32_t tfm_host_ns_app_id;
+
+void tfm_host_set_secure_caller(uint32_t secure)
+{
+    tfm_host_secure_caller = secure;
+}
+
+int32_t tfm_core_validate_secure_caller(void)
+{
+    return tfm_host_secure_caller ? TFM_HOST_SUCCESS : TFM_HOST_ERROR;
+}
+
+int32_t tfm_core_memory_permission_check(void *ptr, uint32_t size,
+                                         int32_t access)
+{
+    (void)ptr;
+    (void)size;
+    (void)access;
+
+    /* The host build has a single address space */
+    return TFM_HOST_SUCCESS;
+}
+
+int32_t tfm_core_partition_request(uint32_t id, void *fn,
+                                   uintptr_t a, uintptr_t b,
+                                   uintptr_t c, uintptr_t d)
+{
+    tfm_host_sfn_t sfn = (tfm_host_sfn_t)fn;
+
+    (void)id;
+
+    /* As the TF-M core does, the secure function is called with the four
+     * arguments of the request, whatever the number of arguments it uses.
+     */
+    return sfn(a, b, c, d);
+}
+
+void tfm_host_set_ns_app_id(uint32_t app_id)
+{
+    tfm_host_ns_app_id = app_id;
+}
+
+uint32_t tfm_sst_get_cur_id(void)
+{
+    return tfm_host_ns_app_id;
+}
+
+/* JWT signing is not supported by the host build */
+int jwt_init_builder(struct jwt_builder *builder, char *buffer,
+                     size_t buffer_size)
+{
+    (void)builder;
+    (void)buffer;
+    (void)buffer_size;
+
+    return -ENOTSUP;
+}
+
+int jwt_add_payload(struct jwt_builder *builder, s32_t exp, s32_t iat,
+                    const char *aud)
+{
+    (void)builder;
+    (void)exp;
+    (void)iat;
+    (void)aud;
+
+    return -ENOTSUP;
+}
+
+int jwt_sign(struct jwt_builder *builder, const char *der_key,
+             size_t der_key_len)
+{
+    (void)builder;
+    (void)der_key;
+    (void)der_key_len;
+
+    return -ENOTSUP;
+}
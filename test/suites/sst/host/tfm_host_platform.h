@@ -0,0 +1,36 @@
+/*
+ * Copyright (c) 2018, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#ifndef __TFM_HOST_PLATFORM_H__
+#define __TFM_HOST_PLATFORM_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+/**
+ * \brief Sets whether the following calls to the secure functions are made
+ *        by a secure caller.
+ *
+ * \param[in] secure  1 for a secure caller, 0 for a non-secure caller
+ */
+void tfm_host_set_secure_caller(uint32_t secure);
+
+/**
+ * \brief Sets the application ID returned by the NS identity manager.
+ *
+ * \param[in] app_id  Application ID of the non-secure caller
+ */
+void tfm_host_set_ns_app_id(uint32_t app_id);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __TFM_HOST_PLATFORM_H__ */
@@ -77,6 +77,7 @@ static void tfm_sst_test_1028(struct test_result_t *ret);
 static void tfm_sst_test_1029(struct test_result_t *ret);
 #endif
 static void tfm_sst_test_1030(struct test_result_t *ret);
+static void tfm_sst_test_1031(struct test_result_t *ret);
 
 static struct test_t asset_veeners_tests[] = {
     {&tfm_sst_test_1001, "TFM_SST_TEST_1001",
@@ -143,6 +144,8 @@ static struct test_t asset_veeners_tests[] = {
 #endif
     {&tfm_sst_test_1030, "TFM_SST_TEST_1030",
      "Basic test to verify set and get attributes functionality", {0} },
+    {&tfm_sst_test_1031, "TFM_SST_TEST_1031",
+     "Apply a list of operations as a single atomic update", {0} },
 };
 
 void register_testsuite_ns_sst_interface(struct test_suite_t *p_test_suite)
@@ -2075,3 +2078,112 @@ TFM_SST_NS_TEST(1030, "Thread_B")
 
     ret->val = TEST_PASSED;
 }
+
+/**
+ * \brief Tests apply operations function against:
+ * - Valid list, which creates and writes two assets
+ * - Invalid list, which deletes an asset and has an invalid operation type
+ */
+TFM_SST_NS_TEST(1031, "Thread_C")
+{
+    const uint32_t asset_uuid_1 = SST_ASSET_ID_AES_KEY_192;
+    const uint32_t asset_uuid_2 = SST_ASSET_ID_SHA384_HASH;
+    struct psa_sst_asset_info_t asset_info;
+    struct psa_sst_asset_op_t ops[4];
+    enum psa_sst_err_t err;
+    uint8_t read_data[READ_BUF_SIZE] = "XXXXXXXXXXXXX";
+    uint8_t wrt_data_1[WRITE_BUF_SIZE] = "DATA";
+    uint8_t wrt_data_2[WRITE_BUF_SIZE] = "ATAD";
+
+    ops[0].type = PSA_SST_ASSET_OP_CREATE;
+    ops[0].uuid = asset_uuid_1;
+    ops[1].type = PSA_SST_ASSET_OP_WRITE;
+    ops[1].uuid = asset_uuid_1;
+    ops[1].data = wrt_data_1;
+    ops[1].size = (WRITE_BUF_SIZE - 1);
+    ops[1].offset = 0;
+    ops[2].type = PSA_SST_ASSET_OP_CREATE;
+    ops[2].uuid = asset_uuid_2;
+    ops[3].type = PSA_SST_ASSET_OP_WRITE;
+    ops[3].uuid = asset_uuid_2;
+    ops[3].data = wrt_data_2;
+    ops[3].size = (WRITE_BUF_SIZE - 1);
+    ops[3].offset = 0;
+
+    /* Calls apply operations with an empty list */
+    err = psa_sst_apply_ops(ASSET_TOKEN, ASSET_TOKEN_SIZE, ops, 0);
+    if (err != PSA_SST_ERR_PARAM_ERROR) {
+        TEST_FAIL("Apply operations should fail for an empty list");
+        return;
+    }
+
+    err = psa_sst_apply_ops(ASSET_TOKEN, ASSET_TOKEN_SIZE, ops, 4);
+    if (err != PSA_SST_ERR_SUCCESS) {
+        TEST_FAIL("Apply operations should not fail for Thread_C");
+        return;
+    }
+
+    /* Reads the first asset back */
+    err = psa_sst_read(asset_uuid_1, ASSET_TOKEN, ASSET_TOKEN_SIZE,
+                       (WRITE_BUF_SIZE - 1), 0,
+                       (read_data + HALF_PADDING_SIZE));
+    if (err != PSA_SST_ERR_SUCCESS) {
+        TEST_FAIL("Read should not fail for Thread_C");
+        return;
+    }
+
+    if (memcmp(read_data, "XXXXDATAXXXXX", READ_BUF_SIZE) != 0) {
+        TEST_FAIL("Read buffer is incorrect");
+        return;
+    }
+
+    /* Thread_C can not read the second asset, so only its size is checked */
+    err = psa_sst_get_info(asset_uuid_2, ASSET_TOKEN, ASSET_TOKEN_SIZE,
+                           &asset_info);
+    if (err != PSA_SST_ERR_SUCCESS) {
+        TEST_FAIL("Get information should not fail for Thread_C");
+        return;
+    }
+
+    if (asset_info.size_current != (WRITE_BUF_SIZE - 1)) {
+        TEST_FAIL("Asset current size is incorrect");
+        return;
+    }
+
+    /* Deletes the first asset followed by an invalid operation type */
+    ops[0].type = PSA_SST_ASSET_OP_DELETE;
+    ops[1].type = PSA_SST_ASSET_OP_DELETE + 1;
+
+    err = psa_sst_apply_ops(ASSET_TOKEN, ASSET_TOKEN_SIZE, ops, 2);
+    if (err != PSA_SST_ERR_PARAM_ERROR) {
+        TEST_FAIL("Apply operations should fail for an invalid operation");
+        return;
+    }
+
+    /* Checks that the delete operation has been discarded */
+    err = psa_sst_read(asset_uuid_1, ASSET_TOKEN, ASSET_TOKEN_SIZE,
+                       (WRITE_BUF_SIZE - 1), 0,
+                       (read_data + HALF_PADDING_SIZE));
+    if (err != PSA_SST_ERR_SUCCESS) {
+        TEST_FAIL("Read should not fail as the list has been discarded");
+        return;
+    }
+
+    if (memcmp(read_data, "XXXXDATAXXXXX", READ_BUF_SIZE) != 0) {
+        TEST_FAIL("Read buffer is incorrect");
+        return;
+    }
+
+    /* Deletes the assets to clean up the SST area for the next test */
+    ops[0].uuid = asset_uuid_1;
+    ops[1].type = PSA_SST_ASSET_OP_DELETE;
+    ops[1].uuid = asset_uuid_2;
+
+    err = psa_sst_apply_ops(ASSET_TOKEN, ASSET_TOKEN_SIZE, ops, 2);
+    if (err != PSA_SST_ERR_SUCCESS) {
+        TEST_FAIL("Delete operations should not fail for Thread_C");
+        return;
+    }
+
+    ret->val = TEST_PASSED;
+}
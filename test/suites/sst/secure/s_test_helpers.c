@@ -12,16 +12,21 @@
 
 #include "test/framework/test_framework.h"
 #include "secure_fw/services/secure_storage/sst_object_system.h"
+#include "secure_fw/services/secure_storage/flash/sst_flash.h"
 
 uint32_t prepare_test_ctx(struct test_result_t *ret)
 {
-    /* Wipes secure storage area */
-    sst_system_wipe_all();
+    uint32_t area_id;
 
-    /* Prepares secure storage area before write */
-    if (sst_system_prepare() != PSA_SST_ERR_SUCCESS) {
-        TEST_FAIL("Wiped system should be preparable");
-        return 1;
+    for (area_id = 0; area_id < SST_NBR_OF_AREAS; area_id++) {
+        /* Wipes secure storage area */
+        sst_system_wipe_all(area_id);
+
+        /* Prepares secure storage area before write */
+        if (sst_system_prepare(area_id) != PSA_SST_ERR_SUCCESS) {
+            TEST_FAIL("Wiped system should be preparable");
+            return 1;
+        }
     }
 
     return 0;
@@ -12,6 +12,7 @@
 
 #include "test/framework/helpers.h"
 #include "secure_fw/services/secure_storage/assets/sst_asset_defs.h"
+#include "secure_fw/services/secure_storage/sst_asset_management.h"
 #include "secure_fw/services/secure_storage/sst_object_system.h"
 #include "tfm_sst_veneers.h"
 #include "s_test_helpers.h"
@@ -22,6 +23,9 @@
 #define READ_BUF_SIZE                14UL
 #define WRITE_BUF_SIZE                5UL
 
+/* Number of writes done to make the storage retire scratch blocks */
+#define LOOP_ITERATIONS               50UL
+
 /* Memory bounds to check */
 #define ROM_ADDR_LOCATION        0x10000000
 #define DEV_ADDR_LOCATION        0x50000000
@@ -67,6 +71,18 @@ static void tfm_sst_test_2021(struct test_result_t *ret);
 #ifdef SST_ENABLE_PARTIAL_ASSET_RW
 static void tfm_sst_test_2022(struct test_result_t *ret);
 #endif
+static void tfm_sst_test_2023(struct test_result_t *ret);
+static void tfm_sst_test_2024(struct test_result_t *ret);
+static void tfm_sst_test_2025(struct test_result_t *ret);
+static void tfm_sst_test_2026(struct test_result_t *ret);
+static void tfm_sst_test_2027(struct test_result_t *ret);
+#ifdef SST_KV
+static void tfm_sst_test_2028(struct test_result_t *ret);
+static void tfm_sst_test_2029(struct test_result_t *ret);
+static void tfm_sst_test_2030(struct test_result_t *ret);
+#endif
+static void tfm_sst_test_2031(struct test_result_t *ret);
+static void tfm_sst_test_2032(struct test_result_t *ret);
 
 static struct test_t write_tests[] = {
     {&tfm_sst_test_2001, "TFM_SST_TEST_2001",
@@ -117,6 +133,28 @@ static struct test_t write_tests[] = {
     {&tfm_sst_test_2022, "TFM_SST_TEST_2022",
      "Write data to the middle of an existing asset", {0} },
 #endif
+    {&tfm_sst_test_2023, "TFM_SST_TEST_2023",
+     "Apply a list of operations as a single update", {0} },
+    {&tfm_sst_test_2024, "TFM_SST_TEST_2024",
+     "Get wear information interface", {0} },
+    {&tfm_sst_test_2025, "TFM_SST_TEST_2025",
+     "Maintenance interface", {0} },
+    {&tfm_sst_test_2026, "TFM_SST_TEST_2026",
+     "Get flash statistics and trace interface", {0} },
+    {&tfm_sst_test_2027, "TFM_SST_TEST_2027",
+     "Read cache statistics", {0} },
+#ifdef SST_KV
+    {&tfm_sst_test_2028, "TFM_SST_TEST_2028",
+     "Key/value set, get and delete interface", {0} },
+    {&tfm_sst_test_2029, "TFM_SST_TEST_2029",
+     "Key/value namespaces and iterate interface", {0} },
+    {&tfm_sst_test_2030, "TFM_SST_TEST_2030",
+     "Key/value set and get with invalid parameters", {0} },
+#endif
+    {&tfm_sst_test_2031, "TFM_SST_TEST_2031",
+     "List assets interface", {0} },
+    {&tfm_sst_test_2032, "TFM_SST_TEST_2032",
+     "Read and write a batch of assets", {0} },
 };
 
 void register_testsuite_s_sst_sec_interface(struct test_suite_t *p_test_suite)
@@ -1543,3 +1581,932 @@ static void tfm_sst_test_2022(struct test_result_t *ret)
     ret->val = TEST_PASSED;
 }
 #endif /* SST_ENABLE_PARTIAL_ASSET_RW */
+
+/**
+ * \brief Tests apply operations function with the following list of
+ *        operations:
+ * - Valid list, which creates and writes two assets
+ * - Invalid list, which deletes an asset and has an invalid operation type
+ */
+static void tfm_sst_test_2023(struct test_result_t *ret)
+{
+    const uint32_t app_id = S_APP_ID;
+    const uint32_t asset_uuid_1 = SST_ASSET_ID_AES_KEY_192;
+    const uint32_t asset_uuid_2 = SST_ASSET_ID_SHA224_HASH;
+    struct psa_sst_asset_op_t ops[4];
+    struct tfm_sst_buf_t buf;
+    enum psa_sst_err_t err;
+    uint8_t read_data[READ_BUF_SIZE] = "XXXXXXXXXXXXX";
+    uint8_t write_data_1[WRITE_BUF_SIZE] = "DATA";
+    uint8_t write_data_2[WRITE_BUF_SIZE] = "ATAD";
+
+    /* Prepares test context */
+    if (prepare_test_ctx(ret) != 0) {
+        TEST_FAIL("Prepare test context should not fail");
+        return;
+    }
+
+    ops[0].type = PSA_SST_ASSET_OP_CREATE;
+    ops[0].uuid = asset_uuid_1;
+    ops[1].type = PSA_SST_ASSET_OP_WRITE;
+    ops[1].uuid = asset_uuid_1;
+    ops[1].data = write_data_1;
+    ops[1].size = (WRITE_BUF_SIZE - 1);
+    ops[1].offset = 0;
+    ops[2].type = PSA_SST_ASSET_OP_CREATE;
+    ops[2].uuid = asset_uuid_2;
+    ops[3].type = PSA_SST_ASSET_OP_WRITE;
+    ops[3].uuid = asset_uuid_2;
+    ops[3].data = write_data_2;
+    ops[3].size = (WRITE_BUF_SIZE - 1);
+    ops[3].offset = 0;
+
+    /* Calls apply operations with an empty list */
+    err = tfm_sst_veneer_apply_ops(app_id, &test_token, ops, 0);
+    if (err != PSA_SST_ERR_PARAM_ERROR) {
+        TEST_FAIL("Apply operations should fail for an empty list");
+        return;
+    }
+
+    err = tfm_sst_veneer_apply_ops(app_id, &test_token, ops, 4);
+    if (err != PSA_SST_ERR_SUCCESS) {
+        TEST_FAIL("Apply operations should not fail");
+        return;
+    }
+
+    /* Reads the second asset back */
+    buf.data = (read_data + HALF_PADDING_SIZE);
+    buf.size = (WRITE_BUF_SIZE - 1);
+    buf.offset = 0;
+
+    err = tfm_sst_veneer_read(app_id, asset_uuid_2, &test_token, &buf);
+    if (err != PSA_SST_ERR_SUCCESS) {
+        TEST_FAIL("Read should not fail");
+        return;
+    }
+
+    if (memcmp(read_data, "XXXXATADXXXXX", READ_BUF_SIZE) != 0) {
+        TEST_FAIL("Read buffer is incorrect");
+        return;
+    }
+
+    /* Deletes the first asset followed by an invalid operation type */
+    ops[0].type = PSA_SST_ASSET_OP_DELETE;
+    ops[1].type = PSA_SST_ASSET_OP_DELETE + 1;
+
+    err = tfm_sst_veneer_apply_ops(app_id, &test_token, ops, 2);
+    if (err != PSA_SST_ERR_PARAM_ERROR) {
+        TEST_FAIL("Apply operations should fail for an invalid operation");
+        return;
+    }
+
+    /* Checks that the delete operation has been discarded */
+    buf.data = (read_data + HALF_PADDING_SIZE);
+    buf.size = (WRITE_BUF_SIZE - 1);
+    buf.offset = 0;
+
+    err = tfm_sst_veneer_read(app_id, asset_uuid_1, &test_token, &buf);
+    if (err != PSA_SST_ERR_SUCCESS) {
+        TEST_FAIL("Read should not fail as the list has been discarded");
+        return;
+    }
+
+    if (memcmp(read_data, "XXXXDATAXXXXX", READ_BUF_SIZE) != 0) {
+        TEST_FAIL("Read buffer is incorrect");
+        return;
+    }
+
+    ret->val = TEST_PASSED;
+}
+
+/**
+ * \brief Tests get wear information function with the following cases:
+ * - Null wear information structure pointer
+ * - Valid wear information structure pointer
+ */
+static void tfm_sst_test_2024(struct test_result_t *ret)
+{
+    const uint32_t app_id = S_APP_ID;
+    struct psa_sst_wear_info_t wear_info;
+    enum psa_sst_err_t err;
+
+    /* Prepares test context */
+    if (prepare_test_ctx(ret) != 0) {
+        TEST_FAIL("Prepare test context should not fail");
+        return;
+    }
+
+    /* Calls get wear information with a null structure pointer */
+    err = tfm_sst_veneer_get_wear_info(app_id, NULL);
+    if (err != PSA_SST_ERR_PARAM_ERROR) {
+        TEST_FAIL("Get wear information should fail with a null pointer");
+        return;
+    }
+
+    err = tfm_sst_veneer_get_wear_info(app_id, &wear_info);
+    if (err != PSA_SST_ERR_SUCCESS) {
+        TEST_FAIL("Get wear information should not fail");
+        return;
+    }
+
+    if (wear_info.nbr_blocks == 0) {
+        TEST_FAIL("Number of blocks should not be 0");
+        return;
+    }
+
+    /* The storage area has been wiped, so each block has been erased once */
+    if (wear_info.min_erase_count == 0 ||
+        wear_info.max_erase_count < wear_info.min_erase_count) {
+        TEST_FAIL("Wear information is incorrect");
+        return;
+    }
+
+    ret->val = TEST_PASSED;
+}
+
+/**
+ * \brief Tests maintenance function. Writes an asset several times, so that
+ *        scratch blocks are retired, performs the maintenance and checks that
+ *        the asset content is still correct.
+ */
+static void tfm_sst_test_2025(struct test_result_t *ret)
+{
+    const uint32_t app_id = S_APP_ID;
+    const uint32_t asset_uuid = SST_ASSET_ID_AES_KEY_192;
+    struct tfm_sst_buf_t buf;
+    enum psa_sst_err_t err;
+    uint32_t i;
+    uint8_t read_data[READ_BUF_SIZE] = "XXXXXXXXXXXXX";
+    uint8_t write_data[WRITE_BUF_SIZE] = "DATA";
+
+    /* Prepares test context */
+    if (prepare_test_ctx(ret) != 0) {
+        TEST_FAIL("Prepare test context should not fail");
+        return;
+    }
+
+    /* Calls maintenance when there are no retired blocks */
+    err = tfm_sst_veneer_maintenance(app_id);
+    if (err != PSA_SST_ERR_SUCCESS) {
+        TEST_FAIL("Maintenance should not fail");
+        return;
+    }
+
+    err = tfm_sst_veneer_create(app_id, asset_uuid, &test_token);
+    if (err != PSA_SST_ERR_SUCCESS) {
+        TEST_FAIL("Create should not fail for application S_APP_ID");
+        return;
+    }
+
+    buf.data = write_data;
+    buf.size = (WRITE_BUF_SIZE - 1);
+    buf.offset = 0;
+
+    for (i = 0; i < LOOP_ITERATIONS; i++) {
+        err = tfm_sst_veneer_write(app_id, asset_uuid, &test_token, &buf);
+        if (err != PSA_SST_ERR_SUCCESS) {
+            TEST_FAIL("Write should not fail");
+            return;
+        }
+    }
+
+    err = tfm_sst_veneer_maintenance(app_id);
+    if (err != PSA_SST_ERR_SUCCESS) {
+        TEST_FAIL("Maintenance should not fail");
+        return;
+    }
+
+    buf.data = (read_data + HALF_PADDING_SIZE);
+    buf.size = (WRITE_BUF_SIZE - 1);
+    buf.offset = 0;
+
+    err = tfm_sst_veneer_read(app_id, asset_uuid, &test_token, &buf);
+    if (err != PSA_SST_ERR_SUCCESS) {
+        TEST_FAIL("Read should not fail");
+        return;
+    }
+
+    if (memcmp(read_data, "XXXXDATAXXXXX", READ_BUF_SIZE) != 0) {
+        TEST_FAIL("Read buffer is incorrect");
+        return;
+    }
+
+    ret->val = TEST_PASSED;
+}
+
+/**
+ * \brief Tests get flash statistics and trace functions with the following
+ *        scenarios:
+ * - Invalid application ID
+ * - Null statistics structure pointer
+ * - Statistics updated by a write
+ * - Most recent trace entry, if the trace is enabled
+ */
+static void tfm_sst_test_2026(struct test_result_t *ret)
+{
+    const uint32_t app_id = S_APP_ID;
+    const uint32_t asset_uuid = SST_ASSET_ID_AES_KEY_192;
+    struct tfm_sst_flash_stats_t before;
+    struct tfm_sst_flash_stats_t after;
+    struct tfm_sst_flash_trace_t entry;
+    struct tfm_sst_buf_t buf;
+    enum psa_sst_err_t err;
+    uint8_t write_data[WRITE_BUF_SIZE] = "DATA";
+
+    /* Prepares test context */
+    if (prepare_test_ctx(ret) != 0) {
+        TEST_FAIL("Prepare test context should not fail");
+        return;
+    }
+
+    /* Calls get flash statistics with an application ID other than the
+     * secure one
+     */
+    err = tfm_sst_veneer_get_flash_stats(INVALID_APP_ID, &before);
+    if (err != PSA_SST_ERR_PARAM_ERROR) {
+        TEST_FAIL("Get flash statistics should fail for a non-secure app ID");
+        return;
+    }
+
+    /* Calls get flash statistics with a null structure pointer */
+    err = tfm_sst_veneer_get_flash_stats(app_id, NULL);
+    if (err != PSA_SST_ERR_PARAM_ERROR) {
+        TEST_FAIL("Get flash statistics should fail with a null pointer");
+        return;
+    }
+
+    err = tfm_sst_veneer_create(app_id, asset_uuid, &test_token);
+    if (err != PSA_SST_ERR_SUCCESS) {
+        TEST_FAIL("Create should not fail for application S_APP_ID");
+        return;
+    }
+
+    err = tfm_sst_veneer_get_flash_stats(app_id, &before);
+    if (err != PSA_SST_ERR_SUCCESS) {
+        TEST_FAIL("Get flash statistics should not fail");
+        return;
+    }
+
+    buf.data = write_data;
+    buf.size = (WRITE_BUF_SIZE - 1);
+    buf.offset = 0;
+
+    err = tfm_sst_veneer_write(app_id, asset_uuid, &test_token, &buf);
+    if (err != PSA_SST_ERR_SUCCESS) {
+        TEST_FAIL("Write should not fail");
+        return;
+    }
+
+    err = tfm_sst_veneer_get_flash_stats(app_id, &after);
+    if (err != PSA_SST_ERR_SUCCESS) {
+        TEST_FAIL("Get flash statistics should not fail");
+        return;
+    }
+
+    /* The write programs at least the asset data in flash */
+    if (after.ops[TFM_SST_FLASH_OP_WRITE].calls <=
+        before.ops[TFM_SST_FLASH_OP_WRITE].calls ||
+        after.ops[TFM_SST_FLASH_OP_WRITE].bytes <
+        before.ops[TFM_SST_FLASH_OP_WRITE].bytes + buf.size) {
+        TEST_FAIL("Flash statistics should account the write");
+        return;
+    }
+
+    if (after.trace_size == 0) {
+        /* The trace is disabled, so no entry can be read */
+        err = tfm_sst_veneer_get_flash_trace(app_id, &entry, 1);
+        if (err != PSA_SST_ERR_PARAM_ERROR) {
+            TEST_FAIL("Get flash trace should fail when it is disabled");
+            return;
+        }
+
+        ret->val = TEST_PASSED;
+        return;
+    }
+
+    err = tfm_sst_veneer_get_flash_trace(app_id, &entry, 1);
+    if (err != PSA_SST_ERR_SUCCESS) {
+        TEST_FAIL("Get flash trace should not fail");
+        return;
+    }
+
+    if (entry.op >= TFM_SST_FLASH_NBR_OPS) {
+        TEST_FAIL("Flash trace entry is incorrect");
+        return;
+    }
+
+    err = tfm_sst_veneer_get_flash_trace(app_id, &entry,
+                                         after.trace_size + 1);
+    if (err != PSA_SST_ERR_PARAM_ERROR) {
+        TEST_FAIL("Get flash trace should fail beyond the trace size");
+        return;
+    }
+
+    ret->val = TEST_PASSED;
+}
+
+/**
+ * \brief Tests the read cache statistics with the following scenarios:
+ * - Reads of the same data served by the read cache, if it is enabled
+ * - No read cache statistics, if it is disabled
+ */
+static void tfm_sst_test_2027(struct test_result_t *ret)
+{
+    const uint32_t app_id = S_APP_ID;
+    const uint32_t asset_uuid = SST_ASSET_ID_AES_KEY_192;
+    struct tfm_sst_flash_stats_t before;
+    struct tfm_sst_flash_stats_t after;
+    struct tfm_sst_buf_t buf;
+    enum psa_sst_err_t err;
+    uint8_t write_data[WRITE_BUF_SIZE] = "DATA";
+    uint8_t read_data[READ_BUF_SIZE] = "XXXXXXXXXXXXX";
+
+    /* Prepares test context */
+    if (prepare_test_ctx(ret) != 0) {
+        TEST_FAIL("Prepare test context should not fail");
+        return;
+    }
+
+    err = tfm_sst_veneer_create(app_id, asset_uuid, &test_token);
+    if (err != PSA_SST_ERR_SUCCESS) {
+        TEST_FAIL("Create should not fail for application S_APP_ID");
+        return;
+    }
+
+    buf.data = write_data;
+    buf.size = (WRITE_BUF_SIZE - 1);
+    buf.offset = 0;
+
+    err = tfm_sst_veneer_write(app_id, asset_uuid, &test_token, &buf);
+    if (err != PSA_SST_ERR_SUCCESS) {
+        TEST_FAIL("Write should not fail");
+        return;
+    }
+
+    buf.data = read_data;
+
+    /* Reads the asset once, so that its data is cached if the read cache is
+     * enabled
+     */
+    err = tfm_sst_veneer_read(app_id, asset_uuid, &test_token, &buf);
+    if (err != PSA_SST_ERR_SUCCESS) {
+        TEST_FAIL("Read should not fail");
+        return;
+    }
+
+    err = tfm_sst_veneer_get_flash_stats(app_id, &before);
+    if (err != PSA_SST_ERR_SUCCESS) {
+        TEST_FAIL("Get flash statistics should not fail");
+        return;
+    }
+
+    err = tfm_sst_veneer_read(app_id, asset_uuid, &test_token, &buf);
+    if (err != PSA_SST_ERR_SUCCESS) {
+        TEST_FAIL("Read should not fail");
+        return;
+    }
+
+    err = tfm_sst_veneer_get_flash_stats(app_id, &after);
+    if (err != PSA_SST_ERR_SUCCESS) {
+        TEST_FAIL("Get flash statistics should not fail");
+        return;
+    }
+
+    if (memcmp(read_data, write_data, (WRITE_BUF_SIZE - 1)) != 0) {
+        TEST_FAIL("Read buffer contains incorrect data");
+        return;
+    }
+
+    if (after.cache_size == 0) {
+        if (after.cache_hits != 0 || after.cache_misses != 0) {
+            TEST_FAIL("Read cache statistics should be 0 when it is disabled");
+            return;
+        }
+
+        ret->val = TEST_PASSED;
+        return;
+    }
+
+    /* The second read finds the data read by the first one in the cache */
+    if (after.cache_hits <= before.cache_hits) {
+        TEST_FAIL("Read cache should serve the data read again");
+        return;
+    }
+
+    ret->val = TEST_PASSED;
+}
+
+#ifdef SST_KV
+/**
+ * \brief Sets a key/value buffer structure.
+ *
+ * \param[out] buf   Buffer structure to set
+ * \param[in]  data  Data pointer
+ * \param[in]  size  Data size
+ */
+static void set_kv_buf(struct tfm_sst_buf_t *buf, const void *data,
+                       uint32_t size)
+{
+    buf->data = (uint8_t *)data;
+    buf->size = size;
+    buf->offset = 0;
+}
+
+/**
+ * \brief Tests the key/value set, get and delete functions with the following
+ *        scenarios:
+ * - Get of a key which does not exist
+ * - Set, get and overwrite of a key
+ * - Value kept across a prepare of the secure storage
+ * - Delete of the key
+ */
+static void tfm_sst_test_2028(struct test_result_t *ret)
+{
+    const uint32_t app_id = S_APP_ID;
+    const char key_name[] = "config.mode";
+    struct tfm_sst_buf_t key;
+    struct tfm_sst_buf_t data;
+    enum psa_sst_err_t err;
+    uint8_t read_data[READ_BUF_SIZE] = "XXXXXXXXXXXXX";
+
+    /* Prepares test context */
+    if (prepare_test_ctx(ret) != 0) {
+        TEST_FAIL("Prepare test context should not fail");
+        return;
+    }
+
+    set_kv_buf(&key, key_name, (sizeof(key_name) - 1));
+    set_kv_buf(&data, read_data, READ_BUF_SIZE);
+
+    err = tfm_sst_veneer_kv_get(app_id, &key, &data);
+    if (err != PSA_SST_ERR_ASSET_NOT_FOUND) {
+        TEST_FAIL("Get should fail for a key which does not exist");
+        return;
+    }
+
+    set_kv_buf(&data, "DATA", 4);
+    err = tfm_sst_veneer_kv_set(app_id, &key, &data);
+    if (err != PSA_SST_ERR_SUCCESS) {
+        TEST_FAIL("Set should not fail");
+        return;
+    }
+
+    set_kv_buf(&data, "AB", 2);
+    err = tfm_sst_veneer_kv_set(app_id, &key, &data);
+    if (err != PSA_SST_ERR_SUCCESS) {
+        TEST_FAIL("Set of an existing key should not fail");
+        return;
+    }
+
+    /* Calls prepare again to simulate reinitialization */
+    err = sst_am_prepare();
+    if (err != PSA_SST_ERR_SUCCESS) {
+        TEST_FAIL("Saved system should have been preparable");
+        return;
+    }
+
+    set_kv_buf(&data, read_data, READ_BUF_SIZE);
+    err = tfm_sst_veneer_kv_get(app_id, &key, &data);
+    if (err != PSA_SST_ERR_SUCCESS) {
+        TEST_FAIL("Get should not fail");
+        return;
+    }
+
+    if ((data.size != 2) ||
+        (memcmp(read_data, "ABXXXXXXXXXXX", READ_BUF_SIZE) != 0)) {
+        TEST_FAIL("Get should return the last value set");
+        return;
+    }
+
+    err = tfm_sst_veneer_kv_delete(app_id, &key);
+    if (err != PSA_SST_ERR_SUCCESS) {
+        TEST_FAIL("Delete should not fail");
+        return;
+    }
+
+    set_kv_buf(&data, read_data, READ_BUF_SIZE);
+    err = tfm_sst_veneer_kv_get(app_id, &key, &data);
+    if (err != PSA_SST_ERR_ASSET_NOT_FOUND) {
+        TEST_FAIL("Get should fail for a deleted key");
+        return;
+    }
+
+    err = tfm_sst_veneer_kv_delete(app_id, &key);
+    if (err != PSA_SST_ERR_ASSET_NOT_FOUND) {
+        TEST_FAIL("Delete should fail for a deleted key");
+        return;
+    }
+
+    ret->val = TEST_PASSED;
+}
+
+/**
+ * \brief Tests the key/value namespaces and the iterate function with the
+ *        following scenarios:
+ * - Key of the secure application not visible to another application
+ * - Secure caller on behalf of another application not allowed to set a key
+ * - Iteration over the keys of the secure application
+ */
+static void tfm_sst_test_2029(struct test_result_t *ret)
+{
+    const uint32_t app_id = S_APP_ID;
+    const char key_names[][8] = { "key.a", "key.b", "key.c" };
+    const uint32_t nbr_keys = sizeof(key_names) / sizeof(key_names[0]);
+    struct tfm_sst_buf_t key;
+    struct tfm_sst_buf_t data;
+    enum psa_sst_err_t err;
+    uint32_t cursor;
+    uint32_t found = 0;
+    uint32_t i;
+    char key_buf[8];
+
+    /* Prepares test context */
+    if (prepare_test_ctx(ret) != 0) {
+        TEST_FAIL("Prepare test context should not fail");
+        return;
+    }
+
+    for (i = 0; i < nbr_keys; i++) {
+        set_kv_buf(&key, key_names[i], strlen(key_names[i]));
+        set_kv_buf(&data, &i, sizeof(i));
+        err = tfm_sst_veneer_kv_set(app_id, &key, &data);
+        if (err != PSA_SST_ERR_SUCCESS) {
+            TEST_FAIL("Set should not fail");
+            return;
+        }
+    }
+
+    /* The keys of the secure application are not visible to the others */
+    set_kv_buf(&key, key_names[0], strlen(key_names[0]));
+    set_kv_buf(&data, &i, sizeof(i));
+    err = tfm_sst_veneer_kv_get(SST_APP_ID_1, &key, &data);
+    if (err != PSA_SST_ERR_ASSET_NOT_FOUND) {
+        TEST_FAIL("Get should fail for a key of another application");
+        return;
+    }
+
+    /* A secure caller can not set a key on behalf of another application */
+    err = tfm_sst_veneer_kv_set(SST_APP_ID_1, &key, &data);
+    if (err != PSA_SST_ERR_ASSET_NOT_FOUND) {
+        TEST_FAIL("Set should fail on behalf of another application");
+        return;
+    }
+
+    cursor = 0;
+    while (1) {
+        set_kv_buf(&key, key_buf, sizeof(key_buf));
+        err = tfm_sst_veneer_kv_iterate(app_id, &cursor, &key);
+        if (err != PSA_SST_ERR_SUCCESS) {
+            break;
+        }
+
+        for (i = 0; i < nbr_keys; i++) {
+            if ((key.size == strlen(key_names[i])) &&
+                (memcmp(key_buf, key_names[i], key.size) == 0)) {
+                found |= (1U << i);
+            }
+        }
+    }
+
+    if (err != PSA_SST_ERR_ASSET_NOT_FOUND) {
+        TEST_FAIL("Iterate should end with no more key");
+        return;
+    }
+
+    if (found != ((1U << nbr_keys) - 1)) {
+        TEST_FAIL("Iterate should return all the keys of the application");
+        return;
+    }
+
+    cursor = 0;
+    set_kv_buf(&key, key_buf, sizeof(key_buf));
+    err = tfm_sst_veneer_kv_iterate(SST_APP_ID_1, &cursor, &key);
+    if (err != PSA_SST_ERR_ASSET_NOT_FOUND) {
+        TEST_FAIL("Iterate should not return the keys of another application");
+        return;
+    }
+
+    ret->val = TEST_PASSED;
+}
+
+/**
+ * \brief Tests the key/value set and get functions with the following
+ *        invalid parameters:
+ * - Empty key
+ * - Key longer than the maximum key length
+ * - Null key and value structure pointers
+ * - Value buffer smaller than the value
+ */
+static void tfm_sst_test_2030(struct test_result_t *ret)
+{
+    const uint32_t app_id = S_APP_ID;
+    const char key_name[] = "config.mode";
+    const char long_key[] = "config.key.longer.than.maximum.length.of.keys";
+    struct tfm_sst_buf_t key;
+    struct tfm_sst_buf_t data;
+    enum psa_sst_err_t err;
+    uint8_t read_data[READ_BUF_SIZE] = "XXXXXXXXXXXXX";
+
+    /* Prepares test context */
+    if (prepare_test_ctx(ret) != 0) {
+        TEST_FAIL("Prepare test context should not fail");
+        return;
+    }
+
+    set_kv_buf(&data, "DATA", 4);
+
+    set_kv_buf(&key, key_name, 0);
+    err = tfm_sst_veneer_kv_set(app_id, &key, &data);
+    if (err != PSA_SST_ERR_PARAM_ERROR) {
+        TEST_FAIL("Set should fail with an empty key");
+        return;
+    }
+
+    set_kv_buf(&key, long_key, (sizeof(long_key) - 1));
+    err = tfm_sst_veneer_kv_set(app_id, &key, &data);
+    if (err != PSA_SST_ERR_PARAM_ERROR) {
+        TEST_FAIL("Set should fail with a key longer than the maximum");
+        return;
+    }
+
+    err = tfm_sst_veneer_kv_set(app_id, NULL, &data);
+    if (err != PSA_SST_ERR_PARAM_ERROR) {
+        TEST_FAIL("Set should fail with a null key structure pointer");
+        return;
+    }
+
+    set_kv_buf(&key, key_name, (sizeof(key_name) - 1));
+    err = tfm_sst_veneer_kv_set(app_id, &key, NULL);
+    if (err != PSA_SST_ERR_PARAM_ERROR) {
+        TEST_FAIL("Set should fail with a null value structure pointer");
+        return;
+    }
+
+    err = tfm_sst_veneer_kv_set(app_id, &key, &data);
+    if (err != PSA_SST_ERR_SUCCESS) {
+        TEST_FAIL("Set should not fail");
+        return;
+    }
+
+    /* The value does not fit in the buffer */
+    set_kv_buf(&data, read_data, 2);
+    err = tfm_sst_veneer_kv_get(app_id, &key, &data);
+    if (err != PSA_SST_ERR_PARAM_ERROR) {
+        TEST_FAIL("Get should fail with a buffer smaller than the value");
+        return;
+    }
+
+    if (memcmp(read_data, "XXXXXXXXXXXXX", READ_BUF_SIZE) != 0) {
+        TEST_FAIL("Get should not modify the buffer when it fails");
+        return;
+    }
+
+    ret->val = TEST_PASSED;
+}
+#endif /* SST_KV */
+
+/**
+ * \brief Tests the list assets function with the following scenarios:
+ * - Empty storage
+ * - Assets listed with their sizes in a single call
+ * - Assets listed one by one with the cursor
+ * - Secure caller on behalf of applications with and without the reference
+ *   permission on the assets
+ * - Invalid number of entries
+ */
+static void tfm_sst_test_2031(struct test_result_t *ret)
+{
+    const uint32_t app_id = S_APP_ID;
+    struct psa_sst_asset_list_entry_t entries[4];
+    struct tfm_sst_buf_t io_data;
+    enum psa_sst_err_t err;
+    uint32_t nbr_entries;
+    uint32_t cursor;
+    uint32_t found = 0;
+    uint32_t i;
+    uint8_t wrt_data[WRITE_BUF_SIZE] = "DATA";
+
+    /* Prepares test context */
+    if (prepare_test_ctx(ret) != 0) {
+        TEST_FAIL("Prepare test context should not fail");
+        return;
+    }
+
+    cursor = 0;
+    nbr_entries = 4;
+    err = tfm_sst_veneer_list_assets(app_id, &cursor, entries, &nbr_entries);
+    if (err != PSA_SST_ERR_ASSET_NOT_FOUND) {
+        TEST_FAIL("List should not return any asset of a wiped storage");
+        return;
+    }
+
+    err = tfm_sst_veneer_create(app_id, SST_ASSET_ID_AES_KEY_192,
+                                &test_token);
+    if (err != PSA_SST_ERR_SUCCESS) {
+        TEST_FAIL("Create should not fail");
+        return;
+    }
+
+    err = tfm_sst_veneer_create(app_id, SST_ASSET_ID_SHA224_HASH,
+                                &test_token);
+    if (err != PSA_SST_ERR_SUCCESS) {
+        TEST_FAIL("Create should not fail");
+        return;
+    }
+
+    io_data.data = wrt_data;
+    io_data.size = WRITE_BUF_SIZE;
+    io_data.offset = 0;
+
+    err = tfm_sst_veneer_write(app_id, SST_ASSET_ID_AES_KEY_192, &test_token,
+                               &io_data);
+    if (err != PSA_SST_ERR_SUCCESS) {
+        TEST_FAIL("Write should not fail");
+        return;
+    }
+
+    cursor = 0;
+    nbr_entries = 4;
+    err = tfm_sst_veneer_list_assets(app_id, &cursor, entries, &nbr_entries);
+    if ((err != PSA_SST_ERR_SUCCESS) || (nbr_entries != 2)) {
+        TEST_FAIL("List should return the two assets");
+        return;
+    }
+
+    for (i = 0; i < nbr_entries; i++) {
+        if ((entries[i].uuid == SST_ASSET_ID_AES_KEY_192) &&
+            (entries[i].size_current == WRITE_BUF_SIZE) &&
+            (entries[i].size_max == SST_ASSET_MAX_SIZE_AES_KEY_192)) {
+            found |= 1U;
+        } else if ((entries[i].uuid == SST_ASSET_ID_SHA224_HASH) &&
+                   (entries[i].size_current == 0) &&
+                   (entries[i].size_max == SST_ASSET_MAX_SIZE_SHA224_HASH)) {
+            found |= 2U;
+        }
+    }
+
+    if (found != 3U) {
+        TEST_FAIL("List should return the assets with their sizes");
+        return;
+    }
+
+    /* Lists the assets one by one */
+    cursor = 0;
+    for (i = 0; i < 3; i++) {
+        nbr_entries = 1;
+        err = tfm_sst_veneer_list_assets(app_id, &cursor, entries,
+                                         &nbr_entries);
+        if (err != PSA_SST_ERR_SUCCESS) {
+            break;
+        }
+
+        if (nbr_entries != 1) {
+            TEST_FAIL("List should return a single asset");
+            return;
+        }
+    }
+
+    if ((i != 2) || (err != PSA_SST_ERR_ASSET_NOT_FOUND)) {
+        TEST_FAIL("List should end after the two assets");
+        return;
+    }
+
+    /* SST_APP_ID_0 only has the reference permission on the AES key */
+    cursor = 0;
+    nbr_entries = 4;
+    err = tfm_sst_veneer_list_assets(SST_APP_ID_0, &cursor, entries,
+                                     &nbr_entries);
+    if ((err != PSA_SST_ERR_SUCCESS) || (nbr_entries != 1) ||
+        (entries[0].uuid != SST_ASSET_ID_AES_KEY_192)) {
+        TEST_FAIL("List should only return the assets of the application");
+        return;
+    }
+
+    cursor = 0;
+    nbr_entries = 4;
+    err = tfm_sst_veneer_list_assets(SST_APP_ID_3, &cursor, entries,
+                                     &nbr_entries);
+    if (err != PSA_SST_ERR_ASSET_NOT_FOUND) {
+        TEST_FAIL("List should not return the assets of other applications");
+        return;
+    }
+
+    cursor = 0;
+    nbr_entries = 0;
+    err = tfm_sst_veneer_list_assets(app_id, &cursor, entries, &nbr_entries);
+    if (err != PSA_SST_ERR_PARAM_ERROR) {
+        TEST_FAIL("List should fail with no entry");
+        return;
+    }
+
+    ret->val = TEST_PASSED;
+}
+
+/**
+ * \brief Tests the batched read and write functions with the following
+ *        scenarios:
+ * - Two assets written and read back in a single call
+ * - Batch stopped at an asset which does not exist
+ * - Secure caller writing on behalf of an application
+ * - Invalid number of descriptors
+ */
+static void tfm_sst_test_2032(struct test_result_t *ret)
+{
+    const uint32_t app_id = S_APP_ID;
+    struct psa_sst_asset_io_t ios[2];
+    enum psa_sst_err_t err;
+    uint32_t nbr_ios;
+    uint8_t wrt_data_1[WRITE_BUF_SIZE] = "DATA";
+    uint8_t wrt_data_2[WRITE_BUF_SIZE] = "HASH";
+    uint8_t read_data_1[WRITE_BUF_SIZE] = "XXXX";
+    uint8_t read_data_2[WRITE_BUF_SIZE] = "XXXX";
+
+    /* Prepares test context */
+    if (prepare_test_ctx(ret) != 0) {
+        TEST_FAIL("Prepare test context should not fail");
+        return;
+    }
+
+    err = tfm_sst_veneer_create(app_id, SST_ASSET_ID_AES_KEY_192,
+                                &test_token);
+    if (err != PSA_SST_ERR_SUCCESS) {
+        TEST_FAIL("Create should not fail");
+        return;
+    }
+
+    err = tfm_sst_veneer_create(app_id, SST_ASSET_ID_SHA224_HASH,
+                                &test_token);
+    if (err != PSA_SST_ERR_SUCCESS) {
+        TEST_FAIL("Create should not fail");
+        return;
+    }
+
+    ios[0].uuid = SST_ASSET_ID_AES_KEY_192;
+    ios[0].token = test_token.token;
+    ios[0].token_size = test_token.token_size;
+    ios[0].size = WRITE_BUF_SIZE;
+    ios[0].offset = 0;
+    ios[0].data = wrt_data_1;
+
+    ios[1] = ios[0];
+    ios[1].uuid = SST_ASSET_ID_SHA224_HASH;
+    ios[1].data = wrt_data_2;
+
+    nbr_ios = 2;
+    err = tfm_sst_veneer_write_multi(app_id, ios, &nbr_ios);
+    if ((err != PSA_SST_ERR_SUCCESS) || (nbr_ios != 2)) {
+        TEST_FAIL("Write multi should write the two assets");
+        return;
+    }
+
+    ios[0].data = read_data_1;
+    ios[1].data = read_data_2;
+
+    nbr_ios = 2;
+    err = tfm_sst_veneer_read_multi(app_id, ios, &nbr_ios);
+    if ((err != PSA_SST_ERR_SUCCESS) || (nbr_ios != 2)) {
+        TEST_FAIL("Read multi should read the two assets");
+        return;
+    }
+
+    if ((memcmp(read_data_1, wrt_data_1, WRITE_BUF_SIZE) != 0) ||
+        (memcmp(read_data_2, wrt_data_2, WRITE_BUF_SIZE) != 0)) {
+        TEST_FAIL("Read multi should read the data written");
+        return;
+    }
+
+    /* The batch stops at the asset which has not been created */
+    memset(read_data_1, 'X', WRITE_BUF_SIZE);
+    ios[1].uuid = SST_ASSET_ID_SHA384_HASH;
+
+    nbr_ios = 2;
+    err = tfm_sst_veneer_read_multi(app_id, ios, &nbr_ios);
+    if ((err != PSA_SST_ERR_ASSET_NOT_FOUND) || (nbr_ios != 1)) {
+        TEST_FAIL("Read multi should stop at the asset which does not exist");
+        return;
+    }
+
+    if (memcmp(read_data_1, wrt_data_1, WRITE_BUF_SIZE) != 0) {
+        TEST_FAIL("Read multi should read the assets before the failure");
+        return;
+    }
+
+    /* The write permission can not be delegated by a secure caller */
+    ios[0].data = wrt_data_2;
+
+    nbr_ios = 1;
+    err = tfm_sst_veneer_write_multi(SST_APP_ID_2, ios, &nbr_ios);
+    if ((err != PSA_SST_ERR_ASSET_NOT_FOUND) || (nbr_ios != 0)) {
+        TEST_FAIL("Write multi should not write on behalf of an application");
+        return;
+    }
+
+    nbr_ios = 0;
+    err = tfm_sst_veneer_read_multi(app_id, ios, &nbr_ios);
+    if (err != PSA_SST_ERR_PARAM_ERROR) {
+        TEST_FAIL("Read multi should fail with no descriptor");
+        return;
+    }
+
+    ret->val = TEST_PASSED;
+}
@@ -0,0 +1,144 @@
+#-------------------------------------------------------------------------------
+# Copyright (c) 2018, Arm Limited. All rights reserved.
+#
+# SPDX-License-Identifier: BSD-3-Clause
+#
+#-------------------------------------------------------------------------------
+
+# Generates the lookup tables of the SST asset policy database. The asset
+# UUIDs and the application IDs are mapped to the rows and columns of a
+# permissions table by perfect hash tables, so that a permission check takes
+# a constant number of operations.
+
+import os
+from keyword_substitution import Verbosity, log_print
+from generate_from_template import generate
+
+try:
+    import yaml
+except ImportError as e:
+    print e, "To install it, type:"
+    print "pip install PyYAML"
+    exit(1)
+
+VERBOSITY = Verbosity.warning
+log_print(Verbosity.debug, "Setting verbosity to", VERBOSITY, verbosity=VERBOSITY)
+
+# All operations assume tf-m repo root as active working directory
+
+POLICY_FILE = os.path.join('secure_fw', 'services', 'secure_storage',
+                           'assets', 'sst_asset_policy.yaml')
+OUTPUT_FILE = os.path.join('secure_fw', 'services', 'secure_storage',
+                           'assets', 'sst_asset_policy_tables.inc')
+
+PERM_NAMES = ["REFERENCE", "READ", "WRITE"]
+
+# Multiplier of the first hash function tried, the golden ratio in 32 bits
+HASH_MULT_BASE = 0x9E3779B1
+HASH_MAX_TRIES = 100000
+
+# Functions
+def hash_key(key, mult, shift):
+    return ((key * mult) & 0xFFFFFFFF) >> shift
+
+def build_perfect_hash(keys):
+    # The table has a power of 2 size, at least twice the number of keys, so
+    # that the hash is a multiplication and a shift.
+    bits = 1
+    while (1 << bits) < (2 * len(keys)):
+        bits += 1
+    shift = 32 - bits
+
+    for attempt in range(HASH_MAX_TRIES):
+        mult = (HASH_MULT_BASE + (2 * attempt)) & 0xFFFFFFFF
+        slots = set()
+        for key in keys:
+            slots.add(hash_key(key, mult, shift))
+        if len(slots) == len(keys):
+            return mult, shift, (1 << bits)
+
+    print "No perfect hash found for the keys", keys
+    exit(1)
+
+def build_hash_table(items, key, empty, empty_comment):
+    mult, shift, size = build_perfect_hash([item[key] for item in items])
+    table = [{"value": empty, "comment": empty_comment}] * size
+    for idx, item in enumerate(items):
+        table[hash_key(item[key], mult, shift)] = {"value": idx,
+                                                   "comment": item["name"]}
+    return {"mult": "0x%08XU" % mult, "shift": shift, "size": size,
+            "slots": table}
+
+def perm_expression(perms):
+    if not perms:
+        return "SST_PERM_FORBIDDEN"
+    return " | ".join(["SST_PERM_" + perm for perm in PERM_NAMES
+                       if perm in perms])
+
+def check_ids(items, key, kind):
+    seen = set()
+    for item in items:
+        if item[key] in seen:
+            print kind, item["name"], "is not unique"
+            exit(1)
+        seen.add(item[key])
+
+def build_policy(policy):
+    apps = policy["apps"]
+    assets = policy["assets"]
+
+    check_ids(apps, "id", "Application ID")
+    check_ids(assets, "uuid", "Asset UUID")
+
+    app_idx = {}
+    for idx, app in enumerate(apps):
+        app_idx[app["name"]] = idx
+
+    # One cell per asset and application, plus the row and column selected
+    # when the asset or the application is not found
+    cells = []
+    for asset in assets:
+        row = [None] * len(apps)
+        for perm in asset["perms"]:
+            if perm["app"] not in app_idx:
+                print "Unknown application", perm["app"], "for", asset["name"]
+                exit(1)
+            for name in perm["perm"]:
+                if name not in PERM_NAMES:
+                    print "Unknown permission", name, "for", asset["name"]
+                    exit(1)
+            row[app_idx[perm["app"]]] = perm["perm"]
+        for idx, app in enumerate(apps):
+            cells.append({"perm": perm_expression(row[idx]),
+                          "comment": asset["name"] + ", " + app["name"]})
+        cells.append({"perm": "SST_PERM_FORBIDDEN",
+                      "comment": asset["name"] + ", unknown application"})
+    for app in apps:
+        cells.append({"perm": "SST_PERM_FORBIDDEN",
+                      "comment": "Unknown asset, " + app["name"]})
+    cells.append({"perm": "SST_PERM_FORBIDDEN",
+                  "comment": "Unknown asset, unknown application"})
+
+    return {"policy": {
+        "nbr_assets": len(assets),
+        "nbr_apps": len(apps),
+        "assets": assets,
+        "apps": apps,
+        "uuid_hash": build_hash_table(assets, "uuid", len(assets),
+                                      "Unknown asset"),
+        "app_hash": build_hash_table(apps, "id", len(apps),
+                                     "Unknown application"),
+        "perms": cells,
+    }}
+
+# main
+def main():
+    with open(POLICY_FILE) as policy_yaml_file:
+        policy = yaml.load(policy_yaml_file)
+
+    print "Generating", OUTPUT_FILE
+    generate([build_policy(policy)], OUTPUT_FILE)
+    print "Generation of files done"
+
+if __name__ == "__main__":
+    main()